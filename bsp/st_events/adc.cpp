@@ -27,25 +27,25 @@ extern "C"
     void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* hadc)
     {
         Nilai::Events::AdcEvent e {hadc, Nilai::Events::EventTypes::ADC_ConvCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* hadc)
     {
         Nilai::Events::AdcEvent e {hadc, Nilai::Events::EventTypes::ADC_ConvHalfCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_ADC_LevelOutOfWindowCallback(ADC_HandleTypeDef* hadc)
     {
         Nilai::Events::AdcEvent e {hadc, Nilai::Events::EventTypes::ADC_LevelOutOfWindow};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_ADC_ErrorCallback(ADC_HandleTypeDef* hadc)
     {
         Nilai::Events::AdcEvent e {hadc, Nilai::Events::EventTypes::ADC_Error};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 }
 
@@ -24,79 +24,79 @@ extern "C"
     void HAL_CAN_TxMailbox0CompleteCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox0Cplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_TxMailbox1CompleteCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox1Cplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_TxMailbox2CompleteCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox2Cplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_TxMailbox0AbortCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox0AbortCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_TxMailbox1AbortCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox1AbortCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_TxMailbox2AbortCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_TxMailbox2AbortCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_RxFifo0MsgPending};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_RxFifo0FullCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_RxFifo0Full};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_RxFifo1MsgPending};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_RxFifo1FullCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_RxFifo1Full};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_SleepCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_Sleep};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_WakeUpFromRxMsgCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_WakeUpFromRx};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_CAN_ErrorCallback(CAN_HandleTypeDef* hcan)
     {
         Nilai::Events::CanEvent e {hcan, Nilai::Events::EventTypes::CAN_Error};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 }
 #    endif
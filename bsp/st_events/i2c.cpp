@@ -26,25 +26,25 @@ extern "C"
     void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_MasterTxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_MasterRxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_SlaveTxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_SlaveRxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_AddrCallback(I2C_HandleTypeDef* hi2c,
@@ -52,37 +52,37 @@ extern "C"
                               uint16_t           AddrMatchCode)
     {
         Nilai::Events::I2cAddrEvent e(hi2c, TransferDirection, AddrMatchCode);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_ListenCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_ListenCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_MemTxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_MemRxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_Error);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 
     void HAL_I2C_AbortCpltCallback(I2C_HandleTypeDef* hi2c)
     {
         Nilai::Events::I2cEvent e(hi2c, Nilai::Events::EventTypes::I2C_AbortCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 }
 #    endif
@@ -24,31 +24,31 @@ extern "C"
     void HAL_I2S_TxHalfCpltCallback(I2S_HandleTypeDef* hi2s)
     {
         Nilai::Events::I2sEvent e(hi2s, Nilai::Events::EventTypes::I2S_TxHalfCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2S_TxCpltCallback(I2S_HandleTypeDef* hi2s)
     {
         Nilai::Events::I2sEvent e(hi2s, Nilai::Events::EventTypes::I2S_TxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2S_RxHalfCpltCallback(I2S_HandleTypeDef* hi2s)
     {
         Nilai::Events::I2sEvent e(hi2s, Nilai::Events::EventTypes::I2S_RxHalfCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2S_RxCpltCallback(I2S_HandleTypeDef* hi2s)
     {
         Nilai::Events::I2sEvent e(hi2s, Nilai::Events::EventTypes::I2S_RxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_I2S_ErrorCallback(I2S_HandleTypeDef* hi2s)
     {
         Nilai::Events::I2sEvent e(hi2s, Nilai::Events::EventTypes::I2S_Error);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 }
 #    endif
@@ -27,7 +27,7 @@ extern "C"
     void HAL_RTC_AlarmAEventCallback(RTC_HandleTypeDef* hrtc)
     {
         Nilai::Events::RtcEvent e(hrtc, Nilai::Events::EventTypes::RTC_AlarmAEvent);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 }
 #    endif
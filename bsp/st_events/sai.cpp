@@ -27,31 +27,31 @@ extern "C"
     void HAL_SAI_TxHalfCpltCallback(SAI_HandleTypeDef* hsai)
     {
         Nilai::Events::SaiEvent e {hsai, Nilai::Events::EventTypes::SAI_TxHalfCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SAI_TxCpltCallback(SAI_HandleTypeDef* hsai)
     {
         Nilai::Events::SaiEvent e {hsai, Nilai::Events::EventTypes::SAI_TxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef* hsai)
     {
         Nilai::Events::SaiEvent e {hsai, Nilai::Events::EventTypes::SAI_RxHalfCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SAI_RxCpltCallback(SAI_HandleTypeDef* hsai)
     {
         Nilai::Events::SaiEvent e {hsai, Nilai::Events::EventTypes::SAI_RxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SAI_ErrorCallback(SAI_HandleTypeDef* hsai)
     {
         Nilai::Events::SaiEvent e {hsai, Nilai::Events::EventTypes::SAI_Error};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 }
 #    endif
@@ -27,49 +27,49 @@ extern "C"
     void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_TxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_RxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_TxRxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_TxHalfCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_TxHalfCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_RxHalfCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_RxCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_TxRxHalfCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_TxRxHalfCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_Error);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 
     void HAL_SPI_AbortCpltCallback(SPI_HandleTypeDef* hspi)
     {
         Nilai::Events::SpiEvent e(hspi, Nilai::Events::EventTypes::SPI_AbortCplt);
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 }
 
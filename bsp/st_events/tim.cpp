@@ -22,37 +22,37 @@
 extern "C" void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_PeriodElapsed);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e);
 }
 
 extern "C" void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_OC_DelayElapsed);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e);
 }
 
 extern "C" void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_IC_Capture);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e);
 }
 
 extern "C" void HAL_TIM_PWM_PulseFinishedCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_PWM_PulseFinished);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e);
 }
 
 extern "C" void HAL_TIM_TriggerCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_Trigger);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e);
 }
 
 extern "C" void HAL_TIM_ErrorCallback(TIM_HandleTypeDef* htim)
 {
     Nilai::Events::TimEvent e(htim, Nilai::Events::EventTypes::Tim_Error);
-    Nilai::Application::Get()->DispatchEvent(&e);
+    Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
 }
 #    endif
 #endif
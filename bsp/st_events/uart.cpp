@@ -27,55 +27,55 @@ extern "C"
     void HAL_UART_TxHalfCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_TxHalfCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_TxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_RxHalfCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_RxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_Error};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e, Nilai::Events::EventPriority::High);
     }
 
     void HAL_UART_AbortCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_AbortCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_AbortTransmitCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_AbortTxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UART_AbortReceiveCpltCallback(UART_HandleTypeDef* huart)
     {
         Nilai::Events::UartEvent e {huart, Nilai::Events::EventTypes::UART_AbortRxCplt};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 
     void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t Size)
     {
         Nilai::Events::UartRxEvent e {huart, Size};
-        Nilai::Application::Get()->DispatchEvent(&e);
+        Nilai::Application::Get()->PostEvent(e);
     }
 }
 
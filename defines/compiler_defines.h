@@ -33,6 +33,10 @@
     {
 #define END_REGION }
 
+//! Pastes two tokens together, after expanding them. Used to make unique names with __LINE__.
+#define NILAI_CONCAT(a, b)      NILAI_CONCAT_IMPL(a, b)
+#define NILAI_CONCAT_IMPL(a, b) a##b
+
 #if defined(__XC16__)
 #    define _PACKED_      __attribute__((__packed__))
 #    define _INTERRUPT_   __attribute__((interrupt, no_auto_psv))
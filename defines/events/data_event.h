@@ -21,30 +21,46 @@
 
 #    include "generic_event.h"
 
-#    include <cstdlib>
 #    include <cstring>
+#    include <new>
+#    include <type_traits>
+
+#    if !defined(NILAI_EVENTS_DATA_EVENT_SIZE)
+#        define NILAI_EVENTS_DATA_EVENT_SIZE 32
+#    endif
 
 namespace Nilai::Events
 {
+/**
+ * @brief Software event carrying a copy of a small object.
+ *
+ * The object is copied in a buffer inside the event itself, nothing is allocated. It must be
+ * trivially copyable and fit in @ref NILAI_EVENTS_DATA_EVENT_SIZE bytes.
+ */
 struct DataEvent : public Event
 {
-    void*  Data = nullptr;
-    size_t Len  = 0;
+    static constexpr size_t s_capacity = NILAI_EVENTS_DATA_EVENT_SIZE;
+
+    size_t Len = 0;
 
     template<typename T>
-    DataEvent(const T& data) : Event(EventTypes::DataEvent, EventCategories::Data)
+    DataEvent(const T& data)
+        requires(std::is_trivially_copyable_v<T> && sizeof(T) <= s_capacity)
+    : Event(EventTypes::DataEvent, EventCategories::Data), Len(sizeof(T))
     {
-        Len  = sizeof(T);
-        Data = malloc(Len);
-        memcpy(Data, reinterpret_cast<void*>(const_cast<T*>(&data)), Len);
+        std::memcpy(m_data, &data, sizeof(T));
     }
-    ~DataEvent() override { free(Data); }
+
+    [[nodiscard]] const void* Data() const noexcept { return m_data; }
 
     template<typename T>
     const T& As() const
     {
-        return *reinterpret_cast<T*>(Data);
+        return *std::launder(reinterpret_cast<const T*>(m_data));
     }
+
+private:
+    alignas(std::max_align_t) uint8_t m_data[s_capacity] = {};
 };
 }    // namespace Nilai::Events
 
@@ -0,0 +1,206 @@
+/**
+ * @file    event_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Queue of events posted from interrupts, to be dispatched later by the main loop.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_EVENTS_EVENTQUEUE_H
+#define NILAI_EVENTS_EVENTQUEUE_H
+
+#if defined(NILAI_USE_EVENTS)
+
+#    include "generic_event.h"
+
+#    include <array>
+#    include <atomic>
+#    include <bit>
+#    include <concepts>
+#    include <cstddef>
+#    include <new>
+
+#    if !defined(NILAI_EVENTS_RECORD_SIZE)
+#        define NILAI_EVENTS_RECORD_SIZE 64
+#    endif
+#    if !defined(NILAI_EVENTS_QUEUE_DEPTH)
+#        define NILAI_EVENTS_QUEUE_DEPTH 8
+#    endif
+
+namespace Nilai::Events
+{
+/**
+ * @brief Context in which an event callback is called.
+ */
+enum class DispatchMode
+{
+    //! Called by the main loop, after the event has been posted. This is the default.
+    Deferred = 0,
+    //! Called directly from the interrupt that posted the event.
+    Immediate,
+};
+
+/**
+ * @brief Order in which the queued events are dispatched by the main loop.
+ */
+enum class EventPriority
+{
+    High = 0,
+    Normal,
+    Low,
+    Count,
+};
+
+/**
+ * @brief Bounded queue of events, with many producers and a single consumer.
+ *
+ * Events are copied in fixed-size records, no allocation is ever made. Any interrupt can push,
+ * even if it preempts another one that is pushing in the same queue: records are reserved with a
+ * compare-and-swap and published with a per-record sequence number. The main loop pops the
+ * records in the order they were reserved.
+ *
+ * @tparam RecordSize Size of the largest event that can be queued, in bytes.
+ * @tparam Depth Maximum number of events in the queue. Must be a power of two.
+ */
+template<size_t RecordSize, size_t Depth>
+class EventQueue
+{
+    static_assert(std::has_single_bit(Depth), "The depth of the queue must be a power of 2!");
+
+    struct Record
+    {
+        //! Equal to the reservation index once the record can be written, and to that index + 1
+        //! once the event is ready to be read.
+        std::atomic<size_t> Sequence = 0;
+        //! The event, as its base class.
+        Event* Obj = nullptr;
+
+        alignas(std::max_align_t) std::byte Data[RecordSize] = {};
+    };
+
+public:
+    static constexpr size_t s_recordSize = RecordSize;
+    static constexpr size_t s_depth      = Depth;
+
+    EventQueue() noexcept
+    {
+        for (size_t i = 0; i < Depth; i++)
+        {
+            m_records[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    EventQueue(const EventQueue&)            = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+
+    ~EventQueue()
+    {
+        while (Pop([](Event*) {}))
+        {
+        }
+    }
+
+    /**
+     * @brief Copies an event at the end of the queue. Can be called from any context.
+     * @param e The event.
+     * @return True if the event was queued, false if the queue was full.
+     */
+    template<typename E>
+        requires std::derived_from<E, Event>
+    bool Push(const E& e) noexcept
+    {
+        static_assert(sizeof(E) <= RecordSize,
+                      "The event is too big to be queued, increase NILAI_EVENTS_RECORD_SIZE!");
+        static_assert(alignof(E) <= alignof(std::max_align_t));
+
+        size_t  pos = m_head.load(std::memory_order_relaxed);
+        Record* record;
+        while (true)
+        {
+            record         = &m_records[pos & (Depth - 1)];
+            size_t    seq  = record->Sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The record still holds an event that hasn't been dispatched.
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        record->Obj = ::new (record->Data) E(e);
+        record->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Hands the oldest event to a function, then removes it from the queue.
+     *
+     * Must only be called by the consumer.
+     *
+     * @param f The function to call with the event.
+     * @return True if an event was popped, false if the queue is empty or if the oldest event is
+     * still being written.
+     */
+    template<typename F>
+    bool Pop(F&& f)
+    {
+        Record& record = m_records[m_tail & (Depth - 1)];
+        if (record.Sequence.load(std::memory_order_acquire) != m_tail + 1)
+        {
+            return false;
+        }
+
+        Event* e = record.Obj;
+        f(e);
+        e->~Event();
+
+        // Hands the record back to the producers, for the next lap.
+        record.Sequence.store(m_tail + Depth, std::memory_order_release);
+        m_tail++;
+        return true;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_records[m_tail & (Depth - 1)].Sequence.load(std::memory_order_acquire) !=
+               m_tail + 1;
+    }
+
+    /**
+     * @brief Gets the number of events that could not be queued because the queue was full.
+     */
+    [[nodiscard]] size_t Dropped() const noexcept
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<Record, Depth> m_records = {};
+    std::atomic<size_t>       m_head    = 0;
+    size_t                    m_tail    = 0;
+    std::atomic<size_t>       m_dropped = 0;
+};
+}    // namespace Nilai::Events
+#endif
+
+#endif    // NILAI_EVENTS_EVENTQUEUE_H
@@ -21,6 +21,7 @@
 
 #    include "../internal_config.h"
 #    include "data_event.h"
+#    include "event_queue.h"
 #    include "ext_event.h"
 #    include "generic_event.h"
 #    include "types.h"
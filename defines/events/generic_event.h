@@ -20,10 +20,14 @@
 #if defined(NILAI_USE_EVENTS)
 
 #    include "../../services/time.h"
+#    include "../inplace_function.h"
 #    include "types.h"
 
 #    include <cstdint>
-#    include <functional>
+
+#    if !defined(NILAI_EVENTS_CALLBACK_SIZE)
+#        define NILAI_EVENTS_CALLBACK_SIZE (4 * sizeof(void*))
+#    endif
 
 namespace Nilai::Events
 {
@@ -57,8 +61,10 @@ struct Event
 /**
  * @brief A callback function should return true if the event should not be propagated further,
  * i.e if the following callbacks in the list should not be called after this one.
+ *
+ * The callback is stored in place, its captures must fit in @ref NILAI_EVENTS_CALLBACK_SIZE bytes.
  */
-using EventFunction = std::function<bool(Event* e)>;
+using EventFunction = InplaceFunction<bool(Event* e), NILAI_EVENTS_CALLBACK_SIZE>;
 }    // namespace Nilai::Events
 #endif
 
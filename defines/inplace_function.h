@@ -0,0 +1,140 @@
+/**
+ * @file    inplace_function.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Type-erased callable stored in a fixed-size buffer, without any heap allocation.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DEFINES_INPLACE_FUNCTION_H
+#define NILAI_DEFINES_INPLACE_FUNCTION_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai
+{
+template<typename Signature, size_t Capacity>
+class InplaceFunction;
+
+/**
+ * @brief Drop-in replacement for std::function that never allocates.
+ *
+ * The callable is stored directly in the object. Callables that don't fit in @p Capacity bytes
+ * are rejected at compile time instead of being moved to the heap. This makes copying, calling
+ * and destroying the function deterministic, and safe to do from an interrupt.
+ *
+ * @tparam R Return type of the function.
+ * @tparam Args Types of the arguments of the function.
+ * @tparam Capacity Size of the storage, in bytes.
+ */
+template<typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity>
+{
+    struct VTable
+    {
+        R (*Invoke)(void* f, Args... args);
+        void (*Copy)(void* dst, const void* src);
+        void (*Destroy)(void* f);
+    };
+
+    template<typename F>
+    static constexpr VTable s_vtable = {
+      [](void* f, Args... args) -> R
+      { return (*static_cast<F*>(f))(std::forward<Args>(args)...); },
+      [](void* dst, const void* src) { ::new (dst) F(*static_cast<const F*>(src)); },
+      [](void* f) { static_cast<F*>(f)->~F(); },
+    };
+
+public:
+    static constexpr size_t s_capacity = Capacity;
+
+    InplaceFunction() noexcept = default;
+    InplaceFunction(std::nullptr_t) noexcept {}
+
+    template<typename F, typename Fn = std::decay_t<F>>
+        requires(!std::is_same_v<Fn, InplaceFunction> && std::is_invocable_r_v<R, Fn&, Args...>)
+    InplaceFunction(F&& f)
+    {
+        static_assert(sizeof(Fn) <= Capacity,
+                      "The callable is too big, capture less or increase the capacity!");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "The callable is over-aligned!");
+        static_assert(std::is_copy_constructible_v<Fn>, "The callable must be copyable!");
+
+        ::new (m_storage) Fn(std::forward<F>(f));
+        m_vtable = &s_vtable<Fn>;
+    }
+
+    InplaceFunction(const InplaceFunction& o) { CopyFrom(o); }
+
+    InplaceFunction& operator=(const InplaceFunction& o)
+    {
+        if (this != &o)
+        {
+            Reset();
+            CopyFrom(o);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { Reset(); }
+
+    /**
+     * @brief Calls the stored callable.
+     *
+     * The function must not be empty.
+     */
+    R operator()(Args... args) const
+    {
+        return m_vtable->Invoke(const_cast<std::byte*>(m_storage), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept { return m_vtable != nullptr; }
+
+private:
+    void CopyFrom(const InplaceFunction& o)
+    {
+        if (o.m_vtable != nullptr)
+        {
+            o.m_vtable->Copy(m_storage, o.m_storage);
+        }
+        m_vtable = o.m_vtable;
+    }
+
+    void Reset() noexcept
+    {
+        if (m_vtable != nullptr)
+        {
+            m_vtable->Destroy(m_storage);
+            m_vtable = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) std::byte m_storage[Capacity] = {};
+    const VTable* m_vtable = nullptr;
+};
+}    // namespace Nilai
+//!@}
+#endif
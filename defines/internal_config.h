@@ -74,6 +74,14 @@
 #    define NILAI_USE_TAS5760
 #endif
 
+#if defined(NILAI_UART_RX_USE_FRAME_POOL) && defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+#    error The UART can only use one reception mode at a time!
+#endif
+
+#if defined(NILAI_UART_RX_USE_FRAME_POOL) || defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+#    define NILAI_UART_RX_IN_PLACE
+#endif
+
 #if defined(NILAI_TEST)
 #    define NILAI_NOP()
 #else
@@ -10,6 +10,7 @@
 /*************************************************************************************************/
 /* File includes ------------------------------------------------------------------------------- */
 #    include <cstddef>
+#    include <cstdint>
 
 namespace Nilai
 {
@@ -21,6 +22,18 @@ namespace Nilai
 
 class Application;
 
+/**
+ * @brief Defines when the scheduler of the application runs a module.
+ *
+ * Only used when @ref NILAI_USE_SCHEDULER is defined, modules are otherwise run on every pass.
+ */
+enum class RunPolicy
+{
+    Always,      //!< Run on every pass of the main loop.
+    Periodic,    //!< Run once every period, or when signalled.
+    OnSignal,    //!< Run only after @ref Module::Signal has been called.
+};
+
 /**
  * @class   Module
  * @brief   Base class to inherit from when building modules.
@@ -62,10 +75,52 @@ public:
      */
     [[nodiscard]] size_t GetId() const noexcept { return m_id; }
 
+    [[nodiscard]] RunPolicy GetRunPolicy() const noexcept { return m_runPolicy; }
+    [[nodiscard]] uint32_t  GetRunPeriod() const noexcept { return m_runPeriod; }
+    [[nodiscard]] uint8_t   GetPriority() const noexcept { return m_priority; }
+
+    /**
+     * @brief Requests the module to be run on the next pass of the main loop.
+     *
+     * Can be called from an interrupt.
+     */
+    void Signal() noexcept { m_signalled = true; }
+
 protected:
     friend class Application;
 
+    /**
+     * @brief Runs the module once every period.
+     * @param ms The period, in milliseconds.
+     */
+    void SetRunPeriod(uint32_t ms) noexcept
+    {
+        m_runPolicy = RunPolicy::Periodic;
+        m_runPeriod = ms;
+    }
+    /**
+     * @brief Runs the module only when it is signalled.
+     */
+    void SetRunOnSignal() noexcept { m_runPolicy = RunPolicy::OnSignal; }
+    /**
+     * @brief Runs the module on every pass. This is the default.
+     */
+    void SetRunAlways() noexcept { m_runPolicy = RunPolicy::Always; }
+    /**
+     * @brief Sets the priority of the module. Modules with a higher priority are run first.
+     */
+    void SetPriority(uint8_t priority) noexcept { m_priority = priority; }
+
     size_t m_id = 0;
+
+private:
+    RunPolicy m_runPolicy = RunPolicy::Always;
+    uint32_t  m_runPeriod = 0;
+    uint8_t   m_priority  = 0;
+    //! Time at which a periodic module is next due.
+    uint32_t m_nextRun = 0;
+    //! Set from interrupts, cleared by the scheduler right before running the module.
+    volatile bool m_signalled = false;
 };
 
 }    // namespace Nilai
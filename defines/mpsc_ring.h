@@ -0,0 +1,180 @@
+/**
+ * @file    mpsc_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Lock-free FIFO with many producers and a single consumer.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DEFINES_MPSC_RING_H
+#define NILAI_DEFINES_MPSC_RING_H
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai
+{
+/**
+ * @brief Fixed-capacity FIFO that any context can push into, and that a single consumer drains.
+ *
+ * Any interrupt can push, even if it preempts another one that is pushing in the same ring: slots
+ * are reserved with a compare-and-swap and published with a per-slot sequence number, in the same
+ * way as @ref Events::EventQueue. Items are built in place with @ref Emplace, so large items are
+ * never copied on the producer side.
+ *
+ * Like @ref SpscRing, pushing in a full ring rejects the new item and counts it in
+ * @ref Overflows.
+ *
+ * @tparam T Type of the items. Must be trivially copyable.
+ * @tparam N Capacity of the ring. Must be a power of two.
+ */
+template<typename T, size_t N>
+class MpscRing
+{
+    static_assert(std::has_single_bit(N), "The capacity of the ring must be a power of 2!");
+    static_assert(std::is_trivially_copyable_v<T>, "The items must be trivially copyable!");
+
+    static constexpr size_t s_mask = N - 1;
+
+    struct Slot
+    {
+        //! Equal to the reservation index once the slot can be written, and to that index + 1
+        //! once the item is ready to be read.
+        std::atomic<size_t> Sequence = 0;
+        T                   Item     = {};
+    };
+
+public:
+    using value_type = T;
+
+    MpscRing() noexcept
+    {
+        for (size_t i = 0; i < N; i++)
+        {
+            m_slots[i].Sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing&)            = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    /**
+     * @brief Reserves a slot at the end of the ring and lets a function fill it. Can be called from
+     * any context.
+     * @param fill Called with a reference to the item to fill.
+     * @return True if the item was added, false if the ring was full.
+     */
+    template<typename F>
+    bool Emplace(F&& fill) noexcept
+    {
+        size_t pos = m_head.load(std::memory_order_relaxed);
+        Slot*  slot;
+        while (true)
+        {
+            slot           = &m_slots[pos & s_mask];
+            size_t    seq  = slot->Sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+            if (diff == 0)
+            {
+                if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                // The slot still holds an item that hasn't been consumed.
+                m_overflows.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        fill(slot->Item);
+        slot->Sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Copies an item at the end of the ring. Can be called from any context.
+     * @return True if the item was added, false if the ring was full.
+     */
+    bool Push(const T& t) noexcept
+    {
+        return Emplace([&t](T& item) { item = t; });
+    }
+
+    /**
+     * @brief Removes the oldest item from the ring. Consumer side only.
+     * @return The item, or nothing if the ring is empty or if the oldest item is still being
+     * written.
+     */
+    std::optional<T> Pop() noexcept
+    {
+        Slot& slot = m_slots[m_tail & s_mask];
+        if (slot.Sequence.load(std::memory_order_acquire) != m_tail + 1)
+        {
+            return std::nullopt;
+        }
+
+        T item = slot.Item;
+        // Hands the slot back to the producers, for the next lap.
+        slot.Sequence.store(m_tail + N, std::memory_order_release);
+        m_tail++;
+        return item;
+    }
+
+    [[nodiscard]] bool Empty() const noexcept
+    {
+        return m_slots[m_tail & s_mask].Sequence.load(std::memory_order_acquire) != m_tail + 1;
+    }
+
+    /**
+     * @brief Gets the number of items in the ring. Consumer side only.
+     *
+     * Includes the items that are reserved but not yet published.
+     */
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_head.load(std::memory_order_relaxed) - m_tail;
+    }
+
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return N; }
+
+    /**
+     * @brief Gets the number of items that were rejected because the ring was full.
+     */
+    [[nodiscard]] size_t Overflows() const noexcept
+    {
+        return m_overflows.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::array<Slot, N> m_slots     = {};
+    std::atomic<size_t> m_head      = 0;
+    size_t              m_tail      = 0;
+    std::atomic<size_t> m_overflows = 0;
+};
+}    // namespace Nilai
+//!@}
+#endif    // NILAI_DEFINES_MPSC_RING_H
@@ -0,0 +1,314 @@
+/**
+ * @file    register_cache.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Shadow copy of the registers of a device, written to it in bursts.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DEFINES_REGISTER_CACHE_H
+#define NILAI_DEFINES_REGISTER_CACHE_H
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai
+{
+/**
+ * @brief Statistics on the usage of a @ref RegisterCache.
+ */
+struct RegisterCacheStats
+{
+    size_t Bursts     = 0;    //!< Number of writes done on the bus.
+    size_t Bytes      = 0;    //!< Number of registers written.
+    size_t Skipped    = 0;    //!< Number of writes dropped because the value didn't change.
+    size_t Verified   = 0;    //!< Number of bursts read back.
+    size_t Mismatches = 0;    //!< Number of registers that didn't hold the value written.
+};
+
+/**
+ * @brief Shadow copy of the 8-bit registers of a device.
+ *
+ * The driver changes the registers in the cache with @ref Set, which only marks a register as
+ * dirty if its value changed, and then writes the dirty ones with @ref Flush. Consecutive dirty
+ * registers are written in a single burst, relying on the device incrementing the register
+ * address after each byte.
+ *
+ * Registers with side effects, like commands or status flags, can be marked as volatile: they are
+ * written every time they are set, and never verified.
+ *
+ * Verification reads the bursts back after writing them. It can be sampled, to only read one
+ * burst every N, with @ref SetVerifyInterval.
+ *
+ * The cache doesn't hold a reference to the bus, the functions doing the transfers are given to
+ * @ref Flush and @ref Refresh:
+ * - write: `bool(uint8_t reg, std::span<const uint8_t> data)`
+ * - read: `bool(uint8_t reg, std::span<uint8_t> data)`
+ *
+ * @tparam Reg The enum of the registers of the device.
+ * @tparam Count Number of registers, the highest address plus one.
+ */
+template<typename Reg, size_t Count>
+class RegisterCache
+{
+    static_assert(Count != 0 && Count <= 256, "Registers must have 8-bit addresses!");
+
+public:
+    /**
+     * @brief Sets the value of a register, without writing it.
+     * @return True if the register must be written.
+     */
+    bool Set(Reg reg, uint8_t value) noexcept
+    {
+        size_t i = Index(reg);
+        if (i >= Count)
+        {
+            return false;
+        }
+        if (m_known[i] && m_values[i] == value && !m_volatile[i])
+        {
+            m_stats.Skipped++;
+            return m_dirty[i];
+        }
+
+        m_values[i] = value;
+        m_known[i]  = true;
+        m_dirty[i]  = true;
+        return true;
+    }
+
+    /**
+     * @brief Sets consecutive registers, without writing them.
+     * @return True if at least one of them must be written.
+     */
+    bool Set(Reg first, std::span<const uint8_t> values) noexcept
+    {
+        bool dirty = false;
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            dirty |= Set(static_cast<Reg>(Index(first) + i), values[i]);
+        }
+        return dirty;
+    }
+
+    /**
+     * @brief Records the value a register is known to hold, like its value after a reset.
+     */
+    void Preset(Reg reg, uint8_t value) noexcept
+    {
+        size_t i = Index(reg);
+        if (i < Count)
+        {
+            m_values[i] = value;
+            m_known[i]  = true;
+            m_dirty[i]  = false;
+        }
+    }
+
+    /**
+     * @brief Gets the value of a register.
+     * @return The value, or std::nullopt if it isn't known.
+     */
+    [[nodiscard]] std::optional<uint8_t> Get(Reg reg) const noexcept
+    {
+        size_t i = Index(reg);
+        if (i >= Count || !m_known[i])
+        {
+            return std::nullopt;
+        }
+        return m_values[i];
+    }
+
+    [[nodiscard]] bool IsDirty(Reg reg) const noexcept
+    {
+        size_t i = Index(reg);
+        return i < Count && m_dirty[i];
+    }
+
+    [[nodiscard]] size_t DirtyCount() const noexcept { return m_dirty.count(); }
+
+    /**
+     * @brief Marks a register as having side effects.
+     */
+    void SetVolatile(Reg reg, bool isVolatile = true) noexcept
+    {
+        size_t i = Index(reg);
+        if (i < Count)
+        {
+            m_volatile[i] = isVolatile;
+        }
+    }
+
+    /**
+     * @brief Forgets the value of every register, after the device was reset for example.
+     *
+     * The registers that are set afterwards are all written. The dirty registers stay dirty.
+     */
+    void Invalidate() noexcept { m_known = m_dirty; }
+
+    /**
+     * @brief Reads back one burst every @p interval.
+     * @param interval 0 to never verify, 1 to verify every burst.
+     */
+    void SetVerifyInterval(size_t interval) noexcept
+    {
+        m_verifyInterval = interval;
+        m_sinceVerify    = 0;
+    }
+
+    /**
+     * @brief Writes the dirty registers, without verifying them.
+     * @return True if every burst was written. The registers of the bursts that failed stay dirty.
+     */
+    template<typename WriteFunc>
+    bool Flush(WriteFunc&& write)
+    {
+        auto noRead = [](uint8_t, std::span<uint8_t>) { return true; };
+        return Flush(write, noRead, false);
+    }
+
+    /**
+     * @brief Writes the dirty registers, verifying them as set by @ref SetVerifyInterval.
+     * @return True if every burst was written and verified. The registers that weren't are marked
+     * as dirty again.
+     */
+    template<typename WriteFunc, typename ReadFunc>
+    bool Flush(WriteFunc&& write, ReadFunc&& read)
+    {
+        return Flush(write, read, m_verifyInterval != 0);
+    }
+
+    /**
+     * @brief Reads consecutive registers from the device into the cache.
+     *
+     * The registers that are dirty keep their value.
+     *
+     * @return True if the registers were read.
+     */
+    template<typename ReadFunc>
+    bool Refresh(Reg first, size_t count, ReadFunc&& read)
+    {
+        size_t start = Index(first);
+        if (start >= Count || count == 0 || count > Count - start)
+        {
+            return false;
+        }
+
+        std::array<uint8_t, Count> buffer = {};
+        if (!read(static_cast<uint8_t>(start), std::span<uint8_t> {buffer.data(), count}))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!m_dirty[start + i])
+            {
+                m_values[start + i] = buffer[i];
+                m_known[start + i]  = true;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] const RegisterCacheStats& Stats() const noexcept { return m_stats; }
+    void                                    ResetStats() noexcept { m_stats = {}; }
+
+private:
+    static constexpr size_t Index(Reg reg) noexcept { return static_cast<size_t>(reg); }
+
+    template<typename WriteFunc, typename ReadFunc>
+    bool Flush(WriteFunc& write, ReadFunc& read, bool verify)
+    {
+        bool   ok = true;
+        size_t i  = 0;
+        while (i < Count)
+        {
+            if (!m_dirty[i])
+            {
+                i++;
+                continue;
+            }
+
+            size_t start = i;
+            while (i < Count && m_dirty[i])
+            {
+                i++;
+            }
+            std::span<const uint8_t> data {&m_values[start], i - start};
+            if (!write(static_cast<uint8_t>(start), data))
+            {
+                ok = false;
+                continue;
+            }
+
+            m_stats.Bursts++;
+            m_stats.Bytes += data.size();
+            for (size_t r = start; r < i; r++)
+            {
+                m_dirty[r] = false;
+            }
+            if (verify && ++m_sinceVerify >= m_verifyInterval)
+            {
+                m_sinceVerify = 0;
+                ok = Verify(start, data.size(), read) && ok;
+            }
+        }
+        return ok;
+    }
+
+    template<typename ReadFunc>
+    bool Verify(size_t start, size_t count, ReadFunc& read)
+    {
+        std::array<uint8_t, Count> buffer = {};
+        m_stats.Verified++;
+        if (!read(static_cast<uint8_t>(start), std::span<uint8_t> {buffer.data(), count}))
+        {
+            return false;
+        }
+
+        bool ok = true;
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t r = start + i;
+            if (!m_volatile[r] && buffer[i] != m_values[r])
+            {
+                // Written again on the next flush.
+                m_dirty[r] = true;
+                m_stats.Mismatches++;
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+private:
+    std::array<uint8_t, Count> m_values   = {};
+    std::bitset<Count>         m_known    = {};
+    std::bitset<Count>         m_dirty    = {};
+    std::bitset<Count>         m_volatile = {};
+
+    size_t m_verifyInterval = 0;
+    size_t m_sinceVerify    = 0;
+
+    RegisterCacheStats m_stats = {};
+};
+}    // namespace Nilai
+//!@}
+#endif    // NILAI_DEFINES_REGISTER_CACHE_H
@@ -0,0 +1,202 @@
+/**
+ * @file    spsc_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Wait-free single-producer, single-consumer ring buffer.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DEFINES_SPSC_RING_H
+#define NILAI_DEFINES_SPSC_RING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai
+{
+/**
+ * @brief Fixed-capacity FIFO shared between exactly one producer and one consumer.
+ *
+ * Meant to hand data from an interrupt to the main loop, or the other way around. Neither side
+ * ever waits on the other, and no critical section is needed.
+ *
+ * Unlike @ref CircularBuffer, pushing in a full ring doesn't overwrite the oldest item: the new
+ * item is rejected and counted in @ref Overflows.
+ *
+ * The head and tail indices run freely and are masked on access, which is why the capacity must
+ * be a power of two. The producer only ever writes the head, the consumer only ever writes the
+ * tail. Only atomic loads and stores are used, so this also works on cores without exclusive
+ * access instructions, like the Cortex-M0.
+ *
+ * @tparam T Type of the items. Should be cheap to copy.
+ * @tparam N Capacity of the ring. Must be a power of two.
+ */
+template<typename T, size_t N>
+class SpscRing
+{
+    static_assert(std::has_single_bit(N), "The capacity of the ring must be a power of 2!");
+
+    static constexpr size_t s_mask = N - 1;
+
+#if defined(NILAI_TEST)
+    // Keeps the indices on separate cache lines when running on the host.
+    static constexpr size_t s_align = 64;
+#else
+    static constexpr size_t s_align = alignof(std::atomic<size_t>);
+#endif
+
+public:
+    using value_type = T;
+
+    constexpr SpscRing() noexcept = default;
+
+    /**
+     * @brief Adds an item at the end of the ring. Producer side only.
+     * @param t The item.
+     * @return True if the item was added, false if the ring was full.
+     */
+    bool Push(const T& t) noexcept
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == N)
+        {
+            m_overflows++;
+            return false;
+        }
+
+        m_buff[head & s_mask] = t;
+        // Publishes the item to the consumer.
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Adds as many items as possible at the end of the ring. Producer side only.
+     *
+     * The items that don't fit are counted as overflows.
+     *
+     * @param items The items to add.
+     * @return The number of items added.
+     */
+    size_t PushMany(std::span<const T> items) noexcept
+    {
+        size_t head  = m_head.load(std::memory_order_relaxed);
+        size_t free  = N - (head - m_tail.load(std::memory_order_acquire));
+        size_t count = std::min(items.size(), free);
+        m_overflows += items.size() - count;
+
+        // Copied in at most two contiguous chunks.
+        size_t idx   = head & s_mask;
+        size_t first = std::min(count, N - idx);
+        std::copy_n(items.begin(), first, m_buff.begin() + idx);
+        std::copy_n(items.begin() + first, count - first, m_buff.begin());
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Takes the oldest item out of the ring. Consumer side only.
+     * @return The item, or std::nullopt if the ring is empty.
+     */
+    std::optional<T> Pop() noexcept
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return std::nullopt;
+        }
+
+        T t = m_buff[tail & s_mask];
+        // Hands the slot back to the producer.
+        m_tail.store(tail + 1, std::memory_order_release);
+        return t;
+    }
+
+    /**
+     * @brief Takes as many items as possible out of the ring. Consumer side only.
+     * @param out Where to write the items. At most out.size() items are taken.
+     * @return The number of items written in out.
+     */
+    size_t PopMany(std::span<T> out) noexcept
+    {
+        size_t tail  = m_tail.load(std::memory_order_relaxed);
+        size_t count = std::min(out.size(), m_head.load(std::memory_order_acquire) - tail);
+
+        size_t idx   = tail & s_mask;
+        size_t first = std::min(count, N - idx);
+        std::copy_n(m_buff.begin() + idx, first, out.begin());
+        std::copy_n(m_buff.begin(), count - first, out.begin() + first);
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * @brief Gets the oldest item without taking it out of the ring. Consumer side only.
+     * @return A pointer to the item, or nullptr if the ring is empty.
+     */
+    [[nodiscard]] const T* Front() const noexcept
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &m_buff[tail & s_mask];
+    }
+
+    /**
+     * @brief Drops every item in the ring. Consumer side only.
+     */
+    void Clear() noexcept
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool             Empty() const noexcept { return Size() == 0; }
+    [[nodiscard]] bool             Full() const noexcept { return Size() == N; }
+    [[nodiscard]] constexpr size_t Capacity() const noexcept { return N; }
+
+    /**
+     * @brief Gets the number of items rejected because the ring was full.
+     */
+    [[nodiscard]] size_t Overflows() const noexcept { return m_overflows; }
+
+private:
+    std::array<T, N> m_buff = {};
+
+    //! Index of the next item to be written. Written by the producer only.
+    alignas(s_align) std::atomic<size_t> m_head = 0;
+    //! Written by the producer only.
+    size_t m_overflows = 0;
+
+    //! Index of the next item to be read. Written by the consumer only.
+    alignas(s_align) std::atomic<size_t> m_tail = 0;
+};
+}    // namespace Nilai
+//!@}
+#endif
@@ -56,6 +56,15 @@ public:
     [[nodiscard]] constexpr const_reference GetActive() const noexcept { return m_buffs[m_active]; }
     [[nodiscard]] constexpr reference       GetActive() noexcept { return m_buffs[m_active]; }
 
+    [[nodiscard]] constexpr const_reference GetInactive() const noexcept
+    {
+        return m_buffs[m_active == 0 ? 1 : 0];
+    }
+    [[nodiscard]] constexpr reference GetInactive() noexcept
+    {
+        return m_buffs[m_active == 0 ? 1 : 0];
+    }
+
     /**
      * Swap the active buffer with the inactive buffer.
      * @return
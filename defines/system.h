@@ -24,11 +24,48 @@
 #    define NILAI_BREAKPOINT __asm("bkpt 1")
 #endif
 
+#include <cstdint>
+
 namespace Nilai::System
 {
 void Reset();
 bool IsDebuggerConnected();
 
+/**
+ * @brief Masks the interrupts.
+ * @return The previous state of the interrupt mask, to be given to @ref ExitCritical.
+ */
+uint32_t EnterCritical();
+/**
+ * @brief Restores the interrupt mask to what it was before @ref EnterCritical was called.
+ * @param state The value returned by @ref EnterCritical.
+ */
+void ExitCritical(uint32_t state);
+
+/**
+ * @brief Puts the core to sleep until an interrupt is pending.
+ *
+ * The core also wakes up if the interrupt is masked, which allows checking for work to do inside a
+ * @ref CriticalSection without missing an interrupt.
+ */
+void WaitForInterrupt();
+
+/**
+ * @brief Masks the interrupts for as long as the object lives.
+ */
+class CriticalSection
+{
+public:
+    CriticalSection() noexcept : m_state(EnterCritical()) {}
+    ~CriticalSection() noexcept { ExitCritical(m_state); }
+
+    CriticalSection(const CriticalSection&)            = delete;
+    CriticalSection& operator=(const CriticalSection&) = delete;
+
+private:
+    uint32_t m_state;
+};
+
 inline void Breakpoint()
 {
     if (IsDebuggerConnected())
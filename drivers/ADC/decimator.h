@@ -0,0 +1,138 @@
+/**
+ * @file    decimator.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   CIC decimation filter for ADC samples.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_ADC_DECIMATOR_H
+#define NILAI_DRIVERS_ADC_DECIMATOR_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Nilai::Drivers::Adc
+{
+/**
+ * @brief Cascaded integrator-comb decimator, producing one output every @ref Ratio inputs.
+ *
+ * An order of 1 is a moving average over the @ref Ratio samples of each output, higher orders
+ * reject more of the noise above the output rate at the cost of a longer settling time: the first
+ * @ref Order - 1 outputs after a reset are partial.
+ *
+ * The integrators and combs work on 32-bit unsigned integers and rely on their wrap-around, so
+ * `inputBits + Order * ceil(log2(Ratio))` must not exceed 32. The outputs are divided by the gain
+ * of the filter, @ref Ratio ^ @ref Order, so they are in the same unit as the inputs.
+ */
+class Decimator
+{
+public:
+    static constexpr size_t MaxOrder = 4;
+
+    /**
+     * @brief Sets up the filter and resets it.
+     * @param order Number of integrator and comb stages, between 1 and @ref MaxOrder.
+     * @param ratio Number of inputs per output. 1 copies the inputs.
+     * @param inputBits Resolution of the inputs.
+     * @return False if the configuration is invalid or would overflow the registers.
+     */
+    constexpr bool Configure(size_t order, size_t ratio, size_t inputBits = 12) noexcept
+    {
+        size_t growth = 0;
+        while ((size_t(1) << growth) < ratio && growth < 32)
+        {
+            growth++;
+        }
+        if (order == 0 || order > MaxOrder || ratio == 0 || inputBits + order * growth > 32)
+        {
+            return false;
+        }
+
+        m_order = order;
+        m_ratio = ratio;
+        float gain = 1.0f;
+        for (size_t i = 0; i < order; i++)
+        {
+            gain *= static_cast<float>(ratio);
+        }
+        m_scale = 1.0f / gain;
+        Reset();
+        return true;
+    }
+
+    /**
+     * @brief Clears the state of the filter, the next output is computed from the next inputs only.
+     */
+    constexpr void Reset() noexcept
+    {
+        m_integrators = {};
+        m_combs       = {};
+        m_phase       = 0;
+    }
+
+    /**
+     * @brief Filters samples.
+     * @param in The first sample.
+     * @param count Number of samples.
+     * @param stride Distance between two samples in @p in, to read one channel out of interleaved
+     * scans.
+     * @param out Where the outputs are written, room for `(count + ratio - 1) / ratio` of them is
+     * needed.
+     * @param scale Multiplies the outputs, to convert them to another unit.
+     * @return The number of outputs written.
+     */
+    template<typename T>
+    size_t Process(
+      const T* in, size_t count, size_t stride, float* out, float scale = 1.0f) noexcept
+    {
+        float  k        = m_scale * scale;
+        size_t produced = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            uint32_t x = static_cast<uint32_t>(in[i * stride]);
+            for (size_t s = 0; s < m_order; s++)
+            {
+                m_integrators[s] += x;
+                x = m_integrators[s];
+            }
+
+            if (++m_phase == m_ratio)
+            {
+                m_phase = 0;
+                for (size_t s = 0; s < m_order; s++)
+                {
+                    uint32_t y = x - m_combs[s];
+                    m_combs[s] = x;
+                    x          = y;
+                }
+                out[produced++] = static_cast<float>(x) * k;
+            }
+        }
+        return produced;
+    }
+
+    [[nodiscard]] constexpr size_t Order() const noexcept { return m_order; }
+    [[nodiscard]] constexpr size_t Ratio() const noexcept { return m_ratio; }
+
+private:
+    std::array<uint32_t, MaxOrder> m_integrators = {};
+    std::array<uint32_t, MaxOrder> m_combs       = {};
+
+    size_t m_order = 1;
+    size_t m_ratio = 1;
+    size_t m_phase = 0;
+    float  m_scale = 1.0f;
+};
+}    // namespace Nilai::Drivers::Adc
+
+#endif    // NILAI_DRIVERS_ADC_DECIMATOR_H
@@ -0,0 +1,264 @@
+/**
+ * @file    stream.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Continuous acquisition of ADC scans through a circular DMA buffer.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_ADC_STREAM_H
+#define NILAI_DRIVERS_ADC_STREAM_H
+
+#include "decimator.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Nilai::Drivers::Adc
+{
+/**
+ * @brief Settings of a @ref Stream.
+ */
+struct StreamConfig
+{
+    //! Number of scans in each half of the DMA buffer. Must be a multiple of @ref Ratio.
+    size_t ScansPerHalf = 64;
+    //! Order of the decimation filter, 1 for a moving average.
+    size_t Order = 1;
+    //! Number of scans per output.
+    size_t Ratio = 1;
+    //! Resolution of the conversions.
+    size_t InputBits = 12;
+    //! Multiplies the outputs, e.g. 3.3f / 4095.0f for volts out of a 12-bit ADC with VDDA at 3.3V.
+    float Scale = 1.0f;
+};
+
+/**
+ * @brief Statistics on the usage of a @ref Stream.
+ */
+struct StreamStats
+{
+    size_t Blocks   = 0;    //!< Number of blocks handed to the callback.
+    size_t Overruns = 0;    //!< Number of halves overwritten before they were entirely read.
+};
+
+/**
+ * @brief Decimated samples of every channel, out of one half of the DMA buffer.
+ */
+struct StreamBlock
+{
+    //! The samples, channel by channel: those of channel `c` start at `c * Samples`.
+    const float* Data     = nullptr;
+    size_t       Channels = 0;
+    //! Number of samples per channel.
+    size_t Samples = 0;
+    //! Incremented for every block, a gap means that samples were lost.
+    uint32_t Sequence = 0;
+
+    [[nodiscard]] std::span<const float> Channel(size_t ch) const noexcept
+    {
+        return {Data + ch * Samples, Samples};
+    }
+};
+
+/**
+ * @brief Function receiving the blocks, from the interrupt context. The block is only valid for the
+ * duration of the call.
+ */
+using BlockCallback = void (*)(const StreamBlock& block, void* ctx);
+
+/**
+ * @brief Function reading the position of the DMA, from the interrupt context.
+ * @param ctx The user data given with the function.
+ * @return The number of conversions the DMA has yet to write before wrapping around.
+ */
+using PositionQuery = size_t (*)(void* ctx);
+
+/**
+ * @brief Turns the scans written by the DMA in a circular buffer into blocks of decimated samples.
+ *
+ * The DMA writes the conversions of every rank of a scan one after the other, and wraps around at
+ * the end of the buffer. When a half of the buffer is full, @ref OnHalfComplete or
+ * @ref OnComplete filters each channel of that half with its own @ref Decimator and hands the
+ * results to the callback in a single @ref StreamBlock, while the DMA fills the other half.
+ *
+ * A half is overrun when the DMA comes back to it before it has been read, which only the position
+ * of the DMA tells: the interrupts keep alternating even when the processing is always too slow.
+ * Without a @ref PositionQuery, only the halves whose interrupt was missed entirely are seen.
+ */
+class Stream
+{
+public:
+    /**
+     * @brief Allocates the buffers and sets up the filters. Must not be called while the DMA runs.
+     * @param channels Number of conversions per scan.
+     * @return False if the configuration is invalid.
+     */
+    bool Configure(size_t channels, const StreamConfig& config, BlockCallback cb, void* ctx)
+    {
+        if (channels == 0 || config.Ratio == 0 || config.ScansPerHalf == 0 ||
+            config.ScansPerHalf % config.Ratio != 0)
+        {
+            return false;
+        }
+
+        m_decimators.assign(channels, {});
+        for (Decimator& d : m_decimators)
+        {
+            if (!d.Configure(config.Order, config.Ratio, config.InputBits))
+            {
+                m_decimators.clear();
+                return false;
+            }
+        }
+
+        m_channels = channels;
+        m_config   = config;
+        m_cb       = cb;
+        m_ctx      = ctx;
+        m_dma.assign(2 * channels * config.ScansPerHalf, 0);
+        m_out.assign(channels * OutputsPerHalf(), 0.0f);
+        Reset();
+        return true;
+    }
+
+    /**
+     * @brief Clears the filters, to be called before starting the DMA.
+     */
+    void Reset() noexcept
+    {
+        for (Decimator& d : m_decimators)
+        {
+            d.Reset();
+        }
+        m_nextHalf = 0;
+        m_lastRaw  = SIZE_MAX;
+        m_sequence = 0;
+    }
+
+    /**
+     * @brief Sets how the position of the DMA is read after each half is read, to find the
+     * overruns.
+     * @param query The function to call, nullptr to not check the position.
+     * @param ctx Passed to @p query.
+     */
+    void SetPositionQuery(PositionQuery query, void* ctx) noexcept
+    {
+        m_query    = query;
+        m_queryCtx = ctx;
+    }
+
+    /**
+     * @brief The buffer the DMA must write the scans to, in circular mode.
+     */
+    [[nodiscard]] std::span<uint32_t> DmaBuffer() noexcept { return m_dma; }
+
+    //! To be called when the DMA filled the first half of the buffer.
+    void OnHalfComplete() noexcept { Process(0); }
+    //! To be called when the DMA filled the second half of the buffer.
+    void OnComplete() noexcept { Process(1); }
+
+    /**
+     * @brief Gets the last conversion of a channel, as read from the DMA buffer.
+     */
+    [[nodiscard]] uint32_t LastRaw(size_t ch) const noexcept
+    {
+        if (ch >= m_channels)
+        {
+            return 0;
+        }
+        return m_lastRaw < m_dma.size() ? m_dma[m_lastRaw + ch] : 0;
+    }
+
+    [[nodiscard]] size_t Channels() const noexcept { return m_channels; }
+    [[nodiscard]] size_t OutputsPerHalf() const noexcept
+    {
+        return m_config.ScansPerHalf / m_config.Ratio;
+    }
+    [[nodiscard]] const StreamConfig& Config() const noexcept { return m_config; }
+
+    [[nodiscard]] StreamStats Stats() const noexcept { return m_stats; }
+    void                      ResetStats() noexcept { m_stats = {}; }
+
+private:
+    void Process(size_t half) noexcept
+    {
+        if (m_channels == 0)
+        {
+            return;
+        }
+        if (half != m_nextHalf)
+        {
+            // The other half was overwritten before it got processed.
+            m_stats.Overruns++;
+            m_sequence++;
+        }
+        m_nextHalf = half ^ 1;
+
+        size_t          scans = m_config.ScansPerHalf;
+        const uint32_t* base  = &m_dma[half * m_channels * scans];
+        size_t          outs  = OutputsPerHalf();
+        for (size_t ch = 0; ch < m_channels; ch++)
+        {
+            m_decimators[ch].Process(
+              base + ch, scans, m_channels, &m_out[ch * outs], m_config.Scale);
+        }
+        m_lastRaw = (half * scans + scans - 1) * m_channels;
+        if (IsWriting(half))
+        {
+            // The DMA was already writing over the half while it was being read.
+            m_stats.Overruns++;
+        }
+
+        StreamBlock block = {m_out.data(), m_channels, outs, m_sequence++};
+        m_stats.Blocks++;
+        if (m_cb != nullptr)
+        {
+            m_cb(block, m_ctx);
+        }
+    }
+
+    //! Checks if the DMA is in @p half.
+    [[nodiscard]] bool IsWriting(size_t half) const noexcept
+    {
+        if (m_query == nullptr)
+        {
+            return false;
+        }
+        size_t size      = m_dma.size();
+        size_t remaining = m_query(m_queryCtx);
+        size_t position  = (size - std::min(remaining, size)) % size;
+        return position / (size / 2) == half;
+    }
+
+private:
+    std::vector<uint32_t>  m_dma;
+    std::vector<float>     m_out;
+    std::vector<Decimator> m_decimators;
+
+    size_t        m_channels = 0;
+    StreamConfig  m_config   = {};
+    BlockCallback m_cb       = nullptr;
+    void*         m_ctx      = nullptr;
+    PositionQuery m_query    = nullptr;
+    void*         m_queryCtx = nullptr;
+
+    size_t      m_nextHalf = 0;
+    size_t      m_lastRaw  = SIZE_MAX;
+    uint32_t    m_sequence = 0;
+    StreamStats m_stats    = {};
+};
+}    // namespace Nilai::Drivers::Adc
+
+#endif    // NILAI_DRIVERS_ADC_STREAM_H
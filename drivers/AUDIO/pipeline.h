@@ -0,0 +1,223 @@
+/**
+ * @file    pipeline.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Continuous audio playback through a circular DMA buffer refilled on demand.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_AUDIO_PIPELINE_H
+#define NILAI_DRIVERS_AUDIO_PIPELINE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace Nilai::Drivers::Audio
+{
+/**
+ * @brief Settings of a @ref Pipeline.
+ */
+struct PipelineConfig
+{
+    //! Number of frames in each half of the DMA buffer. This is the latency between the refill of
+    //! a half and the moment it starts playing.
+    size_t LatencyFrames = 256;
+    //! Number of samples per frame, 2 for stereo.
+    size_t Channels = 2;
+    //! Size of a sample in the DMA buffer: 2 for 16-bit data, 4 for 24 and 32-bit data.
+    size_t BytesPerSample = 2;
+};
+
+/**
+ * @brief Statistics on the usage of a @ref Pipeline.
+ */
+struct PipelineStats
+{
+    size_t Refills      = 0;    //!< Number of halves handed to the producer.
+    size_t Underruns    = 0;    //!< Halves the producer couldn't fill entirely.
+    size_t SilentFrames = 0;    //!< Frames replaced by silence because of underruns.
+    size_t LateRefills  = 0;    //!< Halves the DMA reached before their refill was done.
+};
+
+/**
+ * @brief Function filling a block of frames, from the interrupt context.
+ * @param dst Where the frames are written, interleaved channel by channel.
+ * @param frames Number of frames requested.
+ * @param ctx The user data of the pipeline.
+ * @return The number of frames written. Any missing frame is replaced by silence.
+ */
+using RefillCallback = size_t (*)(void* dst, size_t frames, void* ctx);
+
+/**
+ * @brief Function reading the position of the DMA, from the interrupt context.
+ * @param ctx The user data given with the function.
+ * @return The number of bytes of the buffer the DMA has yet to read before wrapping around.
+ */
+using PositionQuery = size_t (*)(void* ctx);
+
+/**
+ * @brief Keeps a circular DMA buffer fed with frames from a producer.
+ *
+ * The DMA plays the buffer in a loop. Each time it is done with a half, @ref OnHalfComplete or
+ * @ref OnComplete asks the producer to refill that half while the DMA plays the other one, so the
+ * producer has the duration of a half to run and the samples written reach the output
+ * @ref PipelineConfig::LatencyFrames frames later.
+ *
+ * The producer never blocks the stream: the frames it doesn't provide are played as silence and
+ * counted as an underrun, instead of replaying stale samples.
+ *
+ * A refill is late when the DMA reaches the half before it is done, which only the position of the
+ * DMA tells: the interrupts keep alternating even when every refill overruns. Without a
+ * @ref PositionQuery, only the refills whose interrupt was missed entirely are seen.
+ */
+class Pipeline
+{
+public:
+    /**
+     * @brief Allocates the DMA buffer. Must not be called while the DMA runs.
+     * @return False if the configuration is invalid.
+     */
+    bool Configure(const PipelineConfig& config, RefillCallback cb, void* ctx)
+    {
+        if (config.LatencyFrames == 0 || config.Channels == 0 ||
+            (config.BytesPerSample != 2 && config.BytesPerSample != 4) || cb == nullptr)
+        {
+            return false;
+        }
+
+        m_config = config;
+        m_cb     = cb;
+        m_ctx    = ctx;
+        // Stored as words, for the buffer to be aligned for any sample size.
+        m_buffer.assign((2 * HalfSize() + 3) / 4, 0);
+        Reset();
+        return true;
+    }
+
+    /**
+     * @brief Fills both halves of the buffer, to be called right before starting the DMA.
+     */
+    void Prime() noexcept
+    {
+        Reset();
+        Refill(0);
+        Refill(1);
+    }
+
+    void Reset() noexcept { m_nextHalf = 0; }
+
+    /**
+     * @brief Sets how the position of the DMA is read after each refill, to find the late ones.
+     * @param query The function to call, nullptr to not check the position.
+     * @param ctx Passed to @p query.
+     */
+    void SetPositionQuery(PositionQuery query, void* ctx) noexcept
+    {
+        m_query    = query;
+        m_queryCtx = ctx;
+    }
+
+    //! The buffer to stream, in circular mode.
+    [[nodiscard]] std::span<uint8_t> DmaBuffer() noexcept
+    {
+        return {reinterpret_cast<uint8_t*>(m_buffer.data()), 2 * HalfSize()};
+    }
+    //! Number of samples in the buffer, all channels combined.
+    [[nodiscard]] size_t DmaSamples() const noexcept
+    {
+        return 2 * m_config.LatencyFrames * m_config.Channels;
+    }
+
+    //! To be called when the DMA is done with the first half of the buffer.
+    void OnHalfComplete() noexcept { Process(0); }
+    //! To be called when the DMA is done with the second half of the buffer.
+    void OnComplete() noexcept { Process(1); }
+
+    [[nodiscard]] bool                  IsConfigured() const noexcept { return m_cb != nullptr; }
+    [[nodiscard]] const PipelineConfig& Config() const noexcept { return m_config; }
+    [[nodiscard]] size_t LatencyFrames() const noexcept { return m_config.LatencyFrames; }
+
+    [[nodiscard]] PipelineStats Stats() const noexcept { return m_stats; }
+    void                        ResetStats() noexcept { m_stats = {}; }
+
+private:
+    [[nodiscard]] size_t FrameSize() const noexcept
+    {
+        return m_config.Channels * m_config.BytesPerSample;
+    }
+    [[nodiscard]] size_t HalfSize() const noexcept
+    {
+        return m_config.LatencyFrames * FrameSize();
+    }
+
+    void Process(size_t half) noexcept
+    {
+        if (m_cb == nullptr)
+        {
+            return;
+        }
+        // When the half isn't the expected one, the interrupt of the other half was missed.
+        bool late = half != m_nextHalf;
+        Refill(half);
+        if (late || IsPlaying(half))
+        {
+            m_stats.LateRefills++;
+        }
+    }
+
+    //! Checks if the DMA is in @p half, meaning that it already played part of it.
+    [[nodiscard]] bool IsPlaying(size_t half) const noexcept
+    {
+        if (m_query == nullptr)
+        {
+            return false;
+        }
+        size_t size      = 2 * HalfSize();
+        size_t remaining = m_query(m_queryCtx);
+        size_t position  = (size - std::min(remaining, size)) % size;
+        return position / HalfSize() == half;
+    }
+
+    void Refill(size_t half) noexcept
+    {
+        uint8_t* dst     = DmaBuffer().data() + half * HalfSize();
+        size_t   frames  = m_config.LatencyFrames;
+        size_t   written = m_cb(dst, frames, m_ctx);
+        m_stats.Refills++;
+        if (written < frames)
+        {
+            std::memset(dst + written * FrameSize(), 0, (frames - written) * FrameSize());
+            m_stats.Underruns++;
+            m_stats.SilentFrames += frames - written;
+        }
+        m_nextHalf = half ^ 1;
+    }
+
+private:
+    std::vector<uint32_t> m_buffer;
+
+    PipelineConfig m_config = {};
+    RefillCallback m_cb     = nullptr;
+    void*          m_ctx    = nullptr;
+
+    PositionQuery m_query    = nullptr;
+    void*         m_queryCtx = nullptr;
+
+    size_t        m_nextHalf = 0;
+    PipelineStats m_stats    = {};
+};
+}    // namespace Nilai::Drivers::Audio
+
+#endif    // NILAI_DRIVERS_AUDIO_PIPELINE_H
@@ -0,0 +1,211 @@
+/**
+ * @file    filter_table.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Map from the filter match index of received frames to their handlers.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_CAN_FILTER_TABLE_H
+#define NILAI_CAN_FILTER_TABLE_H
+
+#if defined(NILAI_USE_CAN)
+#    include "../../defines/inplace_function.h"
+#    include "structs.h"
+
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+
+#    if !defined(NILAI_CAN_HANDLER_SIZE)
+#        define NILAI_CAN_HANDLER_SIZE (2 * sizeof(void*))
+#    endif
+
+namespace Nilai::Can
+{
+/**
+ * @brief Function called from the receive interrupt with the frames accepted by a filter.
+ *
+ * The callable is stored in place, its captures must fit in @ref NILAI_CAN_HANDLER_SIZE bytes.
+ */
+using FrameHandler = InplaceFunction<void(const Frame& frame), NILAI_CAN_HANDLER_SIZE>;
+
+/**
+ * @brief Keeps track of the filter banks and of the handler attached to each of them.
+ *
+ * The hardware reports which filter accepted a frame with its filter match index (FMI). The
+ * filters are numbered per FIFO, in the order of the banks assigned to that FIFO, whether they are
+ * active or not. A bank holds 1 filter in 32-bit mask mode, 2 in 32-bit list or 16-bit mask mode
+ * and 4 in 16-bit list mode. Banks that were never configured are in 16-bit mask mode and assigned
+ * to FIFO 0, as they are after a reset.
+ *
+ * Every time a bank is configured, the index of each filter is computed again, so that
+ * @ref Find is a single table lookup.
+ *
+ * Not thread-safe, the owner masks the interrupts around the calls that modify the table.
+ *
+ * @tparam Banks Number of filter banks available.
+ */
+template<size_t Banks>
+class FilterTable
+{
+    static_assert(Banks != 0 && Banks <= 28, "bxCAN has at most 28 filter banks!");
+
+    static constexpr size_t s_fifoCount = 2;
+
+public:
+    static constexpr size_t s_invalidBank = Banks;
+    //! Highest number of filters in a FIFO, when every bank is in 16-bit list mode.
+    static constexpr size_t s_maxFilters = Banks * 4;
+
+    FilterTable() noexcept { Rebuild(); }
+
+    /**
+     * @brief Records the configuration of a bank. Its handler, if any, is removed.
+     */
+    void Configure(const FilterConfiguration& config) noexcept
+    {
+        if (config.bank >= Banks)
+        {
+            return;
+        }
+
+        Bank& bank   = m_banks[config.bank];
+        bank.Mode    = config.mode;
+        bank.Scale   = config.scale;
+        bank.Fifo    = config.fifo;
+        bank.Used    = config.activate == FilterEnable::Enable;
+        bank.Handler = nullptr;
+        Rebuild();
+    }
+
+    /**
+     * @brief Finds a bank that isn't used, starting from the last one so that the banks picked
+     * by the application are left alone.
+     * @return The bank, or @ref s_invalidBank if they are all used.
+     */
+    [[nodiscard]] size_t FindFreeBank() const noexcept
+    {
+        for (size_t i = Banks; i > 0; i--)
+        {
+            if (!m_banks[i - 1].Used)
+            {
+                return i - 1;
+            }
+        }
+        return s_invalidBank;
+    }
+
+    /**
+     * @brief Attaches a handler to a bank, configured with a single 32-bit mask filter.
+     */
+    void Attach(size_t bank, FilterFifoAssignation fifo, const FrameHandler& handler) noexcept
+    {
+        if (bank >= Banks)
+        {
+            return;
+        }
+
+        Bank& b   = m_banks[bank];
+        b.Mode    = FilterMode::IdMask;
+        b.Scale   = FilterScale::Scale32bit;
+        b.Fifo    = fifo;
+        b.Used    = true;
+        b.Handler = handler;
+        Rebuild();
+    }
+
+    /**
+     * @brief Removes the handler of a bank and marks it as free.
+     *
+     * The bank keeps its mode, so the index of the other filters doesn't change.
+     */
+    void Detach(size_t bank) noexcept
+    {
+        if (bank < Banks)
+        {
+            m_banks[bank].Used    = false;
+            m_banks[bank].Handler = nullptr;
+        }
+    }
+
+    /**
+     * @brief FIFO a bank is assigned to. A bank that is disabled must keep it, or the filters of
+     * both FIFOs would be numbered differently from the table.
+     */
+    [[nodiscard]] FilterFifoAssignation GetFifo(size_t bank) const noexcept
+    {
+        return bank < Banks ? m_banks[bank].Fifo : FilterFifoAssignation::Fifo0;
+    }
+
+    /**
+     * @brief Gets the handler of the filter that accepted a frame. Constant time.
+     * @param fifo The FIFO in which the frame was received.
+     * @param fmi The filter match index of the frame.
+     * @return The handler, or nullptr if the filter has none.
+     */
+    [[nodiscard]] const FrameHandler* Find(RxFifo fifo, uint32_t fmi) const noexcept
+    {
+        if (fmi >= s_maxFilters)
+        {
+            return nullptr;
+        }
+
+        uint8_t bank = m_fmiToBank[static_cast<size_t>(fifo) & 1][fmi];
+        if (bank == s_invalidBank || !m_banks[bank].Handler)
+        {
+            return nullptr;
+        }
+        return &m_banks[bank].Handler;
+    }
+
+private:
+    struct Bank
+    {
+        FilterMode            Mode  = FilterMode::IdMask;
+        FilterScale           Scale = FilterScale::Scale16bit;
+        FilterFifoAssignation Fifo  = FilterFifoAssignation::Fifo0;
+        bool                  Used  = false;
+        FrameHandler          Handler;
+    };
+
+    static constexpr size_t FilterCount(const Bank& bank) noexcept
+    {
+        size_t count = bank.Scale == FilterScale::Scale32bit ? 1 : 2;
+        return bank.Mode == FilterMode::IdList ? count * 2 : count;
+    }
+
+    void Rebuild() noexcept
+    {
+        for (auto& fifo : m_fmiToBank)
+        {
+            fifo.fill(static_cast<uint8_t>(s_invalidBank));
+        }
+
+        std::array<size_t, s_fifoCount> next = {};
+        for (size_t i = 0; i < Banks; i++)
+        {
+            size_t  fifo  = static_cast<size_t>(m_banks[i].Fifo) & 1;
+            size_t& index = next[fifo];
+            for (size_t f = 0; f < FilterCount(m_banks[i]); f++)
+            {
+                m_fmiToBank[fifo][index++] = static_cast<uint8_t>(i);
+            }
+        }
+    }
+
+private:
+    std::array<Bank, Banks>                                    m_banks     = {};
+    std::array<std::array<uint8_t, s_maxFilters>, s_fifoCount> m_fmiToBank = {};
+};
+}    // namespace Nilai::Can
+#endif
+#endif    // NILAI_CAN_FILTER_TABLE_H
@@ -0,0 +1,565 @@
+/**
+ * @file    isotp.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   ISO-TP (ISO 15765-2) transport, for messages larger than a CAN frame.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_CAN_ISOTP_H
+#define NILAI_CAN_ISOTP_H
+
+#if defined(NILAI_USE_CAN)
+#    include "../../defines/spsc_ring.h"
+#    include "structs.h"
+#    include "tx_queue.h"
+
+#    include <algorithm>
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstring>
+#    include <span>
+
+#    if !defined(NILAI_CAN_ISOTP_RX_FRAMES)
+#        define NILAI_CAN_ISOTP_RX_FRAMES 8
+#    endif
+
+namespace Nilai::Can
+{
+enum class IsoTpStatus
+{
+    Ok = 0,
+    //! The other node stopped answering.
+    Timeout,
+    //! The message doesn't fit in the buffer of the receiver.
+    Overflow,
+    //! A consecutive frame was lost.
+    WrongSequence,
+    //! A new message started before the current one was complete.
+    Interrupted,
+};
+
+/**
+ * @brief Parameters of an ISO-TP channel, with normal addressing.
+ */
+struct IsoTpConfig
+{
+    //! Identifier of the frames sent by this node.
+    uint32_t TxId = 0;
+    //! Identifier of the frames sent by the other node.
+    uint32_t RxId     = 0;
+    bool     Extended = false;
+    //! Number of consecutive frames the other node sends between flow controls, 0 for no limit.
+    uint8_t BlockSize = 0;
+    //! Minimum time between the consecutive frames the other node sends, in the ISO-TP format.
+    uint8_t StMin = 0;
+    //! Pads the frames to 8 bytes with @ref PaddingByte.
+    bool    Padding     = true;
+    uint8_t PaddingByte = 0xCC;
+    //! Time to wait for the next flow control or consecutive frame, in milliseconds.
+    uint32_t Timeout = 1000;
+    //! Number of flow controls asking to wait that are accepted in a row.
+    uint8_t MaxWaits = 10;
+};
+
+/**
+ * @brief One ISO-TP channel between this node and another, able to send and receive a message at
+ * the same time.
+ *
+ * Messages of up to 4095 bytes are segmented in a first frame and consecutive frames, paced by the
+ * flow control frames of the receiver: the block size limits how many consecutive frames are sent
+ * before waiting for the next flow control, and STmin sets the time between them.
+ *
+ * The messages are never copied in an intermediate buffer: the message being sent is read from the
+ * caller's buffer, and the message being received is assembled in the buffer given to
+ * @ref Receive.
+ *
+ * Frames are received with @ref OnFrame, usually from the handler of a subscription in the receive
+ * interrupt. They are only stored, everything else happens in @ref Run, which must be called
+ * regularly from the main loop. Frames are sent with the function given to the constructor, which
+ * normally pushes them in the transmit queue of the CAN module. When it refuses a frame, the frame
+ * is sent again on the next call to @ref Run.
+ */
+class IsoTp
+{
+public:
+    static constexpr size_t s_maxLen = 4095;
+
+    /**
+     * @brief Function sending a frame, without waiting for it to be on the bus.
+     * @return True if the frame will be sent.
+     */
+    using SendFunc = bool (*)(void* ctx, const TxFrame& frame);
+    /**
+     * @brief Function called from @ref Run once a message is sent, or failed to be.
+     */
+    using TxCallback = void (*)(IsoTpStatus status, void* ctx);
+    /**
+     * @brief Function called from @ref Run once a message is received, or failed to be.
+     * @param data The message, in the buffer given to @ref Receive. Empty if the reception failed.
+     */
+    using RxCallback = void (*)(IsoTpStatus status, std::span<const uint8_t> data, void* ctx);
+
+    IsoTp(const IsoTpConfig& config, SendFunc send, void* ctx) noexcept
+    : m_config(config), m_send(send), m_sendCtx(ctx)
+    {
+    }
+
+    IsoTp(const IsoTp&)            = delete;
+    IsoTp& operator=(const IsoTp&) = delete;
+
+    [[nodiscard]] const IsoTpConfig& Config() const noexcept { return m_config; }
+
+    /**
+     * @brief Starts sending a message.
+     * @param data The message. It is borrowed until the callback is called.
+     * @param cb Called once the message is sent, or failed to be. Can be nullptr.
+     * @return True if the message will be sent, false if one is already being sent or if it is
+     * empty or too large.
+     */
+    bool Send(std::span<const uint8_t> data, TxCallback cb = nullptr, void* ctx = nullptr) noexcept
+    {
+        if (m_tx.State != TxState::Idle || data.empty() || data.size() > s_maxLen)
+        {
+            return false;
+        }
+
+        m_tx       = {};
+        m_tx.Data  = data;
+        m_tx.Cb    = cb;
+        m_tx.Ctx   = ctx;
+        m_tx.State = TxState::SendFirst;
+        return true;
+    }
+
+    [[nodiscard]] bool IsSending() const noexcept { return m_tx.State != TxState::Idle; }
+
+    /**
+     * @brief Sets where the received messages are written.
+     *
+     * The buffer is reused for every message, its content must be used before the callback
+     * returns. A message larger than the buffer is refused.
+     */
+    void Receive(std::span<uint8_t> buffer, RxCallback cb, void* ctx = nullptr) noexcept
+    {
+        m_rx        = {};
+        m_rx.Buffer = buffer;
+        m_rx.Cb     = cb;
+        m_rx.Ctx    = ctx;
+    }
+
+    /**
+     * @brief Stops receiving messages. The one being received is dropped.
+     */
+    void StopReceiving() noexcept { m_rx = {}; }
+
+    /**
+     * @brief Checks if a message is partially received.
+     */
+    [[nodiscard]] bool IsReceiving() const noexcept { return m_rx.State != RxState::Idle; }
+
+    /**
+     * @brief Hands a frame received from the other node. Can be called from an interrupt.
+     *
+     * Frames with another identifier are ignored.
+     */
+    void OnFrame(const Frame& frame) noexcept
+    {
+        bool     extended = frame.frame.IDE == static_cast<uint32_t>(IdentifierType::Extended);
+        uint32_t id       = extended ? frame.frame.ExtId : frame.frame.StdId;
+        if (extended != m_config.Extended || id != m_config.RxId || frame.frame.DLC == 0)
+        {
+            return;
+        }
+        m_frames.Push(frame);
+    }
+
+    /**
+     * @brief Gets the number of frames dropped because @ref Run wasn't called often enough.
+     */
+    [[nodiscard]] size_t DroppedFrames() const noexcept { return m_frames.Overflows(); }
+
+    /**
+     * @brief Handles the received frames, sends what can be sent and checks the timeouts.
+     * @param now The current time, in milliseconds.
+     */
+    void Run(uint32_t now) noexcept
+    {
+        while (auto frame = m_frames.Pop())
+        {
+            HandleFrame(*frame, now);
+        }
+
+        if (m_rx.FcPending)
+        {
+            m_rx.FcPending = !SendFlowControl(m_rx.FcStatus);
+        }
+        if (m_rx.State == RxState::Receiving && Expired(now, m_rx.Deadline))
+        {
+            FinishRx(IsoTpStatus::Timeout);
+        }
+
+        RunTx(now);
+    }
+
+private:
+    enum class FrameKind : uint8_t
+    {
+        Single      = 0x0,
+        First       = 0x1,
+        Consecutive = 0x2,
+        FlowControl = 0x3,
+    };
+
+    enum class FlowStatus : uint8_t
+    {
+        ContinueToSend = 0x0,
+        Wait           = 0x1,
+        Overflow       = 0x2,
+    };
+
+    enum class TxState
+    {
+        Idle,
+        SendFirst,
+        WaitFlowControl,
+        SendConsecutive,
+    };
+
+    enum class RxState
+    {
+        Idle,
+        Receiving,
+    };
+
+    struct Tx
+    {
+        std::span<const uint8_t> Data      = {};
+        TxCallback               Cb        = nullptr;
+        void*                    Ctx       = nullptr;
+        TxState                  State     = TxState::Idle;
+        size_t                   Offset    = 0;
+        uint8_t                  Sequence  = 0;
+        uint8_t                  BlockSize = 0;
+        uint8_t                  BlockLeft = 0;
+        uint8_t                  Waits     = 0;
+        uint32_t                 StMin     = 0;
+        uint32_t                 NextFrame = 0;
+        uint32_t                 Deadline  = 0;
+    };
+
+    struct Rx
+    {
+        std::span<uint8_t> Buffer    = {};
+        RxCallback         Cb        = nullptr;
+        void*              Ctx       = nullptr;
+        RxState            State     = RxState::Idle;
+        size_t             Len       = 0;
+        size_t             Offset    = 0;
+        uint8_t            Sequence  = 0;
+        uint8_t            BlockLeft = 0;
+        uint32_t           Deadline  = 0;
+        bool               FcPending = false;
+        FlowStatus         FcStatus  = FlowStatus::ContinueToSend;
+    };
+
+    static constexpr size_t s_frameLen = 8;
+
+    static bool Expired(uint32_t now, uint32_t deadline) noexcept
+    {
+        return static_cast<int32_t>(now - deadline) >= 0;
+    }
+
+    /**
+     * @brief Converts STmin to milliseconds. The values under a millisecond are rounded up, the
+     * reserved values are treated as the maximum, like the standard asks.
+     */
+    static constexpr uint32_t DecodeStMin(uint8_t stMin) noexcept
+    {
+        if (stMin <= 0x7F)
+        {
+            return stMin;
+        }
+        if (stMin >= 0xF1 && stMin <= 0xF9)
+        {
+            return 1;
+        }
+        return 0x7F;
+    }
+
+    bool SendFrame(const uint8_t* data, size_t len) noexcept
+    {
+        TxFrame frame(m_config.TxId, data, len, m_config.Extended);
+        if (m_config.Padding)
+        {
+            std::fill(frame.Data.begin() + frame.Len, frame.Data.end(), m_config.PaddingByte);
+            frame.Len = s_frameLen;
+        }
+        return m_send(m_sendCtx, frame);
+    }
+
+    bool SendFlowControl(FlowStatus status) noexcept
+    {
+        uint8_t data[3] = {static_cast<uint8_t>(0x30 | static_cast<uint8_t>(status)),
+                           m_config.BlockSize,
+                           m_config.StMin};
+        return SendFrame(data, sizeof(data));
+    }
+
+    void HandleFrame(const Frame& frame, uint32_t now) noexcept
+    {
+        const uint8_t* data = frame.data.data();
+        size_t         len  = std::min(static_cast<size_t>(frame.frame.DLC), s_frameLen);
+        switch (static_cast<FrameKind>(data[0] >> 4))
+        {
+            case FrameKind::Single: HandleSingle(data, len); break;
+            case FrameKind::First: HandleFirst(data, len, now); break;
+            case FrameKind::Consecutive: HandleConsecutive(data, len, now); break;
+            case FrameKind::FlowControl: HandleFlowControl(data, len, now); break;
+            default: break;
+        }
+    }
+
+    void HandleSingle(const uint8_t* data, size_t len) noexcept
+    {
+        size_t msgLen = data[0] & 0x0F;
+        if (msgLen == 0 || msgLen > len - 1 || m_rx.Cb == nullptr)
+        {
+            return;
+        }
+        if (m_rx.State == RxState::Receiving)
+        {
+            FinishRx(IsoTpStatus::Interrupted);
+        }
+        if (msgLen > m_rx.Buffer.size())
+        {
+            m_rx.Cb(IsoTpStatus::Overflow, {}, m_rx.Ctx);
+            return;
+        }
+
+        std::memcpy(m_rx.Buffer.data(), &data[1], msgLen);
+        m_rx.Cb(IsoTpStatus::Ok, m_rx.Buffer.first(msgLen), m_rx.Ctx);
+    }
+
+    void HandleFirst(const uint8_t* data, size_t len, uint32_t now) noexcept
+    {
+        size_t msgLen = (static_cast<size_t>(data[0] & 0x0F) << 8) | data[1];
+        // Shorter messages must be sent in a single frame.
+        if (len != s_frameLen || msgLen < s_frameLen || m_rx.Cb == nullptr)
+        {
+            return;
+        }
+        if (m_rx.State == RxState::Receiving)
+        {
+            FinishRx(IsoTpStatus::Interrupted);
+        }
+        if (msgLen > m_rx.Buffer.size())
+        {
+            QueueFlowControl(FlowStatus::Overflow);
+            m_rx.Cb(IsoTpStatus::Overflow, {}, m_rx.Ctx);
+            return;
+        }
+
+        std::memcpy(m_rx.Buffer.data(), &data[2], 6);
+        m_rx.State     = RxState::Receiving;
+        m_rx.Len       = msgLen;
+        m_rx.Offset    = 6;
+        m_rx.Sequence  = 1;
+        m_rx.BlockLeft = m_config.BlockSize;
+        m_rx.Deadline  = now + m_config.Timeout;
+        QueueFlowControl(FlowStatus::ContinueToSend);
+    }
+
+    void HandleConsecutive(const uint8_t* data, size_t len, uint32_t now) noexcept
+    {
+        if (m_rx.State != RxState::Receiving)
+        {
+            return;
+        }
+        if ((data[0] & 0x0F) != m_rx.Sequence)
+        {
+            FinishRx(IsoTpStatus::WrongSequence);
+            return;
+        }
+
+        size_t count = std::min(len - 1, m_rx.Len - m_rx.Offset);
+        std::memcpy(&m_rx.Buffer[m_rx.Offset], &data[1], count);
+        m_rx.Offset += count;
+        m_rx.Sequence = (m_rx.Sequence + 1) & 0x0F;
+        m_rx.Deadline = now + m_config.Timeout;
+
+        if (m_rx.Offset == m_rx.Len)
+        {
+            FinishRx(IsoTpStatus::Ok);
+        }
+        else if (m_config.BlockSize != 0 && --m_rx.BlockLeft == 0)
+        {
+            m_rx.BlockLeft = m_config.BlockSize;
+            QueueFlowControl(FlowStatus::ContinueToSend);
+        }
+    }
+
+    void HandleFlowControl(const uint8_t* data, size_t len, uint32_t now) noexcept
+    {
+        if (m_tx.State != TxState::WaitFlowControl || len < 3)
+        {
+            return;
+        }
+
+        switch (static_cast<FlowStatus>(data[0] & 0x0F))
+        {
+            case FlowStatus::ContinueToSend:
+                m_tx.BlockSize = data[1];
+                m_tx.BlockLeft = data[1];
+                m_tx.StMin     = DecodeStMin(data[2]);
+                m_tx.Waits     = 0;
+                m_tx.NextFrame = now;
+                m_tx.State     = TxState::SendConsecutive;
+                break;
+            case FlowStatus::Wait:
+                if (++m_tx.Waits > m_config.MaxWaits)
+                {
+                    FinishTx(IsoTpStatus::Timeout);
+                }
+                else
+                {
+                    m_tx.Deadline = now + m_config.Timeout;
+                }
+                break;
+            case FlowStatus::Overflow: FinishTx(IsoTpStatus::Overflow); break;
+            default: break;
+        }
+    }
+
+    void RunTx(uint32_t now) noexcept
+    {
+        switch (m_tx.State)
+        {
+            case TxState::SendFirst: SendFirst(now); break;
+            case TxState::WaitFlowControl:
+                if (Expired(now, m_tx.Deadline))
+                {
+                    FinishTx(IsoTpStatus::Timeout);
+                }
+                break;
+            case TxState::SendConsecutive: SendConsecutive(now); break;
+            case TxState::Idle:
+            default: break;
+        }
+    }
+
+    void SendFirst(uint32_t now) noexcept
+    {
+        uint8_t data[s_frameLen] = {};
+        size_t  len              = m_tx.Data.size();
+        if (len < s_frameLen)
+        {
+            data[0] = static_cast<uint8_t>(len);
+            std::memcpy(&data[1], m_tx.Data.data(), len);
+            if (SendFrame(data, len + 1))
+            {
+                FinishTx(IsoTpStatus::Ok);
+            }
+            return;
+        }
+
+        data[0] = static_cast<uint8_t>(0x10 | (len >> 8));
+        data[1] = static_cast<uint8_t>(len);
+        std::memcpy(&data[2], m_tx.Data.data(), 6);
+        if (SendFrame(data, s_frameLen))
+        {
+            m_tx.Offset   = 6;
+            m_tx.Sequence = 1;
+            m_tx.Deadline = now + m_config.Timeout;
+            m_tx.State    = TxState::WaitFlowControl;
+        }
+    }
+
+    void SendConsecutive(uint32_t now) noexcept
+    {
+        while (Expired(now, m_tx.NextFrame))
+        {
+            uint8_t data[s_frameLen] = {};
+            size_t  count            = std::min(s_frameLen - 1, m_tx.Data.size() - m_tx.Offset);
+            data[0]                  = static_cast<uint8_t>(0x20 | m_tx.Sequence);
+            std::memcpy(&data[1], &m_tx.Data[m_tx.Offset], count);
+            if (!SendFrame(data, count + 1))
+            {
+                // The transmit queue is full, sent again on the next call.
+                return;
+            }
+
+            m_tx.Offset += count;
+            m_tx.Sequence = (m_tx.Sequence + 1) & 0x0F;
+            if (m_tx.Offset == m_tx.Data.size())
+            {
+                FinishTx(IsoTpStatus::Ok);
+                return;
+            }
+            if (m_tx.BlockSize != 0 && --m_tx.BlockLeft == 0)
+            {
+                m_tx.Deadline = now + m_config.Timeout;
+                m_tx.State    = TxState::WaitFlowControl;
+                return;
+            }
+            // The tick is only known to the millisecond, a frame sent at the end of a tick would
+            // be followed too early by one sent at the start of the tick STmin later.
+            m_tx.NextFrame = m_tx.StMin == 0 ? now : now + m_tx.StMin + 1;
+        }
+    }
+
+    void QueueFlowControl(FlowStatus status) noexcept
+    {
+        m_rx.FcStatus  = status;
+        m_rx.FcPending = !SendFlowControl(status);
+    }
+
+    void FinishTx(IsoTpStatus status) noexcept
+    {
+        TxCallback cb  = m_tx.Cb;
+        void*      ctx = m_tx.Ctx;
+        m_tx           = {};
+        if (cb != nullptr)
+        {
+            cb(status, ctx);
+        }
+    }
+
+    void FinishRx(IsoTpStatus status) noexcept
+    {
+        size_t len    = m_rx.Len;
+        m_rx.State    = RxState::Idle;
+        m_rx.Len      = 0;
+        m_rx.Offset   = 0;
+        m_rx.Deadline = 0;
+        if (status == IsoTpStatus::Ok)
+        {
+            m_rx.Cb(status, m_rx.Buffer.first(len), m_rx.Ctx);
+        }
+        else
+        {
+            m_rx.Cb(status, {}, m_rx.Ctx);
+        }
+    }
+
+private:
+    IsoTpConfig m_config;
+    SendFunc    m_send    = nullptr;
+    void*       m_sendCtx = nullptr;
+
+    Tx m_tx = {};
+    Rx m_rx = {};
+
+    SpscRing<Frame, NILAI_CAN_ISOTP_RX_FRAMES> m_frames;
+};
+}    // namespace Nilai::Can
+#endif
+#endif    // NILAI_CAN_ISOTP_H
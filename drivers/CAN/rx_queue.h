@@ -0,0 +1,148 @@
+/**
+ * @file    rx_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Rings of received CAN frames, one per hardware receive FIFO.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_CAN_RX_QUEUE_H
+#define NILAI_CAN_RX_QUEUE_H
+
+#if defined(NILAI_USE_CAN)
+#    include "../../defines/spsc_ring.h"
+#    include "structs.h"
+
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+#    include <optional>
+#    include <span>
+
+namespace Nilai::Can
+{
+/**
+ * @brief Statistics on the reception of one FIFO.
+ */
+struct RxStats
+{
+    size_t Received = 0;    //!< Number of frames put in the ring.
+    size_t RingFull = 0;    //!< Frames dropped because the ring was full.
+    size_t Overruns = 0;    //!< Number of times the hardware FIFO overflowed.
+};
+
+/**
+ * @brief Frames received by the interrupts, waiting to be read by the application.
+ *
+ * Each hardware FIFO has its own @ref SpscRing, filled by its interrupt and emptied by the main
+ * loop, so pushing a frame takes the same time at any bus load and never allocates. Frames are
+ * read in the order they were received within a FIFO. When a ring is full, the new frames are
+ * dropped and counted.
+ *
+ * @tparam N Capacity of each ring, in frames. Must be a power of two.
+ */
+template<size_t N>
+class RxQueue
+{
+    static constexpr size_t s_fifoCount = 2;
+
+public:
+    /**
+     * @brief Adds a frame to the ring of a FIFO. Called from the interrupt of that FIFO.
+     * @return True if the frame was added, false if the ring was full.
+     */
+    bool Push(RxFifo fifo, const Frame& frame) noexcept
+    {
+        Fifo& f = Get(fifo);
+        if (!f.Ring.Push(frame))
+        {
+            return false;
+        }
+        f.Received++;
+        return true;
+    }
+
+    /**
+     * @brief Reports that frames were lost because the hardware FIFO overflowed. Called from the
+     * interrupt context.
+     */
+    void OnOverrun(RxFifo fifo) noexcept { Get(fifo).Overruns++; }
+
+    /**
+     * @brief Takes the oldest frame out of the queue, starting with FIFO 0.
+     * @return The frame, or std::nullopt if there are none.
+     */
+    std::optional<Frame> Pop() noexcept
+    {
+        for (Fifo& f : m_fifos)
+        {
+            if (auto frame = f.Ring.Pop(); frame.has_value())
+            {
+                return frame;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Takes as many frames as possible out of the ring of a FIFO, oldest first.
+     * @return The number of frames written in out.
+     */
+    size_t PopMany(std::span<Frame> out, RxFifo fifo) noexcept
+    {
+        return Get(fifo).Ring.PopMany(out);
+    }
+
+    /**
+     * @brief Takes as many frames as possible out of the queue, FIFO 0 first.
+     * @return The number of frames written in out.
+     */
+    size_t PopMany(std::span<Frame> out) noexcept
+    {
+        size_t count = 0;
+        for (Fifo& f : m_fifos)
+        {
+            count += f.Ring.PopMany(out.subspan(count));
+        }
+        return count;
+    }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_fifos[0].Ring.Size() + m_fifos[1].Ring.Size();
+    }
+    [[nodiscard]] size_t Size(RxFifo fifo) const noexcept { return Get(fifo).Ring.Size(); }
+
+    [[nodiscard]] RxStats Stats(RxFifo fifo) const noexcept
+    {
+        const Fifo& f = Get(fifo);
+        return {f.Received, f.Ring.Overflows(), f.Overruns};
+    }
+
+private:
+    struct Fifo
+    {
+        SpscRing<Frame, N> Ring;
+        //! Written by the interrupt only.
+        size_t Received = 0;
+        //! Written by the interrupt only.
+        size_t Overruns = 0;
+    };
+
+    Fifo&       Get(RxFifo fifo) noexcept { return m_fifos[static_cast<size_t>(fifo) & 1]; }
+    const Fifo& Get(RxFifo fifo) const noexcept { return m_fifos[static_cast<size_t>(fifo) & 1]; }
+
+private:
+    std::array<Fifo, s_fifoCount> m_fifos = {};
+};
+}    // namespace Nilai::Can
+#endif
+#endif    // NILAI_CAN_RX_QUEUE_H
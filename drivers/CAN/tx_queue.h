@@ -0,0 +1,215 @@
+/**
+ * @file    tx_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Queue of CAN frames waiting for a transmit mailbox, ordered by priority.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_CAN_TX_QUEUE_H
+#define NILAI_CAN_TX_QUEUE_H
+
+#if defined(NILAI_USE_CAN)
+#    include <algorithm>
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstring>
+#    include <optional>
+
+namespace Nilai::Can
+{
+/**
+ * @brief Frame waiting to be transmitted.
+ */
+struct TxFrame
+{
+    uint32_t               Id       = 0;
+    bool                   Extended = false;
+    //! Number of data bytes. A frame without data is sent as a remote frame.
+    uint8_t                Len  = 0;
+    std::array<uint8_t, 8> Data = {};
+
+    TxFrame() noexcept = default;
+    TxFrame(uint32_t id, const uint8_t* data, size_t len, bool forceExtended) noexcept
+    : Id(id),
+      Extended(id > 0x7FF || forceExtended),
+      Len(static_cast<uint8_t>(std::min(len, static_cast<size_t>(8))))
+    {
+        if (data != nullptr)
+        {
+            std::memcpy(Data.data(), data, Len);
+        }
+    }
+
+    /**
+     * @brief Gets the priority of the frame on the bus. The lowest value wins the arbitration.
+     *
+     * The 11 bits of the base identifier come first. A standard frame wins against an extended
+     * frame with the same base identifier, which is then decided by its 18 extension bits.
+     */
+    [[nodiscard]] constexpr uint32_t Priority() const noexcept
+    {
+        if (!Extended)
+        {
+            return (Id & 0x7FF) << 19;
+        }
+        return (((Id >> 18) & 0x7FF) << 19) | (1U << 18) | (Id & 0x3FFFF);
+    }
+};
+
+/**
+ * @brief Statistics on a @ref TxQueue.
+ */
+struct TxStats
+{
+    size_t Depth         = 0;    //!< Number of frames currently waiting.
+    size_t HighWaterMark = 0;    //!< Maximum number of frames that have been waiting.
+    size_t Rejected      = 0;    //!< Frames that could not be queued.
+    size_t Sent          = 0;    //!< Frames transmitted.
+    size_t Aborted       = 0;    //!< Frames whose transmission was aborted.
+};
+
+/**
+ * @brief Fixed-capacity priority queue of frames waiting for a transmit mailbox.
+ *
+ * The frame with the highest priority on the bus comes out first, so that urgent frames are not
+ * stuck behind bulk traffic. Frames of the same priority come out in the order they were pushed,
+ * which keeps the segments of a message in order.
+ *
+ * Not thread-safe, the owner masks the interrupts around each call.
+ *
+ * @tparam N Maximum number of frames in the queue.
+ */
+template<size_t N>
+class TxQueue
+{
+    static_assert(N != 0, "The queue must be able to hold at least one frame!");
+
+    struct Entry
+    {
+        TxFrame  Frame;
+        uint32_t Priority = 0;
+        uint32_t Sequence = 0;
+
+        //! True if this entry must leave the queue before the other.
+        [[nodiscard]] bool Before(const Entry& o) const noexcept
+        {
+            if (Priority != o.Priority)
+            {
+                return Priority < o.Priority;
+            }
+            return static_cast<int32_t>(Sequence - o.Sequence) < 0;
+        }
+    };
+
+public:
+    /**
+     * @brief Adds a frame to the queue.
+     * @return True if the frame was queued, false if the queue is full.
+     */
+    bool Push(const TxFrame& frame) noexcept
+    {
+        if (m_size == N)
+        {
+            m_stats.Rejected++;
+            return false;
+        }
+
+        // Sift up the binary heap.
+        size_t i = m_size++;
+        Entry  e = {frame, frame.Priority(), m_sequence++};
+        while (i != 0)
+        {
+            size_t parent = (i - 1) / 2;
+            if (!e.Before(m_heap[parent]))
+            {
+                break;
+            }
+            m_heap[i] = m_heap[parent];
+            i         = parent;
+        }
+        m_heap[i]             = e;
+        m_stats.HighWaterMark = std::max(m_stats.HighWaterMark, m_size);
+        return true;
+    }
+
+    /**
+     * @brief Gets the frame that must be sent next, without removing it.
+     * @return The frame, or nullptr if the queue is empty.
+     */
+    [[nodiscard]] const TxFrame* Top() const noexcept
+    {
+        return m_size == 0 ? nullptr : &m_heap[0].Frame;
+    }
+
+    /**
+     * @brief Removes the frame that must be sent next.
+     */
+    std::optional<TxFrame> Pop() noexcept
+    {
+        if (m_size == 0)
+        {
+            return std::nullopt;
+        }
+
+        TxFrame top  = m_heap[0].Frame;
+        Entry   last = m_heap[--m_size];
+
+        // Sift the last entry down from the root.
+        size_t i = 0;
+        while (true)
+        {
+            size_t child = (2 * i) + 1;
+            if (child >= m_size)
+            {
+                break;
+            }
+            if (child + 1 < m_size && m_heap[child + 1].Before(m_heap[child]))
+            {
+                child++;
+            }
+            if (!m_heap[child].Before(last))
+            {
+                break;
+            }
+            m_heap[i] = m_heap[child];
+            i         = child;
+        }
+        m_heap[i] = last;
+        return top;
+    }
+
+    void Clear() noexcept { m_size = 0; }
+
+    void OnSent() noexcept { m_stats.Sent++; }
+    void OnAborted() noexcept { m_stats.Aborted++; }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+    [[nodiscard]] bool   Empty() const noexcept { return m_size == 0; }
+
+    [[nodiscard]] TxStats Stats() const noexcept
+    {
+        TxStats stats = m_stats;
+        stats.Depth   = m_size;
+        return stats;
+    }
+    void ResetStats() noexcept { m_stats = {}; }
+
+private:
+    std::array<Entry, N> m_heap     = {};
+    size_t               m_size     = 0;
+    uint32_t             m_sequence = 0;
+    TxStats              m_stats    = {};
+};
+}    // namespace Nilai::Can
+#endif
+#endif    // NILAI_CAN_TX_QUEUE_H
@@ -0,0 +1,345 @@
+/**
+ * @file    job_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Queue of I2C jobs, run back-to-back by the I2C module.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_I2C_JOB_QUEUE_H
+#define NILAI_DRIVERS_I2C_JOB_QUEUE_H
+
+#include "../../defines/system.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Nilai::Drivers::I2c
+{
+struct Job;
+
+/**
+ * @brief Function called once a job is over.
+ *
+ * Called from the interrupt context. It can submit new jobs, they are started as soon as it
+ * returns.
+ *
+ * @param job The job. Its buffers can be reused once this is called.
+ * @param ok True if every transfer of the job succeeded.
+ * @param ctx The user data of the job.
+ */
+using JobCallback = void (*)(const Job& job, bool ok, void* ctx);
+
+/**
+ * @brief Step of a job, handed to the function starting the transfers.
+ */
+enum class JobStep
+{
+    //! Sends @ref Job::Tx.
+    Write,
+    //! Reads @ref Job::Rx. When the job has a write step, it is read after a repeated start.
+    Read,
+};
+
+/**
+ * @brief Description of an exchange with a device.
+ *
+ * The buffers are borrowed, they must stay valid until the callback is called.
+ *
+ * - With a register, either @ref Tx is written to it, or @ref Rx is read from it.
+ * - Without a register, @ref Tx is written and then @ref Rx is read, without releasing the bus in
+ *   between. Either of them can be empty.
+ */
+struct Job
+{
+    //! 8-bit address of the device.
+    uint8_t Address = 0;
+    //! Address of the register, sent before the data when @ref UseRegister is set.
+    uint8_t Register    = 0;
+    bool    UseRegister = false;
+    //! Bytes to send.
+    std::span<const uint8_t> Tx = {};
+    //! Where to write the received bytes.
+    std::span<uint8_t> Rx  = {};
+    JobCallback        Cb  = nullptr;
+    void*              Ctx = nullptr;
+
+    /**
+     * @brief Writes to a register.
+     */
+    static constexpr Job WriteRegister(uint8_t                  addr,
+                                       uint8_t                  reg,
+                                       std::span<const uint8_t> data,
+                                       JobCallback              cb  = nullptr,
+                                       void*                    ctx = nullptr) noexcept
+    {
+        return {addr, reg, true, data, {}, cb, ctx};
+    }
+
+    /**
+     * @brief Reads from a register.
+     */
+    static constexpr Job ReadRegister(uint8_t            addr,
+                                      uint8_t            reg,
+                                      std::span<uint8_t> data,
+                                      JobCallback        cb  = nullptr,
+                                      void*              ctx = nullptr) noexcept
+    {
+        return {addr, reg, true, {}, data, cb, ctx};
+    }
+
+    /**
+     * @brief Writes to a device, then reads from it after a repeated start.
+     */
+    static constexpr Job WriteRead(uint8_t                  addr,
+                                   std::span<const uint8_t> tx,
+                                   std::span<uint8_t>       rx,
+                                   JobCallback              cb  = nullptr,
+                                   void*                    ctx = nullptr) noexcept
+    {
+        return {addr, 0, false, tx, rx, cb, ctx};
+    }
+
+    [[nodiscard]] constexpr bool IsValid() const noexcept
+    {
+        if (UseRegister)
+        {
+            return Tx.empty() != Rx.empty();
+        }
+        return !Tx.empty() || !Rx.empty();
+    }
+
+    [[nodiscard]] constexpr JobStep FirstStep() const noexcept
+    {
+        return Tx.empty() ? JobStep::Read : JobStep::Write;
+    }
+};
+
+/**
+ * @brief Statistics on the usage of a @ref JobQueue.
+ */
+struct JobQueueStats
+{
+    size_t Depth         = 0;    //!< Number of jobs currently in the queue.
+    size_t HighWaterMark = 0;    //!< Maximum number of jobs that have been in the queue.
+    size_t Rejected      = 0;    //!< Number of jobs that could not be queued.
+    size_t Completed     = 0;    //!< Number of jobs that succeeded.
+    size_t Failed        = 0;    //!< Number of jobs that failed.
+};
+
+/**
+ * @brief Fixed-capacity queue of jobs for one bus.
+ *
+ * The job at the front of the queue is the one on the bus. Each of its steps is started with the
+ * function given to the constructor, and reported with @ref OnComplete from the transfer complete
+ * interrupt. Once the last step is done, the callback of the job is called and the next one is
+ * started right away, from the interrupt.
+ *
+ * Jobs can be submitted from any context.
+ *
+ * @tparam Depth Maximum number of jobs in the queue, including the one on the bus.
+ */
+template<size_t Depth>
+class JobQueue
+{
+    static_assert(Depth != 0, "The queue must be able to hold at least one job!");
+
+public:
+    /**
+     * @brief Function starting a step of a job on the bus, without waiting for it to be done.
+     * @return True if the transfer was started.
+     */
+    using StartFunc = bool (*)(void* ctx, const Job& job, JobStep step);
+
+    constexpr JobQueue(StartFunc start, void* ctx) noexcept : m_start(start), m_ctx(ctx) {}
+
+    JobQueue(const JobQueue&)            = delete;
+    JobQueue& operator=(const JobQueue&) = delete;
+
+    /**
+     * @brief Adds a job to the queue, and starts it if the bus is idle.
+     * @return True if the job was queued, false if it is invalid or the queue is full.
+     */
+    bool Submit(const Job& job) noexcept { return Submit(std::span<const Job> {&job, 1}); }
+
+    /**
+     * @brief Adds jobs to the queue, all of them or none. They are run in order, without other jobs
+     * in between.
+     * @return True if the jobs were queued, false if one of them is invalid or they don't fit.
+     */
+    bool Submit(std::span<const Job> jobs) noexcept
+    {
+        {
+            System::CriticalSection lock;
+            bool                    valid = !jobs.empty() && jobs.size() <= Depth - m_size;
+            for (size_t i = 0; valid && i < jobs.size(); i++)
+            {
+                valid = jobs[i].IsValid();
+            }
+            if (!valid)
+            {
+                m_stats.Rejected++;
+                return false;
+            }
+
+            for (const Job& job : jobs)
+            {
+                m_items[(m_head + m_size) % Depth] = job;
+                m_size++;
+            }
+            if (m_size > m_stats.HighWaterMark)
+            {
+                m_stats.HighWaterMark = m_size;
+            }
+
+            if (m_busy)
+            {
+                return true;
+            }
+            // Claims the bus, the jobs are started below.
+            m_busy = true;
+        }
+
+        StartNext();
+        return true;
+    }
+
+    /**
+     * @brief Reports the end of the step that is on the bus. Called from the transfer complete and
+     * error interrupts.
+     * @param ok True if the transfer succeeded.
+     */
+    void OnComplete(bool ok) noexcept
+    {
+        Job done;
+        {
+            System::CriticalSection lock;
+            if (!m_busy)
+            {
+                return;
+            }
+
+            const Job& job = m_items[m_head];
+            if (ok && m_step == JobStep::Write && !job.Rx.empty())
+            {
+                m_step = JobStep::Read;
+                if (m_start(m_ctx, job, m_step))
+                {
+                    return;
+                }
+                ok = false;
+            }
+            done = Finish(ok);
+        }
+
+        // The queue is still marked as busy, what the callback submits is picked up below.
+        if (done.Cb != nullptr)
+        {
+            done.Cb(done, ok, done.Ctx);
+        }
+        StartNext();
+    }
+
+    /**
+     * @brief Checks if a job is on the bus.
+     */
+    [[nodiscard]] bool Busy() const noexcept { return m_busy; }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+
+    [[nodiscard]] JobQueueStats Stats() const noexcept
+    {
+        System::CriticalSection lock;
+        JobQueueStats           stats = m_stats;
+        stats.Depth                   = m_size;
+        return stats;
+    }
+
+    void ResetStats() noexcept
+    {
+        System::CriticalSection lock;
+        m_stats = {};
+    }
+
+private:
+    /**
+     * @brief Starts the job at the front of the queue, if any. Must be called with the queue marked
+     * as busy, and the interrupts enabled.
+     *
+     * Jobs that can't be started are failed right away. Their callbacks are called with the
+     * interrupts enabled, like those of the jobs that completed.
+     */
+    void StartNext() noexcept
+    {
+        // Stays busy while the callbacks run, so that what they submit is only queued.
+        while (true)
+        {
+            Job failed;
+            {
+                System::CriticalSection lock;
+                if (m_size == 0)
+                {
+                    m_busy = false;
+                    return;
+                }
+
+                const Job& job = m_items[m_head];
+                m_step         = job.FirstStep();
+                if (m_start(m_ctx, job, m_step))
+                {
+                    return;
+                }
+                failed = Finish(false);
+            }
+
+            if (failed.Cb != nullptr)
+            {
+                failed.Cb(failed, false, failed.Ctx);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the job on the bus from the queue. Must be called with the interrupts masked.
+     */
+    Job Finish(bool ok) noexcept
+    {
+        Job done = m_items[m_head];
+        m_head   = (m_head + 1) % Depth;
+        m_size--;
+        if (ok)
+        {
+            m_stats.Completed++;
+        }
+        else
+        {
+            m_stats.Failed++;
+        }
+        return done;
+    }
+
+private:
+    StartFunc m_start = nullptr;
+    void*     m_ctx   = nullptr;
+
+    std::array<Job, Depth> m_items = {};
+    size_t                 m_head  = 0;
+    size_t                 m_size  = 0;
+    JobStep                m_step  = JobStep::Write;
+    volatile bool          m_busy  = false;
+
+    JobQueueStats m_stats = {};
+};
+}    // namespace Nilai::Drivers::I2c
+
+#endif    // NILAI_DRIVERS_I2C_JOB_QUEUE_H
@@ -0,0 +1,179 @@
+/**
+ * @file    write_batch.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Register writes grouped in as few bursts as possible.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_I2C_WRITE_BATCH_H
+#define NILAI_DRIVERS_I2C_WRITE_BATCH_H
+
+#include "job_queue.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Nilai::Drivers::I2c
+{
+/**
+ * @brief Register writes, copied in the batch and sent as a sequence of jobs.
+ *
+ * A write to the register following the last one written on the same device is appended to the
+ * same burst, so that writing N consecutive registers takes a single job with a single address
+ * phase. This relies on the device incrementing the register address after each byte, like most
+ * of them do; don't add writes to consecutive registers for a device that doesn't.
+ *
+ * The batch must stay alive until the callback given to @ref Submit is called. It can then be
+ * submitted again as is, or cleared.
+ *
+ * @tparam Bytes Space for the data of all the writes.
+ * @tparam Bursts Maximum number of bursts. Must not be larger than the depth of the queue the
+ * batch is submitted to.
+ */
+template<size_t Bytes, size_t Bursts>
+class WriteBatch
+{
+    static_assert(Bytes != 0 && Bursts != 0, "The batch must be able to hold a write!");
+
+public:
+    /**
+     * @brief Function called once every burst of the batch is done.
+     * @param ok True if they all succeeded.
+     */
+    using DoneCallback = void (*)(bool ok, void* ctx);
+
+    WriteBatch() noexcept = default;
+
+    WriteBatch(const WriteBatch&)            = delete;
+    WriteBatch& operator=(const WriteBatch&) = delete;
+
+    /**
+     * @brief Adds a write to the batch.
+     * @param addr 8-bit address of the device.
+     * @param reg The first register written.
+     * @param data Written to @p reg and the following registers.
+     * @return True if the write was added, false if it doesn't fit or the batch is being sent.
+     */
+    bool Add(uint8_t addr, uint8_t reg, std::span<const uint8_t> data) noexcept
+    {
+        if (IsPending() || data.empty() || data.size() > Bytes - m_used)
+        {
+            return false;
+        }
+
+        bool merge = false;
+        if (m_count != 0)
+        {
+            const Job& last = m_jobs[m_count - 1];
+            merge = last.Address == addr && last.Register + last.Tx.size() == reg;
+        }
+        if (!merge && m_count == Bursts)
+        {
+            return false;
+        }
+
+        std::memcpy(&m_data[m_used], data.data(), data.size());
+        if (merge)
+        {
+            Job& last = m_jobs[m_count - 1];
+            last.Tx   = {last.Tx.data(), last.Tx.size() + data.size()};
+        }
+        else
+        {
+            m_jobs[m_count++] =
+              Job::WriteRegister(addr, reg, {&m_data[m_used], data.size()}, &OnJobDone, this);
+        }
+        m_used += data.size();
+        return true;
+    }
+
+    bool Add(uint8_t addr, uint8_t reg, uint8_t value) noexcept
+    {
+        return Add(addr, reg, std::span<const uint8_t> {&value, 1});
+    }
+
+    /**
+     * @brief Queues every burst, without other jobs in between.
+     * @param queue Anything with a `bool Submit(std::span<const Job>)`, like I2cModule.
+     * @param cb Called once every burst is done. Can be nullptr.
+     * @return True if the bursts were queued, false if the batch is empty, already being sent or
+     * if the queue doesn't have room for all of them.
+     */
+    template<typename Queue>
+    bool Submit(Queue& queue, DoneCallback cb = nullptr, void* ctx = nullptr) noexcept
+    {
+        if (IsPending() || m_count == 0)
+        {
+            return false;
+        }
+
+        m_cb        = cb;
+        m_cbCtx     = ctx;
+        m_ok        = true;
+        m_remaining = m_count;
+        if (!queue.Submit(Jobs()))
+        {
+            m_remaining = 0;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Removes every write. Does nothing while the batch is being sent.
+     */
+    void Clear() noexcept
+    {
+        if (!IsPending())
+        {
+            m_used  = 0;
+            m_count = 0;
+        }
+    }
+
+    [[nodiscard]] bool IsPending() const noexcept { return m_remaining != 0; }
+
+    [[nodiscard]] std::span<const Job> Jobs() const noexcept { return {m_jobs.data(), m_count}; }
+
+    //! Number of bytes written by the batch, register addresses excluded.
+    [[nodiscard]] size_t Size() const noexcept { return m_used; }
+
+private:
+    static void OnJobDone([[maybe_unused]] const Job& job, bool ok, void* ctx) noexcept
+    {
+        auto*  batch       = static_cast<WriteBatch*>(ctx);
+        size_t remaining   = batch->m_remaining - 1;
+        batch->m_ok        = batch->m_ok && ok;
+        batch->m_remaining = remaining;
+        if (remaining == 0 && batch->m_cb != nullptr)
+        {
+            batch->m_cb(batch->m_ok, batch->m_cbCtx);
+        }
+    }
+
+private:
+    std::array<uint8_t, Bytes> m_data  = {};
+    std::array<Job, Bursts>    m_jobs  = {};
+    size_t                     m_used  = 0;
+    size_t                     m_count = 0;
+
+    volatile size_t m_remaining = 0;
+    bool            m_ok        = true;
+    DoneCallback    m_cb        = nullptr;
+    void*           m_cbCtx     = nullptr;
+};
+}    // namespace Nilai::Drivers::I2c
+
+#endif    // NILAI_DRIVERS_I2C_WRITE_BATCH_H
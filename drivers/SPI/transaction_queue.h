@@ -0,0 +1,267 @@
+/**
+ * @file    transaction_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Queue of SPI transactions, run back-to-back by the SPI module.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_SPI_TRANSACTION_QUEUE_H
+#define NILAI_DRIVERS_SPI_TRANSACTION_QUEUE_H
+
+#include "../../defines/pin.h"
+#include "../../defines/system.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Nilai::Drivers::Spi
+{
+struct Transaction;
+
+/**
+ * @brief Function called once a transaction is over.
+ *
+ * Called from the interrupt context. It can submit new transactions, they are started as soon as
+ * it returns.
+ *
+ * @param t The transaction. Its buffers can be reused once this is called.
+ * @param ok True if the transfer succeeded.
+ * @param ctx The user data of the transaction.
+ */
+using TransactionCallback = void (*)(const Transaction& t, bool ok, void* ctx);
+
+/**
+ * @brief Description of a transfer on the bus.
+ *
+ * The buffers are borrowed, they must stay valid until the callback is called.
+ */
+struct Transaction
+{
+    //! Bytes to send. If empty, only @ref Rx is read.
+    std::span<const uint8_t> Tx = {};
+    //! Where to write the received bytes. If empty, only @ref Tx is sent. When both are set, they
+    //! must be of the same size.
+    std::span<uint8_t> Rx = {};
+    //! Chip select, pulled low for the transfer. Left alone if it is the default pin.
+    Pin Cs = {};
+    //! Leaves the chip select low after the transfer, so that the next transaction continues the
+    //! same frame.
+    bool                KeepCs = false;
+    TransactionCallback Cb     = nullptr;
+    void*               Ctx    = nullptr;
+
+    [[nodiscard]] size_t Size() const noexcept { return Tx.empty() ? Rx.size() : Tx.size(); }
+};
+
+/**
+ * @brief Statistics on the usage of a @ref TransactionQueue.
+ */
+struct TransactionQueueStats
+{
+    size_t Depth         = 0;    //!< Number of transactions currently in the queue.
+    size_t HighWaterMark = 0;    //!< Maximum number of transactions that have been in the queue.
+    size_t Rejected      = 0;    //!< Number of transactions that could not be queued.
+    size_t Completed     = 0;    //!< Number of transactions that succeeded.
+    size_t Failed        = 0;    //!< Number of transactions that failed.
+};
+
+/**
+ * @brief Fixed-capacity queue of transactions for one bus.
+ *
+ * The transaction at the front of the queue is the one on the bus. Once its transfer complete
+ * interrupt reports it with @ref OnComplete, its chip select is released, its callback is called
+ * and the next one is started right away, from the interrupt.
+ *
+ * Transactions can be submitted from any context.
+ *
+ * @tparam Depth Maximum number of transactions in the queue, including the one on the bus.
+ */
+template<size_t Depth>
+class TransactionQueue
+{
+    static_assert(Depth != 0, "The queue must be able to hold at least one transaction!");
+
+public:
+    /**
+     * @brief Function starting a transfer on the bus, without waiting for it to be done.
+     * @return True if the transfer was started.
+     */
+    using StartFunc = bool (*)(void* ctx, const Transaction& t);
+
+    TransactionQueue(StartFunc start, void* ctx) noexcept : m_start(start), m_ctx(ctx) {}
+
+    TransactionQueue(const TransactionQueue&)            = delete;
+    TransactionQueue& operator=(const TransactionQueue&) = delete;
+
+    /**
+     * @brief Adds a transaction to the queue, and starts it if the bus is idle.
+     * @return True if the transaction was queued, false if it is invalid or the queue is full.
+     */
+    bool Submit(const Transaction& t) noexcept
+    {
+        {
+            System::CriticalSection lock;
+            if (t.Size() == 0 || (!t.Tx.empty() && !t.Rx.empty() && t.Tx.size() != t.Rx.size()) ||
+                m_size == Depth)
+            {
+                m_stats.Rejected++;
+                return false;
+            }
+
+            m_items[(m_head + m_size) % Depth] = t;
+            m_size++;
+            if (m_size > m_stats.HighWaterMark)
+            {
+                m_stats.HighWaterMark = m_size;
+            }
+
+            if (m_busy)
+            {
+                return true;
+            }
+            // Claims the bus, the transaction is started below.
+            m_busy = true;
+        }
+
+        StartNext();
+        return true;
+    }
+
+    /**
+     * @brief Reports the end of the transfer that is on the bus. Called from the transfer complete
+     * and error interrupts.
+     * @param ok True if the transfer succeeded.
+     */
+    void OnComplete(bool ok) noexcept
+    {
+        Transaction done;
+        {
+            System::CriticalSection lock;
+            if (!m_busy)
+            {
+                return;
+            }
+            done = Finish(ok);
+        }
+
+        // The queue is still marked as busy, what the callback submits is picked up below.
+        if (done.Cb != nullptr)
+        {
+            done.Cb(done, ok, done.Ctx);
+        }
+        StartNext();
+    }
+
+    /**
+     * @brief Checks if a transaction is on the bus.
+     */
+    [[nodiscard]] bool Busy() const noexcept { return m_busy; }
+
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+
+    [[nodiscard]] TransactionQueueStats Stats() const noexcept
+    {
+        System::CriticalSection lock;
+        TransactionQueueStats   stats = m_stats;
+        stats.Depth                   = m_size;
+        return stats;
+    }
+
+    void ResetStats() noexcept
+    {
+        System::CriticalSection lock;
+        m_stats = {};
+    }
+
+private:
+    /**
+     * @brief Starts the transaction at the front of the queue, if any. Must be called with the
+     * queue marked as busy, and the interrupts enabled.
+     *
+     * Transactions that can't be started are failed right away. Their callbacks are called with the
+     * interrupts enabled, like those of the transactions that completed.
+     */
+    void StartNext() noexcept
+    {
+        // Stays busy while the callbacks run, so that what they submit is only queued.
+        while (true)
+        {
+            Transaction failed;
+            {
+                System::CriticalSection lock;
+                if (m_size == 0)
+                {
+                    m_busy = false;
+                    return;
+                }
+
+                const Transaction& t = m_items[m_head];
+                if (!t.Cs.IsDefault())
+                {
+                    t.Cs.Set(false);
+                }
+                if (m_start(m_ctx, t))
+                {
+                    return;
+                }
+                failed = Finish(false);
+            }
+
+            if (failed.Cb != nullptr)
+            {
+                failed.Cb(failed, false, failed.Ctx);
+            }
+        }
+    }
+
+    /**
+     * @brief Removes the transaction on the bus from the queue. Must be called with the interrupts
+     * masked.
+     */
+    Transaction Finish(bool ok) noexcept
+    {
+        Transaction done = m_items[m_head];
+        // A failed transfer ends the frame, even if it was meant to be continued.
+        if (!done.Cs.IsDefault() && (!done.KeepCs || !ok))
+        {
+            done.Cs.Set(true);
+        }
+
+        m_head = (m_head + 1) % Depth;
+        m_size--;
+        if (ok)
+        {
+            m_stats.Completed++;
+        }
+        else
+        {
+            m_stats.Failed++;
+        }
+        return done;
+    }
+
+private:
+    StartFunc m_start = nullptr;
+    void*     m_ctx   = nullptr;
+
+    std::array<Transaction, Depth> m_items = {};
+    size_t                         m_head  = 0;
+    size_t                         m_size  = 0;
+    volatile bool                  m_busy  = false;
+
+    TransactionQueueStats m_stats = {};
+};
+}    // namespace Nilai::Drivers::Spi
+
+#endif    // NILAI_DRIVERS_SPI_TRANSACTION_QUEUE_H
@@ -0,0 +1,247 @@
+/**
+ * @file    frame_pool.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Fixed-capacity pool of reception slots for the UART module.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_UART_FRAME_POOL_H
+#define NILAI_DRIVERS_UART_FRAME_POOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Nilai::Drivers::Uart
+{
+/**
+ * @brief Non-owning view of a frame that lives in a @ref FramePool slot.
+ *
+ * The view stays valid until it is handed back to the pool with @ref FramePool::Release.
+ */
+struct FrameView
+{
+    static constexpr size_t s_invalidSlot = static_cast<size_t>(-1);
+
+    const uint8_t* Data      = nullptr;
+    size_t         Len       = 0;
+    uint32_t       Timestamp = 0;
+    size_t         Slot      = s_invalidSlot;
+
+    [[nodiscard]] bool IsValid() const noexcept { return Slot != s_invalidSlot; }
+    explicit           operator bool() const noexcept { return IsValid(); }
+
+    [[nodiscard]] size_t Size() const noexcept { return Len; }
+
+    /**
+     * @brief Copies the frame into a contiguous buffer.
+     * @param dest Where to copy the frame.
+     * @param maxLen Size of the destination buffer.
+     * @return The number of bytes copied.
+     */
+    size_t CopyTo(uint8_t* dest, size_t maxLen) const noexcept
+    {
+        size_t len = Len < maxLen ? Len : maxLen;
+        std::memcpy(dest, Data, len);
+        return len;
+    }
+
+    [[nodiscard]] std::string_view ToStrView() const noexcept
+    {
+        return {reinterpret_cast<const char*>(Data), Len};
+    }
+
+    bool operator==(std::string_view s) const noexcept { return ToStrView() == s; }
+    bool operator!=(std::string_view s) const noexcept { return !(*this == s); }
+};
+
+/**
+ * @brief Statically sized pool of reception slots.
+ *
+ * Every slot goes through the following states:
+ * - Free: Available to the DMA.
+ * - Receiving: The DMA is currently writing in it.
+ * - Ready: Contains a complete frame, waiting in the FIFO to be read.
+ * - Borrowed: Handed out to the user as a @ref FrameView.
+ *
+ * The interrupt context owns the Free -> Receiving -> Ready transitions, the main loop owns the
+ * Ready -> Borrowed -> Free transitions. Since a given transition only ever has a single writer,
+ * no critical section is needed.
+ *
+ * @tparam SlotSize Maximum size of a frame, in bytes.
+ * @tparam SlotCount Number of slots in the pool.
+ */
+template<size_t SlotSize, size_t SlotCount>
+class FramePool
+{
+    static_assert(SlotSize != 0, "Slots must be able to hold at least one byte!");
+    static_assert(SlotCount >= 2, "At least one slot must be available while the DMA is running!");
+
+    enum class SlotState : uint8_t
+    {
+        Free,
+        Receiving,
+        Ready,
+        Borrowed,
+    };
+
+    struct Slot
+    {
+        std::array<uint8_t, SlotSize> Data      = {};
+        size_t                        Len       = 0;
+        uint32_t                      Timestamp = 0;
+        std::atomic<SlotState>        State     = SlotState::Free;
+    };
+
+public:
+    static constexpr size_t s_slotSize  = SlotSize;
+    static constexpr size_t s_slotCount = SlotCount;
+
+    constexpr FramePool() noexcept = default;
+
+    /**
+     * @brief Takes a free slot and marks it as being written to by the DMA.
+     * @return A pointer to the start of the slot, or nullptr if all slots are in use.
+     */
+    uint8_t* Acquire() noexcept
+    {
+        for (size_t i = 0; i < SlotCount; i++)
+        {
+            if (m_slots[i].State.load(std::memory_order_acquire) == SlotState::Free)
+            {
+                m_slots[i].State.store(SlotState::Receiving, std::memory_order_relaxed);
+                m_receiving = i;
+                return m_slots[i].Data.data();
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Gets the slot currently being written to by the DMA.
+     * @return A pointer to the start of the slot, or nullptr if no slot is being written to.
+     */
+    [[nodiscard]] uint8_t* Receiving() noexcept
+    {
+        return m_receiving == FrameView::s_invalidSlot ? nullptr : m_slots[m_receiving].Data.data();
+    }
+
+    /**
+     * @brief Marks the slot being written to by the DMA as a complete frame.
+     *
+     * If there are no free slots to receive the next frame in, the frame is dropped and its slot
+     * is re-used by the DMA.
+     *
+     * @param len Number of bytes written in the slot.
+     * @param timestamp Time of reception.
+     * @return A pointer to the slot to be used by the DMA for the next frame.
+     */
+    uint8_t* Commit(size_t len, uint32_t timestamp) noexcept
+    {
+        if (m_receiving == FrameView::s_invalidSlot)
+        {
+            return Acquire();
+        }
+
+        if (len == 0)
+        {
+            // Nothing received, keep using the same slot.
+            return m_slots[m_receiving].Data.data();
+        }
+
+        size_t current = m_receiving;
+        if (Acquire() == nullptr)
+        {
+            // Every slot is either waiting to be read or borrowed, drop the frame.
+            m_droppedFrames++;
+            return m_slots[current].Data.data();
+        }
+
+        Slot& slot     = m_slots[current];
+        slot.Len       = len > SlotSize ? SlotSize : len;
+        slot.Timestamp = timestamp;
+        slot.State.store(SlotState::Ready, std::memory_order_release);
+
+        m_ready[m_readyHead.load(std::memory_order_relaxed) % SlotCount] = current;
+        m_readyHead.fetch_add(1, std::memory_order_release);
+
+        return m_slots[m_receiving].Data.data();
+    }
+
+    /**
+     * @brief Takes the oldest complete frame out of the pool.
+     * @return A view of the frame. The view is invalid if no frames are available.
+     */
+    FrameView Pop() noexcept
+    {
+        size_t tail = m_readyTail.load(std::memory_order_relaxed);
+        if (tail == m_readyHead.load(std::memory_order_acquire))
+        {
+            return {};
+        }
+
+        size_t idx  = m_ready[tail % SlotCount];
+        Slot&  slot = m_slots[idx];
+        slot.State.store(SlotState::Borrowed, std::memory_order_relaxed);
+        m_readyTail.store(tail + 1, std::memory_order_release);
+
+        return {slot.Data.data(), slot.Len, slot.Timestamp, idx};
+    }
+
+    /**
+     * @brief Hands a borrowed slot back to the pool.
+     *
+     * The view must not be used after it has been released.
+     *
+     * @param view The view to release.
+     */
+    void Release(FrameView& view) noexcept
+    {
+        if (view.IsValid() && view.Slot < SlotCount)
+        {
+            m_slots[view.Slot].State.store(SlotState::Free, std::memory_order_release);
+        }
+        view = {};
+    }
+
+    /**
+     * @brief Gets the number of complete frames waiting to be read.
+     */
+    [[nodiscard]] size_t Available() const noexcept
+    {
+        return m_readyHead.load(std::memory_order_acquire) -
+               m_readyTail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of frames dropped because every slot was in use.
+     */
+    [[nodiscard]] size_t DroppedFrames() const noexcept { return m_droppedFrames; }
+
+private:
+    std::array<Slot, SlotCount> m_slots = {};
+
+    //! FIFO of the slots containing complete frames, in order of reception.
+    std::array<size_t, SlotCount> m_ready     = {};
+    std::atomic<size_t>           m_readyHead = 0;
+    std::atomic<size_t>           m_readyTail = 0;
+
+    size_t m_receiving     = FrameView::s_invalidSlot;
+    size_t m_droppedFrames = 0;
+};
+}    // namespace Nilai::Drivers::Uart
+
+#endif    // NILAI_DRIVERS_UART_FRAME_POOL_H
@@ -0,0 +1,289 @@
+/**
+ * @file    rx_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Reception ring continuously written by a circular DMA, framed on idle-line events.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_UART_RX_RING_H
+#define NILAI_DRIVERS_UART_RX_RING_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+
+namespace Nilai::Drivers::Uart
+{
+/**
+ * @brief Non-owning view of a frame that lives in a @ref RxRing.
+ *
+ * Since the frame can wrap around the end of the ring, it is made of up to two contiguous parts.
+ * The view stays valid until it is handed back to the ring with @ref RxRing::Release, as long as
+ * the ring has not been overrun.
+ */
+struct RingFrameView
+{
+    std::span<const uint8_t> First;
+    std::span<const uint8_t> Second;
+    uint32_t                 Timestamp = 0;
+    //! Position of the end of the frame in the stream. Used by the ring to free the bytes.
+    uint32_t End   = 0;
+    bool     Valid = false;
+
+    [[nodiscard]] bool IsValid() const noexcept { return Valid; }
+    explicit           operator bool() const noexcept { return IsValid(); }
+
+    [[nodiscard]] size_t Size() const noexcept { return First.size() + Second.size(); }
+
+    /**
+     * @brief Copies the frame into a contiguous buffer.
+     * @param dest Where to copy the frame.
+     * @param maxLen Size of the destination buffer.
+     * @return The number of bytes copied.
+     */
+    size_t CopyTo(uint8_t* dest, size_t maxLen) const noexcept
+    {
+        size_t first  = std::min(First.size(), maxLen);
+        size_t second = std::min(Second.size(), maxLen - first);
+        std::memcpy(dest, First.data(), first);
+        std::memcpy(dest + first, Second.data(), second);
+        return first + second;
+    }
+
+    bool operator==(std::string_view s) const noexcept
+    {
+        if (s.size() != Size())
+        {
+            return false;
+        }
+        return std::equal(First.begin(), First.end(), s.begin()) &&
+               std::equal(Second.begin(), Second.end(), s.begin() + First.size());
+    }
+    bool operator!=(std::string_view s) const noexcept { return !(*this == s); }
+};
+
+/**
+ * @brief Ring of bytes in which a DMA in circular mode continuously receives.
+ *
+ * The interrupt context reports the position of the DMA with @ref OnRxEvent on every half
+ * transfer, transfer complete and idle-line event. Frames are delimited by the idle-line events
+ * and are never copied: their position in the ring is pushed in a FIFO of descriptors, which the
+ * main loop reads with @ref Pop.
+ *
+ * The bytes of a frame are considered free once the frame is released. If the DMA writes over
+ * bytes that haven't been released yet, the ring is overrun and the overwritten frames are
+ * corrupted. This is counted in @ref Overruns. The bytes of a frame that is dropped, or lost by a
+ * @ref Resync, are never released: the ring then frees everything received so far, the frames still
+ * being read included.
+ *
+ * @tparam N Size of the ring, in bytes.
+ * @tparam FrameCount Maximum number of frames waiting to be read.
+ */
+template<size_t N, size_t FrameCount>
+class RxRing
+{
+    static_assert(N >= 2, "The ring must be large enough for the half-transfer event!");
+    static_assert(N <= UINT16_MAX, "The HAL can't receive more than 65535 bytes at once!");
+    static_assert(FrameCount != 0, "The ring must be able to hold at least one frame!");
+
+    struct Descriptor
+    {
+        size_t   Start     = 0;    //!< Index of the first byte in the ring.
+        uint32_t Len       = 0;
+        uint32_t End       = 0;    //!< Position of the end of the frame in the stream.
+        uint32_t Timestamp = 0;
+    };
+
+public:
+    static constexpr size_t s_size       = N;
+    static constexpr size_t s_frameCount = FrameCount;
+
+    constexpr RxRing() noexcept = default;
+
+    [[nodiscard]] uint8_t* Data() noexcept { return m_buff.data(); }
+    [[nodiscard]] size_t   Capacity() const noexcept { return N; }
+
+    /**
+     * @brief Reports the position of the DMA in the ring. To be called from the interrupt context.
+     *
+     * Runs in constant time, regardless of the size of the frame.
+     *
+     * @param pos Index of the next byte the DMA will write, as reported by the HAL.
+     * @param endOfFrame True if the event is an idle-line event, closing the current frame.
+     * @param timestamp Time of the event.
+     */
+    void OnRxEvent(size_t pos, bool endOfFrame, uint32_t timestamp) noexcept
+    {
+        pos %= N;
+        // Between two events, at most half of the ring can have been written.
+        uint32_t received = static_cast<uint32_t>((pos + N - m_lastPos) % N);
+        m_lastPos         = pos;
+        m_written += received;
+
+        bool lapped = m_written - m_consumed.load(std::memory_order_acquire) > N;
+        if (lapped && !m_lapped)
+        {
+            // The DMA went over bytes that haven't been released yet.
+            m_overruns++;
+        }
+        m_lapped = lapped;
+
+        if (!endOfFrame || m_written == m_frameStart)
+        {
+            return;
+        }
+
+        uint32_t len = m_written - m_frameStart;
+        if (len > N)
+        {
+            // Frame is larger than the ring, only the last N bytes are still there.
+            m_frameStartIdx = pos;
+            len             = N;
+        }
+
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= FrameCount)
+        {
+            // No room to store the frame's descriptor, drop it. Nobody will release its bytes.
+            m_droppedFrames++;
+            ReleaseUpTo(m_written);
+        }
+        else
+        {
+            m_frames[head % FrameCount] = {m_frameStartIdx, len, m_written, timestamp};
+            m_head.store(head + 1, std::memory_order_release);
+        }
+        m_frameStart    = m_written;
+        m_frameStartIdx = pos;
+    }
+
+    /**
+     * @brief Re-synchronizes the ring after the DMA was restarted from the start of the ring.
+     *
+     * The bytes of the frame that was being received are lost.
+     */
+    void Resync() noexcept
+    {
+        m_lastPos       = 0;
+        m_frameStart    = m_written;
+        m_frameStartIdx = 0;
+        m_lapped        = false;
+        ReleaseUpTo(m_written);
+    }
+
+    /**
+     * @brief Takes the oldest complete frame out of the ring.
+     * @return A view of the frame. The view is invalid if no frames are available.
+     */
+    RingFrameView Pop() noexcept
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return {};
+        }
+
+        Descriptor desc = m_frames[tail % FrameCount];
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        size_t start = desc.Start;
+        size_t first = std::min(static_cast<size_t>(desc.Len), N - start);
+
+        RingFrameView view;
+        view.First     = {m_buff.data() + start, first};
+        view.Second    = {m_buff.data(), desc.Len - first};
+        view.Timestamp = desc.Timestamp;
+        view.End       = desc.End;
+        view.Valid     = true;
+        return view;
+    }
+
+    /**
+     * @brief Hands the bytes of a frame back to the DMA.
+     *
+     * Frames must be released in the order they were popped.
+     *
+     * @param view The view to release. It is invalidated by this call.
+     */
+    void Release(RingFrameView& view) noexcept
+    {
+        if (view.IsValid())
+        {
+            ReleaseUpTo(view.End);
+        }
+        view = {};
+    }
+
+    /**
+     * @brief Gets the number of complete frames waiting to be read.
+     */
+    [[nodiscard]] size_t Available() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of bytes received since the end of the last frame.
+     */
+    [[nodiscard]] size_t Pending() const noexcept { return m_written - m_frameStart; }
+
+    /**
+     * @brief Gets the number of frames dropped because the FIFO of descriptors was full.
+     */
+    [[nodiscard]] size_t DroppedFrames() const noexcept { return m_droppedFrames; }
+
+    /**
+     * @brief Gets the number of times the DMA wrote over bytes that were not released yet.
+     */
+    [[nodiscard]] size_t Overruns() const noexcept { return m_overruns; }
+
+private:
+    //! Frees the bytes up to @p end, unless they already are. Called from both contexts.
+    void ReleaseUpTo(uint32_t end) noexcept
+    {
+        uint32_t consumed = m_consumed.load(std::memory_order_relaxed);
+        while (static_cast<int32_t>(end - consumed) > 0 &&
+               !m_consumed.compare_exchange_weak(consumed, end, std::memory_order_release))
+        {
+        }
+    }
+
+private:
+    std::array<uint8_t, N> m_buff = {};
+
+    //! Position of the DMA in the ring at the last event.
+    size_t m_lastPos = 0;
+    //! Total number of bytes received. Wraps around, only differences are meaningful.
+    uint32_t m_written = 0;
+    //! Position in the stream where the current frame started.
+    uint32_t m_frameStart = 0;
+    //! Index in the ring where the current frame started.
+    size_t m_frameStartIdx = 0;
+    //! Position in the stream up to which the bytes have been released.
+    std::atomic<uint32_t> m_consumed = 0;
+
+    std::array<Descriptor, FrameCount> m_frames = {};
+    std::atomic<size_t>                m_head   = 0;
+    std::atomic<size_t>                m_tail   = 0;
+
+    size_t m_droppedFrames = 0;
+    size_t m_overruns      = 0;
+    bool   m_lapped        = false;
+};
+}    // namespace Nilai::Drivers::Uart
+
+#endif    // NILAI_DRIVERS_UART_RX_RING_H
@@ -0,0 +1,291 @@
+/**
+ * @file    tx_queue.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Queue of segments waiting to be transmitted by the UART module.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_DRIVERS_UART_TX_QUEUE_H
+#define NILAI_DRIVERS_UART_TX_QUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Nilai::Drivers::Uart
+{
+/**
+ * @brief Function called once a borrowed segment has been transmitted.
+ *
+ * Called from the interrupt context.
+ */
+using TxCpltCallback = void (*)(const uint8_t* data, size_t len, void* ctx);
+
+/**
+ * @brief A contiguous block of bytes waiting to be transmitted.
+ */
+struct TxSegment
+{
+    const uint8_t* Data = nullptr;
+    size_t         Len  = 0;
+    //! Called once the segment has been sent. Only used by borrowed segments.
+    TxCpltCallback Cb  = nullptr;
+    void*          Ctx = nullptr;
+    //! Number of bytes of the copy buffer used by this segment, including alignment padding.
+    uint32_t PoolUsed = 0;
+};
+
+/**
+ * @brief Statistics on the usage of a @ref TxQueue.
+ */
+struct TxQueueStats
+{
+    size_t Depth             = 0;    //!< Number of segments currently in the queue.
+    size_t HighWaterMark     = 0;    //!< Maximum number of segments that have been in the queue.
+    size_t PoolHighWaterMark = 0;    //!< Maximum number of bytes used in the copy buffer.
+    size_t Rejected          = 0;    //!< Number of segments that could not be queued.
+};
+
+/**
+ * @brief Fixed-capacity queue of segments to transmit.
+ *
+ * Segments are either copied into an internal buffer, or borrowed from the caller, which must
+ * then keep them alive until their completion callback is called.
+ *
+ * Segments are pushed by a single producer and popped from the transmission complete interrupt.
+ * When segments can be pushed from both the main loop and interrupts, the owner must serialize the
+ * pushes, like @ref Nilai::Drivers::UartModule does by masking the interrupts around them.
+ * Segments, and the bytes they use in the copy buffer, are freed in the order they were pushed.
+ *
+ * A segment larger than @p PoolSize can never be copied, it is rejected.
+ *
+ * @tparam Depth Maximum number of segments in the queue.
+ * @tparam PoolSize Size of the buffer in which the copied segments are stored. Must be a power of
+ * two.
+ */
+template<size_t Depth, size_t PoolSize>
+class TxQueue
+{
+    static_assert(Depth != 0, "The queue must be able to hold at least one segment!");
+    static_assert(std::has_single_bit(PoolSize), "The size of the copy buffer must be a power of 2!");
+
+public:
+    static constexpr size_t s_depth    = Depth;
+    static constexpr size_t s_poolSize = PoolSize;
+
+    constexpr TxQueue() noexcept = default;
+
+    /**
+     * @brief Copies a buffer into the queue.
+     * @param data The bytes to transmit.
+     * @param len The number of bytes to transmit.
+     * @return True if the buffer was queued, false if there wasn't enough room.
+     */
+    bool Push(const uint8_t* data, size_t len) noexcept
+    {
+        TxSegment seg;
+        uint8_t*  dest = HasRoomFor(1) ? Reserve(len, seg) : nullptr;
+        if (dest == nullptr)
+        {
+            m_stats.Rejected++;
+            return false;
+        }
+        std::memcpy(dest, data, len);
+        m_poolAllocated += seg.PoolUsed;
+        Commit(seg);
+        return true;
+    }
+
+    /**
+     * @brief Queues a buffer without copying it.
+     *
+     * The buffer must stay valid until the callback is called.
+     *
+     * @param data The bytes to transmit.
+     * @param len The number of bytes to transmit.
+     * @param cb Function called once the buffer has been sent. Can be nullptr.
+     * @param ctx User data passed to the callback.
+     * @return True if the buffer was queued, false if there wasn't enough room.
+     */
+    bool PushBorrowed(const uint8_t* data, size_t len, TxCpltCallback cb, void* ctx) noexcept
+    {
+        if (!HasRoomFor(1))
+        {
+            m_stats.Rejected++;
+            return false;
+        }
+        Commit({data, len, cb, ctx, 0});
+        return true;
+    }
+
+    /**
+     * @brief Copies many buffers into the queue, as a single unit.
+     *
+     * Either all the buffers are queued, or none of them are.
+     *
+     * @param buffers The buffers to transmit, in order.
+     * @return True if the buffers were queued.
+     */
+    bool Push(std::span<const std::span<const uint8_t>> buffers) noexcept
+    {
+        if (!HasRoomFor(buffers.size()))
+        {
+            m_stats.Rejected += buffers.size();
+            return false;
+        }
+
+        // Reserve everything before committing anything.
+        std::array<TxSegment, Depth> segs;
+        std::array<uint8_t*, Depth>  dests;
+        uint32_t                     allocated = m_poolAllocated;
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            dests[i] = Reserve(buffers[i].size(), segs[i]);
+            if (dests[i] == nullptr)
+            {
+                m_poolAllocated = allocated;
+                m_stats.Rejected += buffers.size();
+                return false;
+            }
+            m_poolAllocated += segs[i].PoolUsed;
+        }
+
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            std::memcpy(dests[i], buffers[i].data(), buffers[i].size());
+            Commit(segs[i]);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gets the oldest segment in the queue, without removing it.
+     * @return The segment, or nullptr if the queue is empty.
+     */
+    [[nodiscard]] const TxSegment* Front() const noexcept
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &m_segments[tail % Depth];
+    }
+
+    /**
+     * @brief Removes the oldest segment from the queue once it's been transmitted.
+     *
+     * The completion callback of the segment, if any, is called.
+     */
+    void Pop() noexcept
+    {
+        const TxSegment* seg = Front();
+        if (seg == nullptr)
+        {
+            return;
+        }
+
+        TxSegment done = *seg;
+        m_poolFreed.fetch_add(done.PoolUsed, std::memory_order_release);
+        m_tail.fetch_add(1, std::memory_order_release);
+
+        if (done.Cb != nullptr)
+        {
+            done.Cb(done.Data, done.Len, done.Ctx);
+        }
+    }
+
+    [[nodiscard]] bool Empty() const noexcept { return Size() == 0; }
+
+    [[nodiscard]] size_t Size() const noexcept
+    {
+        return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+    }
+
+    [[nodiscard]] TxQueueStats Stats() const noexcept
+    {
+        TxQueueStats stats = m_stats;
+        stats.Depth        = Size();
+        return stats;
+    }
+
+    void ResetStats() noexcept { m_stats = {}; }
+
+private:
+    [[nodiscard]] bool HasRoomFor(size_t count) const noexcept
+    {
+        return Size() + count <= Depth;
+    }
+
+    /**
+     * @brief Finds a contiguous block of bytes in the copy buffer.
+     *
+     * If the block doesn't fit before the end of the buffer, the bytes up to the end are skipped.
+     * The block is only allocated once m_poolAllocated is incremented by seg.PoolUsed.
+     *
+     * @return Where to write the bytes of the segment, or nullptr if there isn't enough room.
+     */
+    uint8_t* Reserve(size_t len, TxSegment& seg) noexcept
+    {
+        uint32_t used   = m_poolAllocated - m_poolFreed.load(std::memory_order_acquire);
+        size_t   offset = m_poolAllocated & (PoolSize - 1);
+        size_t   skip   = offset + len > PoolSize ? PoolSize - offset : 0;
+
+        // When the buffer is empty, the skipped bytes are free, any segment that fits is accepted.
+        if (len > PoolSize || (used != 0 && used + skip + len > PoolSize))
+        {
+            return nullptr;
+        }
+
+        uint8_t* dest = &m_pool[(offset + skip) & (PoolSize - 1)];
+        seg           = {dest, len, nullptr, nullptr, static_cast<uint32_t>(skip + len)};
+        return dest;
+    }
+
+    void Commit(const TxSegment& seg) noexcept
+    {
+        size_t head              = m_head.load(std::memory_order_relaxed);
+        m_segments[head % Depth] = seg;
+        m_head.store(head + 1, std::memory_order_release);
+
+        size_t size = Size();
+        if (size > m_stats.HighWaterMark)
+        {
+            m_stats.HighWaterMark = size;
+        }
+        size_t poolUsed =
+          std::min<size_t>(m_poolAllocated - m_poolFreed.load(std::memory_order_relaxed), PoolSize);
+        if (poolUsed > m_stats.PoolHighWaterMark)
+        {
+            m_stats.PoolHighWaterMark = poolUsed;
+        }
+    }
+
+private:
+    std::array<TxSegment, Depth> m_segments = {};
+    std::atomic<size_t>          m_head     = 0;
+    std::atomic<size_t>          m_tail     = 0;
+
+    std::array<uint8_t, PoolSize> m_pool          = {};
+    uint32_t                      m_poolAllocated = 0;
+    std::atomic<uint32_t>         m_poolFreed     = 0;
+
+    TxQueueStats m_stats = {};
+};
+}    // namespace Nilai::Drivers::Uart
+
+#endif    // NILAI_DRIVERS_UART_TX_QUEUE_H
@@ -90,6 +90,9 @@ AdcModule::AdcModule(ADC_HandleTypeDef* adc, std::string label)
     // Register conversion complete and error callbacks.
     REGISTER_CALLBACK(HAL_ADC_CONVERSION_COMPLETE_CB_ID, &AdcModule::AdcModuleConvCpltCallback);
     REGISTER_CALLBACK(HAL_ADC_ERROR_CB_ID, &AdcModule::AdcModuleErrorCallback);
+#        if defined(NILAI_ADC_USE_STREAM)
+    REGISTER_CALLBACK(HAL_ADC_CONVERSION_HALF_CB_ID, &AdcModule::AdcModuleConvHalfCpltCallback);
+#        endif
 #    endif
 
     Start();
@@ -158,6 +161,13 @@ void AdcModule::Run()
         ADC_ERROR("An error occurred: %#08x", m_lastError);
 #    endif
         m_lastError = 0;
+#    if defined(NILAI_ADC_USE_STREAM)
+        if (m_isStreaming)
+        {
+            StartStreamDma();
+            return;
+        }
+#    endif
         Start();
     }
 }
@@ -173,6 +183,12 @@ uint32_t AdcModule::GetRawChannelReading(size_t channel) const
                  "[%s] Channel %i is not a valid channel!",
                  m_label.c_str(),
                  channel);
+#    if defined(NILAI_ADC_USE_STREAM)
+    if (m_isStreaming)
+    {
+        return m_stream.LastRaw(channel);
+    }
+#    endif
     return m_channelBuff[channel];
 }
 
@@ -237,8 +253,98 @@ void AdcModule::Stop()
     m_isRunning = false;
 }
 
+#    if defined(NILAI_ADC_USE_STREAM)
+bool AdcModule::StartStream(TIM_HandleTypeDef*       trigger,
+                            const Adc::StreamConfig& config,
+                            Adc::BlockCallback       cb,
+                            void*                    ctx)
+{
+    StopStream();
+    Stop();
+
+    if (!m_stream.Configure(m_channelBuff.size(), config, cb, ctx))
+    {
+        ADC_ERROR("Invalid stream configuration!");
+        return false;
+    }
+
+    m_trigger     = trigger;
+    m_isStreaming = true;
+    if (!StartStreamDma())
+    {
+        m_isStreaming = false;
+        return false;
+    }
+
+    if (m_trigger != nullptr && HAL_TIM_Base_Start(m_trigger) != HAL_OK)
+    {
+        ADC_ERROR("Unable to start the trigger!");
+        StopStream();
+        return false;
+    }
+
+    ADC_INFO("Streaming %i scans per block, decimated by %i",
+             config.ScansPerHalf,
+             config.Ratio);
+    return true;
+}
+
+void AdcModule::StopStream()
+{
+    if (!m_isStreaming)
+    {
+        return;
+    }
+
+    if (m_trigger != nullptr)
+    {
+        HAL_TIM_Base_Stop(m_trigger);
+    }
+    HAL_ADC_Stop_DMA(m_adc);
+    m_isStreaming = false;
+}
+
+bool AdcModule::StartStreamDma()
+{
+    m_stream.Reset();
+    if (m_adc->DMA_Handle != nullptr)
+    {
+        m_stream.SetPositionQuery(&QueryDmaPosition, m_adc->DMA_Handle);
+    }
+    auto buff = m_stream.DmaBuffer();
+    if (HAL_ADC_Start_DMA(m_adc, buff.data(), buff.size()) != HAL_OK)
+    {
+        ADC_ERROR("Unable to start the DMA!");
+        return false;
+    }
+    return true;
+}
+
+size_t AdcModule::QueryDmaPosition(void* ctx)
+{
+    return __HAL_DMA_GET_COUNTER(static_cast<DMA_HandleTypeDef*>(ctx));
+}
+
+void AdcModule::ConvHalfCpltCallback()
+{
+    if (m_isStreaming)
+    {
+        m_stream.OnHalfComplete();
+    }
+}
+#    endif
+
 void AdcModule::ConvCpltCallback()
 {
+#    if defined(NILAI_ADC_USE_STREAM)
+    if (m_isStreaming)
+    {
+        // The application gets whole blocks instead of a callback per scan.
+        m_stream.OnComplete();
+        return;
+    }
+#    endif
+
     for (const auto& cb : m_convCpltCallbacks)
     {
         cb(this);
@@ -270,6 +376,25 @@ extern "C" void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef* adc)
     module->ConvCpltCallback();
 }
 
+#    if defined(NILAI_ADC_USE_STREAM)
+/**
+ * @brief Callback invoked by the HAL once the first half of the DMA buffer is filled.
+ * @param adc Handle to the hardware peripheral.
+ */
+#        if defined(NILAI_ADC_REGISTER_CALLBACKS)
+void AdcModule::AdcModuleConvHalfCpltCallback(ADC_HandleTypeDef* adc)
+#        else
+extern "C" void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef* adc)
+#        endif
+{
+    AdcModule* module = FindModule(adc);
+    if (module != nullptr)
+    {
+        module->ConvHalfCpltCallback();
+    }
+}
+#    endif
+
 /**
  * @brief Callback invoked by the HAL when an error is detected in the ADC peripheral.
  * @param adc Handle to the hardware peripheral.
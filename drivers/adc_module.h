@@ -24,6 +24,13 @@
 #    if defined(HAL_ADC_MODULE_ENABLED) || defined(NILAI_TEST)
 #        include "../defines/module.h"
 
+#        if defined(NILAI_ADC_USE_STREAM)
+#            if !defined(HAL_TIM_MODULE_ENABLED) && !defined(NILAI_TEST)
+#                error The ADC stream needs the TIM HAL module to trigger the conversions
+#            endif
+#            include "ADC/stream.h"
+#        endif
+
 #        include <functional>
 #        include <map>
 #        include <string>
@@ -83,6 +90,36 @@ public:
     [[nodiscard]] float    GetChannelReading(size_t channel) const;
     [[nodiscard]] uint32_t GetRawChannelReading(size_t channel) const;
 
+#        if defined(NILAI_ADC_USE_STREAM)
+    /**
+     * @brief Starts a continuous acquisition, handing blocks of decimated samples to @p cb instead
+     * of calling the conversion complete callbacks.
+     *
+     * The ADC must start its scans on the trigger output of @p trigger, without continuous mode,
+     * and its DMA stream must be circular with a word width. The timer sets the rate of the scans.
+     *
+     * @param trigger The timer triggering the scans, started by this function. Can be nullptr if it
+     * is started elsewhere.
+     * @param config Size of the blocks and settings of the decimation filters.
+     * @param cb Called with each block, from the interrupt context.
+     * @return False if the configuration is invalid or the ADC couldn't be started.
+     */
+    bool StartStream(TIM_HandleTypeDef*       trigger,
+                     const Adc::StreamConfig& config,
+                     Adc::BlockCallback       cb,
+                     void*                    ctx = nullptr);
+
+    /**
+     * @brief Stops the continuous acquisition and its trigger.
+     */
+    void StopStream();
+
+    [[nodiscard]] bool             IsStreaming() const { return m_isStreaming; }
+    [[nodiscard]] Adc::StreamStats GetStreamStats() const { return m_stream.Stats(); }
+
+    virtual void ConvHalfCpltCallback();
+#        endif
+
     virtual void ConvCpltCallback();
     virtual void ErrorCallback();
 
@@ -90,6 +127,15 @@ private:
 #        if defined(NILAI_ADC_REGISTER_CALLBACKS)
     static void AdcModuleConvCpltCallback(ADC_HandleTypeDef* adc);
     static void AdcModuleErrorCallback(ADC_HandleTypeDef* adc);
+#            if defined(NILAI_ADC_USE_STREAM)
+    static void AdcModuleConvHalfCpltCallback(ADC_HandleTypeDef* adc);
+#            endif
+#        endif
+
+#        if defined(NILAI_ADC_USE_STREAM)
+    bool StartStreamDma();
+    //! Number of conversions the DMA has yet to write, @p ctx being its handle.
+    static size_t QueryDmaPosition(void* ctx);
 #        endif
 
 #        if defined(NILAI_ADC_STATUS_STRING)
@@ -106,6 +152,12 @@ protected:
 
     std::vector<std::function<void(AdcModule*)>> m_convCpltCallbacks;
     std::vector<std::function<void(AdcModule*)>> m_errorCallbacks;
+
+#        if defined(NILAI_ADC_USE_STREAM)
+    Adc::Stream        m_stream;
+    TIM_HandleTypeDef* m_trigger     = nullptr;
+    bool               m_isStreaming = false;
+#        endif
 };
 }    // namespace Nilai::Drivers
 #    else
@@ -20,7 +20,12 @@
 #if defined(NILAI_USE_I2S) || defined(NILAI_USE_SAI)
 #    include "../defines/module.h"
 
+#    if defined(NILAI_AUDIO_USE_PIPELINE)
+#        include "AUDIO/pipeline.h"
+#    endif
+
 #    include <functional>
+#    include <optional>
 
 namespace Nilai::Drivers
 {
@@ -34,6 +39,8 @@ public:
 
     virtual void SetTxHalfCpltCb([[maybe_unused]] const std::function<void()>& cb) {}
     virtual void SetTxCpltCb([[maybe_unused]] const std::function<void()>& cb) {}
+    [[nodiscard]] virtual std::function<void()> GetTxHalfCpltCb() const { return []() {}; }
+    [[nodiscard]] virtual std::function<void()> GetTxCpltCb() const { return []() {}; }
 
     [[nodiscard]] virtual bool IsStreaming() const { return false; }
     /**
@@ -76,6 +83,105 @@ public:
 
     virtual void               ToggleShutdown([[maybe_unused]] bool s) {}
     [[nodiscard]] virtual bool IsShutdown() const { return false; }
+
+    /**
+     * @brief Checks if the transmission DMA runs in circular mode, wrapping around at the end of
+     * the buffer instead of stopping.
+     */
+    [[nodiscard]] virtual bool IsTxCircular() const { return false; }
+
+    /**
+     * @brief Reads the number of bytes the transmission DMA has yet to send before the end of the
+     * buffer.
+     * @return Nothing if the device can't tell.
+     */
+    [[nodiscard]] virtual std::optional<size_t> GetTxRemainingBytes() const { return std::nullopt; }
+
+#    if defined(NILAI_AUDIO_USE_PIPELINE)
+    /**
+     * @brief Plays frames provided on demand, without gaps between the blocks.
+     *
+     * The device streams a buffer of two halves of @ref Audio::PipelineConfig::LatencyFrames
+     * frames in a loop, and @p cb is called from the DMA interrupts to refill each half as soon as
+     * it has been played. Both halves are filled before the stream starts.
+     *
+     * The transmission DMA must be configured in circular mode. The callbacks set with
+     * @ref SetTxHalfCpltCb and @ref SetTxCpltCb are replaced for the duration of the stream, and
+     * restored by @ref StopPipeline. The late refills are found with @ref GetTxRemainingBytes when
+     * the device supports it.
+     *
+     * @return True if the stream was started.
+     */
+    bool StartPipeline(const Audio::PipelineConfig& config, Audio::RefillCallback cb, void* ctx)
+    {
+        if (IsStreaming() || !IsTxCircular() || !m_pipeline.Configure(config, cb, ctx))
+        {
+            return false;
+        }
+        // The HAL takes the size of the transfer on 16 bits.
+        if (m_pipeline.DmaSamples() > 0xFFFF)
+        {
+            return false;
+        }
+
+        m_pipeline.ResetStats();
+        m_pipeline.Prime();
+        if (GetTxRemainingBytes().has_value())
+        {
+            m_pipeline.SetPositionQuery(&QueryTxPosition, this);
+        }
+        else
+        {
+            m_pipeline.SetPositionQuery(nullptr, nullptr);
+        }
+        m_savedTxHalfCpltCb = GetTxHalfCpltCb();
+        m_savedTxCpltCb     = GetTxCpltCb();
+        SetTxHalfCpltCb([this]() { m_pipeline.OnHalfComplete(); });
+        SetTxCpltCb([this]() { m_pipeline.OnComplete(); });
+        if (!Stream(m_pipeline.DmaBuffer().data(), m_pipeline.DmaSamples()))
+        {
+            RestoreTxCallbacks();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stops the stream started by @ref StartPipeline.
+     * @return True if successfully stopped.
+     */
+    bool StopPipeline()
+    {
+        bool stopped = StopStream();
+        RestoreTxCallbacks();
+        return stopped;
+    }
+
+    [[nodiscard]] Audio::PipelineStats GetPipelineStats() const { return m_pipeline.Stats(); }
+    [[nodiscard]] size_t GetPipelineLatency() const { return m_pipeline.LatencyFrames(); }
+
+private:
+    void RestoreTxCallbacks()
+    {
+        SetTxHalfCpltCb(m_savedTxHalfCpltCb);
+        SetTxCpltCb(m_savedTxCpltCb);
+        m_savedTxHalfCpltCb = nullptr;
+        m_savedTxCpltCb     = nullptr;
+    }
+
+    static size_t QueryTxPosition(void* ctx)
+    {
+        return static_cast<AudioDevice*>(ctx)->GetTxRemainingBytes().value_or(0);
+    }
+
+protected:
+    Audio::Pipeline m_pipeline;
+
+private:
+    //! Callbacks of the user, replaced by the ones of the pipeline while it streams.
+    std::function<void()> m_savedTxHalfCpltCb;
+    std::function<void()> m_savedTxCpltCb;
+#    endif
 };
 
 }    // namespace Nilai::Drivers
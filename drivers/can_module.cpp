@@ -11,33 +11,37 @@
 #include "drivers/can_module.h"
 
 #if defined(NILAI_USE_CAN) && defined(HAL_CAN_MODULE_ENABLED)
+#    include "defines/system.h"
 #    include "services/logger.h"
 
 #    include <algorithm>
+#    include <bit>
 
-static std::map<CAN_HandleTypeDef*, Nilai::Drivers::CanModule*> s_modules = {};
 namespace Nilai::Drivers
 {
+static std::array<CanModule*, 3> s_modules = {};
+
 CanModule::CanModule(CAN_HandleTypeDef* handle, std::string label)
 : m_handle(handle), m_label(std::move(label))
 {
-    CEP_ASSERT(handle != nullptr, "CAN Handle is NULL!");
-    m_framesReceived.reserve(5);
-    m_callbacks =
-      std::map<Can::Irq, std::function<void()>>({{Can::Irq::TxMailboxEmpty, []() {}},
-                                                 {Can::Irq::Fifo0MessagePending, []() {}},
-                                                 {Can::Irq::Fifo0Full, []() {}},
-                                                 {Can::Irq::Fifo0Overrun, []() {}},
-                                                 {Can::Irq::Fifo1MessagePending, []() {}},
-                                                 {Can::Irq::Fifo1Full, []() {}},
-                                                 {Can::Irq::Fifo1Overrun, []() {}},
-                                                 {Can::Irq::Wakeup, []() {}},
-                                                 {Can::Irq::SleepAck, []() {}},
-                                                 {Can::Irq::ErrorWarning, []() {}},
-                                                 {Can::Irq::ErrorPassive, []() {}},
-                                                 {Can::Irq::BusOffError, []() {}},
-                                                 {Can::Irq::LastErrorCode, []() {}},
-                                                 {Can::Irq::ErrorStatus, []() {}}});
+    NILAI_ASSERT(handle != nullptr, "CAN Handle is NULL!");
+    for (Can::Irq irq : {Can::Irq::TxMailboxEmpty,
+                         Can::Irq::Fifo0MessagePending,
+                         Can::Irq::Fifo0Full,
+                         Can::Irq::Fifo0Overrun,
+                         Can::Irq::Fifo1MessagePending,
+                         Can::Irq::Fifo1Full,
+                         Can::Irq::Fifo1Overrun,
+                         Can::Irq::Wakeup,
+                         Can::Irq::SleepAck,
+                         Can::Irq::ErrorWarning,
+                         Can::Irq::ErrorPassive,
+                         Can::Irq::BusOffError,
+                         Can::Irq::LastErrorCode,
+                         Can::Irq::ErrorStatus})
+    {
+        ClearCallback(irq);
+    }
 
     HAL_CAN_Start(m_handle);
 
@@ -49,15 +53,25 @@ CanModule::CanModule(CAN_HandleTypeDef* handle, std::string label)
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_TX_MAILBOX1_ABORT_CB_ID, &CanTxMailbox1AbortCb);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_TX_MAILBOX2_ABORT_CB_ID, &CanTxMailbox2AbortCb);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO0_MSG_PENDING_CB_ID, &CanRxFifo0MsgPendingCb);
-    HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO0_FULL_CB_ID, &CanRxFifo0FullCb);
+    HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO0_FULL_CB_ID, &CanRxFifo0FullCallback);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO1_MSG_PENDING_CB_ID, &CanRxFifo1MsgPendingCb);
-    HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO1_FULL_CB_ID, &CanRxFifo1FullCb);
+    HAL_CAN_RegisterCallback(m_handle, HAL_CAN_RX_FIFO1_FULL_CB_ID, &CanRxFifo1FullCallback);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_SLEEP_CB_ID, &CanSleepCallback);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_WAKEUP_FROM_RX_MSG_CB_ID, &CanWakeUpFromRxCb);
     HAL_CAN_RegisterCallback(m_handle, HAL_CAN_ERROR_CB_ID, &CanErrorCb);
 #    endif
 
-    s_modules[handle] = this;
+    for (CanModule*& module : s_modules)
+    {
+        if (module == nullptr)
+        {
+            module = this;
+            break;
+        }
+    }
+
+    // Everything is done from the interrupts, there's nothing to poll.
+    SetRunOnSignal();
 
     LOG_INFO("[%s]: Initialized", m_label.c_str());
 }
@@ -65,6 +79,7 @@ CanModule::CanModule(CAN_HandleTypeDef* handle, std::string label)
 CanModule::~CanModule()
 {
     HAL_CAN_Stop(m_handle);
+    std::replace(s_modules.begin(), s_modules.end(), this, static_cast<CanModule*>(nullptr));
 }
 
 /**
@@ -91,9 +106,14 @@ void CanModule::Reset()
     m_handle->Init = params;
     if (HAL_CAN_Init(m_handle) != HAL_OK)
     {
-        CEP_ASSERT(false, "Unable to restart %s!", m_label.c_str());
+        NILAI_ASSERT(false, "Unable to restart %s!", m_label.c_str());
     }
     HAL_CAN_Start(m_handle);
+
+    // The mailboxes were emptied, the frames still in the queue are sent.
+    System::CriticalSection lock;
+    m_txPending = 0;
+    FillMailboxes();
 }
 
 void CanModule::ConfigureFilter(const Can::FilterConfiguration& config)
@@ -104,17 +124,124 @@ void CanModule::ConfigureFilter(const Can::FilterConfiguration& config)
 
     if (HAL_CAN_ConfigFilter(m_handle, &filter) != HAL_OK)
     {
-        CEP_ASSERT(false, "In %s::ConfigureFilter: Unable to configure filter!", m_label.c_str());
+        NILAI_ASSERT(false, "In %s::ConfigureFilter: Unable to configure filter!", m_label.c_str());
     }
 
     m_filters[hash] = config;
+
+    // The mode of the bank changes the index of the filters after it.
+    System::CriticalSection lock;
+    m_filterTable.Configure(config);
 }
 
+size_t CanModule::Subscribe(uint32_t                   id,
+                            uint32_t                   mask,
+                            const Can::FrameHandler&   handler,
+                            bool                       extended,
+                            Can::FilterFifoAssignation fifo)
+{
+    NILAI_ASSERT(handler, "In %s::Subscribe: The handler is empty!", m_label.c_str());
+    size_t bank = m_filterTable.FindFreeBank();
+    if (bank == s_invalidSubscription)
+    {
+        LOG_ERROR("In %s::Subscribe: No filter bank available", m_label.c_str());
+        return s_invalidSubscription;
+    }
+
+    // In 32-bit scale, the identifier is aligned on the left, followed by the IDE and RTR bits.
+    // The IDE bit is always compared, so that standard and extended frames don't mix.
+    static constexpr uint32_t s_ideBit = 0x04;
+    Can::FilterConfiguration  config   = {};
+    if (extended)
+    {
+        config.filterId.fullId = ((id & 0x1FFFFFFF) << 3) | s_ideBit;
+        config.maskId.fullId   = ((mask & 0x1FFFFFFF) << 3) | s_ideBit;
+    }
+    else
+    {
+        config.filterId.fullId = (id & 0x7FF) << 21;
+        config.maskId.fullId   = ((mask & 0x7FF) << 21) | s_ideBit;
+    }
+    config.fifo     = fifo;
+    config.bank     = static_cast<uint8_t>(bank);
+    config.mode     = Can::FilterMode::IdMask;
+    config.scale    = Can::FilterScale::Scale32bit;
+    config.activate = Can::FilterEnable::Enable;
+
+    {
+        // Attached before the filter is enabled, so that no frame goes by without its handler.
+        System::CriticalSection lock;
+        m_filterTable.Attach(bank, fifo, handler);
+    }
+
+    CAN_FilterTypeDef filter = AssertAndConvertFilterStruct(config);
+    if (HAL_CAN_ConfigFilter(m_handle, &filter) != HAL_OK)
+    {
+        LOG_ERROR("In %s::Subscribe: Unable to configure filter bank %d",
+                  m_label.c_str(),
+                  static_cast<int>(bank));
+        System::CriticalSection lock;
+        m_filterTable.Detach(bank);
+        return s_invalidSubscription;
+    }
+
+    return bank;
+}
+
+size_t CanModule::Subscribe(Can::IsoTp& channel)
+{
+    const Can::IsoTpConfig& config = channel.Config();
+    return Subscribe(
+      config.RxId,
+      config.Extended ? 0x1FFFFFFF : 0x7FF,
+      [&channel](const Can::Frame& frame) { channel.OnFrame(frame); },
+      config.Extended);
+}
+
+void CanModule::Unsubscribe(size_t subscription)
+{
+    if (subscription >= s_invalidSubscription)
+    {
+        return;
+    }
+
+    // The bank keeps its mode and its FIFO, only its activation changes. Disabled banks are still
+    // counted in the filter match indexes of their FIFO.
+    CAN_FilterTypeDef filter = {0, 0, 0, 0, 0, (FunctionalState)0, 0, 0, 0, 0};
+    filter.FilterFIFOAssignment = static_cast<uint32_t>(m_filterTable.GetFifo(subscription));
+    filter.FilterBank           = static_cast<uint32_t>(subscription);
+    filter.FilterMode           = CAN_FILTERMODE_IDMASK;
+    filter.FilterScale          = CAN_FILTERSCALE_32BIT;
+    filter.FilterActivation     = CAN_FILTER_DISABLE;
+    filter.SlaveStartFilterBank = NILAI_CAN_FILTER_BANKS;
+    HAL_CAN_ConfigFilter(m_handle, &filter);
+
+    System::CriticalSection lock;
+    m_filterTable.Detach(subscription);
+}
+
+/**
+ * Takes the oldest frame received, starting with FIFO 0.
+ * @return The frame, or a default frame if none were received.
+ */
 Can::Frame CanModule::ReceiveFrame()
 {
-    Can::Frame frame = m_framesReceived.back();
-    m_framesReceived.pop_back();
-    return frame;
+    return m_rxQueue.Pop().value_or(Can::Frame {});
+}
+
+/**
+ * Takes as many received frames as possible, FIFO 0 first, oldest first.
+ * @param frames Where to write the frames.
+ * @return The number of frames written.
+ */
+size_t CanModule::ReceiveFrames(std::span<Can::Frame> frames)
+{
+    return m_rxQueue.PopMany(frames);
+}
+
+size_t CanModule::ReceiveFrames(std::span<Can::Frame> frames, Can::RxFifo fifo)
+{
+    return m_rxQueue.PopMany(frames, fifo);
 }
 
 Can::Status CanModule::TransmitFrame(uint32_t                    addr,
@@ -125,44 +252,64 @@ Can::Status CanModule::TransmitFrame(uint32_t                    addr,
 }
 
 
+/**
+ * Queues a frame for transmission, without waiting for a mailbox to be free.
+ *
+ * The queued frames are sent by order of priority on the bus, the mailbox complete interrupts
+ * loading the next ones into the mailboxes.
+ *
+ * @return Can::Status::TX_ERROR if the queue is full.
+ */
 Can::Status CanModule::TransmitFrame(uint32_t       addr,
                                      const uint8_t* data,
                                      size_t         len,
                                      bool           forceExtended)
 {
-    CAN_TxHeaderTypeDef head = BuildTxHeader(addr, len, forceExtended);
-
-    if (!WaitForFreeMailbox())
+    Can::Status status = TransmitFrame(Can::TxFrame(addr, data, len, forceExtended));
+    if (status != Can::Status::ERROR_NONE)
     {
-        LOG_ERROR("In %s::TransmitFrame: Timed out before a Tx mailbox is free", m_label.c_str());
-        return Can::Status::TX_ERROR;
+        LOG_ERROR("In %s::TransmitFrame: Tx queue is full", m_label.c_str());
     }
+    return status;
+}
 
-    uint32_t buffNum = 0;
+/**
+ * Queues a frame for transmission. Can be called from an interrupt.
+ *
+ * @return Can::Status::TX_ERROR if the queue is full.
+ */
+Can::Status CanModule::TransmitFrame(const Can::TxFrame& frame)
+{
+    System::CriticalSection lock;
+    bool                    queued = m_txQueue.Push(frame);
+    FillMailboxes();
+    return queued ? Can::Status::ERROR_NONE : Can::Status::TX_ERROR;
+}
 
-    // Add frame to the mailbox.
-    // Using const_cast here because data.data() is a const uint8_t* and not an uint8_t*.
-    if (HAL_CAN_AddTxMessage(m_handle, &head, const_cast<uint8_t*>(data), &buffNum) != HAL_OK)
-    {
-        LOG_ERROR("In %s::TransmitFrame: Unable to add frame to mailbox", m_label.c_str());
-        return Can::Status::TX_ERROR;
-    }
+Can::TxStats CanModule::GetTxStats() const
+{
+    System::CriticalSection lock;
+    return m_txQueue.Stats();
+}
 
-    return Can::Status::ERROR_NONE;
+void CanModule::ResetTxStats()
+{
+    System::CriticalSection lock;
+    m_txQueue.ResetStats();
 }
 
 void CanModule::SetCallback(Can::Irq irq, const Callback& callback)
 {
     if (callback)
     {
-        m_callbacks[irq] = callback;
+        m_callbacks[IrqToIndex(irq)] = callback;
     }
 }
 
 void CanModule::ClearCallback(Can::Irq irq)
 {
     // Empty but valid function.
-    m_callbacks[irq] = [](const CanModule&) {};
+    m_callbacks[IrqToIndex(irq)] = [](const CanModule&) {};
 }
 
 void CanModule::EnableInterrupt(Can::Irq irq)
@@ -177,17 +324,40 @@ void CanModule::DisableInterrupt(Can::Irq irq)
 
 void CanModule::HandleFrameReception(Can::RxFifo fifo)
 {
-    Can::Frame frame {};
-    HAL_CAN_GetRxMessage(m_handle, (uint32_t)fifo, &frame.frame, frame.data.data());
-    frame.timestamp = GetTime();
+    // Everything pending in the hardware FIFO (at most 3 frames) is read on each interrupt, with
+    // the time of the interrupt.
+    uint32_t timestamp = GetTime();
+    while (HAL_CAN_GetRxFifoFillLevel(m_handle, (uint32_t)fifo) != 0)
+    {
+        Can::Frame frame {};
+        if (HAL_CAN_GetRxMessage(m_handle, (uint32_t)fifo, &frame.frame, frame.data.data()) !=
+            HAL_OK)
+        {
+            break;
+        }
+        frame.timestamp = timestamp;
 
-    m_framesReceived.push_back(frame);
+        const Can::FrameHandler* handler = m_filterTable.Find(fifo, frame.frame.FilterMatchIndex);
+        if (handler != nullptr)
+        {
+            (*handler)(frame);
+        }
+        else
+        {
+            // Dropped and counted if the ring is full.
+            m_rxQueue.Push(fifo, frame);
+        }
+    }
 
     switch (fifo)
     {
-        case Can::RxFifo::Fifo0: m_callbacks[Can::Irq::Fifo0MessagePending](*this); break;
-        case Can::RxFifo::Fifo1: m_callbacks[Can::Irq::Fifo1MessagePending](*this); break;
-        default: CEP_ASSERT(false, "In %s::HandleFrameReception, invalid FIFO!", m_label.c_str());
+        case Can::RxFifo::Fifo0:
+            m_callbacks[IrqToIndex(Can::Irq::Fifo0MessagePending)](*this);
+            break;
+        case Can::RxFifo::Fifo1:
+            m_callbacks[IrqToIndex(Can::Irq::Fifo1MessagePending)](*this);
+            break;
+        default: NILAI_ASSERT(false, "In %s::HandleFrameReception, invalid FIFO!", m_label.c_str());
     }
 }
 
@@ -229,89 +399,183 @@ CAN_FilterTypeDef CanModule::AssertAndConvertFilterStruct(const Can::FilterConfi
     filter.FilterMode           = (uint32_t)config.mode;
     filter.FilterScale          = (uint32_t)config.scale;
     filter.FilterActivation     = (uint32_t)config.activate;
-    filter.SlaveStartFilterBank = 0;
+    // The banks after these belong to the second CAN, if any. 14 is the value after a reset.
+    filter.SlaveStartFilterBank = NILAI_CAN_FILTER_BANKS;
 
     return filter;
 }
 
-bool CanModule::WaitForFreeMailbox()
+/**
+ * Loads the queued frames into the free mailboxes, by order of priority. Must be called with the
+ * interrupts masked.
+ */
+void CanModule::FillMailboxes()
 {
-    uint32_t timeout = GetTime() + CanModule::s_timeout;
+    while (HAL_CAN_GetTxMailboxesFreeLevel(m_handle) != 0)
+    {
+        const Can::TxFrame* next = m_txQueue.Top();
+        if (next == nullptr)
+        {
+            return;
+        }
+
+        // Pending mailboxes with the same identifier are sent by mailbox number, not in the order
+        // they were loaded. The frame waits for the previous one to be sent, to stay in order.
+        uint32_t priority = next->Priority();
+        for (size_t i = 0; i < s_mailboxCount; i++)
+        {
+            if ((m_txPending & (CAN_TX_MAILBOX0 << i)) != 0 && m_txPriorities[i] == priority)
+            {
+                return;
+            }
+        }
+
+        CAN_TxHeaderTypeDef head    = BuildTxHeader(next->Id, next->Len, next->Extended);
+        uint32_t            mailbox = 0;
+        // Using const_cast here because the HAL takes a uint8_t* even though it only reads it.
+        if (HAL_CAN_AddTxMessage(
+              m_handle, &head, const_cast<uint8_t*>(next->Data.data()), &mailbox) != HAL_OK)
+        {
+            return;
+        }
+
+        m_txPending |= mailbox;
+        m_txPriorities[static_cast<size_t>(std::countr_zero(mailbox))] = priority;
+        m_txQueue.Pop();
+    }
+}
 
-    while (GetTime() <= timeout)
+void CanModule::HandleMailboxDone(uint32_t mailbox, bool sent)
+{
     {
-        if (HAL_CAN_GetTxMailboxesFreeLevel(m_handle) != 0)
+        System::CriticalSection lock;
+        m_txPending &= ~mailbox;
+        if (sent)
+        {
+            m_txQueue.OnSent();
+        }
+        else
         {
-            return true;
+            m_txQueue.OnAborted();
         }
+        FillMailboxes();
     }
 
-    return false;
+    m_callbacks[IrqToIndex(Can::Irq::TxMailboxEmpty)](*this);
+}
+
+size_t CanModule::IrqToIndex(Can::Irq irq)
+{
+    switch (irq)
+    {
+        case Can::Irq::TxMailboxEmpty: return 0;
+        case Can::Irq::Fifo0MessagePending: return 1;
+        case Can::Irq::Fifo0Full: return 2;
+        case Can::Irq::Fifo0Overrun: return 3;
+        case Can::Irq::Fifo1MessagePending: return 4;
+        case Can::Irq::Fifo1Full: return 5;
+        case Can::Irq::Fifo1Overrun: return 6;
+        case Can::Irq::Wakeup: return 7;
+        case Can::Irq::SleepAck: return 8;
+        case Can::Irq::ErrorWarning: return 9;
+        case Can::Irq::ErrorPassive: return 10;
+        case Can::Irq::BusOffError: return 11;
+        case Can::Irq::LastErrorCode: return 12;
+        case Can::Irq::ErrorStatus:
+        default: return 13;
+    }
+}
+
+CanModule* CanModule::FindModule(CAN_HandleTypeDef* can)
+{
+    for (CanModule* module : s_modules)
+    {
+        if (module != nullptr && module->m_handle == can)
+        {
+            return module;
+        }
+    }
+    NILAI_ASSERT(false, "No CAN module for this handle!");
+    return nullptr;
 }
 
 void CanModule::CanTxMailbox0CpltCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX0, true);
 }
 
 void CanModule::CanTxMailbox1CpltCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX1, true);
 }
 
 void CanModule::CanTxMailbox2CpltCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX2, true);
 }
 
 void CanModule::CanTxMailbox0AbortCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX0, false);
 }
 
 void CanModule::CanTxMailbox1AbortCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX1, false);
 }
 
 void CanModule::CanTxMailbox2AbortCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::TxMailboxEmpty](*this);
+    FindModule(can)->HandleMailboxDone(CAN_TX_MAILBOX2, false);
 }
 
 void CanModule::CanRxFifo0MsgPendingCb(CAN_HandleTypeDef* can)
 {
-    HandleFrameReception(Can::RxFifo::Fifo0);
+    FindModule(can)->HandleFrameReception(Can::RxFifo::Fifo0);
 }
 
 void CanModule::CanRxFifo0FullCallback(CAN_HandleTypeDef* can)
 {
-    HandleFrameReception(Can::RxFifo::Fifo0);
+    FindModule(can)->HandleFrameReception(Can::RxFifo::Fifo0);
 }
 
 void CanModule::CanRxFifo1MsgPendingCb(CAN_HandleTypeDef* can)
 {
-    HandleFrameReception(Can::RxFifo::Fifo1);
+    FindModule(can)->HandleFrameReception(Can::RxFifo::Fifo1);
 }
 
 void CanModule::CanRxFifo1FullCallback(CAN_HandleTypeDef* can)
 {
-    HandleFrameReception(Can::RxFifo::Fifo1);
+    FindModule(can)->HandleFrameReception(Can::RxFifo::Fifo1);
 }
 
 void CanModule::CanSleepCallback(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::SleepAck](*this);
+    CanModule* module = FindModule(can);
+    module->m_callbacks[IrqToIndex(Can::Irq::SleepAck)](*module);
 }
 
 void CanModule::CanWakeUpFromRxCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::Wakeup](*this);
+    CanModule* module = FindModule(can);
+    module->m_callbacks[IrqToIndex(Can::Irq::Wakeup)](*module);
 }
 
 void CanModule::CanErrorCb(CAN_HandleTypeDef* can)
 {
-    s_modules[can]->m_callbacks[Can::Irq::ErrorStatus](*this);
+    CanModule* module = FindModule(can);
+    // The HAL accumulates the errors, only the overruns that haven't been counted yet are set.
+    if ((can->ErrorCode & HAL_CAN_ERROR_RX_FOV0) != 0)
+    {
+        module->m_rxQueue.OnOverrun(Can::RxFifo::Fifo0);
+    }
+    if ((can->ErrorCode & HAL_CAN_ERROR_RX_FOV1) != 0)
+    {
+        module->m_rxQueue.OnOverrun(Can::RxFifo::Fifo1);
+    }
+    can->ErrorCode = can->ErrorCode & ~(HAL_CAN_ERROR_RX_FOV0 | HAL_CAN_ERROR_RX_FOV1);
+
+    module->m_callbacks[IrqToIndex(Can::Irq::ErrorStatus)](*module);
 }
 
 #    if !defined(NILAI_CAN_REGISTER_CALLBACKS)
@@ -21,12 +21,17 @@
 #            include "../defines/module.h"
 
 #            include "CAN/enums.h"
+#            include "CAN/filter_table.h"
+#            include "CAN/isotp.h"
+#            include "CAN/rx_queue.h"
 #            include "CAN/structs.h"
+#            include "CAN/tx_queue.h"
 
 #            include <array>
 #            include <cstdint>
 #            include <functional>
 #            include <map>
+#            include <span>
 #            include <vector>
 
 /*************************************************************************************************/
@@ -38,6 +43,18 @@
 #                define NILAI_CAN_REGISTER_CALLBACKS
 #            endif
 
+#            if !defined(NILAI_CAN_RX_RING_SIZE)
+#                define NILAI_CAN_RX_RING_SIZE 32
+#            endif
+
+#            if !defined(NILAI_CAN_TX_QUEUE_SIZE)
+#                define NILAI_CAN_TX_QUEUE_SIZE 16
+#            endif
+
+#            if !defined(NILAI_CAN_FILTER_BANKS)
+#                define NILAI_CAN_FILTER_BANKS 14
+#            endif
+
 /*************************************************************************************************/
 /* Enumerated Types
  * ----------------------------------------------------------------------------
@@ -61,8 +78,52 @@ public:
 
     void ConfigureFilter(const Can::FilterConfiguration& config);
 
-    [[nodiscard]] size_t     GetNumberOfAvailableFrames() const { return m_framesReceived.size(); }
+    static constexpr size_t s_invalidSubscription =
+      Can::FilterTable<NILAI_CAN_FILTER_BANKS>::s_invalidBank;
+
+    /**
+     * @brief Calls a handler with every frame whose identifier matches, from the receive
+     * interrupt.
+     *
+     * A filter bank is configured for the subscription. The frames it accepts are given to the
+     * handler through the filter match index reported by the hardware, without being compared to
+     * the other subscriptions and without going through @ref ReceiveFrame.
+     *
+     * @param id The identifier to match.
+     * @param mask The bits of the identifier that must match, all of them by default.
+     * @param handler The handler, called from the interrupt context.
+     * @param extended True to match extended identifiers, false for standard ones.
+     * @param fifo The FIFO in which the frames are received.
+     * @return The ID of the subscription, or @ref s_invalidSubscription if no filter bank is
+     * free.
+     */
+    size_t Subscribe(uint32_t                   id,
+                     uint32_t                   mask,
+                     const Can::FrameHandler&   handler,
+                     bool                       extended = false,
+                     Can::FilterFifoAssignation fifo     = Can::FilterFifoAssignation::Fifo0);
+    /**
+     * @brief Routes the frames sent by the other node of an ISO-TP channel to it.
+     *
+     * The channel must have been constructed with @ref SendFrame and this module.
+     * Can::IsoTp::Run must still be called from the main loop.
+     *
+     * @return The ID of the subscription, or @ref s_invalidSubscription if no filter bank is
+     * free.
+     */
+    size_t Subscribe(Can::IsoTp& channel);
+    void   Unsubscribe(size_t subscription);
+
+    [[nodiscard]] size_t GetNumberOfAvailableFrames() const { return m_rxQueue.Size(); }
+    [[nodiscard]] size_t GetNumberOfAvailableFrames(Can::RxFifo fifo) const
+    {
+        return m_rxQueue.Size(fifo);
+    }
     [[nodiscard]] Can::Frame ReceiveFrame();
+    size_t                   ReceiveFrames(std::span<Can::Frame> frames);
+    size_t                   ReceiveFrames(std::span<Can::Frame> frames, Can::RxFifo fifo);
+    [[nodiscard]] Can::RxStats GetRxStats(Can::RxFifo fifo) const { return m_rxQueue.Stats(fifo); }
+
     Can::Status              TransmitFrame(uint32_t                    addr,
                                            const std::vector<uint8_t>& data = std::vector<uint8_t>(),
                                            bool                        forceExtended = false);
@@ -70,6 +131,19 @@ public:
                                            const uint8_t* data          = nullptr,
                                            size_t         len           = 0,
                                            bool           forceExtended = false);
+    Can::Status              TransmitFrame(const Can::TxFrame& frame);
+
+    /**
+     * @brief Queues a frame on a module, in the format of Can::IsoTp::SendFunc.
+     * @param module The CanModule.
+     */
+    static bool SendFrame(void* module, const Can::TxFrame& frame)
+    {
+        return static_cast<CanModule*>(module)->TransmitFrame(frame) == Can::Status::ERROR_NONE;
+    }
+
+    [[nodiscard]] Can::TxStats GetTxStats() const;
+    void                       ResetTxStats();
 
     void SetCallback(Can::Irq irq, const Callback& callback);
     void ClearCallback(Can::Irq irq);
@@ -93,9 +167,12 @@ public:
 
 private:
     static CAN_FilterTypeDef   AssertAndConvertFilterStruct(const Can::FilterConfiguration& config);
-    bool                       WaitForFreeMailbox();
+    void                       FillMailboxes();
+    void                       HandleMailboxDone(uint32_t mailbox, bool sent);
     void                       HandleFrameReception(Can::RxFifo fifo);
     static CAN_TxHeaderTypeDef BuildTxHeader(uint32_t addr, size_t len, bool forceExtended);
+    static size_t              IrqToIndex(Can::Irq irq);
+    static CanModule*          FindModule(CAN_HandleTypeDef* can);
 
 #            if !defined(NILAI_CAN_REGISTER_CALLBACKS)
 public:
@@ -119,11 +196,19 @@ private:
     std::string        m_label;
     Can::Status        m_status = Can::Status::ERROR_NONE;
 
-    std::vector<Can::Frame>                      m_framesReceived;
-    std::map<Can::Irq, Callback>                 m_callbacks;
+    static constexpr size_t s_irqCount     = 14;
+    static constexpr size_t s_mailboxCount = 3;
+
+    Can::RxQueue<NILAI_CAN_RX_RING_SIZE>         m_rxQueue;
+    std::array<Callback, s_irqCount>             m_callbacks;
     std::map<uint64_t, Can::FilterConfiguration> m_filters;
+    Can::FilterTable<NILAI_CAN_FILTER_BANKS>     m_filterTable;
 
-    static constexpr uint32_t s_timeout = 15;
+    Can::TxQueue<NILAI_CAN_TX_QUEUE_SIZE> m_txQueue;
+    //! Priority of the frame in each transmit mailbox.
+    std::array<uint32_t, s_mailboxCount> m_txPriorities = {};
+    //! Mailboxes in which a frame is pending, as CAN_TX_MAILBOXx flags.
+    uint32_t m_txPending = 0;
 };
 }    // namespace Nilai::Drivers
 #        else
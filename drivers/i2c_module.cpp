@@ -15,14 +15,61 @@
 
 #if defined(NILAI_USE_I2C)
 #    include "../services/logger.h"
+
+#    include <algorithm>
 #    include <utility>
 
 #    define I2C_INFO(msg, ...)  LOG_INFO("[%s]: " msg, m_label.data(), ##__VA_ARGS__)
 #    define I2C_ERROR(msg, ...) LOG_ERROR("[%s]: " msg, m_label.data(), ##__VA_ARGS__)
 
+#    if defined(NILAI_I2C_USE_QUEUE)
+#        include "../services/time.h"
+
+#        if defined(NILAI_USE_EXPERIMENTAL) && defined(NILAI_USE_I2C_EVENTS)
+#            error NILAI_I2C_USE_QUEUE and NILAI_USE_I2C_EVENTS both need the I2C HAL callbacks!
+#        endif
+
+//! Returns from the blocking function if the queued jobs are still running after the timeout.
+#        define I2C_WAIT_FOR_QUEUE(...)                                                            \
+            do                                                                                     \
+            {                                                                                      \
+                if (!WaitForQueue())                                                               \
+                {                                                                                  \
+                    I2C_ERROR("Queued jobs still running");                                        \
+                    return __VA_ARGS__;                                                            \
+                }                                                                                  \
+            } while (0)
+#    else
+#        define I2C_WAIT_FOR_QUEUE(...)                                                            \
+            do                                                                                     \
+            {                                                                                      \
+            } while (0)
+#    endif
 
 namespace Nilai::Drivers
 {
+#    if defined(NILAI_I2C_USE_QUEUE)
+std::array<I2cModule*, NILAI_I2C_MAX_MODULES> I2cModule::s_i2cs = {};
+
+I2cModule::I2cModule(Handle* handle, std::string_view label) noexcept
+: m_handle(handle), m_label(label), m_queue(&I2cModule::StartJob, this)
+{
+    NILAI_ASSERT(handle != nullptr, "In I2cModule: handle is NULL!");
+    auto slot = std::find(s_i2cs.begin(), s_i2cs.end(), nullptr);
+    // Its interrupts would never reach it, its jobs would never complete.
+    NILAI_ASSERT(slot != s_i2cs.end(), "In I2cModule: too many modules, see NILAI_I2C_MAX_MODULES");
+    if (slot != s_i2cs.end())
+    {
+        *slot = this;
+    }
+}
+
+I2cModule::~I2cModule()
+{
+    std::replace(s_i2cs.begin(), s_i2cs.end(), this, static_cast<I2cModule*>(nullptr));
+}
+#    endif
+
 /**
  * If the initialization passed, the POST passes.
  * @return
@@ -39,6 +86,7 @@ void I2cModule::Run()
 
 void I2cModule::TransmitFrame(uint8_t addr, const uint8_t* data, size_t len)
 {
+    I2C_WAIT_FOR_QUEUE();
     if (HAL_I2C_Master_Transmit(m_handle,
                                 addr,
                                 const_cast<uint8_t*>(data),
@@ -49,11 +97,12 @@ void I2cModule::TransmitFrame(uint8_t addr, const uint8_t* data, size_t len)
     }
 }
 
-void I2cModule::TransmitFrameToRegister(uint8_t        addr,
+bool I2cModule::TransmitFrameToRegister(uint8_t        addr,
                                         uint8_t        regAddr,
                                         const uint8_t* data,
                                         size_t         len)
 {
+    I2C_WAIT_FOR_QUEUE(false);
     if (HAL_I2C_Mem_Write(m_handle,
                           addr,
                           regAddr,
@@ -63,12 +112,15 @@ void I2cModule::TransmitFrameToRegister(uint8_t        addr,
                           I2cModule::TIMEOUT) != HAL_OK)
     {
         I2C_ERROR("Unable to transmit frame to register");
+        return false;
     }
+    return true;
 }
 
 I2C::Frame I2cModule::ReceiveFrame(uint8_t addr, size_t len)
 {
     I2C::Frame frame;
+    I2C_WAIT_FOR_QUEUE(frame);
 
     frame.deviceAddress = addr;
     // Allocate memory for the data.
@@ -89,6 +141,7 @@ I2C::Frame I2cModule::ReceiveFrame(uint8_t addr, size_t len)
 I2C::Frame I2cModule::ReceiveFrameFromRegister(uint8_t addr, uint8_t regAddr, size_t len)
 {
     I2C::Frame frame;
+    I2C_WAIT_FOR_QUEUE(frame);
 
     frame.deviceAddress   = addr;
     frame.registerAddress = regAddr;
@@ -108,10 +161,138 @@ I2C::Frame I2cModule::ReceiveFrameFromRegister(uint8_t addr, uint8_t regAddr, si
     return frame;
 }
 
+bool I2cModule::ReceiveFrameFromRegister(uint8_t addr, uint8_t regAddr, std::span<uint8_t> out)
+{
+    I2C_WAIT_FOR_QUEUE(false);
+    if (HAL_I2C_Mem_Read(m_handle,
+                         addr,
+                         regAddr,
+                         sizeof(regAddr),
+                         out.data(),
+                         static_cast<uint16_t>(out.size()),
+                         I2cModule::TIMEOUT) != HAL_OK)
+    {
+        I2C_ERROR("Unable to receive frame from register");
+        return false;
+    }
+    return true;
+}
+
 bool I2cModule::CheckIfDevOnBus(uint8_t addr, size_t attempts, size_t timeout)
 {
+    I2C_WAIT_FOR_QUEUE(false);
     return HAL_I2C_IsDeviceReady(m_handle, addr, attempts, timeout) == HAL_OK;
 }
+
+#    if defined(NILAI_I2C_USE_QUEUE)
+void I2cModule::TransferCpltCallback(I2C_HandleTypeDef* handle) noexcept
+{
+    I2cModule* module = FindModule(handle);
+    if (module != nullptr)
+    {
+        module->m_queue.OnComplete(true);
+    }
+}
+
+void I2cModule::TransferErrorCallback(I2C_HandleTypeDef* handle) noexcept
+{
+    I2cModule* module = FindModule(handle);
+    if (module != nullptr)
+    {
+        // Logging isn't possible from here, the failure is counted in the queue's statistics.
+        module->m_queue.OnComplete(false);
+    }
+}
+
+bool I2cModule::WaitForQueue() noexcept
+{
+    uint32_t start = GetTime();
+    while (m_queue.Busy())
+    {
+        if (GetTime() - start >= TIMEOUT)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool I2cModule::StartJob(void* ctx, const I2c::Job& job, I2c::JobStep step) noexcept
+{
+    auto*              module = static_cast<I2cModule*>(ctx);
+    I2C_HandleTypeDef* handle = module->m_handle;
+    auto*              tx     = const_cast<uint8_t*>(job.Tx.data());
+    auto               txLen  = static_cast<uint16_t>(job.Tx.size());
+    uint8_t*           rx     = job.Rx.data();
+    auto               rxLen  = static_cast<uint16_t>(job.Rx.size());
+    uint16_t           addr   = job.Address;
+
+    HAL_StatusTypeDef status;
+    if (job.UseRegister && step == I2c::JobStep::Write)
+    {
+        status = HAL_I2C_Mem_Write_DMA(handle, addr, job.Register, I2C_MEMADD_SIZE_8BIT, tx, txLen);
+    }
+    else if (job.UseRegister)
+    {
+        status = HAL_I2C_Mem_Read_DMA(handle, addr, job.Register, I2C_MEMADD_SIZE_8BIT, rx, rxLen);
+    }
+    else if (step == I2c::JobStep::Write && job.Rx.empty())
+    {
+        status = HAL_I2C_Master_Transmit_DMA(handle, addr, tx, txLen);
+    }
+    else if (step == I2c::JobStep::Write)
+    {
+        // Something is read next, the bus is kept for the repeated start.
+        status = HAL_I2C_Master_Seq_Transmit_DMA(handle, addr, tx, txLen, I2C_FIRST_FRAME);
+    }
+    else if (job.Tx.empty())
+    {
+        status = HAL_I2C_Master_Receive_DMA(handle, addr, rx, rxLen);
+    }
+    else
+    {
+        status = HAL_I2C_Master_Seq_Receive_DMA(handle, addr, rx, rxLen, I2C_LAST_FRAME);
+    }
+    return status == HAL_OK;
+}
+
+I2cModule* I2cModule::FindModule(I2C_HandleTypeDef* handle) noexcept
+{
+    for (auto&& module : s_i2cs)
+    {
+        if (module != nullptr && module->m_handle == handle)
+        {
+            return module;
+        }
+    }
+    return nullptr;
+}
+
+extern "C" void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2cModule::TransferCpltCallback(hi2c);
+}
+
+extern "C" void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2cModule::TransferCpltCallback(hi2c);
+}
+
+extern "C" void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2cModule::TransferCpltCallback(hi2c);
+}
+
+extern "C" void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2cModule::TransferCpltCallback(hi2c);
+}
+
+extern "C" void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c)
+{
+    I2cModule::TransferErrorCallback(hi2c);
+}
+#    endif
 }    // namespace Nilai::Drivers
 
 #endif
@@ -41,6 +41,21 @@
 #            include "I2C/enums.h"
 #            include "I2C/structs.h"
 
+#            if defined(NILAI_I2C_USE_QUEUE)
+#                include "I2C/job_queue.h"
+#                include "I2C/write_batch.h"
+
+#                include <array>
+
+#                if !defined(NILAI_I2C_QUEUE_DEPTH)
+#                    define NILAI_I2C_QUEUE_DEPTH 8
+#                endif
+#                if !defined(NILAI_I2C_MAX_MODULES)
+#                    define NILAI_I2C_MAX_MODULES 4
+#                endif
+#            endif
+
+#            include <span>
 #            include <string_view>
 #            include <vector>
 
@@ -53,10 +68,20 @@ namespace Nilai::Drivers
  */
 class I2cModule : public Module
 {
+#            if defined(NILAI_I2C_USE_QUEUE)
+    using queue_t = I2c::JobQueue<NILAI_I2C_QUEUE_DEPTH>;
+#            endif
+
 public:
     using Handle = I2C_HandleTypeDef;
 
 public:
+#            if defined(NILAI_I2C_USE_QUEUE)
+    I2cModule(Handle* handle, std::string_view label) noexcept;
+    I2cModule(const I2cModule&)            = delete;
+    I2cModule& operator=(const I2cModule&) = delete;
+    ~I2cModule() override;
+#            else
     constexpr I2cModule() noexcept                  = default;
     constexpr I2cModule(const I2cModule&) noexcept  = default;
     constexpr I2cModule(I2cModule&&) noexcept       = default;
@@ -69,6 +94,7 @@ public:
     }
 
     constexpr ~I2cModule() override = default;
+#            endif
 
     bool                                     DoPost() override;
     void                                     Run() override;
@@ -84,19 +110,28 @@ public:
         TransmitFrame(frame.deviceAddress, frame.data.data(), frame.data.size());
     }
 
-    void TransmitFrameToRegister(uint8_t addr, uint8_t regAddr, const uint8_t* data, size_t len);
-    void TransmitFrameToRegister(uint8_t addr, uint8_t regAddr, const std::vector<uint8_t>& data)
+    /**
+     * @brief Writes to a register of a device.
+     * @returns True if the write succeeded.
+     */
+    bool TransmitFrameToRegister(uint8_t addr, uint8_t regAddr, const uint8_t* data, size_t len);
+    bool TransmitFrameToRegister(uint8_t addr, uint8_t regAddr, const std::vector<uint8_t>& data)
     {
-        TransmitFrameToRegister(addr, regAddr, data.data(), data.size());
+        return TransmitFrameToRegister(addr, regAddr, data.data(), data.size());
     }
-    void TransmitFrameToRegister(const I2C::Frame& frame)
+    bool TransmitFrameToRegister(const I2C::Frame& frame)
     {
-        TransmitFrameToRegister(
+        return TransmitFrameToRegister(
           frame.deviceAddress, frame.registerAddress, frame.data.data(), frame.data.size());
     }
 
     I2C::Frame ReceiveFrame(uint8_t addr, size_t len);
     I2C::Frame ReceiveFrameFromRegister(uint8_t addr, uint8_t regAddr, size_t len);
+    /**
+     * @brief Reads from a register into the caller's buffer, without allocating.
+     * @returns True if the read succeeded.
+     */
+    bool ReceiveFrameFromRegister(uint8_t addr, uint8_t regAddr, std::span<uint8_t> out);
 
     /**
      * @brief Checks if a device with the specified address is active on the I2C bus.
@@ -109,11 +144,52 @@ public:
                                                         size_t  attempts = 5,
                                                         size_t  timeout  = 2);
 
+#            if defined(NILAI_I2C_USE_QUEUE)
+    /**
+     * @brief Queues a job, to be run with DMA without blocking the caller.
+     *
+     * Can be called from any context, including the callback of another job. The queued jobs are
+     * run back-to-back, the next one being started from the transfer complete interrupt of the
+     * previous one.
+     *
+     * The blocking functions wait for the queue to be empty before using the bus.
+     *
+     * @param job The job. Its buffers must stay valid until its callback is called.
+     * @returns True if the job was queued.
+     * @returns False if the job is invalid or the queue is full.
+     */
+    bool Submit(const I2c::Job& job) noexcept { return m_queue.Submit(job); }
+    /**
+     * @brief Queues jobs that are run in order, without other jobs in between. Either all of them
+     * are queued, or none.
+     */
+    bool Submit(std::span<const I2c::Job> jobs) noexcept { return m_queue.Submit(jobs); }
+
+    [[nodiscard]] I2c::JobQueueStats GetQueueStats() const noexcept { return m_queue.Stats(); }
+    void                             ResetQueueStats() noexcept { m_queue.ResetStats(); }
+
+    static void TransferCpltCallback(I2C_HandleTypeDef* handle) noexcept;
+    static void TransferErrorCallback(I2C_HandleTypeDef* handle) noexcept;
+#            endif
+
 protected:
     Handle*          m_handle = nullptr;
     std::string_view m_label;
 
     static constexpr uint16_t TIMEOUT = 200;
+
+#            if defined(NILAI_I2C_USE_QUEUE)
+    queue_t m_queue;
+
+    //! The modules that exist, for the interrupts to find theirs. Free slots are nullptr.
+    static std::array<I2cModule*, NILAI_I2C_MAX_MODULES> s_i2cs;
+
+private:
+    bool WaitForQueue() noexcept;
+
+    static bool       StartJob(void* ctx, const I2c::Job& job, I2c::JobStep step) noexcept;
+    static I2cModule* FindModule(I2C_HandleTypeDef* handle) noexcept;
+#            endif
 };
 }    // namespace Nilai::Drivers
 #        else
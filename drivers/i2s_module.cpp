@@ -37,6 +37,8 @@ I2sModule::I2sModule(I2S_HandleTypeDef* handle, std::string label)
     s_modules[handle] = this;
 
     SetStreamingCallbacks();
+    // Everything is done from the interrupts, there's nothing to poll.
+    SetRunOnSignal();
 
     I2S_INFO("Initialized.");
 }
@@ -75,7 +77,11 @@ void I2sModule::TxHalfCplt()
 
 void I2sModule::TxCplt()
 {
-    m_isStreaming = false;
+    // In circular mode, the DMA keeps going.
+    if (!IsTxCircular())
+    {
+        m_isStreaming = false;
+    }
     m_txCpltCb();
 }
 
@@ -176,6 +182,23 @@ bool I2sModule::StopStream()
     return true;
 }
 
+bool I2sModule::IsTxCircular() const
+{
+    return m_handle->hdmatx != nullptr && m_handle->hdmatx->Init.Mode == DMA_CIRCULAR;
+}
+
+std::optional<size_t> I2sModule::GetTxRemainingBytes() const
+{
+    if (m_handle->hdmatx == nullptr)
+    {
+        return std::nullopt;
+    }
+    // The DMA counts the data items of the peripheral.
+    uint32_t align = m_handle->hdmatx->Init.PeriphDataAlignment;
+    size_t   item  = align == DMA_PDATAALIGN_WORD ? 4 : align == DMA_PDATAALIGN_HALFWORD ? 2 : 1;
+    return __HAL_DMA_GET_COUNTER(m_handle->hdmatx) * item;
+}
+
 void I2sModule::StartClock()
 {
     // Constantly send nothing to generate the clocks for I2S.
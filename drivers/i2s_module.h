@@ -27,6 +27,7 @@
 #            include "I2S/enums.h"
 
 #            include <functional>
+#            include <optional>
 #            include <map>
 #            include <string>
 
@@ -54,6 +55,8 @@ public:
 
     void SetTxHalfCpltCb(const std::function<void()>& cb) override;
     void SetTxCpltCb(const std::function<void()>& cb) override;
+    [[nodiscard]] std::function<void()> GetTxHalfCpltCb() const override { return m_txHalfCpltCb; }
+    [[nodiscard]] std::function<void()> GetTxCpltCb() const override { return m_txCpltCb; }
 
     [[nodiscard]] bool IsStreaming() const override { return m_isStreaming; }
     /**
@@ -83,6 +86,9 @@ public:
      */
     bool StopStream() override;
 
+    [[nodiscard]] bool IsTxCircular() const override;
+    [[nodiscard]] std::optional<size_t> GetTxRemainingBytes() const override;
+
     /**
      * @brief Helper function to retrieve the HAL handle.
      */
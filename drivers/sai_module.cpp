@@ -104,6 +104,23 @@ void SaiModule::SetSampleRate(Sai::SamplingRate sr)
     NILAI_ASSERT(s == HAL_OK, "Unable to re-init SAI!");
 }
 
+bool SaiModule::IsTxCircular() const
+{
+    return m_handle->hdmatx != nullptr && m_handle->hdmatx->Init.Mode == DMA_CIRCULAR;
+}
+
+std::optional<size_t> SaiModule::GetTxRemainingBytes() const
+{
+    if (m_handle->hdmatx == nullptr)
+    {
+        return std::nullopt;
+    }
+    // The DMA counts the data items of the peripheral.
+    uint32_t align = m_handle->hdmatx->Init.PeriphDataAlignment;
+    size_t   item  = align == DMA_PDATAALIGN_WORD ? 4 : align == DMA_PDATAALIGN_HALFWORD ? 2 : 1;
+    return __HAL_DMA_GET_COUNTER(m_handle->hdmatx) * item;
+}
+
 void SaiModule::StartClock()
 {
     // Constantly send nothing to generate the clocks.
@@ -232,7 +249,11 @@ void SaiModule::TxHalfCplt()
 
 void SaiModule::TxCplt()
 {
-    m_isStreaming = false;
+    // In circular mode, the DMA keeps going.
+    if (!IsTxCircular())
+    {
+        m_isStreaming = false;
+    }
     m_txCpltCb();
 }
 
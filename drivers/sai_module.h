@@ -29,6 +29,7 @@
 #            include "SAI/enums.h"
 
 #            include <functional>
+#            include <optional>
 #            include <string>
 
 #            include <map>
@@ -66,6 +67,8 @@ public:
 
     void SetTxHalfCpltCb(const std::function<void()>& cb) override;
     void SetTxCpltCb(const std::function<void()>& cb) override;
+    [[nodiscard]] std::function<void()> GetTxHalfCpltCb() const override { return m_txHalfCpltCb; }
+    [[nodiscard]] std::function<void()> GetTxCpltCb() const override { return m_txCpltCb; }
 
     [[nodiscard]] bool IsStreaming() const override { return m_isStreaming; }
 
@@ -96,6 +99,9 @@ public:
      */
     bool StopStream() override;
 
+    [[nodiscard]] bool IsTxCircular() const override;
+    [[nodiscard]] std::optional<size_t> GetTxRemainingBytes() const override;
+
     /**
      * @brief Helper function to retrieve the HAL handle.
      */
@@ -15,6 +15,7 @@
 #if defined(NILAI_USE_SPI) && defined(HAL_SPI_MODULE_ENABLED)
 #    include "../processes/application.h"
 
+#    include <algorithm>
 #    include <vector>
 
 /*************************************************************************************************/
@@ -24,20 +25,47 @@
 #    define SPI_INFO(msg, ...)  LOG_INFO("[%s]: " msg, m_label.c_str() __VA_OPT__(, ) __VA_ARGS__)
 #    define SPI_ERROR(msg, ...) LOG_ERROR("[%s]: " msg, m_label.c_str() __VA_OPT__(, ) __VA_ARGS__)
 
+#    if defined(NILAI_SPI_USE_QUEUE) && defined(NILAI_USE_EXPERIMENTAL) &&                         \
+      defined(NILAI_USE_SPI_EVENTS)
+#        error NILAI_SPI_USE_QUEUE and NILAI_USE_SPI_EVENTS both need the SPI HAL callbacks!
+#    endif
+
 namespace Nilai::Drivers
 {
+#    if defined(NILAI_SPI_USE_QUEUE)
+std::array<SpiModule*, NILAI_SPI_MAX_MODULES> SpiModule::s_spis = {};
+#    endif
+
 /*************************************************************************************************/
 /* Public function definitions
  * --------------------------------------------------------------- */
 SpiModule::SpiModule(SPI_HandleTypeDef* handle, std::string_view label) noexcept
-: m_label(label), m_handle(handle)
+: m_label(label),
+  m_handle(handle)
+#    if defined(NILAI_SPI_USE_QUEUE)
+  ,
+  m_queue(&SpiModule::StartTransfer, this)
+#    endif
 {
     NILAI_ASSERT(handle != nullptr, "Handle is NULL!");
+#    if defined(NILAI_SPI_USE_QUEUE)
+    auto slot = std::find(s_spis.begin(), s_spis.end(), nullptr);
+    // Its interrupts would never reach it, its transactions would never complete.
+    NILAI_ASSERT(slot != s_spis.end(), "Too many modules, see NILAI_SPI_MAX_MODULES");
+    if (slot != s_spis.end())
+    {
+        *slot = this;
+    }
+#    endif
     SPI_INFO("Initialized");
 }
 
 SpiModule::~SpiModule() noexcept
 {
+#    if defined(NILAI_SPI_USE_QUEUE)
+    std::replace(s_spis.begin(), s_spis.end(), this, static_cast<SpiModule*>(nullptr));
+#    endif
+
     /* Abort ongoing messages on SPI peripheral */
     if (HAL_SPI_Abort_IT(m_handle) != HAL_OK)
     {
@@ -148,6 +176,27 @@ SPI::Status SpiModule::Transaction(const std::vector<uint8_t>& txData,
     return Transaction(txData.data(), txData.size(), rxData.data(), rxData.size());
 }
 
+#    if defined(NILAI_SPI_USE_QUEUE)
+void SpiModule::TransferCpltCallback(SPI_HandleTypeDef* handle) noexcept
+{
+    SpiModule* module = FindModule(handle);
+    if (module != nullptr)
+    {
+        module->m_queue.OnComplete(true);
+    }
+}
+
+void SpiModule::TransferErrorCallback(SPI_HandleTypeDef* handle) noexcept
+{
+    SpiModule* module = FindModule(handle);
+    if (module != nullptr)
+    {
+        // Logging isn't possible from here, the failure is counted in the queue's statistics.
+        module->m_queue.OnComplete(false);
+    }
+}
+#    endif
+
 /*************************************************************************************************/
 /* Private functions definitions
  * --------------------------------------------------------------- */
@@ -200,7 +249,12 @@ bool SpiModule::WaitUntilNotBusy() noexcept
     while (GetTime() <= timeoutTime)
     {
         // Check if the SPI port is ready.
+#    if defined(NILAI_SPI_USE_QUEUE)
+        // The peripheral is briefly ready between two queued transfers.
+        if (!m_queue.Busy() && m_handle->State == HAL_SPI_STATE_READY)
+#    else
         if (m_handle->State == HAL_SPI_STATE_READY)
+#    endif
         {
             return true;
         }
@@ -208,6 +262,63 @@ bool SpiModule::WaitUntilNotBusy() noexcept
 
     return false;
 }
+
+#    if defined(NILAI_SPI_USE_QUEUE)
+bool SpiModule::StartTransfer(void* ctx, const Spi::Transaction& t) noexcept
+{
+    auto*              module = static_cast<SpiModule*>(ctx);
+    SPI_HandleTypeDef* handle = module->m_handle;
+    auto               len    = static_cast<uint16_t>(t.Size());
+
+    HAL_StatusTypeDef status;
+    if (t.Rx.empty())
+    {
+        status = HAL_SPI_Transmit_DMA(handle, const_cast<uint8_t*>(t.Tx.data()), len);
+    }
+    else if (t.Tx.empty())
+    {
+        status = HAL_SPI_Receive_DMA(handle, t.Rx.data(), len);
+    }
+    else
+    {
+        status = HAL_SPI_TransmitReceive_DMA(
+          handle, const_cast<uint8_t*>(t.Tx.data()), t.Rx.data(), len);
+    }
+    return status == HAL_OK;
+}
+
+SpiModule* SpiModule::FindModule(SPI_HandleTypeDef* handle) noexcept
+{
+    for (auto&& module : s_spis)
+    {
+        if (module != nullptr && module->m_handle == handle)
+        {
+            return module;
+        }
+    }
+    return nullptr;
+}
+
+extern "C" void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiModule::TransferCpltCallback(hspi);
+}
+
+extern "C" void HAL_SPI_RxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiModule::TransferCpltCallback(hspi);
+}
+
+extern "C" void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiModule::TransferCpltCallback(hspi);
+}
+
+extern "C" void HAL_SPI_ErrorCallback(SPI_HandleTypeDef* hspi)
+{
+    SpiModule::TransferErrorCallback(hspi);
+}
+#    endif
 }    // namespace Nilai::Drivers
 #endif
 /* ----- END OF FILE ----- */
@@ -24,6 +24,19 @@
 
 #                include "SPI/enums.h"
 
+#                if defined(NILAI_SPI_USE_QUEUE)
+#                    include "SPI/transaction_queue.h"
+
+#                    include <array>
+
+#                    if !defined(NILAI_SPI_QUEUE_DEPTH)
+#                        define NILAI_SPI_QUEUE_DEPTH 8
+#                    endif
+#                    if !defined(NILAI_SPI_MAX_MODULES)
+#                        define NILAI_SPI_MAX_MODULES 6
+#                    endif
+#                endif
+
 #                include <string>
 #                include <string_view>
 #                include <vector>
@@ -61,6 +74,10 @@ namespace Nilai::Drivers
  */
 class SpiModule : public Module
 {
+#                if defined(NILAI_SPI_USE_QUEUE)
+    using queue_t = Spi::TransactionQueue<NILAI_SPI_QUEUE_DEPTH>;
+#                endif
+
 public:
     /**
      * @brief Initializes the SPI module.
@@ -215,6 +232,32 @@ public:
           reinterpret_cast<uint8_t*>(&txData), 2, reinterpret_cast<uint8_t*>(rxData), 2);
     }
 
+#                if defined(NILAI_SPI_USE_QUEUE)
+    /**
+     * @brief Queues a transaction, to be run with DMA without blocking the caller.
+     *
+     * Can be called from any context, including the callback of another transaction. The queued
+     * transactions are run back-to-back, the next one being started from the transfer complete
+     * interrupt of the previous one.
+     *
+     * The blocking functions wait for the queue to be empty before using the bus.
+     *
+     * @param t The transaction. Its buffers must stay valid until its callback is called.
+     * @returns True if the transaction was queued.
+     * @returns False if the transaction is invalid or the queue is full.
+     */
+    bool Submit(const Spi::Transaction& t) noexcept { return m_queue.Submit(t); }
+
+    [[nodiscard]] Spi::TransactionQueueStats GetQueueStats() const noexcept
+    {
+        return m_queue.Stats();
+    }
+    void ResetQueueStats() noexcept { m_queue.ResetStats(); }
+
+    static void TransferCpltCallback(SPI_HandleTypeDef* handle) noexcept;
+    static void TransferErrorCallback(SPI_HandleTypeDef* handle) noexcept;
+#                endif
+
 private:
     std::string        m_label;                         //!< The identifying label of the module.
     SPI_HandleTypeDef* m_handle = nullptr;              //!< Pointer to the hardware peripheral.
@@ -223,9 +266,21 @@ private:
     //! Maximum amount of time that will be waited for the SPI peripheral to become ready.
     constexpr static uint16_t s_timeout = 200;
 
+#                if defined(NILAI_SPI_USE_QUEUE)
+    queue_t m_queue;
+
+    //! The modules that exist, for the interrupts to find theirs. Free slots are nullptr.
+    static std::array<SpiModule*, NILAI_SPI_MAX_MODULES> s_spis;
+#                endif
+
 private:
     void ErrorHandler() noexcept;
     bool WaitUntilNotBusy() noexcept;
+
+#                if defined(NILAI_SPI_USE_QUEUE)
+    static bool       StartTransfer(void* ctx, const Spi::Transaction& t) noexcept;
+    static SpiModule* FindModule(SPI_HandleTypeDef* handle) noexcept;
+#                endif
 };
 }    // namespace Nilai::Drivers
 
@@ -51,8 +51,16 @@ UartModule::UartModule(std::string label, handle_type* uart, size_type txl, size
 
     m_txBuff.resize(txl);
 
+#    if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    m_expectedRxLen = std::min(rxl, static_cast<size_type>(rx_store_t::s_slotSize));
+    m_rxStore.Acquire();
+#    elif defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    // The ring is statically sized, its size is set by NILAI_UART_RX_RING_SIZE.
+    NILAI_UNUSED(rxl);
+#    else
     m_dmaBuff.resize(rxl);
     m_rxBuff.resize(rxl);
+#    endif
 
     if (uart->hdmatx != nullptr)
     {
@@ -70,6 +78,9 @@ UartModule::UartModule(std::string label, handle_type* uart, size_type txl, size
         UART_ERROR("RX DMA not enabled!");
         AssertFailed(reinterpret_cast<const uint8_t*>(__FILE__), __LINE__, 1);
     }
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA) && defined(DMA_CIRCULAR)
+    NILAI_ASSERT(uart->hdmarx->Init.Mode == DMA_CIRCULAR, "RX DMA must be in circular mode!");
+#    endif
 
     StartDma();
     UART_INFO("Uart initialized");
@@ -100,6 +111,33 @@ bool UartModule::DoPost()
 
 void UartModule::Run()
 {
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+    if (!m_txBusy && !m_txQueue.Empty())
+    {
+        // The last attempt to start a transmission failed, try again.
+        KickTransmission();
+    }
+#    endif
+
+#    if defined(NILAI_UART_RX_IN_PLACE)
+    // Frames are committed straight from the interrupt, only the callbacks are left.
+    if (m_viewCb)
+    {
+        for (frame_view_t view = m_rxStore.Pop(); view; view = m_rxStore.Pop())
+        {
+            m_viewCb(view);
+            m_rxStore.Release(view);
+        }
+    }
+    else if (m_cb && m_rxStore.Available() != 0)
+    {
+        frame_view_t         view = m_rxStore.Pop();
+        std::vector<uint8_t> data(view.Size());
+        view.CopyTo(data.data(), data.size());
+        m_cb(Uart::Frame {std::move(data), view.Timestamp});
+        m_rxStore.Release(view);
+    }
+#    else
     if (m_bytesInRxBuff != 0)
     {
         // DMA has received something!
@@ -110,6 +148,7 @@ void UartModule::Run()
             m_cb(m_rxFrames.Pop().value_or(Uart::Frame {}));
         }
     }
+#    endif
 }
 
 bool UartModule::Transmit(const signed_data_type* msg, size_type len)
@@ -127,6 +166,24 @@ bool UartModule::Transmit(const data_type* buff, size_type len)
 {
     NILAI_ASSERT(buff != nullptr, "buff is NULL");
 
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+    if (len == 0)
+    {
+        return true;
+    }
+    {
+        // Transmit can be called from the main loop and from interrupts, the queue only takes one
+        // producer at a time. Nothing is logged on failure, the logger itself could be the one
+        // transmitting.
+        System::CriticalSection cs;
+        if (!m_txQueue.Push(buff, len))
+        {
+            return false;
+        }
+    }
+    KickTransmission();
+    return true;
+#    else
     if (!WaitUntilTransmissionComplete())
     {
         // Timed out.
@@ -145,6 +202,7 @@ bool UartModule::Transmit(const data_type* buff, size_type len)
     }
 
     return true;
+#    endif
 }
 
 bool UartModule::Transmit(const data_type* buff, size_type len, timeout_t timeout)
@@ -165,6 +223,18 @@ bool UartModule::Transmit(const raw_buffer_type& msg)
 
 [[maybe_unused]] bool UartModule::VTransmit(const signed_data_type* fmt, ...)
 {
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+    // The transmission buffer is only used to format the message, it is then copied in the queue.
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(reinterpret_cast<char*>(m_txBuff.data()), m_txBuff.size(), fmt, args);
+    va_end(args);
+    if (len < 0)
+    {
+        return false;
+    }
+    return Transmit(m_txBuff.data(), std::min(static_cast<size_type>(len), m_txBuff.size() - 1));
+#    else
     if (!WaitUntilTransmissionComplete())
     {
         // Timed out.
@@ -183,11 +253,62 @@ bool UartModule::Transmit(const raw_buffer_type& msg)
         return false;
     }
 
+    return true;
+#    endif
+}
+
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+bool UartModule::TransmitBorrowed(const data_type*     buff,
+                                  size_type            len,
+                                  Uart::TxCpltCallback cb,
+                                  void*                ctx)
+{
+    NILAI_ASSERT(buff != nullptr, "buff is NULL");
+
+    if (len == 0)
+    {
+        return true;
+    }
+    {
+        System::CriticalSection cs;
+        if (!m_txQueue.PushBorrowed(buff, len, cb, ctx))
+        {
+            return false;
+        }
+    }
+    KickTransmission();
+    return true;
+}
+
+bool UartModule::Transmit(std::span<const std::span<const data_type>> buffers)
+{
+    {
+        System::CriticalSection cs;
+        if (!m_txQueue.Push(buffers))
+        {
+            return false;
+        }
+    }
+    KickTransmission();
     return true;
 }
+#    endif
 
 Uart::Frame UartModule::Receive(timeout_t timeout)
 {
+#    if defined(NILAI_UART_RX_IN_PLACE)
+    // Kept for compatibility, prefer ReceiveView to avoid copying the frame.
+    frame_view_t view = ReceiveView(timeout);
+    if (!view)
+    {
+        return {};
+    }
+    std::vector<uint8_t> data(view.Size());
+    view.CopyTo(data.data(), data.size());
+    Uart::Frame frame {std::move(data), view.Timestamp};
+    m_rxStore.Release(view);
+    return frame;
+#    else
     timeout_t deadline = GetTicks() + timeout;
 
     while (GetTicks() <= deadline)
@@ -199,19 +320,62 @@ Uart::Frame UartModule::Receive(timeout_t timeout)
     }
     // Return an empty frame on timeout.
     return m_rxFrames.Pop().value_or(Uart::Frame {});
+#    endif
+}
+
+#    if defined(NILAI_UART_RX_IN_PLACE)
+UartModule::frame_view_t UartModule::ReceiveView(timeout_t timeout)
+{
+    timeout_t deadline = GetTicks() + timeout;
+
+    while (GetTicks() <= deadline)
+    {
+        if (m_rxStore.Available() != 0)
+        {
+            break;
+        }
+    }
+    // The view is invalid on timeout.
+    return m_rxStore.Pop();
+}
+
+void UartModule::SetFrameViewReceiveCpltCallback(const view_callback_t& cb)
+{
+    if (cb)
+    {
+        m_viewCb = cb;
+    }
+}
+
+void UartModule::ClearFrameViewReceiveCpltCallback()
+{
+    m_viewCb = {};
 }
+#    endif
 
 void UartModule::ForceSwap()
 {
-#    if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
-    HAL_UART_DMAStop(m_handle);
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    // Close the current frame where the DMA currently is, without ever stopping it.
+    System::CriticalSection cs;
+    size_t                  pos = rx_store_t::s_size - __HAL_DMA_GET_COUNTER(m_handle->hdmarx);
+    m_rxStore.OnRxEvent(pos, true, GetTicks());
 #    else
+#        if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
+    HAL_UART_DMAStop(m_handle);
+#        else
     HAL_UART_AbortReceive_IT(m_handle);
+#        endif
 #    endif
+#    if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    uint16_t rcvd = m_expectedRxLen - __HAL_DMA_GET_COUNTER(m_handle->hdmarx);
+    RxCpltCallback(rcvd);
+#    elif !defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
     uint16_t rcvd = m_dmaBuff.size() - __HAL_DMA_GET_COUNTER(m_handle->hdmarx);
     std::memcpy(m_rxBuff.data(), m_dmaBuff.data(), m_dmaBuff.size());
     //    m_rxBuff = m_dmaBuff;
     RxCpltCallback(rcvd);
+#    endif
 }
 
 void UartModule::SetExpectedRxLen(size_type len)
@@ -241,7 +405,11 @@ bool UartModule::WaitUntilTransmissionComplete(timeout_t timeout)
 
     while (GetTicks() < timeoutTime)
     {
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+        if (m_txQueue.Empty())
+#    else
         if (m_handle->gState == HAL_UART_STATE_READY)
+#    endif
         {
             return true;
         }
@@ -250,30 +418,109 @@ bool UartModule::WaitUntilTransmissionComplete(timeout_t timeout)
     return false;
 }
 
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+void UartModule::KickTransmission()
+{
+    // The completion interrupt must not chain a segment while we're checking if one is in flight.
+    System::CriticalSection cs;
+    if (!m_txBusy)
+    {
+        StartNextTransmission();
+    }
+}
+
+void UartModule::StartNextTransmission()
+{
+    const Uart::TxSegment* seg = m_txQueue.Front();
+    if (seg == nullptr)
+    {
+        m_txBusy = false;
+        return;
+    }
+
+    m_txBusy = true;
+    if (!m_txFunc(m_handle, seg->Data, seg->Len))
+    {
+        // Leave the segment in the queue, Run will try again.
+        m_txBusy = false;
+    }
+}
+
+void UartModule::TxCpltCallback()
+{
+    // Chain straight to the next segment, the peripheral is never released in between.
+    m_txQueue.Pop();
+    StartNextTransmission();
+}
+
+void UartModule::TxCpltCallback(UartModule::handle_type* handle)
+{
+    for (auto&& module : s_uarts)
+    {
+        if (module != nullptr && module->m_handle == handle)
+        {
+            module->TxCpltCallback();
+            return;
+        }
+    }
+}
+#    endif
+
+#    if !defined(NILAI_UART_RX_IN_PLACE)
 void UartModule::MoveCompleteFrameToFrameBuff()
 {
     auto frameData = std::vector<uint8_t> {m_rxBuff.begin(), m_rxBuff.begin() + m_bytesInRxBuff};
     m_rxFrames.Emplace(frameData, GetTicks());
     m_bytesInRxBuff = 0;
 }
+#    endif
 
 bool UartModule::StartDma()
 {
-#    if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
-    HAL_StatusTypeDef status = HAL_UART_Receive_DMA(m_handle, m_dmaBuff.data(), m_dmaBuff.size());
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    // The DMA runs over the whole ring, reporting its position on half transfer, transfer
+    // complete and idle line. Since it is circular, it never has to be restarted.
+    m_rxStore.Resync();
+    m_lastRxEvent = 0;
+    return HAL_UARTEx_ReceiveToIdle_DMA(m_handle, m_rxStore.Data(), rx_store_t::s_size) == HAL_OK;
+#    elif defined(NILAI_UART_RX_USE_FRAME_POOL)
+    uint8_t* dest = m_rxStore.Receiving();
+    if (dest == nullptr)
+    {
+        dest = m_rxStore.Acquire();
+    }
+    if (dest == nullptr)
+    {
+        // Every slot is borrowed, nowhere to receive into.
+        return false;
+    }
+    size_type len = m_expectedRxLen;
 #    else
-    HAL_StatusTypeDef status = HAL_UART_Receive_IT(m_handle, m_dmaBuff.data(), m_dmaBuff.size());
+    uint8_t*  dest = m_dmaBuff.data();
+    size_type len  = m_dmaBuff.size();
 #    endif
+#    if !defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+#        if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
+    HAL_StatusTypeDef status = HAL_UART_Receive_DMA(m_handle, dest, len);
+#        else
+    HAL_StatusTypeDef status = HAL_UART_Receive_IT(m_handle, dest, len);
+#        endif
     return status == HAL_OK;
+#    endif
 }
 
 bool UartModule::ResizeDma(size_t newSize)
 {
-#    if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
-    HAL_StatusTypeDef s = HAL_UART_DMAStop(m_handle);
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    // Frames are delimited by the idle line, there is no expected length to wait for.
+    NILAI_UNUSED(newSize);
+    return true;
 #    else
-    HAL_StatusTypeDef s      = HAL_UART_AbortReceive_IT(m_handle);
-#    endif
+#        if NILAI_UART_USE_IMPL == NILAI_UART_USE_DMA
+    HAL_StatusTypeDef s = HAL_UART_DMAStop(m_handle);
+#        else
+    HAL_StatusTypeDef s = HAL_UART_AbortReceive_IT(m_handle);
+#        endif
     if (s != HAL_OK)
     {
         UART_ERROR("Unable to stop the DMA stream! %i", static_cast<int>(s));
@@ -281,10 +528,16 @@ bool UartModule::ResizeDma(size_t newSize)
     }
 
     // Resizing the DMA buffer drops whatever data is pending!
+#        if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    // The slots are statically sized, the DMA can only be told to stop earlier.
+    m_expectedRxLen = std::min(newSize, rx_store_t::s_slotSize);
+#        else
     m_rxBuff.resize(newSize);
     m_dmaBuff.resize(newSize);
+#        endif
 
     return StartDma();
+#    endif
 }
 
 void UartModule::RxCpltCallback(UartModule::handle_type* handle, uint16_t size)
@@ -302,15 +555,69 @@ void UartModule::RxCpltCallback(UartModule::handle_type* handle, uint16_t size)
 
 void UartModule::RxCpltCallback(uint16_t size)
 {
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    // The DMA is never stopped in this mode, there is nothing to restart.
+    m_rxStore.OnRxEvent(size, true, GetTicks());
+#    else
+#        if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    // The DMA wrote straight into the slot, hand it to the FIFO and continue in a fresh one.
+    m_rxStore.Commit(size, GetTicks());
+#        else
     if (m_bytesInRxBuff != 0)
     {
         // Frame already pending, run hasn't done its job yet, do it for it.
         MoveCompleteFrameToFrameBuff();
     }
     m_bytesInRxBuff = size;
+#        endif
     StartDma();
+#    endif
+}
+
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+void UartModule::RxEventCallback(UartModule::handle_type* handle, uint16_t size)
+{
+    for (auto&& module : s_uarts)
+    {
+        if (module != nullptr && module->m_handle == handle)
+        {
+            module->RxEventCallback(size);
+            return;
+        }
+    }
 }
 
+void UartModule::RxEventCallback(uint16_t size)
+{
+#        if defined(HAL_UART_RXEVENT_IDLE)
+    bool isIdle = HAL_UARTEx_GetRxEventType(m_handle) == HAL_UART_RXEVENT_IDLE;
+#        else
+    // Older HALs don't tell which event this is, and clear the IDLE flag before calling back.
+    // Half transfer and transfer complete only report the middle and the end of the ring, and
+    // always move the position. An idle line there comes right after one of them, at the same
+    // position. These HALs don't report an idle line at the end of the ring at all.
+    bool isIdle = (size != rx_store_t::s_size / 2 && size != rx_store_t::s_size) ||
+                  size == m_lastRxEvent;
+    m_lastRxEvent = size;
+#        endif
+    m_rxStore.OnRxEvent(size, isIdle, GetTicks());
+}
+
+void UartModule::RxErrorCallback(UartModule::handle_type* handle)
+{
+    for (auto&& module : s_uarts)
+    {
+        if (module != nullptr && module->m_handle == handle &&
+            handle->RxState == HAL_UART_STATE_READY)
+        {
+            // The HAL aborted the reception, get it going again.
+            module->StartDma();
+            return;
+        }
+    }
+}
+#    endif
+
 bool UartModule::TransmitIT(UartModule::handle_type* uart, const uint8_t* data, size_t len)
 {
     return HAL_UART_Transmit_IT(uart, const_cast<uint8_t*>(data), len) == HAL_OK;
@@ -323,7 +630,11 @@ bool UartModule::TransmitDMA(UartModule::handle_type* uart, const uint8_t* data,
 
 extern "C" void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef* huart, uint16_t size)
 {
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    UartModule::RxEventCallback(huart, size);
+#    else
     UartModule::RxCpltCallback(huart, size);
+#    endif
 }
 
 extern "C" void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart)
@@ -333,7 +644,11 @@ extern "C" void HAL_UART_RxCpltCallback(UART_HandleTypeDef* huart)
 
 extern "C" void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart)
 {
+#    if defined(NILAI_UART_TX_USE_QUEUE)
+    UartModule::TxCpltCallback(huart);
+#    else
     HAL_UART_AbortTransmit(huart);
+#    endif
 }
 
 extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
@@ -361,6 +676,10 @@ extern "C" void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart)
     [[maybe_unused]] volatile Status status = {.Register =
                                                  huart->Instance->NILAI_UART_IRQ_STATUS_REG};
 
+#    if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    UartModule::RxErrorCallback(huart);
+#    endif
+
     System::Breakpoint();
 }
 
@@ -41,6 +41,33 @@
 #            include "UART/frame.h"
 #            include "UART/status.h"
 
+#            if defined(NILAI_UART_RX_USE_FRAME_POOL)
+#                include "UART/frame_pool.h"
+
+#                if !defined(NILAI_UART_RX_POOL_SLOT_SIZE)
+#                    define NILAI_UART_RX_POOL_SLOT_SIZE 64
+#                endif
+#            elif defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+#                include "UART/rx_ring.h"
+
+#                if !defined(NILAI_UART_RX_RING_SIZE)
+#                    define NILAI_UART_RX_RING_SIZE 256
+#                endif
+#            endif
+
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+#                include "UART/tx_queue.h"
+
+#                if !defined(NILAI_UART_TX_QUEUE_DEPTH)
+#                    define NILAI_UART_TX_QUEUE_DEPTH 8
+#                endif
+#                if !defined(NILAI_UART_TX_QUEUE_BUFF_SIZE)
+#                    define NILAI_UART_TX_QUEUE_BUFF_SIZE 1024
+#                endif
+
+#                include <span>
+#            endif
+
 #            include <cstdint>       // For uint8_t, size_t
 #            include <functional>    // For std::function
 #            include <string>        // For std::string
@@ -72,8 +99,23 @@ public:
 
     using callback_t = std::function<void(Uart::Frame)>;
 
+#            if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    using rx_store_t = Uart::FramePool<NILAI_UART_RX_POOL_SLOT_SIZE, NILAI_UART_RX_FRAME_BUFF_SIZE>;
+    using frame_view_t = Uart::FrameView;
+#            elif defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    using rx_store_t   = Uart::RxRing<NILAI_UART_RX_RING_SIZE, NILAI_UART_RX_FRAME_BUFF_SIZE>;
+    using frame_view_t = Uart::RingFrameView;
+#            endif
+#            if defined(NILAI_UART_RX_IN_PLACE)
+    using view_callback_t = std::function<void(const frame_view_t&)>;
+#            endif
+
     using tx_func_t = bool (*)(handle_type*, const uint8_t*, size_t);
 
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+    using tx_queue_t = Uart::TxQueue<NILAI_UART_TX_QUEUE_DEPTH, NILAI_UART_TX_QUEUE_BUFF_SIZE>;
+#            endif
+
 public:
     UartModule() noexcept = default;
     UartModule(std::string    label,
@@ -109,11 +151,84 @@ public:
     bool                  Transmit(const raw_buffer_type& msg);
     [[maybe_unused]] bool VTransmit(const signed_data_type* fmt, ...);
 
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+    /**
+     * @brief Queues a buffer for transmission without copying it.
+     *
+     * The buffer must stay valid until the callback is called, from the interrupt context.
+     *
+     * @param buff The bytes to send.
+     * @param len The number of bytes to send.
+     * @param cb Function called once the buffer has been sent. Can be nullptr.
+     * @param ctx User data passed to the callback.
+     * @return False if the queue is full.
+     */
+    bool TransmitBorrowed(const data_type*     buff,
+                          size_type            len,
+                          Uart::TxCpltCallback cb  = nullptr,
+                          void*                ctx = nullptr);
+
+    /**
+     * @brief Copies many buffers in the transmission queue at once.
+     *
+     * The buffers are sent back-to-back, in order. Either all of them are queued, or none are.
+     *
+     * @param buffers The buffers to send.
+     * @return False if the queue doesn't have enough room for all the buffers.
+     */
+    bool Transmit(std::span<const std::span<const data_type>> buffers);
+
+    [[nodiscard]] Uart::TxQueueStats GetTxQueueStats() const noexcept { return m_txQueue.Stats(); }
+    void                             ResetTxQueueStats() noexcept { m_txQueue.ResetStats(); }
+#            endif
+
+#            if defined(NILAI_UART_RX_IN_PLACE)
+    [[nodiscard]] size_type AvailableFrames() const noexcept { return m_rxStore.Available(); }
+    [[nodiscard]] size_type DroppedFrames() const noexcept { return m_rxStore.DroppedFrames(); }
+#            else
     [[nodiscard]] size_type AvailableFrames() const noexcept { return m_rxFrames.Size(); }
+#            endif
 
     // Blocks until a frame is received.
     Uart::Frame Receive(timeout_t timeout = s_rxTimeout);
 
+#            if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    /**
+     * @brief Gets the number of times the DMA wrote over frames that were not released yet.
+     */
+    [[nodiscard]] size_type Overruns() const noexcept { return m_rxStore.Overruns(); }
+#            endif
+
+#            if defined(NILAI_UART_RX_IN_PLACE)
+    /**
+     * @brief Blocks until a frame is received, without copying it out of the reception buffer.
+     *
+     * The returned view must be handed back with @ref Release once the caller is done with it,
+     * otherwise its bytes will never be re-used.
+     *
+     * @param timeout Maximum amount of time to wait for a frame.
+     * @return A view of the frame. The view is invalid on timeout.
+     */
+    frame_view_t ReceiveView(timeout_t timeout = s_rxTimeout);
+
+    /**
+     * @brief Hands a frame obtained with @ref ReceiveView back to the reception buffer.
+     *
+     * With @ref NILAI_UART_RX_USE_CIRCULAR_DMA, frames must be released in order.
+     *
+     * @param view The view to release. It is invalidated by this call.
+     */
+    void Release(frame_view_t& view) noexcept { m_rxStore.Release(view); }
+
+    /**
+     * @brief Sets a callback invoked from @ref Run for every received frame.
+     *
+     * The frame is released as soon as the callback returns.
+     */
+    void SetFrameViewReceiveCpltCallback(const view_callback_t& cb);
+    void ClearFrameViewReceiveCpltCallback();
+#            endif
+
     void ForceSwap();
 
     void SetExpectedRxLen(size_type len);
@@ -127,11 +242,19 @@ private:
     void RxCpltCallback(uint16_t size);
     bool ResizeDma(size_t newSize);
     bool StartDma();
+#            if !defined(NILAI_UART_RX_IN_PLACE)
     void MoveCompleteFrameToFrameBuff();
+#            endif
 
     static bool TransmitIT(handle_type* uart, const uint8_t* data, size_t len);
     static bool TransmitDMA(handle_type* uart, const uint8_t* data, size_t len);
 
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+    void KickTransmission();
+    void StartNextTransmission();
+    void TxCpltCallback();
+#            endif
+
 protected:
     handle_type* m_handle = nullptr;    //!< Pointer to the hardware peripheral.
 
@@ -141,17 +264,40 @@ private:
     tx_func_t       m_txFunc = nullptr;
     raw_buffer_type m_txBuff;    //!< Transmission buffer
 
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+    //! Segments waiting to be sent. The front segment is the one being sent.
+    tx_queue_t m_txQueue;
+    //! True while a segment of the queue is being sent.
+    volatile bool m_txBusy = false;
+#            endif
+
     /**
      * Number of bytes that have been received by DMA.
      * When this value is not 0, it means that a DMA event has occurred and that the buffer should
      * be swapped.
      */
-    uint16_t    m_bytesInRxBuff = 0;
+    uint16_t m_bytesInRxBuff = 0;
+#            if defined(NILAI_UART_RX_IN_PLACE)
+#                if defined(NILAI_UART_RX_USE_FRAME_POOL)
+    //! Number of bytes the DMA is expected to receive per frame.
+    size_type m_expectedRxLen = NILAI_UART_RX_POOL_SLOT_SIZE;
+#                endif
+
+    //! Buffer in which the DMA directly writes the received frames.
+    rx_store_t m_rxStore;
+#                if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    //! Position reported by the last reception event, to tell the idle line events apart.
+    uint16_t m_lastRxEvent = 0;
+#                endif
+
+    view_callback_t m_viewCb;
+#            else
     buffer_type m_dmaBuff;
     buffer_type m_rxBuff;    //!< Buffer where the raw, unprocessed data is received.
 
     //! Buffer where received frames are stored.
     CircularBuffer<Uart::Frame, NILAI_UART_RX_FRAME_BUFF_SIZE> m_rxFrames;
+#            endif
 
     callback_t m_cb;
 
@@ -162,6 +308,18 @@ private:
 
 public:
     static void RxCpltCallback(UartModule::handle_type* handle, uint16_t size);
+#            if defined(NILAI_UART_TX_USE_QUEUE)
+    static void TxCpltCallback(UartModule::handle_type* handle);
+#            endif
+#            if defined(NILAI_UART_RX_USE_CIRCULAR_DMA)
+    static void RxEventCallback(UartModule::handle_type* handle, uint16_t size);
+    static void RxErrorCallback(UartModule::handle_type* handle);
+
+private:
+    void RxEventCallback(uint16_t size);
+
+public:
+#            endif
 
 private:
 #            ifdef GTEST
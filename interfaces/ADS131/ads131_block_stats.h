@@ -0,0 +1,239 @@
+/**
+ * @file    ads131_block_stats.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Conversion and statistics on blocks of raw ADS131 frames.
+ *
+ * The frames are processed as they were read, without first being converted to one float vector
+ * per channel. Samples are sign-extended from 24 bits and accumulated as integers, so the
+ * statistics are exact and only converted to volts at the end.
+ *
+ * On cores with the DSP extension (Cortex-M4/M7), each sample is read with a single unaligned
+ * load and a byte reversal. The squares are plain 64-bit multiply-accumulates, which the compiler
+ * turns into SMLAL.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_INTERFACES_ADS131_BLOCK_STATS_H
+#define NILAI_INTERFACES_ADS131_BLOCK_STATS_H
+
+#include "ads131_stream.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Interfaces::Ads131
+{
+//! Offset, in bytes, of the first channel in a frame. It is preceded by the status word.
+static constexpr size_t s_firstChannelOffset = 3;
+static constexpr size_t s_sampleSize         = 3;
+
+//! Weight of 1 LSB, in volts: (2 * Vref / Gain) / 2^24.
+static constexpr float s_lsb = (2.0f * (2.442f / 1.0f)) / 16777216.0f;
+//! Offset added by the ADS131, which is removed from the readings.
+static constexpr float s_offset = 0.02656f;
+
+/**
+ * @brief Converts a raw sample to volts.
+ */
+constexpr float ToVolts(int32_t raw) noexcept
+{
+    return (static_cast<float>(raw) * s_lsb) + s_offset;
+}
+
+/**
+ * @brief Statistics of one channel, in raw counts.
+ *
+ * The values in volts are 0 when no sample was accumulated.
+ */
+struct ChannelStats
+{
+    int32_t  Min   = std::numeric_limits<int32_t>::max();
+    int32_t  Max   = std::numeric_limits<int32_t>::min();
+    int64_t  Sum   = 0;
+    int64_t  SumSq = 0;
+    uint32_t Count = 0;
+
+    [[nodiscard]] float MinVolts() const noexcept { return Count == 0 ? 0.0f : ToVolts(Min); }
+    [[nodiscard]] float MaxVolts() const noexcept { return Count == 0 ? 0.0f : ToVolts(Max); }
+
+    [[nodiscard]] float MeanVolts() const noexcept
+    {
+        if (Count == 0)
+        {
+            return 0.0f;
+        }
+        double mean = static_cast<double>(Sum) / Count;
+        return static_cast<float>((mean * s_lsb) + s_offset);
+    }
+
+    /**
+     * @brief Gets the RMS value of the channel, offset included.
+     */
+    [[nodiscard]] float RmsVolts() const noexcept
+    {
+        if (Count == 0)
+        {
+            return 0.0f;
+        }
+        // E[(x*lsb + off)^2] = lsb^2 * E[x^2] + 2 * lsb * off * E[x] + off^2
+        double mean   = static_cast<double>(Sum) / Count;
+        double meanSq = static_cast<double>(SumSq) / Count;
+        double lsb    = s_lsb;
+        double off    = s_offset;
+        double ms     = (lsb * lsb * meanSq) + (2.0 * lsb * off * mean) + (off * off);
+        return static_cast<float>(std::sqrt(std::max(ms, 0.0)));
+    }
+
+    constexpr bool operator==(const ChannelStats&) const noexcept = default;
+};
+
+using BlockStats = std::array<ChannelStats, s_channelCount>;
+
+namespace Internal
+{
+/**
+ * @brief Reads a big-endian 24-bit sample one byte at a time.
+ */
+inline int32_t LoadSampleBytes(const uint8_t* p) noexcept
+{
+    uint32_t word = (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+                    (static_cast<uint32_t>(p[2]) << 8);
+    // The arithmetic shift extends the sign from 24 to 32 bits.
+    return static_cast<int32_t>(word) >> 8;
+}
+
+/**
+ * @brief Reads a big-endian 24-bit sample with a single word load.
+ *
+ * The byte following the sample is read too, and then shifted out. The last channel is followed
+ * by the padding byte of the frame, so this never reads past the frame.
+ */
+inline int32_t LoadSampleWord(const uint8_t* p) noexcept
+{
+    uint32_t word;
+    std::memcpy(&word, p, sizeof(word));
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        word = __builtin_bswap32(word);
+    }
+    return static_cast<int32_t>(word) >> 8;
+}
+
+template<bool WordLoads>
+void AccumulateFrames(std::span<const uint8_t> frames, BlockStats& stats) noexcept
+{
+    // Local copies, so that the accumulators stay in registers for the whole block.
+    std::array<int32_t, s_channelCount> mins;
+    std::array<int32_t, s_channelCount> maxs;
+    std::array<int64_t, s_channelCount> sums;
+    std::array<int64_t, s_channelCount> sumSqs;
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        mins[ch]   = stats[ch].Min;
+        maxs[ch]   = stats[ch].Max;
+        sums[ch]   = stats[ch].Sum;
+        sumSqs[ch] = stats[ch].SumSq;
+    }
+
+    size_t count = frames.size() / s_frameSize;
+    for (size_t f = 0; f < count; f++)
+    {
+        const uint8_t* frame = &frames[(f * s_frameSize) + s_firstChannelOffset];
+        for (size_t ch = 0; ch < s_channelCount; ch++)
+        {
+            const uint8_t* p = &frame[ch * s_sampleSize];
+            int32_t        v = WordLoads ? LoadSampleWord(p) : LoadSampleBytes(p);
+            mins[ch]         = std::min(mins[ch], v);
+            maxs[ch]         = std::max(maxs[ch], v);
+            sums[ch] += v;
+            sumSqs[ch] += static_cast<int64_t>(v) * v;
+        }
+    }
+
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        stats[ch].Min   = mins[ch];
+        stats[ch].Max   = maxs[ch];
+        stats[ch].Sum   = sums[ch];
+        stats[ch].SumSq = sumSqs[ch];
+        stats[ch].Count += static_cast<uint32_t>(count);
+    }
+}
+}    // namespace Internal
+
+/**
+ * @brief Reads a sample from a frame.
+ * @param frame The frame, @ref s_frameSize bytes long.
+ * @param channel The channel, from 0 to 3.
+ */
+inline int32_t GetSample(const uint8_t* frame, size_t channel) noexcept
+{
+    return Internal::LoadSampleBytes(&frame[s_firstChannelOffset + (channel * s_sampleSize)]);
+}
+
+/**
+ * @brief Adds frames to the statistics of each channel, in a single pass.
+ * @param frames Whole frames, one after the other. A partial frame at the end is ignored.
+ * @param stats The statistics to update. Start from default-constructed statistics.
+ */
+inline void AccumulateFrames(std::span<const uint8_t> frames, BlockStats& stats) noexcept
+{
+    Internal::AccumulateFrames<true>(frames, stats);
+}
+
+/**
+ * @brief Same as @ref AccumulateFrames, reading each byte on its own. Used as a reference.
+ */
+inline void AccumulateFramesPortable(std::span<const uint8_t> frames, BlockStats& stats) noexcept
+{
+    Internal::AccumulateFrames<false>(frames, stats);
+}
+
+/**
+ * @brief Converts the samples of a channel to volts.
+ * @param frames Whole frames, one after the other.
+ * @param channel The channel, from 0 to 3.
+ * @param out Receives the samples. Frames that don't fit are left out.
+ * @return The number of samples converted.
+ */
+inline size_t ConvertChannel(std::span<const uint8_t> frames,
+                             size_t                   channel,
+                             std::span<float>         out) noexcept
+{
+    size_t count = std::min(frames.size() / s_frameSize, out.size());
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const uint8_t* p = &frames[s_firstChannelOffset + (channel * s_sampleSize)];
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = ToVolts(Internal::LoadSampleWord(p + (i * s_frameSize)));
+    }
+    return count;
+}
+}    // namespace Nilai::Interfaces::Ads131
+//!@}
+#endif    // NILAI_INTERFACES_ADS131_BLOCK_STATS_H
@@ -47,6 +47,19 @@ bool AdsModule::DoPost()
 
 void AdsModule::Run()
 {
+#    if defined(NILAI_ADS_USE_STREAMING)
+    if (m_streaming && m_blockCb)
+    {
+        const block_t* block = m_stream.Acquire();
+        if (block != nullptr)
+        {
+            UpdateLatestFrame(*block);
+            m_blockCb(*block);
+            m_stream.Release();
+        }
+    }
+#    endif
+
     static bool wasTriggered = false;
 
     if (m_hasTriggered != wasTriggered)
@@ -227,7 +240,7 @@ const AdsPacket& AdsModule::RefreshValues(uint32_t timeout)
         }
     }
 
-    uint8_t data[16];
+    uint8_t data[Ads131::s_frameSize];
 
     // Activate CS to start transaction.
     HAL_GPIO_WritePin(m_config.pins.chipSelect.port, m_config.pins.chipSelect.pin, GPIO_PIN_RESET);
@@ -246,6 +259,10 @@ const AdsPacket& AdsModule::RefreshValues(uint32_t timeout)
     // Check for the trigger, if we haven't triggered yet.
     if (m_hasTriggered == true)
     {
+        if (m_samplesTaken >= m_samplesToIgnore)
+        {
+            Ads131::AccumulateFrames({&data[0], std::size(data)}, m_frameStats);
+        }
         m_channels.channel1[m_samplesTaken] = chs[0];
         m_channels.channel2[m_samplesTaken] = chs[1];
         m_channels.channel3[m_samplesTaken] = chs[2];
@@ -308,6 +325,91 @@ const AdsPacket& AdsModule::RefreshValues(uint32_t timeout)
     return m_latestFrame;
 }
 
+#    if defined(NILAI_ADS_USE_STREAMING)
+bool AdsModule::StartStreaming(Events::EventTypes dataReady)
+{
+    if (m_streaming)
+    {
+        return true;
+    }
+
+    Enable();
+    if (!m_isConfigured)
+    {
+        ADS_ERROR("Unable to stream, the ADS is not configured.");
+        return false;
+    }
+
+    m_stream.Reset();
+    m_stream.ResetStats();
+    m_dataReadyEvent = dataReady;
+
+    // The frame must be read before the next data ready, this can't wait for the main loop.
+    m_dataReadyCbId = Application::Get().RegisterEventCallback(
+      dataReady,
+      [this](Events::Event* e) { return OnDataReady(e); },
+      Events::DispatchMode::Immediate);
+    m_streaming = true;
+    ADS_INFO("Streaming started, %u frames per block.", block_t::s_frames);
+    return true;
+}
+
+void AdsModule::StopStreaming()
+{
+    if (!m_streaming)
+    {
+        return;
+    }
+
+    m_streaming = false;
+    Application::Get().UnregisterEventCallback(m_dataReadyEvent, m_dataReadyCbId);
+    Disable();
+    const Ads131::StreamStats& stats = m_stream.Stats();
+    ADS_INFO("Streaming stopped: %u blocks, %u overruns, %u missed frames.",
+             stats.Blocks,
+             stats.Overruns,
+             stats.MissedFrames);
+}
+
+bool AdsModule::OnDataReady(Events::Event* e)
+{
+    if (e->Type != m_dataReadyEvent || !m_streaming)
+    {
+        return false;
+    }
+
+    uint8_t* dest = m_stream.BeginFrame(e->Timestamp);
+    if (dest == nullptr)
+    {
+        // Still reading the previous frame, this one is lost.
+        return true;
+    }
+
+    Drivers::Spi::Transaction t = {
+      .Rx  = {dest, Ads131::s_frameSize},
+      .Cs  = m_config.pins.chipSelect,
+      .Cb  = &AdsModule::OnFrameRead,
+      .Ctx = this,
+    };
+    if (!m_spi->Submit(t))
+    {
+        m_stream.EndFrame(false);
+    }
+    return true;
+}
+
+void AdsModule::OnFrameRead([[maybe_unused]] const Drivers::Spi::Transaction& t,
+                            bool                                             ok,
+                            void*                                            ctx)
+{
+    auto* self = static_cast<AdsModule*>(ctx);
+    if (self->m_stream.EndFrame(ok))
+    {
+        self->Signal();
+    }
+}
+#    endif
+
 /*****************************************************************************/
 /* Private method definitions                                                */
 /*****************************************************************************/
@@ -428,23 +530,14 @@ uint16_t AdsModule::ReadCommandResponse()
 
 float AdsModule::CalculateTension(uint8_t* data)
 {
-    int32_t up  = ((int32_t)data[0] << 24);
-    int32_t mid = ((int32_t)data[1] << 16);
-    int32_t bot = ((int32_t)data[2] << 8);
-
-    // NOTE: This right-shift operation on signed data maintains the signed bit,
-    // and provides for the sign-extension from 24 to 32 bits.
-    return ConvertToVolt(((int32_t)(up | mid | bot)) >> 8);
+    // Sign-extends the 24-bit sample, the block kernels use the exact same conversion.
+    return ConvertToVolt(Ads131::Internal::LoadSampleBytes(data));
 }
 
 float AdsModule::ConvertToVolt(int32_t val)
 {
-    // 1 LSB = (2 * Vref / Gain) / 2^24
     // #TODO Modify this to get the value depending on the ADS's config.
-    constexpr float LSB = (2.0f * (2.442f / 1.0f)) / 16777216.0f;
-
-    //    // The 0.02656 value is a negative offset added by the ADS131, which we don't want.
-    return (((float)val * LSB) + 0.02656f);
+    return Ads131::ToVolts(val);
 }
 
 uint32_t AdsModule::ConvertToHex(float val)
@@ -475,82 +568,47 @@ const std::vector<float>& AdsModule::GetChannel(size_t channel) const
 
 void AdsModule::UpdateLatestFrame()
 {
-    float tot1 = 0, tot2 = 0, tot3 = 0, tot4 = 0;
-    float min1 = std::numeric_limits<float>::max(), min2 = min1, min3 = min1, min4 = min1;
-    float max1 = std::numeric_limits<float>::lowest(), max2 = max1, max3 = max1, max4 = max1;
-    // Ignore the first half of the samples taken.
-    int cnt = 0;
-    for (size_t i = m_samplesToIgnore; i < m_channels.size(); i++)
-    {
-        min1 = std::min(min1, m_channels.channel1[i]);
-        min2 = std::min(min2, m_channels.channel2[i]);
-        min3 = std::min(min3, m_channels.channel3[i]);
-        min4 = std::min(min4, m_channels.channel4[i]);
-
-        max1 = std::max(max1, m_channels.channel1[i]);
-        max2 = std::max(max2, m_channels.channel2[i]);
-        max3 = std::max(max3, m_channels.channel3[i]);
-        max4 = std::max(max4, m_channels.channel4[i]);
-
-        tot1 += m_channels.channel1[i];
-        tot2 += m_channels.channel2[i];
-        tot3 += m_channels.channel3[i];
-        tot4 += m_channels.channel4[i];
-
-        cnt++;
-    }
-
-    tot1 /= cnt;
-    tot2 /= cnt;
-    tot3 /= cnt;
-    tot4 /= cnt;
-
-    m_latestFrame.avgChannel1 = (tot1);
-    m_latestFrame.avgChannel2 = (tot2);
-    m_latestFrame.avgChannel3 = (tot3);
-    m_latestFrame.avgChannel4 = (tot4);
-
-    m_latestFrame.minChannel1 = (min1);
-    m_latestFrame.minChannel2 = (min2);
-    m_latestFrame.minChannel3 = (min3);
-    m_latestFrame.minChannel4 = (min4);
-
-    m_latestFrame.maxChannel1 = (max1);
-    m_latestFrame.maxChannel2 = (max2);
-    m_latestFrame.maxChannel3 = (max3);
-    m_latestFrame.maxChannel4 = (max4);
-    m_latestFrame.timestamp   = HAL_GetTick();
+    // The samples to ignore were left out as they were read.
+    SetLatestFrame(m_frameStats, HAL_GetTick());
 
     // Clear all of the buffers for the next run.
-    m_samplesTaken = 0;
-
-// Debug stuff.
-#    if 0
-    LOG_INFO("[ADS] (%i milliseconds)"
-             "\n\r\tCH1: 0x%06X (%0.3f) min: %0.3f\tmax: %0.3f"
-             "\n\r\tCH2: 0x%06X (%0.3f) min: %0.3f\tmax: %0.3f"
-             "\n\r\tCH3: 0x%06X (%0.3f) min: %0.3f\tmax: %0.3f"
-             "\n\r\tCH4: 0x%06X (%0.3f) min: %0.3f\tmax: %0.3f",
-             HAL_GetTick( ) - m_lastStartTime,
-             m_latestFrame.avgChannel1,
-             tot1,
-             min1,
-             max1,
-             m_latestFrame.avgChannel2,
-             tot2,
-             min2,
-             max2,
-             m_latestFrame.avgChannel3,
-             tot3,
-             min3,
-             max3,
-             m_latestFrame.avgChannel4,
-             tot4,
-             min4,
-             max4);
-#    endif
+    m_samplesTaken  = 0;
+    m_frameStats    = {};
     m_lastStartTime = HAL_GetTick();
 }
+
+#    if defined(NILAI_ADS_USE_STREAMING)
+void AdsModule::UpdateLatestFrame(const block_t& block)
+{
+    Ads131::BlockStats stats;
+    Ads131::AccumulateFrames(block.Data, stats);
+    SetLatestFrame(stats, block.Timestamp);
+}
+#    endif
+
+void AdsModule::SetLatestFrame(const Ads131::BlockStats& stats, uint32_t timestamp)
+{
+    m_latestFrame.avgChannel1 = stats[0].MeanVolts();
+    m_latestFrame.avgChannel2 = stats[1].MeanVolts();
+    m_latestFrame.avgChannel3 = stats[2].MeanVolts();
+    m_latestFrame.avgChannel4 = stats[3].MeanVolts();
+
+    m_latestFrame.minChannel1 = stats[0].MinVolts();
+    m_latestFrame.minChannel2 = stats[1].MinVolts();
+    m_latestFrame.minChannel3 = stats[2].MinVolts();
+    m_latestFrame.minChannel4 = stats[3].MinVolts();
+
+    m_latestFrame.maxChannel1 = stats[0].MaxVolts();
+    m_latestFrame.maxChannel2 = stats[1].MaxVolts();
+    m_latestFrame.maxChannel3 = stats[2].MaxVolts();
+    m_latestFrame.maxChannel4 = stats[3].MaxVolts();
+
+    m_latestFrame.rmsChannel1 = stats[0].RmsVolts();
+    m_latestFrame.rmsChannel2 = stats[1].RmsVolts();
+    m_latestFrame.rmsChannel3 = stats[2].RmsVolts();
+    m_latestFrame.rmsChannel4 = stats[3].RmsVolts();
+    m_latestFrame.timestamp   = timestamp;
+}
 }    // namespace Nilai::Interfaces
 #endif
 /* Have a wonderful day :) */
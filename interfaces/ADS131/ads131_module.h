@@ -14,6 +14,7 @@
 #    if defined(NILAI_USE_ADS) && defined(NILAI_USE_SPI)
 /*****************************************************************************/
 /* Includes */
+#        include "ads131_block_stats.h"
 #        include "ads131_module_config.h"
 
 #        include "../../defines/misc.h"
@@ -21,6 +22,20 @@
 
 #        include "../../drivers/spi_module.h"
 
+#        if defined(NILAI_ADS_USE_STREAMING)
+#            if !defined(NILAI_SPI_USE_QUEUE) || !defined(NILAI_USE_EVENTS)
+#                error The ADS streaming mode requires NILAI_SPI_USE_QUEUE and NILAI_USE_EVENTS
+#            endif
+#            include "../../defines/events/events.h"
+
+#            include "ads131_stream.h"
+
+#            if !defined(NILAI_ADS_STREAM_BLOCK_FRAMES)
+#                define NILAI_ADS_STREAM_BLOCK_FRAMES 128
+#            endif
+#        endif
+
+#        include <functional>
 #        include <string>
 #        include <vector>
 
@@ -106,6 +121,11 @@ class SystemModule;
 class AdsModule : public Nilai::Module
 {
 public:
+#        if defined(NILAI_ADS_USE_STREAMING)
+    using stream_t = Ads131::SampleStream<NILAI_ADS_STREAM_BLOCK_FRAMES>;
+    using block_t  = stream_t::block_t;
+#        endif
+
     AdsModule(Drivers::SpiModule* spi, std::string label);
     ~AdsModule() override = default;
 
@@ -156,6 +176,8 @@ public:
         m_samplesToTake   = samplesToTake;
         m_samplesToIgnore = samplesToIgnore;
         m_channels.resize(samplesToTake);
+        m_samplesTaken = 0;
+        m_frameStats   = {};
     }
     [[nodiscard]] uint8_t GetSamplesToTake() const { return m_samplesToTake; }
 
@@ -167,6 +189,38 @@ public:
 
     void ClearBuffers() { m_channels.clear(); }
 
+#        if defined(NILAI_ADS_USE_STREAMING)
+    /**
+     * @brief Starts reading every frame of the ADS, without involving the CPU between blocks.
+     *
+     * Each data ready interrupt queues a DMA read of the frame on the SPI bus. Full blocks of
+     * raw frames are then handed to the application, either through the block callback, called
+     * from Run, or with @ref AcquireBlock.
+     *
+     * @param dataReady The EXTI event of the data ready pin.
+     * @returns True if the streaming started.
+     */
+    bool StartStreaming(Events::EventTypes dataReady);
+    void StopStreaming();
+    [[nodiscard]] bool IsStreaming() const { return m_streaming; }
+
+    /**
+     * @brief Sets the function called by Run with each full block. The block is released once
+     * it returns.
+     */
+    void SetBlockCallback(const std::function<void(const block_t&)>& cb) { m_blockCb = cb; }
+
+    /**
+     * @brief Gets the last full block, when no block callback is set.
+     * @return The block, or nullptr if there isn't any. It must be released with
+     * @ref ReleaseBlock.
+     */
+    [[nodiscard]] const block_t* AcquireBlock() const { return m_stream.Acquire(); }
+    void                         ReleaseBlock() { m_stream.Release(); }
+
+    [[nodiscard]] const Ads131::StreamStats& GetStreamStats() const { return m_stream.Stats(); }
+#        endif
+
 private:
     bool                m_active = false;
     Drivers::SpiModule* m_spi;
@@ -184,6 +238,8 @@ private:
     uint16_t                              m_samplesToTake   = 1;
     uint16_t                              m_samplesToIgnore = 0;
     uint16_t                              m_samplesTaken    = 0;
+    //! Statistics of the samples taken so far, past the ones to ignore.
+    Ads131::BlockStats                    m_frameStats = {};
     std::function<void(const AdsPacket&)> m_callback;
     bool                                  m_repeat = true;
     struct ChannelData
@@ -247,6 +303,21 @@ private:
     inline float    ConvertToVolt(int32_t val);
     inline uint32_t ConvertToHex(float val);
     void            UpdateLatestFrame();
+    void            SetLatestFrame(const Ads131::BlockStats& stats, uint32_t timestamp);
+#        if defined(NILAI_ADS_USE_STREAMING)
+    void UpdateLatestFrame(const block_t& block);
+#        endif
+
+#        if defined(NILAI_ADS_USE_STREAMING)
+    bool        OnDataReady(Events::Event* e);
+    static void OnFrameRead(const Drivers::Spi::Transaction& t, bool ok, void* ctx);
+
+    stream_t                            m_stream;
+    std::function<void(const block_t&)> m_blockCb;
+    Events::EventTypes                  m_dataReadyEvent = Events::EventTypes::Exti_Generic;
+    size_t                              m_dataReadyCbId  = 0;
+    bool                                m_streaming      = false;
+#        endif
 };
 
 /*****************************************************************************/
@@ -0,0 +1,187 @@
+/**
+ * @file    ads131_stream.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Blocks of raw frames read from the ADS131 in streaming mode.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_INTERFACES_ADS131_STREAM_H
+#define NILAI_INTERFACES_ADS131_STREAM_H
+
+#include "../../defines/swap_buffer.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Interfaces::Ads131
+{
+//! Size of a frame read on each data ready: the status word followed by the 4 channels, all 24
+//! bits wide, plus a padding byte.
+static constexpr size_t s_frameSize    = 16;
+static constexpr size_t s_channelCount = 4;
+
+/**
+ * @brief Frames as they were read from the ADS131, one after the other.
+ */
+template<size_t Frames>
+struct RawBlock
+{
+    static constexpr size_t s_frames = Frames;
+
+    std::array<uint8_t, Frames * s_frameSize> Data = {};
+    //! Time at which the first frame was read, in milliseconds.
+    uint32_t Timestamp = 0;
+    //! Number of blocks that were filled before this one, dropped ones included.
+    uint32_t Sequence = 0;
+
+    [[nodiscard]] std::span<const uint8_t, s_frameSize> Frame(size_t i) const noexcept
+    {
+        return std::span<const uint8_t, s_frameSize> {&Data[i * s_frameSize], s_frameSize};
+    }
+};
+
+/**
+ * @brief Statistics on a @ref SampleStream.
+ */
+struct StreamStats
+{
+    size_t Frames       = 0;    //!< Number of frames read.
+    size_t Blocks       = 0;    //!< Number of blocks handed to the application.
+    size_t Overruns     = 0;    //!< Blocks dropped because the previous one wasn't released.
+    size_t MissedFrames = 0;    //!< Data ready signals that came while a frame was being read.
+    size_t FailedFrames = 0;    //!< Frames whose transfer failed.
+};
+
+/**
+ * @brief Assembles the frames read by DMA into blocks, double-buffered with a @ref SwapBuffer.
+ *
+ * The interrupts fill the active block one frame at a time. Once it is full, the blocks are
+ * swapped and the full one is handed to the application, which gives it back with
+ * @ref Release. If the application still holds the previous block by then, the new one is
+ * dropped and filled again, so a block is never modified while it is being read.
+ *
+ * @tparam Frames Number of frames in a block.
+ */
+template<size_t Frames>
+class SampleStream
+{
+    static_assert(Frames != 0, "A block must hold at least one frame!");
+
+public:
+    using block_t = RawBlock<Frames>;
+
+    /**
+     * @brief Gets where to read the next frame. Called from the data ready interrupt.
+     * @param timestamp The current time, in milliseconds.
+     * @return Where the frame must be written, or nullptr if the previous frame is still being
+     * read.
+     */
+    uint8_t* BeginFrame(uint32_t timestamp) noexcept
+    {
+        if (m_reading)
+        {
+            m_stats.MissedFrames++;
+            return nullptr;
+        }
+
+        block_t& block = m_blocks.GetActive();
+        if (m_frame == 0)
+        {
+            block.Timestamp = timestamp;
+            block.Sequence  = m_sequence;
+        }
+        m_reading = true;
+        return &block.Data[m_frame * s_frameSize];
+    }
+
+    /**
+     * @brief Marks the frame as read. Called from the transfer complete interrupt.
+     * @param ok True if the frame was read successfully. Failed frames are read again.
+     * @return True if a block was handed to the application.
+     */
+    bool EndFrame(bool ok) noexcept
+    {
+        m_reading = false;
+        if (!ok)
+        {
+            m_stats.FailedFrames++;
+            return false;
+        }
+
+        m_stats.Frames++;
+        if (++m_frame < Frames)
+        {
+            return false;
+        }
+
+        m_frame = 0;
+        m_sequence++;
+        if (m_ready.load(std::memory_order_acquire))
+        {
+            m_stats.Overruns++;
+            return false;
+        }
+
+        m_blocks.Swap();
+        m_stats.Blocks++;
+        m_ready.store(true, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Gets the last full block.
+     * @return The block, or nullptr if there isn't any. It must be released with @ref Release.
+     */
+    [[nodiscard]] const block_t* Acquire() const noexcept
+    {
+        return m_ready.load(std::memory_order_acquire) ? &m_blocks.GetInactive() : nullptr;
+    }
+
+    /**
+     * @brief Hands the block back, so that it can be filled again.
+     */
+    void Release() noexcept { m_ready.store(false, std::memory_order_release); }
+
+    /**
+     * @brief Drops the partially filled block and the one held by the application.
+     *
+     * Must not be called while frames are being read.
+     */
+    void Reset() noexcept
+    {
+        m_frame   = 0;
+        m_reading = false;
+        m_ready.store(false, std::memory_order_release);
+    }
+
+    [[nodiscard]] const StreamStats& Stats() const noexcept { return m_stats; }
+    void                             ResetStats() noexcept { m_stats = {}; }
+
+private:
+    SwapBuffer<block_t> m_blocks;
+    size_t              m_frame    = 0;
+    uint32_t            m_sequence = 0;
+    volatile bool       m_reading  = false;
+    std::atomic<bool>   m_ready    = false;
+    StreamStats         m_stats    = {};
+};
+}    // namespace Nilai::Interfaces::Ads131
+//!@}
+#endif    // NILAI_INTERFACES_ADS131_STREAM_H
@@ -30,16 +30,11 @@
 
 #    if defined(TS_ENABLE_DEBUG)
 #        define TS_DEBUG(msg, ...) LOG_DEBUG("[AT24QT]: " msg __VA_OPT__(, ) __VA_ARGS__)
-#        define TS_VERIFY_VALUE(exp, v)                                                            \
-            do                                                                                     \
-            {                                                                                      \
-                [[maybe_unused]] auto readback = v;                                                \
-                NILAI_ASSERT(                                                                      \
-                  (exp) == readback, "Readback failed, exp: %i, got: %i", exp, readback);          \
-            } while (0)
+//! One burst out of this many is read back after being written.
+#        define TS_VERIFY_INTERVAL 1
 #    else
 #        define TS_DEBUG(msg, ...)
-#        define TS_VERIFY_VALUE(x, msg, ...)
+#        define TS_VERIFY_INTERVAL 0
 #    endif
 #    define TS_INFO(msg, ...)  LOG_INFO("[AT24QT]: " msg __VA_OPT__(, ) __VA_ARGS__)
 #    define TS_ERROR(msg, ...) LOG_ERROR("[AT24QT]: " msg __VA_OPT__(, ) __VA_ARGS__)
@@ -66,6 +61,7 @@ At24Qt2120 At24Qt2120::Builder::Build() const
     using FirmwareVersion = AT24QT2120::FirmwareVersion;
 
     At24Qt2120 obj {m_i2c};
+    obj.m_regs.SetVerifyInterval(TS_VERIFY_INTERVAL);
 
     // Trigger a full chip reset.
     obj.Reset(true);
@@ -89,6 +85,9 @@ At24Qt2120 At24Qt2120::Builder::Build() const
         obj.Reset();
     }
 
+    // The settings are all written at once, the consecutive registers in a single burst.
+    obj.m_holdWrites = true;
+
     CONFIG_IF_NOT_DEFAULT(SamplingInterval);
     CONFIG_IF_NOT_DEFAULT(TowardTouchDrift);
     CONFIG_IF_NOT_DEFAULT(AwayFromTouchDrift);
@@ -159,6 +158,12 @@ At24Qt2120 At24Qt2120::Builder::Build() const
         obj.m_changePin = m_pin;
     }
 
+    obj.m_holdWrites = false;
+    if (!obj.FlushRegisters())
+    {
+        TS_ERROR("Unable to configure sensor!");
+    }
+
     if (!obj.Calibrate(true))
     {
         TS_ERROR("Unable to calibrate sensor!");
@@ -232,6 +237,8 @@ void At24Qt2120::BindIrq(Events::EventTypes type)
     m_irqType = type;
     m_irqId   = Application::Get().RegisterEventCallback(
       type, [this](Events::Event* e) { return HandleIrq(e); });
+    // The IRQ does all the work, there's nothing to poll.
+    SetRunOnSignal();
 }
 #    endif
 
@@ -356,8 +363,6 @@ void At24Qt2120::SetSamplingInterval(size_t time) noexcept
     TS_DEBUG("Set LPM: %ims (%#02x)", time, regVal);
 
     SetRegisters(Registers::LowPowerMode, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(time, GetSamplingInterval());
 }
 
 size_t At24Qt2120::GetSamplingInterval() noexcept
@@ -374,8 +379,6 @@ void At24Qt2120::SetTowardTouchDrift(uint8_t v) noexcept
     TS_DEBUG("Set TTD: %#02x", v);
 
     SetRegisters(Registers::TowardTouchDrift, &v, sizeof(v));
-
-    TS_VERIFY_VALUE(v, GetTowardTouchDrift());
 }
 
 uint8_t At24Qt2120::GetTowardTouchDrift() noexcept
@@ -392,8 +395,6 @@ void At24Qt2120::SetAwayFromTouchDrift(uint8_t v) noexcept
     TS_DEBUG("Set AFD: %#02x", v);
 
     SetRegisters(Registers::AwayFromTouchDrift, &v, sizeof(v));
-
-    TS_VERIFY_VALUE(v, GetAwayFromTouchDrift());
 }
 
 uint8_t At24Qt2120::GetAwayFromTouchDrift() noexcept
@@ -412,8 +413,6 @@ void At24Qt2120::SetDetectionIntegrator(uint8_t v) noexcept
     TS_DEBUG("Set DI: %#02x", v);
 
     SetRegisters(Registers::DetectionIntegrator, &v, sizeof(uint8_t));
-
-    TS_VERIFY_VALUE(v, GetDetectionIntegrator());
 }
 
 uint8_t At24Qt2120::GetDetectionIntegrator() noexcept
@@ -431,8 +430,6 @@ void At24Qt2120::SetTouchRecalibrationDelay(size_t delay) noexcept
     TS_DEBUG("Set TRD: %ims (%#02x)", delay, regVal);
 
     SetRegisters(Registers::TouchRecalDelay, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(RegValToDriftTime(regVal), GetTouchRecalibrationDelay());
 }
 
 size_t At24Qt2120::GetTouchRecalibrationDelay() noexcept
@@ -450,8 +447,6 @@ void At24Qt2120::SetDriftHoldTime(size_t time) noexcept
     TS_DEBUG("Set DHT: %ims (%#02x)", time, regVal);
 
     SetRegisters(Registers::DriftHoldTime, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(time, GetDriftHoldTime());
 }
 
 size_t At24Qt2120::GetDriftHoldTime() noexcept
@@ -472,8 +467,6 @@ void At24Qt2120::SetSliderOptions(bool enable, bool wheel) noexcept
     uint8_t                   regVal = static_cast<uint8_t>(opt);
 
     SetRegisters(Registers::SliderOption, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(opt, GetSliderOptions());
 }
 
 AT24QT2120::SliderOptions At24Qt2120::GetSliderOptions() noexcept
@@ -490,8 +483,6 @@ void At24Qt2120::SetChargeTime(uint8_t us) noexcept
     TS_DEBUG("Set Charge Time: %ius", us);
 
     SetRegisters(Registers::ChargeTime, &us, sizeof(us));
-
-    TS_VERIFY_VALUE(us, GetChargeTime());
 }
 
 uint8_t At24Qt2120::GetChargeTime() noexcept
@@ -513,8 +504,6 @@ void At24Qt2120::SetDetectionThreshold(AT24QT2120::Keys key, uint8_t threshold)
     Registers r = RegisterFromKey(key, Registers::Key0DetectThreshold);
 
     SetRegisters(r, &threshold, sizeof(threshold));
-
-    TS_VERIFY_VALUE(threshold, GetDetectionThreshold(key));
 }
 
 uint8_t At24Qt2120::GetDetectionThreshold(AT24QT2120::Keys key) noexcept
@@ -579,8 +568,6 @@ void At24Qt2120::SetKeyOptions(AT24QT2120::Keys key, const KeyOptions& options)
     Registers r = RegisterFromKey(key, Registers::Key0Control);
 
     SetRegisters(r, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(options, GetKeyOptions(key));
 }
 
 AT24QT2120::KeyOptions At24Qt2120::GetKeyOptions(AT24QT2120::Keys key) noexcept
@@ -617,8 +604,6 @@ void At24Qt2120::SetKeyPulseScale(AT24QT2120::Keys key, const AT24QT2120::PulseS
     Registers r      = RegisterFromKey(key, Registers::Key0PulseScale);
 
     SetRegisters(r, &regVal, sizeof(regVal));
-
-    TS_VERIFY_VALUE(ps, GetKeyPulseScale(key));
 }
 
 AT24QT2120::PulseScale At24Qt2120::GetKeyPulseScale(AT24QT2120::Keys key) noexcept
@@ -668,10 +653,38 @@ I2C::Frame At24Qt2120::GetRegisters(AT24QT2120::Registers r, size_t cnt)
 
 void At24Qt2120::SetRegisters(AT24QT2120::Registers r, const uint8_t* data, size_t cnt)
 {
-    TransmitFrameToRegister(s_i2cAddress, static_cast<uint8_t>(r), data, cnt);
+    m_regs.Set(r, std::span<const uint8_t> {data, cnt});
+    if (!m_holdWrites)
+    {
+        FlushRegisters();
+    }
+
+    if (r == Registers::Reset)
+    {
+        // Every register is back to its default value.
+        m_regs.Invalidate();
+    }
+}
+
+bool At24Qt2120::FlushRegisters()
+{
+    auto write = [this](uint8_t reg, std::span<const uint8_t> data)
+    { return TransmitFrameToRegister(s_i2cAddress, reg, data.data(), data.size()); };
+    auto read = [this](uint8_t reg, std::span<uint8_t> data)
+    { return ReceiveFrameFromRegister(s_i2cAddress, reg, data); };
+
+    if (!m_regs.Flush(write, read))
+    {
+        // Those registers are written again on the next flush.
+        TS_ERROR("Unable to flush the registers, %u mismatches so far",
+                 static_cast<unsigned>(m_regs.Stats().Mismatches));
+        return false;
+    }
+    return true;
 }
 
-constexpr At24Qt2120::At24Qt2120(At24Qt2120&& o) noexcept : I2cModule(std::move(o))
+constexpr At24Qt2120::At24Qt2120(At24Qt2120&& o) noexcept
+: I2cModule(std::move(o)), m_regs(o.m_regs)
 {
 #    if defined(NILAI_USE_EVENTS)
     Nilai::Application::Get().UnregisterEventCallback(m_irqType, m_irqId);
@@ -691,6 +704,7 @@ At24Qt2120& At24Qt2120::operator=(At24Qt2120&& o) noexcept
     m_lastEventTime = o.m_lastEventTime;
     m_changePin     = o.m_changePin;
     m_initialized   = o.m_initialized;
+    m_regs          = o.m_regs;
 
 #    if defined(NILAI_USE_EVENTS)
     Nilai::Application::Get().UnregisterEventCallback(o.m_irqType, o.m_irqId);
@@ -21,6 +21,7 @@
 #if defined(NILAI_USE_AT24QT2120)
 
 #    include "../../defines/pin.h"
+#    include "../../defines/register_cache.h"
 #    include "../../drivers/i2c_module.h"
 
 #    if defined(NILAI_USE_EVENTS)
@@ -786,6 +787,9 @@ private:
     constexpr explicit At24Qt2120(Drivers::I2cModule::Handle* i2c) noexcept
     : I2cModule(i2c, "AT24QT I2C"), m_run(&PollingRun)
     {
+        // Commands, they must be written every time.
+        m_regs.SetVolatile(AT24QT2120::Registers::Calibrate);
+        m_regs.SetVolatile(AT24QT2120::Registers::Reset);
     }
 
     /**
@@ -897,12 +901,22 @@ private:
 
     /**
      * @brief Writes to a register in the sensor.
+     *
+     * Registers that already hold the value are not written. While @ref m_holdWrites is set, the
+     * registers are only written on the next call to @ref FlushRegisters.
+     *
      * @param r The register to write to.
      * @param data A pointer to the data to write.
      * @param cnt The number of bytes to write.
      */
     void SetRegisters(AT24QT2120::Registers r, const uint8_t* data, size_t cnt);
 
+    /**
+     * @brief Writes the registers that changed, consecutive ones in a single burst.
+     * @returns True if the registers were written and verified.
+     */
+    bool FlushRegisters();
+
     /**
      * @brief Waits for the sensor's calibration sequence to complete.
      * @param timeout The maximum amount of time that this function will wait for.
@@ -925,6 +939,13 @@ private:
     //! Set to true by the builder, indicates a properly functioning chip.
     bool m_initialized = false;
 
+    static constexpr size_t s_registerCount =
+      static_cast<size_t>(AT24QT2120::Registers::ReferenceData11LSB) + 1;
+    //! Shadow copy of the registers written to the sensor.
+    RegisterCache<AT24QT2120::Registers, s_registerCount> m_regs;
+    //! Defers the writes until @ref FlushRegisters is called, while the sensor is configured.
+    bool m_holdWrites = false;
+
 #    if defined(NILAI_USE_EVENTS)
     /**
      * @brief     The ID of the event callback.
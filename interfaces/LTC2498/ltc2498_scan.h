@@ -0,0 +1,321 @@
+/**
+ * @file    ltc2498_scan.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Scheduling of the conversions of the LTC2498 over a list of channels.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_INTERFACES_LTC2498_SCAN_H
+#define NILAI_INTERFACES_LTC2498_SCAN_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Interfaces::Ltc2498
+{
+//! Size of a frame: the 32 bits of the result are read while the configuration is written.
+static constexpr size_t s_frameSize = 4;
+
+using SlotConfig = std::array<uint8_t, s_frameSize>;
+
+/**
+ * @brief State of a conversion result.
+ */
+enum class ResultStatus : uint8_t
+{
+    None = 0,      //!< No conversion has been read for that slot yet.
+    Ok,            //!< The conversion is valid.
+    OverRange,     //!< The input is above +0.5 * VREF.
+    UnderRange,    //!< The input is below -0.5 * VREF.
+    Invalid,       //!< The EOC or the dummy bit was set, the frame was not a result.
+};
+
+/**
+ * @brief Last conversion read for a slot of the scan.
+ */
+struct Result
+{
+    //! Signed conversion, 2^23 LSBs being +0.5 * VREF.
+    int32_t      Raw    = 0;
+    ResultStatus Status = ResultStatus::None;
+    //! Number of conversions read for the slot since the scan was started.
+    uint32_t Count = 0;
+    //! Time of the end of conversion signal that led to the reading.
+    uint32_t Timestamp = 0;
+};
+
+/**
+ * @brief Statistics on a @ref ScanEngine.
+ */
+struct ScanStats
+{
+    size_t Conversions  = 0;    //!< Number of results stored in the table, invalid ones included.
+    size_t Sweeps       = 0;    //!< Number of passes completed over all the slots.
+    size_t Invalid      = 0;    //!< Results rejected because of their EOC or dummy bit.
+    size_t FailedFrames = 0;    //!< Frames whose transfer failed. The result is lost.
+    size_t SpuriousEocs = 0;    //!< End of conversion signals that came while a frame was read.
+};
+
+/**
+ * @brief Decodes the 32 bits read from the LTC2498, most significant byte first.
+ * @param frame The bytes read.
+ * @param raw Where the signed conversion is written, unless the frame is invalid.
+ */
+constexpr ResultStatus DecodeResult(std::span<const uint8_t, s_frameSize> frame,
+                                    int32_t&                              raw) noexcept
+{
+    uint32_t word = (uint32_t(frame[0]) << 24) | (uint32_t(frame[1]) << 16) |
+                    (uint32_t(frame[2]) << 8) | uint32_t(frame[3]);
+
+    // Bit 31 is the EOC flag, bit 30 is a dummy bit. Both are 0 in a result.
+    if ((word & 0xC0000000) != 0)
+    {
+        return ResultStatus::Invalid;
+    }
+
+    // The sign bit and the 24 bits that follow are offset binary: 0x1000000 is 0V, one LSB being
+    // VREF / 2^24.
+    raw = static_cast<int32_t>((word >> 5) & 0x01FFFFFF) - 0x01000000;
+
+    // Bits 29 and 28, the sign and the MSB, are equal when the input is out of range.
+    switch (word & 0x30000000)
+    {
+        case 0x30000000: return ResultStatus::OverRange;
+        case 0x00000000: return ResultStatus::UnderRange;
+        default: return ResultStatus::Ok;
+    }
+}
+
+/**
+ * @brief Converts a conversion into volts.
+ * @param raw The conversion, as decoded by @ref DecodeResult.
+ * @param vref The reference voltage, the full scale being +/- 0.5 * vref.
+ */
+constexpr float ToVolts(int32_t raw, float vref) noexcept
+{
+    return static_cast<float>(raw) * (vref / 16777216.0f);
+}
+
+/**
+ * @brief Steps through a list of conversion settings, one slot per end of conversion.
+ *
+ * The LTC2498 reads the configuration of the next conversion during the same frame as the result
+ * of the last one. On each end of conversion, @ref BeginFrame thus prepares a frame that reads the
+ * result of slot N while programming slot N + 1, and @ref EndFrame stores that result in the
+ * preallocated table once the transfer is done. The chip starts converting slot N + 1 as soon as
+ * the frame ends, so a scan runs at the full rate of the converter.
+ *
+ * The first frame after @ref Start only programs the first slot: whatever it reads was not
+ * requested by the scan and is dropped.
+ *
+ * @tparam MaxSlots Maximum number of slots in a scan.
+ */
+template<size_t MaxSlots>
+class ScanEngine
+{
+    static constexpr size_t s_none = SIZE_MAX;
+
+public:
+    /**
+     * @brief Buffers of a frame. They stay valid until the next frame is prepared.
+     */
+    struct Frame
+    {
+        std::span<const uint8_t> Tx;
+        std::span<uint8_t>       Rx;
+    };
+
+    /**
+     * @brief Sets the list of conversions. Must not be called while a scan runs.
+     * @param slots The configuration of each conversion, as made by
+     * `LTC2498::ConversionSettings::ToRegValues`. A setting can appear more than once.
+     * @param repeat If true, the scan wraps around to the first slot forever. Otherwise, it stops
+     * after reading the last slot.
+     * @return False if there are no slots or too many of them.
+     */
+    bool Configure(std::span<const SlotConfig> slots, bool repeat) noexcept
+    {
+        if (slots.empty() || slots.size() > MaxSlots)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            m_configs[i] = slots[i];
+        }
+        m_count   = slots.size();
+        m_repeat  = repeat;
+        m_results = {};
+        return true;
+    }
+
+    /**
+     * @brief Starts the scan over from the first slot, on the next end of conversion.
+     */
+    void Start() noexcept
+    {
+        m_converting = s_none;
+        m_pending    = 0;
+        m_running    = m_count != 0;
+        m_busy       = false;
+    }
+
+    /**
+     * @brief Stops the scan. The frame being read, if any, is still stored.
+     */
+    void Stop() noexcept { m_running = false; }
+
+    /**
+     * @brief Forgets the slot being converted, after the frame that programmed it failed. The next
+     * frame reprograms the slot, and its result is dropped.
+     */
+    void Resync() noexcept { m_converting = s_none; }
+
+    /**
+     * @brief To be called on the end of conversion signal.
+     * @param frame Where the buffers of the frame to send are written.
+     * @param timestamp Time of the signal, saved with the result.
+     * @return True if the frame must be sent.
+     * @return False if the scan is over or a frame is already being read.
+     */
+    bool BeginFrame(Frame& frame, uint32_t timestamp = 0) noexcept
+    {
+        if (!m_running)
+        {
+            return false;
+        }
+        if (m_busy)
+        {
+            m_stats.SpuriousEocs++;
+            return false;
+        }
+
+        if (m_converting == s_none)
+        {
+            if (m_pending == s_none)
+            {
+                // The frame ending the scan failed, there is nothing left to program.
+                m_running = false;
+                return false;
+            }
+            // Nothing requested is being converted, program the pending slot again.
+            m_busy      = true;
+            m_timestamp = timestamp;
+            frame       = {m_configs[m_pending], m_rx};
+            return true;
+        }
+
+        m_busy      = true;
+        m_timestamp = timestamp;
+
+        m_pending = m_converting + 1;
+        if (m_pending == m_count)
+        {
+            m_pending = m_repeat ? 0 : s_none;
+        }
+        // An empty configuration keeps the chip on its last settings, it is ignored by the scan.
+        frame = {m_pending == s_none ? s_idle : m_configs[m_pending], m_rx};
+        return true;
+    }
+
+    /**
+     * @brief To be called when the transfer of the frame is over.
+     * @param ok False if the transfer failed, in which case @ref Resync is called.
+     * @return True if a result was stored in the table.
+     */
+    bool EndFrame(bool ok) noexcept
+    {
+        m_busy = false;
+        if (!ok)
+        {
+            m_stats.FailedFrames++;
+            Resync();
+            return false;
+        }
+
+        size_t read  = m_converting;
+        m_converting = m_pending;
+        if (m_pending == s_none)
+        {
+            m_running = false;
+        }
+        if (read == s_none)
+        {
+            return false;
+        }
+
+        Result& r   = m_results[read];
+        r.Status    = DecodeResult(std::span<const uint8_t, s_frameSize> {m_rx}, r.Raw);
+        r.Timestamp = m_timestamp;
+        r.Count++;
+        m_stats.Conversions++;
+        if (r.Status == ResultStatus::Invalid)
+        {
+            m_stats.Invalid++;
+        }
+        if (read == m_count - 1)
+        {
+            m_stats.Sweeps++;
+        }
+        return true;
+    }
+
+    [[nodiscard]] const Result& GetResult(size_t slot) const noexcept
+    {
+        return slot < m_count ? m_results[slot] : s_empty;
+    }
+    [[nodiscard]] const SlotConfig& GetConfig(size_t slot) const noexcept
+    {
+        return slot < m_count ? m_configs[slot] : s_idle;
+    }
+
+    [[nodiscard]] size_t Slots() const noexcept { return m_count; }
+    [[nodiscard]] bool   IsRunning() const noexcept { return m_running; }
+    [[nodiscard]] bool   IsBusy() const noexcept { return m_busy; }
+
+    [[nodiscard]] const ScanStats& Stats() const noexcept { return m_stats; }
+    void                           ResetStats() noexcept { m_stats = {}; }
+
+private:
+    static constexpr SlotConfig s_idle  = {};
+    static constexpr Result     s_empty = {};
+
+    std::array<SlotConfig, MaxSlots> m_configs = {};
+    std::array<Result, MaxSlots>     m_results = {};
+    alignas(4) std::array<uint8_t, s_frameSize> m_rx = {};
+
+    size_t m_count  = 0;
+    bool   m_repeat = false;
+
+    //! Slot whose conversion is running on the chip, @ref s_none if it wasn't requested.
+    size_t m_converting = s_none;
+    //! Slot programmed by the frame being read, @ref s_none to end the scan.
+    size_t   m_pending   = 0;
+    uint32_t m_timestamp = 0;
+
+    volatile bool m_running = false;
+    volatile bool m_busy    = false;
+
+    ScanStats m_stats = {};
+};
+}    // namespace Nilai::Interfaces::Ltc2498
+//!@}
+
+#endif    // NILAI_INTERFACES_LTC2498_SCAN_H
@@ -182,12 +182,10 @@ bool SwTas5760<Device>::SetDigitalClipLevel(uint32_t lvl)
     //! Bits 5..0 -> Digital Clipper 1 register.
     m_cfg.DigClipLev5_0 = static_cast<uint8_t>(((lvl & 0x0000003F) << 2));
 
-    bool isGood = true;
-    isGood &= SetRegister(TAS5760::Registers::PwrCtrl, static_cast<uint8_t>(m_cfg.PowerConfig));
-    isGood &= SetRegister(TAS5760::Registers::DigClip2, m_cfg.DigClipLev13_6);
-    isGood &= SetRegister(TAS5760::Registers::DigClip1, m_cfg.DigClipLev5_0);
-
-    return isGood;
+    m_regs.Set(TAS5760::Registers::PwrCtrl, static_cast<uint8_t>(m_cfg.PowerConfig));
+    m_regs.Set(TAS5760::Registers::DigClip2, m_cfg.DigClipLev13_6);
+    m_regs.Set(TAS5760::Registers::DigClip1, m_cfg.DigClipLev5_0);
+    return FlushRegisters();
 }
 
 template<typename Device>
@@ -251,23 +249,20 @@ bool SwTas5760<Device>::Init()
 
     Device::StartClock();
 
-    bool isConfigGood = true;
-    isConfigGood &=
-      SetRegister(TAS5760::Registers::PwrCtrl, static_cast<uint8_t>(m_cfg.PowerConfig));
-    isConfigGood &=
-      SetRegister(TAS5760::Registers::DigCtrl, static_cast<uint8_t>(m_cfg.DigitalConfig));
-
+    // The state of the chip is unknown, everything is written. Consecutive registers are written
+    // in a single burst.
+    m_regs.Invalidate();
+    m_regs.Set(TAS5760::Registers::PwrCtrl, static_cast<uint8_t>(m_cfg.PowerConfig));
+    m_regs.Set(TAS5760::Registers::DigCtrl, static_cast<uint8_t>(m_cfg.DigitalConfig));
     // Mute both channels to avoid weird sounds during setup.
-    isConfigGood &= SetRegister(TAS5760::Registers::VolCtrlCfg, s_bothChMuted);
-    isConfigGood &= SetRegister(TAS5760::Registers::LeftChVolCtrl, m_lVol);
-    isConfigGood &= SetRegister(TAS5760::Registers::RightChVolCtrl, m_rVol);
-    isConfigGood &=
-      SetRegister(TAS5760::Registers::AnalCtrl, static_cast<uint8_t>(m_cfg.AnalogConfig));
-    // Ignore errors for now...
-    /*isConfigGood &=*/SetRegister(TAS5760::Registers::FaultCfgAndErrStatus,
-                                   static_cast<uint8_t>(m_cfg.FaultConfig));
-    isConfigGood &= SetRegister(TAS5760::Registers::DigClip2, m_cfg.DigClipLev13_6);
-    isConfigGood &= SetRegister(TAS5760::Registers::DigClip1, m_cfg.DigClipLev5_0);
+    m_regs.Set(TAS5760::Registers::VolCtrlCfg, s_bothChMuted);
+    m_regs.Set(TAS5760::Registers::LeftChVolCtrl, m_lVol);
+    m_regs.Set(TAS5760::Registers::RightChVolCtrl, m_rVol);
+    m_regs.Set(TAS5760::Registers::AnalCtrl, static_cast<uint8_t>(m_cfg.AnalogConfig));
+    m_regs.Set(TAS5760::Registers::FaultCfgAndErrStatus, static_cast<uint8_t>(m_cfg.FaultConfig));
+    m_regs.Set(TAS5760::Registers::DigClip2, m_cfg.DigClipLev13_6);
+    m_regs.Set(TAS5760::Registers::DigClip1, m_cfg.DigClipLev5_0);
+    bool isConfigGood = FlushRegisters();
 
     Device::StopClock();
 
@@ -338,27 +333,41 @@ void SwTas5760<Device>::HandleHeadphoneChange()
 template<typename Device>
 bool SwTas5760<Device>::SetRegister(TAS5760::Registers r, uint8_t v)
 {
-    m_cfg.I2c.TransmitFrameToRegister(
-      static_cast<uint8_t>(m_cfg.Address), static_cast<uint8_t>(r), &v, sizeof(uint8_t));
-
-#    if defined(NILAI_TAS5760_VERIFY_WRITE)
-    I2C::Frame f = m_cfg.I2c.ReceiveFrameFromRegister(
-      static_cast<uint8_t>(m_cfg.Address), static_cast<uint8_t>(r), sizeof(uint8_t));
-    if (f.data[0] == v)
+    if (!m_regs.Set(r, v))
     {
-        // Data read is data written, that's good.
+        // Already holds that value.
         return true;
     }
-    else
+    return FlushRegisters();
+}
+
+template<typename Device>
+bool SwTas5760<Device>::FlushRegisters()
+{
+    auto addr  = static_cast<uint8_t>(m_cfg.Address);
+    auto write = [this, addr](uint8_t reg, std::span<const uint8_t> data)
+    { return m_cfg.I2c.TransmitFrameToRegister(addr, reg, data.data(), data.size()); };
+
+#    if defined(NILAI_TAS5760_VERIFY_WRITE)
+    auto read = [this, addr](uint8_t reg, std::span<uint8_t> data)
+    { return m_cfg.I2c.ReceiveFrameFromRegister(addr, reg, data); };
+
+    size_t mismatches = m_regs.Stats().Mismatches;
+    if (!m_regs.Flush(write, read))
     {
-        // Mismatch between value read and value expected.
-        TAS_ERROR("An error occurred while writing to 0x%02x, Exp: 0x%02x, got: 0x%02x",
-                  static_cast<uint8_t>(r),
-                  v,
-                  f.data[0]);
+        // A write failed, or the values read back don't match. Those registers are written again on
+        // the next flush.
+        TAS_ERROR("Unable to flush the registers, %u didn't take the value written",
+                  static_cast<unsigned>(m_regs.Stats().Mismatches - mismatches));
         return false;
     }
+    return true;
 #    else
+    if (!m_regs.Flush(write))
+    {
+        TAS_ERROR("Unable to flush the registers");
+        return false;
+    }
     return true;
 #    endif
 }
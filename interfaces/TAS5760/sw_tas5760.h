@@ -24,6 +24,12 @@
 
 #        include "sw_config.h"
 
+#        include "../../defines/register_cache.h"
+
+#        if !defined(NILAI_TAS5760_VERIFY_INTERVAL)
+#            define NILAI_TAS5760_VERIFY_INTERVAL 1
+#        endif
+
 #        if defined(NILAI_USE_EVENTS)
 #            include "../../defines/events/events.h"
 #        endif
@@ -67,6 +73,11 @@ public:
     SwTas5760(const TAS5760::SwConfig& cfg, Handle handle, const std::string& label, Args&&... args)
     : Tas5760Module<Device>(handle, label, std::forward<Args>(args)...), m_cfg(cfg)
     {
+        // Holds the error flags, which must be written back even if they didn't change.
+        m_regs.SetVolatile(TAS5760::Registers::FaultCfgAndErrStatus);
+#        if defined(NILAI_TAS5760_VERIFY_WRITE)
+        m_regs.SetVerifyInterval(NILAI_TAS5760_VERIFY_INTERVAL);
+#        endif
         Build(cfg);
     }
     SwTas5760(const SwTas5760&)            = delete;
@@ -120,11 +131,17 @@ private:
     void HandleHeadphoneChange();
 
     bool                      SetRegister(TAS5760::Registers r, uint8_t v);
+    bool                      FlushRegisters();
     static const std::string& StatusToStr(uint8_t s);
 
 private:
     TAS5760::SwConfig m_cfg;
 
+    static constexpr size_t s_registerCount =
+      static_cast<size_t>(TAS5760::Registers::DigClip1) + 1;
+    //! Shadow copy of the registers, only the ones that changed are written.
+    RegisterCache<TAS5760::Registers, s_registerCount> m_regs;
+
     std::function<void()> m_faultFunction    = []() {};
     std::function<void()> m_hpChangeFunction = []() {};
 
@@ -10,7 +10,11 @@
 #include "ltc2498_module.h"
 
 #if defined(NILAI_USE_LTC2498) && defined(NILAI_USE_SPI)
-#    include "services/logger.hpp"
+#    include "../services/logger.h"
+
+#    if defined(NILAI_LTC2498_USE_SCAN)
+#        include APPLICATION_HEADER
+#    endif
 
 #    define LTC_INFO(msg, ...)  LOG_INFO("[%s]: " msg, m_label.c_str(), ##__VA_ARGS__)
 #    define LTC_ERROR(msg, ...) LOG_ERROR("[%s]: " msg, m_label.c_str(), ##__VA_ARGS__)
@@ -37,11 +41,11 @@ std::array<uint8_t, 4> ConversionSettings::ToRegValues() const
 }
 }    // namespace LTC2498
 
-Ltc2498Module::Ltc2498Module(const std::string& label,
-                             SpiModule*         spi,
-                             const Nilai::Pin&  inPin,
-                             const Nilai::Pin&  csPin,
-                             float              vcom)
+Ltc2498Module::Ltc2498Module(const std::string&          label,
+                             Nilai::Drivers::SpiModule* spi,
+                             const Nilai::Pin&          inPin,
+                             const Nilai::Pin&          csPin,
+                             float                      vcom)
 : m_label(label), m_spi(spi), m_misoPin(inPin), m_csPin(csPin), m_vcom(vcom)
 {
     // Enable the LTC2498 chip select signal to monitor its status.
@@ -158,6 +162,14 @@ void Ltc2498Module::Run()
 bool Ltc2498Module::QueueConversions(const std::vector<LTC2498::ConversionSettings>& conversions,
                                      bool                                            repeat)
 {
+#    if defined(NILAI_LTC2498_USE_SCAN)
+    if (m_scanning)
+    {
+        LTC_ERROR("Unable to queue conversions while scanning!");
+        return false;
+    }
+#    endif
+
     m_conversions = conversions;
     m_repeat      = repeat;
 
@@ -272,7 +284,7 @@ std::array<uint8_t, 4> Ltc2498Module::SetNextConvAndReadResults(
 
     // Read the conversion result and (maybe) start the next one.
     if (m_spi->Transaction(config.data(), config.size(), resp.data(), resp.size()) !=
-        CEP_SPI::Status::NONE)
+        Nilai::SPI::Status::NONE)
     {
         LTC_ERROR("Unable to communicate with the ADC!");
     }
@@ -308,63 +320,221 @@ void Ltc2498Module::ParseConversionResult(const std::array<uint8_t, 4>&      res
     if ((raw & 0x40000000) != 0)
     {
         LTC_ERROR("Dummy bit is not 0!\t0x%08X", raw);
-        // Bit 29 is the sign of the result.
-        int sign = ((raw & 0x20000000) ? 1 : -1);
+        return;
+    }
+
+    // Bit 29 is the sign of the result.
+    int sign = ((raw & 0x20000000) ? 1 : -1);
 
-        // Combining bit 29 and bit 28 gives us the status of the conversion.
-        // If both bits are the same, we are over the acceptable range of the ADC.
-        if ((raw & 0x30000000) == 0x30000000)
+    // Combining bit 29 and bit 28 gives us the status of the conversion.
+    // If both bits are the same, we are over the acceptable range of the ADC.
+    if ((raw & 0x30000000) == 0x30000000)
+    {
+        LTC_ERROR("Over range detected! (0x%08X)", raw);
+        m_lastReading.raw     = 0x30000000 >> 5;    // Code for over range.
+        m_lastReading.reading = 0.0f;
+        return;
+    }
+    else if ((raw & 0x30000000) == 0x00000000)
+    {
+        LTC_ERROR("Under range detected! (0x%08X)", raw);
+        m_lastReading.raw     = 0x0FFFFFFF;    // Code for under range.
+        m_lastReading.reading = 0.0f;
+        return;
+    }
+
+    // Bit 28 to 5 is the conversion result.
+    raw = (raw & 0x1FFFFFE0) >> 5;
+
+    // Apply the sign.
+    int32_t hex = (int32_t)raw * sign;
+
+    m_lastReading.raw = hex;
+
+    // Convert the raw reading into volts.
+    // Full scale of the chip is 0.5Vref, Vref being 5V.
+    float value = (float)hex * (5.0f / 16777216.0f);
+
+    // In the case of a single-ended conversion, it was observed that if the input voltage is
+    // inferior to the common voltage, the measured voltage is equal to `-Vcom - Vin` instead of
+    // the `Vin - Vcom` that is expected. We thus need to compensate for this.
+    if (config.type == LTC2498::AcquisitionTypes::SingleEnded)
+    {
+        if (value < 0.0f)
+        {
+            value = (value * -1.0f) - m_vcom;
+        }
+        else
         {
-            LTC_ERROR("Over range detected! (0x%08X)", raw);
-            m_lastReading.raw     = 0x30000000 >> 5;    // Code for over range.
-            m_lastReading.reading = 0.0f;
-            return;
+            value = (value + m_vcom);
         }
-        else if ((raw & 0x30000000) == 0x00000000)
+    }
+    else
+    {
+        // In the case of a differential conversion, it was observed that if V+'s voltage is
+        // under V-'s, the measured voltage is equal to `-5.0 + abs(V+ - V-)`.
+        if (value < 0.0f)
         {
-            LTC_ERROR("Under range detected! (0x%08X)", raw);
-            m_lastReading.raw     = 0x0FFFFFFF;    // Code for under range.
-            m_lastReading.reading = 0.0f;
-            return;
+            value = -5.0f - value;
         }
+    }
 
-        // Bit 28 to 5 is the conversion result.
-        raw = (raw & 0x1FFFFFE0) >> 5;
+    m_lastReading.reading = value;
+}
 
-        // Apply the sign.
-        int32_t hex = (int32_t)raw * sign;
+#    if defined(NILAI_LTC2498_USE_SCAN)
+bool Ltc2498Module::StartScan(const std::vector<LTC2498::ConversionSettings>& conversions,
+                              Nilai::Events::EventTypes                       eoc,
+                              bool                                            repeat)
+{
+    StopScan();
 
-        m_lastReading.raw = hex;
+    std::array<Nilai::Interfaces::Ltc2498::SlotConfig, NILAI_LTC2498_SCAN_SLOTS> slots = {};
+    if (conversions.size() > slots.size())
+    {
+        LTC_ERROR("Unable to scan %u conversions, the maximum is %u.",
+                  conversions.size(),
+                  slots.size());
+        return false;
+    }
+    for (size_t i = 0; i < conversions.size(); i++)
+    {
+        slots[i] = conversions[i].ToRegValues();
+    }
+    if (!m_scan.Configure({slots.data(), conversions.size()}, repeat))
+    {
+        LTC_ERROR("Unable to scan, no conversions were given.");
+        return false;
+    }
 
-        // Convert the raw reading into volts.
-        // Full scale of the chip is 0.5Vref, Vref being 5V.
-        float value = (float)hex * (5.0f / 16777216.0f);
+    // Any conversion started by polling is abandoned.
+    m_conversions.clear();
+    m_currentConversion = m_conversions.end();
+    m_isConverting      = false;
 
-        // In the case of a single-ended conversion, it was observed that if the input voltage is
-        // inferior to the common voltage, the measured voltage is equal to `-Vcom - Vin` instead of
-        // the `Vin - Vcom` that is expected. We thus need to compensate for this.
-        if (config.type == LTC2498::AcquisitionTypes::SingleEnded)
-        {
-            if (value < 0.0f)
-            {
-                value = (value * -1.0f) - m_vcom;
-            }
-            else
-            {
-                value = (value + m_vcom);
-            }
-        }
-        else
+    SetMisoAsMiso();
+    m_scan.ResetStats();
+    m_scan.Start();
+    m_eocEvent = eoc;
+    m_eocCbId  = Nilai::Application::Get().RegisterEventCallback(
+      eoc,
+      [this](Nilai::Events::Event* e)
+      {
+          if (e->Type != m_eocEvent || !m_scanning)
+          {
+              return false;
+          }
+          // MISO also toggles while a frame is read, only a low level is an end of conversion.
+          if (!m_misoPin.Get())
+          {
+              OnEndOfConversion(e->Timestamp);
+          }
+          return true;
+      },
+      Nilai::Events::DispatchMode::Immediate);
+    m_scanning = true;
+
+    // A conversion that ended before the scan started produced no edge.
+    if (!m_misoPin.Get())
+    {
+        OnEndOfConversion(HAL_GetTick());
+    }
+    LTC_INFO("Scan of %u conversions started.", conversions.size());
+    return true;
+}
+
+void Ltc2498Module::StopScan()
+{
+    if (!m_scanning)
+    {
+        return;
+    }
+
+    m_scanning = false;
+    m_scan.Stop();
+    Nilai::Application::Get().UnregisterEventCallback(m_eocEvent, m_eocCbId);
+    // Lets the frame being read, if any, release the bus before monitoring MISO again.
+    uint32_t start = HAL_GetTick();
+    while (m_scan.IsBusy())
+    {
+        if (HAL_GetTick() - start > s_stopTimeout)
         {
-            // In the case of a differential conversion, it was observed that if V+'s voltage is
-            // under V-'s, the measured voltage is equal to `-5.0 + abs(V+ - V-)`.
-            if (value < 0.0f)
-            {
-                value = -5.0f - value;
-            }
+            // The SPI never completed the frame, its result is lost.
+            LTC_ERROR("Timed out waiting for the last frame of the scan!");
+            break;
         }
+    }
+    SetMisoAsGpio();
+
+    const Nilai::Interfaces::Ltc2498::ScanStats& stats = m_scan.Stats();
+    LTC_INFO("Scan stopped: %u conversions, %u sweeps, %u invalid, %u failed frames.",
+             stats.Conversions,
+             stats.Sweeps,
+             stats.Invalid,
+             stats.FailedFrames);
+}
+
+std::optional<float> Ltc2498Module::GetScanReading(size_t slot) const
+{
+    const Nilai::Interfaces::Ltc2498::Result& result = m_scan.GetResult(slot);
+    // Slots that don't exist read as having no result.
+    if (result.Status != Nilai::Interfaces::Ltc2498::ResultStatus::Ok)
+    {
+        return std::nullopt;
+    }
 
-        m_lastReading.reading = value;
+    // Full scale is 0.5Vref, Vref being 5V.
+    float value = Nilai::Interfaces::Ltc2498::ToVolts(result.Raw, 5.0f);
+    if ((m_scan.GetConfig(slot)[0] & 0x10) != 0)
+    {
+        // Single-ended conversions are referenced to COM.
+        value += m_vcom;
     }
+    return value;
+}
 
+bool Ltc2498Module::OnEndOfConversion(uint32_t timestamp)
+{
+    scan_t::Frame frame;
+    if (!m_scan.BeginFrame(frame, timestamp))
+    {
+        return false;
+    }
+
+    // The chip select stays low after the frame, for MISO to signal the end of the conversion.
+    Nilai::Drivers::Spi::Transaction t = {
+      .Tx     = frame.Tx,
+      .Rx     = frame.Rx,
+      .Cs     = m_csPin,
+      .KeepCs = true,
+      .Cb     = &Ltc2498Module::OnScanFrame,
+      .Ctx    = this,
+    };
+    if (!m_spi->Submit(t))
+    {
+        OnScanFrame(t, false, this);
+    }
+    return true;
+}
+
+void Ltc2498Module::OnScanFrame([[maybe_unused]] const Nilai::Drivers::Spi::Transaction& t,
+                                bool                                                    ok,
+                                void*                                                   ctx)
+{
+    auto* self = static_cast<Ltc2498Module*>(ctx);
+    self->m_scan.EndFrame(ok);
+    if (ok || !self->m_scanning)
+    {
+        return;
+    }
+
+    // The chip select was released by the failure. If the conversion is already over, no edge
+    // will come once it is pulled low again.
+    self->m_csPin.Set(false);
+    if (!self->m_misoPin.Get())
+    {
+        self->OnEndOfConversion(HAL_GetTick());
+    }
+}
+#    endif
 #endif
@@ -16,14 +16,28 @@
 #    if !defined(NILAI_USE_SPI)
 #        error The SPI module must be enabled in order to use the LTC2498 Module
 #    endif
-#    include "defines/internalConfig.h"
+#    include "../defines/internal_config.h"
 #    include NILAI_HAL_HEADER
-#    include "defines/module.hpp"
-#    include "defines/pin.h"
-#    include "drivers/spiModule.hpp"
+#    include "../defines/module.h"
+#    include "../defines/pin.h"
+#    include "../drivers/spi_module.h"
+
+#    if defined(NILAI_LTC2498_USE_SCAN)
+#        if !defined(NILAI_SPI_USE_QUEUE) || !defined(NILAI_USE_EVENTS)
+#            error The LTC2498 scan requires NILAI_SPI_USE_QUEUE and NILAI_USE_EVENTS
+#        endif
+#        include "../defines/events/events.h"
+
+#        include "LTC2498/ltc2498_scan.h"
+
+#        if !defined(NILAI_LTC2498_SCAN_SLOTS)
+#            define NILAI_LTC2498_SCAN_SLOTS 16
+#        endif
+#    endif
 
 #    include <array>
 #    include <functional>
+#    include <optional>
 #    include <string>
 #    include <vector>
 
@@ -146,17 +160,21 @@ using CurrentConversion = std::vector<ConversionSettings>::iterator;
 
 class Ltc2498Module : public Nilai::Module
 {
+#    if defined(NILAI_LTC2498_USE_SCAN)
+    using scan_t = Nilai::Interfaces::Ltc2498::ScanEngine<NILAI_LTC2498_SCAN_SLOTS>;
+#    endif
+
 public:
-    Ltc2498Module(const std::string& label,
-                  SpiModule*         spi,
-                  const Nilai::Pin&  inPin,
-                  const Nilai::Pin&  csPin,
-                  float              vcom = 0.00f);
-    virtual ~Ltc2498Module() override = default;
+    Ltc2498Module(const std::string&          label,
+                  Nilai::Drivers::SpiModule* spi,
+                  const Nilai::Pin&          inPin,
+                  const Nilai::Pin&          csPin,
+                  float                      vcom = 0.00f);
+    ~Ltc2498Module() override = default;
 
-    virtual bool               DoPost() override;
-    virtual void               Run() override;
-    virtual const std::string& GetLabel() const override { return m_label; }
+    bool                             DoPost() override;
+    void                             Run() override;
+    [[nodiscard]] const std::string& GetLabel() const { return m_label; }
 
     bool QueueConversions(const std::vector<LTC2498::ConversionSettings>& conversions,
                           bool                                            repeat = false);
@@ -167,12 +185,57 @@ public:
 
     bool StartConversion(const LTC2498::ConversionSettings& config);
 
+#    if defined(NILAI_LTC2498_USE_SCAN)
+    /**
+     * @brief Converts a list of channels one after the other, without polling.
+     *
+     * Each end of conversion queues a single SPI frame that reads the result of the conversion
+     * that just ended while programming the next one, so the converter never waits for the main
+     * loop. The results are stored in a table, read with @ref GetScanResult.
+     *
+     * The chip select is kept low for the whole scan, the LTC2498 signalling the end of each
+     * conversion by pulling MISO low. The application must route the MISO pin to its EXTI line,
+     * on the falling edge, without taking it out of its SPI alternate function, and raise
+     * @p eoc from that interrupt. Edges caused by the frames themselves are ignored. As it drives
+     * MISO for the whole scan, the LTC2498 can't share its bus with other devices while scanning.
+     *
+     * The callbacks of the settings are not called.
+     *
+     * @param conversions The conversions, at most NILAI_LTC2498_SCAN_SLOTS of them.
+     * @param eoc The event raised on the falling edge of MISO.
+     * @param repeat If true, the scan runs until @ref StopScan is called.
+     * @return False if the list is empty or too long.
+     */
+    bool StartScan(const std::vector<LTC2498::ConversionSettings>& conversions,
+                   Nilai::Events::EventTypes                       eoc,
+                   bool                                            repeat = true);
+    void StopScan();
+    [[nodiscard]] bool IsScanning() const { return m_scanning && m_scan.IsRunning(); }
+
+    [[nodiscard]] const Nilai::Interfaces::Ltc2498::Result& GetScanResult(size_t slot) const
+    {
+        return m_scan.GetResult(slot);
+    }
+    /**
+     * @brief Gets the last result of a slot in volts, referenced to COM for single-ended
+     * conversions.
+     * @return Nothing if the slot doesn't exist, has no valid result yet, or if its input is out of
+     * range. @ref GetScanResult tells which.
+     */
+    [[nodiscard]] std::optional<float> GetScanReading(size_t slot) const;
+
+    [[nodiscard]] const Nilai::Interfaces::Ltc2498::ScanStats& GetScanStats() const
+    {
+        return m_scan.Stats();
+    }
+#    endif
+
 private:
-    std::string m_label   = "";
-    SpiModule*  m_spi     = nullptr;
-    Nilai::Pin  m_misoPin = {};
-    Nilai::Pin  m_csPin   = {};
-    float       m_vcom    = 0.00f;
+    std::string                m_label   = "";
+    Nilai::Drivers::SpiModule* m_spi     = nullptr;
+    Nilai::Pin                 m_misoPin = {};
+    Nilai::Pin                 m_csPin   = {};
+    float                      m_vcom    = 0.00f;
 
     std::vector<LTC2498::ConversionSettings> m_conversions       = {};
     LTC2498::CurrentConversion               m_currentConversion = m_conversions.end();
@@ -182,6 +245,16 @@ private:
 
     LTC2498::Reading m_lastReading = {};
 
+#    if defined(NILAI_LTC2498_USE_SCAN)
+    //! Time StopScan waits for the frame being read, in ticks. A frame takes well under a tick.
+    static constexpr uint32_t s_stopTimeout = 2;
+
+    scan_t                    m_scan     = {};
+    Nilai::Events::EventTypes m_eocEvent = Nilai::Events::EventTypes::Exti_Generic;
+    size_t                    m_eocCbId  = 0;
+    bool                      m_scanning = false;
+#    endif
+
 private:
     void                       SetMisoAsGpio();
     void                       SetMisoAsMiso();
@@ -189,6 +262,11 @@ private:
     std::array<uint8_t, 4>     SetNextConvAndReadResults(const std::array<uint8_t, 4>& config);
     void                       ParseConversionResult(const std::array<uint8_t, 4>&      resp,
                                                      const LTC2498::ConversionSettings& config);
+
+#    if defined(NILAI_LTC2498_USE_SCAN)
+    bool        OnEndOfConversion(uint32_t timestamp);
+    static void OnScanFrame(const Nilai::Drivers::Spi::Transaction& t, bool ok, void* ctx);
+#    endif
 };
 
 /***********************************************/
@@ -33,4 +33,29 @@ bool IsDebuggerConnected()
 {
     return (((*(volatile uint32_t*)0xE000EDF0) & (1 << 0)) != 0u);
 }
+
+uint32_t EnterCritical()
+{
+#if !defined(NILAI_TEST)
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+#else
+    return 0;
+#endif
+}
+
+void ExitCritical([[maybe_unused]] uint32_t state)
+{
+#if !defined(NILAI_TEST)
+    __set_PRIMASK(state);
+#endif
+}
+
+void WaitForInterrupt()
+{
+#if !defined(NILAI_TEST)
+    __WFI();
+#endif
+}
 }    // namespace Nilai::System
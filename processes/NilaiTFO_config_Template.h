@@ -63,6 +63,26 @@
  */
 #    define NILAI_MAX_PROFILE_EVENTS 20
 //!@}
+
+/**
+ * @addtogroup NILAI_PROFILE_MAX_MODULES
+ * @{
+ * @brief Sets the maximum number of modules whose Run is timed by the profiler.
+ *
+ * Default: NILAI_MAX_MODULE_AMOUNT
+ */
+#    define NILAI_PROFILE_MAX_MODULES NILAI_MAX_MODULE_AMOUNT
+//!@}
+
+/**
+ * @addtogroup NILAI_PROFILE_MAX_ISRS
+ * @{
+ * @brief Sets the maximum number of interrupts that can be timed with NILAI_PROFILE_ISR.
+ *
+ * Default: 8
+ */
+#    define NILAI_PROFILE_MAX_ISRS 8
+//!@}
 //!@}
 
 /**
@@ -114,6 +134,17 @@
 #    define NILAI_MAX_MODULE_AMOUNT 16
 //!@}
 
+/**
+ * @addtogroup NILAI_USE_SCHEDULER
+ * @{
+ * @brief If defined, the application only runs the modules that are due, according to their
+ * run policy, and puts the core to sleep when none of them have anything to do.
+ *
+ * Modules run on every pass by default. See Module::SetRunPeriod and Module::SetRunOnSignal.
+ */
+// #    define NILAI_USE_SCHEDULER
+//!@}
+
 /**
  * @addtogroup nilai_log_opts Logging Options
  * @{
@@ -130,6 +161,81 @@
 #    define NILAI_LOGGER_USE_RTC
 //!@}
 
+/**
+ * @addtogroup NILAI_LOGGER_DEFERRED
+ * @{
+ * @brief If defined, the LOG_ macros record binary messages instead of formatting them.
+ *
+ * Only the address of the format string, the time and the arguments are recorded, which is cheap
+ * enough to log from an interrupt. Logger::FlushDeferred sends the messages as binary frames, they
+ * are decoded on the host with the firmware's ELF file, see services/deferred_log_decoder.h.
+ *
+ * Takes precedence over NILAI_LOGGER_USE_RTC.
+ */
+// #    define NILAI_LOGGER_DEFERRED
+//!@}
+
+/**
+ * @addtogroup NILAI_LOG_DEFERRED_RECORD_SIZE
+ * @{
+ * @brief Size of a deferred message, in bytes. 10 bytes are used by the header of the message,
+ * the rest holds the arguments.
+ *
+ * Default: 48
+ */
+#    define NILAI_LOG_DEFERRED_RECORD_SIZE 48
+//!@}
+
+/**
+ * @addtogroup NILAI_LOG_DEFERRED_DEPTH
+ * @{
+ * @brief Number of deferred messages that can wait to be sent. Must be a power of two.
+ *
+ * Default: 64
+ */
+#    define NILAI_LOG_DEFERRED_DEPTH 64
+//!@}
+
+/**
+ * @addtogroup NILAI_LOGGER_ASYNC
+ * @{
+ * @brief If defined, messages are written to a ring buffer instead of being sent right away.
+ *
+ * The sinks (UART, callback, file logger) are fed from the ring by Logger::Run, which the
+ * application calls once per pass of the main loop. Messages that don't fit in the ring are dropped
+ * and counted, logging never waits for a sink.
+ *
+ * Messages can then be logged from interrupts. Each message is formatted on the stack of the
+ * caller, which takes up to 1 KiB, and the interrupts are only masked while it is copied into the
+ * ring.
+ * Without this option, messages must only be logged from the main loop.
+ *
+ * When NILAI_USE_UART is defined, NILAI_UART_TX_USE_QUEUE must be defined too: the UART is fed
+ * from its transmission queue, without ever waiting for it.
+ */
+// #    define NILAI_LOGGER_ASYNC
+//!@}
+
+/**
+ * @addtogroup NILAI_LOGGER_RING_SIZE
+ * @{
+ * @brief Size of the log ring, in bytes. Must be a power of two.
+ *
+ * Default: 2048
+ */
+#    define NILAI_LOGGER_RING_SIZE 2048
+//!@}
+
+/**
+ * @addtogroup NILAI_LOGGER_MAX_SINKS
+ * @{
+ * @brief Maximum number of sinks reading the log ring.
+ *
+ * Default: 4
+ */
+#    define NILAI_LOGGER_MAX_SINKS 4
+//!@}
+
 /**
  * @defgroup nilai_log_opt_log_levels Log Levels
  * @{
@@ -203,6 +309,64 @@
 //!@}
 //!@}
 
+/**
+ * @addtogroup nilai_crc_opts CRC Options
+ * @{
+ */
+/**
+ * @addtogroup NILAI_CRC_SMALL_TABLES
+ * @{
+ * @brief If defined, the software CRC-32 uses a single 1 KiB table and processes one byte at a
+ * time, instead of 8 KiB of tables and 8 bytes at a time.
+ */
+// #define NILAI_CRC_SMALL_TABLES
+//!@}
+
+/**
+ * @addtogroup NILAI_CRC_USE_DMA
+ * @{
+ * @brief If defined, enables Nilai::Services::CrcDma, which feeds the CRC peripheral with the DMA.
+ */
+// #define NILAI_CRC_USE_DMA
+//!@}
+
+/**
+ * @addtogroup NILAI_CRC_DMA_MIN_WORDS
+ * @{
+ * @brief Buffers shorter than this many words are computed on the CPU by
+ * Nilai::Services::CrcDma.
+ *
+ * Defaults to 256.
+ */
+#    define NILAI_CRC_DMA_MIN_WORDS 256
+//!@}
+//!@}
+
+/**
+ * @addtogroup nilai_dsp_opts DSP Options
+ * @{
+ */
+/**
+ * @addtogroup NILAI_DSP_PORTABLE
+ * @{
+ * @brief If defined, the audio DSP blocks of Nilai::Services::Dsp use their portable kernels even
+ * on cores with the DSP extension.
+ */
+// #define NILAI_DSP_PORTABLE
+//!@}
+
+/**
+ * @addtogroup NILAI_DSP_SRC_MAX_PHASES
+ * @{
+ * @brief Maximum number of phases of Nilai::Services::Dsp::Resampler, which is the output rate
+ * divided by the greatest common divisor of both rates. Each phase takes TapsPerPhase coefficients.
+ *
+ * Defaults to 1024.
+ */
+#    define NILAI_DSP_SRC_MAX_PHASES 1024
+//!@}
+//!@}
+
 /**
  * @addtogroup nilai_event_opts Event Options
  * @{
@@ -225,6 +389,50 @@
 #        define NILAI_EVENTS_MAX_CALLBACKS 1
 //!@}
 
+/**
+ * @addtogroup NILAI_EVENTS_CALLBACK_SIZE
+ * @{
+ * @brief Sets the number of bytes available to store the captures of an event callback
+ * (Default: 4 pointers).
+ */
+#        define NILAI_EVENTS_CALLBACK_SIZE (4 * sizeof(void*))
+//!@}
+
+/**
+ * @addtogroup NILAI_EVENTS_DATA_EVENT_SIZE
+ * @{
+ * @brief Sets the maximum size of the data carried by a DataEvent, in bytes (Default: 32).
+ */
+#        define NILAI_EVENTS_DATA_EVENT_SIZE 32
+//!@}
+
+/**
+ * @addtogroup NILAI_EVENTS_RECORD_SIZE
+ * @{
+ * @brief Sets the size of the largest event that can be posted from an interrupt, in bytes
+ * (Default: 64).
+ */
+#        define NILAI_EVENTS_RECORD_SIZE 64
+//!@}
+
+/**
+ * @addtogroup NILAI_EVENTS_QUEUE_DEPTH
+ * @{
+ * @brief Sets the number of posted events each priority queue can hold. Must be a power of 2
+ * (Default: 8).
+ */
+#        define NILAI_EVENTS_QUEUE_DEPTH 8
+//!@}
+
+/**
+ * @addtogroup NILAI_EVENTS_BUDGET_US
+ * @{
+ * @brief Sets the maximum time spent dispatching posted events per iteration of the main loop,
+ * in microseconds. 0 means no limit (Default: 500).
+ */
+#        define NILAI_EVENTS_BUDGET_US 500
+//!@}
+
 /**
  * @addtogroup NILAI_USE_ADC_EVENTS
  * @{
@@ -653,6 +861,17 @@
  */
 #        define NILAI_TAS5760_VERIFY_WRITE
 //!@}
+
+/**
+ * @addtogroup NILAI_TAS5760_VERIFY_INTERVAL
+ * @{
+ * @brief Defines how often the writes are verified when @ref NILAI_TAS5760_VERIFY_WRITE is used:
+ * one burst out of this many is read back.
+ *
+ * Defaults to 1, every burst is verified.
+ */
+#        define NILAI_TAS5760_VERIFY_INTERVAL 1
+//!@}
 //!@}
 #    endif
 
@@ -708,6 +927,17 @@
  */
 #        define NILAI_ADC_STATUS_STRING
 //!@}
+
+/**
+ * @addtogroup NILAI_ADC_USE_STREAM
+ * @{
+ * @brief If defined, enables AdcModule::StartStream, which acquires timer-triggered scans through
+ * a circular DMA buffer and hands blocks of decimated samples to the application.
+ *
+ * @attention Requires the TIM HAL module.
+ */
+// #define NILAI_ADC_USE_STREAM
+//!@}
 //!@}
 #    endif
 
@@ -731,6 +961,284 @@
  */
 #        define NILAI_UART_RX_FRAME_BUFF_SIZE 4
 //!@}
+
+/**
+ * @addtogroup NILAI_UART_RX_USE_FRAME_POOL
+ * @{
+ * @brief If defined, the DMA receives directly in a statically sized pool of
+ * @ref NILAI_UART_RX_FRAME_BUFF_SIZE slots instead of allocating a new frame for every reception.
+ *
+ * Frames are then read with UartModule::ReceiveView and must be handed back with
+ * UartModule::Release.
+ */
+// #        define NILAI_UART_RX_USE_FRAME_POOL
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_RX_POOL_SLOT_SIZE
+ * @{
+ * @brief Defines the maximum size of a frame when @ref NILAI_UART_RX_USE_FRAME_POOL is used.
+ *
+ * Defaults to 64.
+ */
+#        define NILAI_UART_RX_POOL_SLOT_SIZE 64
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_RX_USE_CIRCULAR_DMA
+ * @{
+ * @brief If defined, the RX DMA runs continuously in circular mode over a single ring and frames
+ * are delimited by idle-line events.
+ *
+ * The DMA stream of the UART must be configured in circular mode.
+ * Frames are then read with UartModule::ReceiveView and must be handed back in order with
+ * UartModule::Release.
+ *
+ * @attention Can't be used with @ref NILAI_UART_RX_USE_FRAME_POOL.
+ */
+// #        define NILAI_UART_RX_USE_CIRCULAR_DMA
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_RX_RING_SIZE
+ * @{
+ * @brief Defines the size of the reception ring when @ref NILAI_UART_RX_USE_CIRCULAR_DMA is used.
+ *
+ * Defaults to 256.
+ */
+#        define NILAI_UART_RX_RING_SIZE 256
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_TX_USE_QUEUE
+ * @{
+ * @brief If defined, UartModule::Transmit queues the data and returns immediately instead of
+ * waiting for the previous transmission to complete.
+ *
+ * Queued segments are sent back-to-back, the next one being started from the transmission
+ * complete interrupt.
+ */
+// #        define NILAI_UART_TX_USE_QUEUE
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_TX_QUEUE_DEPTH
+ * @{
+ * @brief Defines the maximum number of segments waiting to be sent when
+ * @ref NILAI_UART_TX_USE_QUEUE is used.
+ *
+ * Defaults to 8.
+ */
+#        define NILAI_UART_TX_QUEUE_DEPTH 8
+//!@}
+
+/**
+ * @addtogroup NILAI_UART_TX_QUEUE_BUFF_SIZE
+ * @{
+ * @brief Defines the size of the buffer in which the queued data is copied when
+ * @ref NILAI_UART_TX_USE_QUEUE is used. Must be a power of 2.
+ *
+ * A message larger than the buffer can't be queued, it must be at least as large as the biggest
+ * message transmitted at once. The logger sends messages of up to 1024 bytes.
+ *
+ * Defaults to 1024.
+ */
+#        define NILAI_UART_TX_QUEUE_BUFF_SIZE 1024
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_SPI)
+/**
+ * @addtogroup NILAI_SPI_USE_QUEUE
+ * @{
+ * @brief If defined, enables SpiModule::Submit, which queues transactions that are then run with
+ * DMA without blocking the caller.
+ *
+ * Queued transactions are run back-to-back, the next one being started from the transfer complete
+ * interrupt. The DMA streams of the SPI must be configured.
+ *
+ * @attention Can't be used with @ref NILAI_USE_SPI_EVENTS.
+ */
+// #        define NILAI_SPI_USE_QUEUE
+//!@}
+
+/**
+ * @addtogroup NILAI_SPI_QUEUE_DEPTH
+ * @{
+ * @brief Defines the maximum number of transactions waiting on each SPI bus when
+ * @ref NILAI_SPI_USE_QUEUE is used.
+ *
+ * Defaults to 8.
+ */
+#        define NILAI_SPI_QUEUE_DEPTH 8
+//!@}
+
+/**
+ * @addtogroup NILAI_SPI_MAX_MODULES
+ * @{
+ * @brief Defines the maximum number of SpiModule that can exist at once when
+ * @ref NILAI_SPI_USE_QUEUE is used, to route the DMA interrupts to them.
+ *
+ * Defaults to 6.
+ */
+#        define NILAI_SPI_MAX_MODULES 6
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_ADS)
+/**
+ * @addtogroup NILAI_ADS_USE_STREAMING
+ * @{
+ * @brief If defined, enables AdsModule::StartStreaming, where every frame is read by DMA on the
+ * data ready interrupt and handed to the application in blocks.
+ *
+ * @attention Requires @ref NILAI_SPI_USE_QUEUE and NILAI_USE_EVENTS.
+ */
+// #        define NILAI_ADS_USE_STREAMING
+//!@}
+
+/**
+ * @addtogroup NILAI_ADS_STREAM_BLOCK_FRAMES
+ * @{
+ * @brief Defines the number of frames in each block when @ref NILAI_ADS_USE_STREAMING is used.
+ * Two blocks of 16 bytes per frame are allocated.
+ *
+ * Defaults to 128.
+ */
+#        define NILAI_ADS_STREAM_BLOCK_FRAMES 128
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_LTC2498)
+/**
+ * @addtogroup NILAI_LTC2498_USE_SCAN
+ * @{
+ * @brief If defined, enables Ltc2498Module::StartScan, where each end of conversion reads the
+ * result and programs the next channel in a single DMA frame, without polling.
+ *
+ * @attention Requires @ref NILAI_SPI_USE_QUEUE and NILAI_USE_EVENTS.
+ */
+// #        define NILAI_LTC2498_USE_SCAN
+//!@}
+
+/**
+ * @addtogroup NILAI_LTC2498_SCAN_SLOTS
+ * @{
+ * @brief Defines the maximum number of conversions in a scan when @ref NILAI_LTC2498_USE_SCAN is
+ * used.
+ *
+ * Defaults to 16.
+ */
+#        define NILAI_LTC2498_SCAN_SLOTS 16
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_CAN)
+/**
+ * @addtogroup NILAI_CAN_RX_RING_SIZE
+ * @{
+ * @brief Defines the number of received frames that can wait to be read, for each receive FIFO.
+ * Must be a power of two.
+ *
+ * Defaults to 32.
+ */
+#        define NILAI_CAN_RX_RING_SIZE 32
+//!@}
+
+/**
+ * @addtogroup NILAI_CAN_TX_QUEUE_SIZE
+ * @{
+ * @brief Defines the number of frames that can wait for a transmit mailbox.
+ * CanModule::TransmitFrame fails once the queue is full.
+ *
+ * Defaults to 16.
+ */
+#        define NILAI_CAN_TX_QUEUE_SIZE 16
+//!@}
+
+/**
+ * @addtogroup NILAI_CAN_FILTER_BANKS
+ * @{
+ * @brief Defines the number of filter banks used by the CAN module. The banks after these belong
+ * to the second CAN, on devices that have one.
+ *
+ * Defaults to 14.
+ */
+#        define NILAI_CAN_FILTER_BANKS 14
+//!@}
+
+/**
+ * @addtogroup NILAI_CAN_HANDLER_SIZE
+ * @{
+ * @brief Defines the space available for the captures of the handlers given to
+ * CanModule::Subscribe, in bytes.
+ *
+ * Defaults to 2 * sizeof(void*).
+ */
+#        define NILAI_CAN_HANDLER_SIZE (2 * sizeof(void*))
+//!@}
+
+/**
+ * @addtogroup NILAI_CAN_ISOTP_RX_FRAMES
+ * @{
+ * @brief Defines the number of received frames an ISO-TP channel stores between two calls to
+ * Can::IsoTp::Run.
+ *
+ * Must be a power of two. Defaults to 8.
+ */
+#        define NILAI_CAN_ISOTP_RX_FRAMES 8
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_I2C)
+/**
+ * @addtogroup NILAI_I2C_USE_QUEUE
+ * @{
+ * @brief If defined, enables I2cModule::Submit, which queues jobs that are then run with DMA
+ * without blocking the caller.
+ *
+ * Queued jobs are run back-to-back, the next one being started from the transfer complete
+ * interrupt. The DMA streams of the I2C must be configured.
+ *
+ * @attention Can't be used with @ref NILAI_USE_I2C_EVENTS.
+ */
+// #        define NILAI_I2C_USE_QUEUE
+//!@}
+
+/**
+ * @addtogroup NILAI_I2C_QUEUE_DEPTH
+ * @{
+ * @brief Defines the maximum number of jobs waiting on each I2C bus when
+ * @ref NILAI_I2C_USE_QUEUE is used.
+ *
+ * Defaults to 8.
+ */
+#        define NILAI_I2C_QUEUE_DEPTH 8
+//!@}
+
+/**
+ * @addtogroup NILAI_I2C_MAX_MODULES
+ * @{
+ * @brief Defines the maximum number of I2cModule that can exist at once when
+ * @ref NILAI_I2C_USE_QUEUE is used, to route the DMA interrupts to them.
+ *
+ * Defaults to 4.
+ */
+#        define NILAI_I2C_MAX_MODULES 4
+//!@}
+#    endif
+
+#    if defined(NILAI_USE_I2S) || defined(NILAI_USE_SAI)
+/**
+ * @addtogroup NILAI_AUDIO_USE_PIPELINE
+ * @{
+ * @brief If defined, enables AudioDevice::StartPipeline, which plays frames requested from a
+ * refill callback through a circular DMA buffer, counting the underruns.
+ *
+ * @attention The transmission DMA of the I2S or SAI must be configured in circular mode.
+ */
+// #        define NILAI_AUDIO_USE_PIPELINE
+//!@}
 #    endif
 //!@}
 /* END OF FILE */
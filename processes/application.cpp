@@ -9,13 +9,26 @@
 
 #if defined(NILAI_USE_EVENTS)
 #    include "../defines/macros.h"
+
+#    if !defined(NILAI_EVENTS_BUDGET_US)
+#        define NILAI_EVENTS_BUDGET_US 500
+#    endif
 #endif
 
 #include "../services/profiler/profiler.h"
 
+#if defined(NILAI_USE_LOGGER) && defined(NILAI_LOGGER_ASYNC)
+#    include "../services/logger.h"
+#endif
+
+#if defined(NILAI_USE_SCHEDULER)
+#    include "../defines/system.h"
+#    include "../services/time.h"
+#endif
+
 #include <exception>
 
-static void AtExitForwarder();
+[[maybe_unused]] static void AtExitForwarder();
 
 
 namespace Nilai
@@ -25,22 +38,32 @@ Application* Application::s_instance = nullptr;
 
 Application::Application()
 {
+#if !defined(NILAI_TEST)
+    // On the host, the process must be able to exit normally.
     std::set_terminate(&AtExitForwarder);
     std::signal(SIGABRT, &AbortionHandler);
     std::atexit(&AtExitForwarder);
+#endif
 
     m_modules.reserve(NILAI_MAX_MODULE_AMOUNT);
     m_deletionQueue.reserve(NILAI_MAX_MODULE_AMOUNT);
 
     s_instance = this;
+
+#if defined(NILAI_USE_EVENTS)
+    SetEventBudget(NILAI_EVENTS_BUDGET_US);
+#endif
 }
 
 #if defined(NILAI_USE_EVENTS)
-size_t Application::RegisterEventCallback(Events::EventTypes event, const Events::EventFunction& cb)
+size_t Application::RegisterEventCallback(Events::EventTypes           event,
+                                          const Events::EventFunction& cb,
+                                          Events::DispatchMode         mode)
 {
     NILAI_ASSERT(cb, "Callback is not valid!");
 
-    return InsertCallback(m_callbacks[static_cast<size_t>(event)], cb);
+    return InsertCallback(m_callbacks[static_cast<size_t>(event)],
+                          {cb, true, mode == Events::DispatchMode::Immediate});
 }
 
 void Application::UnregisterEventCallback(Events::EventTypes event, [[maybe_unused]] size_t id)
@@ -56,13 +79,12 @@ void Application::UnregisterEventCallback(Events::EventTypes event, [[maybe_unus
 #    endif
 }
 
-size_t Application::InsertCallback(Application::EventCallbacks& events,
-                                   const Events::EventFunction& cb)
+size_t Application::InsertCallback(Application::EventCallbacks& events, const CallbackSlot& cb)
 {
 #    if NILAI_EVENTS_MAX_CALLBACKS == 1
     if (!events.Used)
     {
-        events = {cb, true};
+        events = cb;
         return 0;
     }
     return -1;
@@ -75,7 +97,7 @@ size_t Application::InsertCallback(Application::EventCallbacks& events,
     if (it != events.end())
     {
         // Place the callback there.
-        *it = {cb, true};
+        *it = cb;
         // Return the ID of the callback.
         return std::distance(events.begin(), it);
     }
@@ -87,20 +109,95 @@ size_t Application::InsertCallback(Application::EventCallbacks& events,
 
 void Application::DispatchEvent(Events::Event* data)
 {
-    const auto& events = m_callbacks[static_cast<size_t>(data->Type)];
-#    if NILAI_EVENTS_MAX_CALLBACKS == 1
-    events.F(data);
-#    else
-    for (const auto& [cb, used] : events)
+    for (const auto& [cb, used, immediate] : GetCallbacks(data->Type))
     {
-        if (cb(data))
+        if (used && cb(data))
         {
             return;
         }
     }
+}
+
+size_t Application::ProcessEvents()
+{
+    NILAI_PROFILE_FUNCTION();
+    time_t start = GetTicks();
+    size_t count = 0;
+
+    // Restart from the highest priority after every event, events might have been posted since.
+    for (size_t priority = 0; priority < s_numOfPriorities;)
+    {
+        if (!m_eventQueues[priority].Pop([this](Events::Event* e)
+                                         { Dispatch(e, Events::DispatchMode::Deferred); }))
+        {
+            priority++;
+            continue;
+        }
+
+        count++;
+        if (m_eventBudget != 0 && GetTicks() - start >= m_eventBudget)
+        {
+            break;
+        }
+        priority = 0;
+    }
+
+    return count;
+}
+
+void Application::SetEventBudget(uint32_t us)
+{
+#    if defined(NILAI_TEST)
+    // On the host, ticks are milliseconds.
+    m_eventBudget = us / 1000;
+#    else
+    // Ticks are CPU cycles.
+    m_eventBudget = us * (SystemCoreClock / 1000000);
+#    endif
+}
+
+size_t Application::GetDroppedEventCount() const noexcept
+{
+    size_t dropped = 0;
+    for (const auto& queue : m_eventQueues)
+    {
+        dropped += queue.Dropped();
+    }
+    return dropped;
+}
+
+std::span<const Application::CallbackSlot> Application::GetCallbacks(Events::EventTypes event) const
+{
+#    if NILAI_EVENTS_MAX_CALLBACKS == 1
+    return {&m_callbacks[static_cast<size_t>(event)], 1};
+#    else
+    return m_callbacks[static_cast<size_t>(event)];
 #    endif
 }
 
+bool Application::HasCallbacks(Events::EventTypes event, Events::DispatchMode mode) const
+{
+    bool immediate = mode == Events::DispatchMode::Immediate;
+    auto callbacks = GetCallbacks(event);
+    return std::any_of(callbacks.begin(),
+                       callbacks.end(),
+                       [immediate](const CallbackSlot& slot)
+                       { return slot.Used && slot.Immediate == immediate; });
+}
+
+bool Application::Dispatch(Events::Event* e, Events::DispatchMode mode)
+{
+    bool immediate = mode == Events::DispatchMode::Immediate;
+    for (const auto& [cb, used, isImmediate] : GetCallbacks(e->Type))
+    {
+        if (used && isImmediate == immediate && cb(e))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 #endif
 
 [[noreturn]] void Application::Run()
@@ -108,6 +205,15 @@ void Application::DispatchEvent(Events::Event* data)
     std::for_each(
       m_modules.begin(), m_modules.end(), [](const ModuleInfo& module) { module.Mod->OnAttach(); });
 
+#if defined(NILAI_USE_SCHEDULER)
+    // Modules might have changed their priority when attached.
+    SortModules();
+#endif
+
+#if defined(NILAI_ENABLE_PROFILING)
+    Profiler::StartCycleCounter();
+#endif
+
     while (true)
     {
         OnRun();
@@ -120,10 +226,29 @@ void Application::DispatchEvent(Events::Event* data)
 void Application::OnRun()
 {
     NILAI_PROFILE_FUNCTION();
-    for (auto& module : m_modules)
+#if defined(NILAI_ENABLE_PROFILING)
+    Profiler::RecordLoop();
+#endif
+#if defined(NILAI_USE_EVENTS)
+    ProcessEvents();
+#endif
+
+#if defined(NILAI_USE_SCHEDULER)
+    bool busy = RunScheduledModules();
+#else
+    for (const auto& module : m_modules)
     {
-        module.Mod->Run();
+        RunModule(module);
     }
+#endif
+
+#if defined(NILAI_USE_LOGGER) && defined(NILAI_LOGGER_ASYNC) && !defined(NILAI_TEST)
+    // The sinks are fed once per pass, after the modules had their chance to log.
+    if (Services::Logger::Get() != nullptr)
+    {
+        Services::Logger::Get()->Run();
+    }
+#endif
 
     if (m_modulesPendingDeletion)
     {
@@ -150,6 +275,113 @@ void Application::OnRun()
 #if defined(NILAI_ENABLE_PROFILING)
     Profiler::Report();
 #endif
+
+#if defined(NILAI_USE_SCHEDULER)
+    if (!busy)
+    {
+        Sleep();
+    }
+#endif
+}
+
+#if defined(NILAI_USE_SCHEDULER)
+time_t Application::GetNextWakeUp() const noexcept
+{
+    return m_timeUntilNextRun == s_noDeadline ? s_noDeadline
+                                              : m_lastSchedule + m_timeUntilNextRun;
+}
+
+void Application::OnIdle([[maybe_unused]] time_t timeUntilNextRun)
+{
+    System::WaitForInterrupt();
+}
+
+void Application::SortModules()
+{
+    std::stable_sort(m_modules.begin(),
+                     m_modules.end(),
+                     [](const ModuleInfo& a, const ModuleInfo& b)
+                     { return a.Mod->GetPriority() > b.Mod->GetPriority(); });
+}
+
+bool Application::RunScheduledModules()
+{
+    time_t now          = GetTime();
+    time_t untilNextRun = s_noDeadline;
+    bool   busy         = false;
+
+    for (auto& info : m_modules)
+    {
+        Module& module = *info.Mod;
+        bool    due    = module.m_signalled;
+
+        switch (module.m_runPolicy)
+        {
+            case RunPolicy::Always:
+                due  = true;
+                busy = true;
+                break;
+            case RunPolicy::Periodic:
+                // Time differences are used, so that the tick counter can wrap around.
+                if (static_cast<int32_t>(now - module.m_nextRun) >= 0)
+                {
+                    due = true;
+                    module.m_nextRun += module.m_runPeriod;
+                    if (static_cast<int32_t>(now - module.m_nextRun) >= 0)
+                    {
+                        // More than a period late, don't try to catch up.
+                        module.m_nextRun = now + module.m_runPeriod;
+                    }
+                }
+                untilNextRun = std::min(untilNextRun, module.m_nextRun - now);
+                break;
+            case RunPolicy::OnSignal:
+            default: break;
+        }
+
+        if (due)
+        {
+            // Cleared first, so that a signal raised while running is not lost.
+            module.m_signalled = false;
+            RunModule(info);
+        }
+    }
+
+    m_lastSchedule     = now;
+    m_timeUntilNextRun = untilNextRun;
+    return busy || untilNextRun == 0;
+}
+
+void Application::Sleep()
+{
+    // An interrupt raised from here on still wakes the core up, it just isn't serviced until the
+    // interrupts are unmasked.
+    System::CriticalSection cs;
+
+    bool signalled = std::any_of(
+      m_modules.begin(), m_modules.end(), [](const ModuleInfo& m) { return m.Mod->m_signalled; });
+#    if defined(NILAI_USE_EVENTS)
+    signalled |= std::any_of(
+      m_eventQueues.begin(), m_eventQueues.end(), [](const auto& q) { return !q.Empty(); });
+#    endif
+    if (signalled)
+    {
+        return;
+    }
+
+    OnIdle(m_timeUntilNextRun);
+}
+#endif
+
+void Application::RunModule(const ModuleInfo& info)
+{
+#if defined(NILAI_ENABLE_PROFILING)
+    uint32_t start = Profiler::GetCycles();
+    info.Mod->Run();
+    Profiler::RecordModule(info.Id, Profiler::GetCycles() - start);
+#else
+    info.Mod->Run();
+#endif
 }
 
 void Application::RemoveModule(size_t id)
@@ -14,15 +14,23 @@
 
 #    include "../defines/smart_pointers.h"
 
+#    include <algorithm>
 #    include <csignal>
 #    include <type_traits>
 #    include <vector>
 
+#    if defined(NILAI_USE_SCHEDULER)
+#        include "../defines/system.h"
+#        include "../services/time.h"
+
+#        include <limits>
+#    endif
+
 #    if defined(NILAI_USE_EVENTS)
 #        include "../defines/events/events.h"
 
 #        include <array>
-#        include <functional>
+#        include <span>
 #    endif
 
 namespace Nilai
@@ -66,7 +74,11 @@ public:
 
         ++m_lastId;
 
-        return *static_cast<T*>(m.Mod.get());
+        T* mod = static_cast<T*>(m.Mod.get());
+#    if defined(NILAI_USE_SCHEDULER)
+        SortModules();
+#    endif
+        return *mod;
     }
 
     void RemoveModule(size_t id);
@@ -94,9 +106,13 @@ public:
      * @param event The event to bind the callback to.
      * @param cb The callback function. This function should return true if the event should not be
      * propagated further.
+     * @param mode Whether the callback is called from the main loop or directly from the interrupt
+     * that posted the event. Events dispatched with @ref DispatchEvent call every callback.
      * @return The ID of the callback. This ID is used to unregister the callback.
      */
-    size_t RegisterEventCallback(Events::EventTypes event, const Events::EventFunction& cb);
+    size_t RegisterEventCallback(Events::EventTypes           event,
+                                 const Events::EventFunction& cb,
+                                 Events::DispatchMode         mode = Events::DispatchMode::Deferred);
 
     /**
      * @brief Unregisters a callback that has previously been registered to an event.
@@ -117,10 +133,81 @@ public:
      * @param data The event data.
      */
     void DispatchEvent(Events::Event* data);
+
+    /**
+     * @brief Posts an event from an interrupt.
+     *
+     * The callbacks registered as @ref Events::DispatchMode::Immediate are called right away.
+     * Unless one of them stops the propagation, the event is then copied in the queue of the given
+     * priority, to be dispatched to the deferred callbacks by the main loop.
+     *
+     * @param e The event.
+     * @param priority The queue in which the event is placed.
+     * @return False if the event had to be queued but the queue was full.
+     */
+    template<typename E>
+        requires std::derived_from<E, Events::Event>
+    bool PostEvent(E e, Events::EventPriority priority = Events::EventPriority::Normal)
+    {
+        if (Dispatch(&e, Events::DispatchMode::Immediate))
+        {
+            return true;
+        }
+        if (!HasCallbacks(e.Type, Events::DispatchMode::Deferred))
+        {
+            return true;
+        }
+        return m_eventQueues[static_cast<size_t>(priority)].Push(e);
+    }
+
+    /**
+     * @brief Dispatches the posted events to the deferred callbacks, highest priority first.
+     *
+     * Called by @ref OnRun. Stops once the time budget set with @ref SetEventBudget is spent, at
+     * least one event is always processed.
+     *
+     * @return The number of events dispatched.
+     */
+    size_t ProcessEvents();
+
+    /**
+     * @brief Sets the maximum time spent dispatching posted events per iteration of the main loop.
+     * @param us The budget, in microseconds. 0 means no limit.
+     */
+    void SetEventBudget(uint32_t us);
+
+    /**
+     * @brief Gets the number of posted events that were lost because their queue was full.
+     */
+    [[nodiscard]] size_t GetDroppedEventCount() const noexcept;
+#    endif
+
+#    if defined(NILAI_USE_SCHEDULER)
+    static constexpr time_t s_noDeadline = std::numeric_limits<time_t>::max();
+
+    /**
+     * @brief Gets the time at which the next periodic module is due.
+     * @return The time, or @ref s_noDeadline if no periodic module is waiting.
+     */
+    [[nodiscard]] time_t GetNextWakeUp() const noexcept;
 #    endif
 
     static Application& Get() { return *s_instance; }
 
+protected:
+#    if defined(NILAI_USE_SCHEDULER)
+    /**
+     * @brief Called with the interrupts masked when no module has anything to do.
+     *
+     * Waits for an interrupt by default. Can be overridden to enter a deeper sleep mode, as long
+     * as the core is woken up before the next periodic module is due.
+     *
+     * @param timeUntilNextRun Time before the next periodic module is due, in milliseconds, or
+     * @ref s_noDeadline if only an interrupt can give work to the modules.
+     */
+    virtual void OnIdle(time_t timeUntilNextRun);
+#    endif
+
 private:
     size_t m_lastId = 0;
     //! List of the modules to remove from the application.
@@ -128,12 +215,33 @@ private:
 
     bool m_modulesPendingDeletion = false;
 
+    /**
+     * @brief Runs a module, timing it when profiling is enabled.
+     */
+    static void RunModule(const ModuleInfo& info);
+
+#    if defined(NILAI_USE_SCHEDULER)
+    //! Time at which the modules were last scheduled.
+    time_t m_lastSchedule = 0;
+    //! Time between the last scheduling and the next periodic module being due.
+    time_t m_timeUntilNextRun = s_noDeadline;
+
+    void SortModules();
+    /**
+     * @brief Runs the modules that are due, highest priority first.
+     * @return True if a module must run again on the next pass.
+     */
+    bool RunScheduledModules();
+    void Sleep();
+#    endif
+
 #    if defined(NILAI_USE_EVENTS)
 protected:
     struct CallbackSlot
     {
-        Events::EventFunction F    = [](Events::Event*) { return false; };
-        bool                  Used = false;
+        Events::EventFunction F         = nullptr;
+        bool                  Used      = false;
+        bool                  Immediate = false;
     };
 #        if NILAI_EVENTS_MAX_CALLBACKS == 1
     using EventCallbacks = CallbackSlot;
@@ -145,8 +253,21 @@ protected:
     static constexpr size_t s_numOfEvents = static_cast<size_t>(Events::EventTypes::Count);
     std::array<EventCallbacks, s_numOfEvents> m_callbacks = {};
 
+    using EventQueue = Events::EventQueue<NILAI_EVENTS_RECORD_SIZE, NILAI_EVENTS_QUEUE_DEPTH>;
+    static constexpr size_t s_numOfPriorities = static_cast<size_t>(Events::EventPriority::Count);
+    std::array<EventQueue, s_numOfPriorities> m_eventQueues = {};
+    time_t                                    m_eventBudget = 0;
+
 private:
-    static size_t InsertCallback(EventCallbacks& events, const Events::EventFunction& cb);
+    static size_t InsertCallback(EventCallbacks& events, const CallbackSlot& cb);
+
+    [[nodiscard]] std::span<const CallbackSlot> GetCallbacks(Events::EventTypes event) const;
+    [[nodiscard]] bool HasCallbacks(Events::EventTypes event, Events::DispatchMode mode) const;
+    /**
+     * @brief Calls the callbacks registered with the given mode.
+     * @return True if a callback stopped the propagation of the event.
+     */
+    bool Dispatch(Events::Event* e, Events::DispatchMode mode);
 #    endif
 
     static Application* s_instance;
@@ -20,25 +20,177 @@
 #include "../../defines/internal_config.h"
 #include NILAI_HAL_HEADER
 
+#if defined(NILAI_CRC_USE_DMA) && defined(HAL_CRC_MODULE_ENABLED)
+#    include "../../defines/system.h"
+
+#    include <algorithm>
+#endif
+
 namespace Nilai::Services
 {
+namespace
+{
+#if defined(HAL_CRC_MODULE_ENABLED)
+CRC_TypeDef* Peripheral()
+{
+    return reinterpret_cast<CRC_TypeDef*>(CRC_BASE);
+}
+
+/**
+ * @brief Resets the peripheral so that it starts from @p initial.
+ * @return False if the peripheral can't start from that value.
+ */
+bool StartPeripheral(uint32_t initial)
+{
+#    if defined(CRC_INIT_INIT)
+    Peripheral()->INIT = initial;
+#    else
+    // The initial value isn't programmable, it is always 0xFFFFFFFF.
+    if (initial != 0xFFFFFFFF)
+    {
+        return false;
+    }
+#    endif
+    Peripheral()->CR = Peripheral()->CR | CRC_CR_RESET;
+    return true;
+}
+#endif
+
+#if defined(NILAI_CRC_USE_DMA) && defined(HAL_CRC_MODULE_ENABLED)
+//! The DMA transfers at most this many words at once, longer buffers are sent in chunks.
+constexpr size_t s_maxDmaWords = 0xFFFF;
+
+struct DmaJob
+{
+    DMA_HandleTypeDef* Dma       = nullptr;
+    const uint32_t*    Next      = nullptr;
+    size_t             Remaining = 0;
+    CrcCallback        Cb        = nullptr;
+    void*              Ctx       = nullptr;
+};
+
+DmaJob        s_dmaJob  = {};
+volatile bool s_dmaBusy = false;
+
+bool StartDmaChunk()
+{
+    size_t count = std::min(s_dmaJob.Remaining, s_maxDmaWords);
+    auto   src   = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(s_dmaJob.Next));
+    auto   dst   = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&Peripheral()->DR));
+    if (HAL_DMA_Start_IT(s_dmaJob.Dma, src, dst, static_cast<uint32_t>(count)) != HAL_OK)
+    {
+        return false;
+    }
+    s_dmaJob.Next += count;
+    s_dmaJob.Remaining -= count;
+    return true;
+}
+
+void FinishDma(bool ok)
+{
+    DmaJob   job = s_dmaJob;
+    uint32_t crc = Peripheral()->DR;
+    s_dmaBusy    = false;
+    if (job.Cb != nullptr)
+    {
+        job.Cb(ok, crc, job.Ctx);
+    }
+}
+
+void OnDmaComplete([[maybe_unused]] DMA_HandleTypeDef* dma)
+{
+    if (s_dmaJob.Remaining == 0)
+    {
+        FinishDma(true);
+    }
+    else if (!StartDmaChunk())
+    {
+        FinishDma(false);
+    }
+}
+
+void OnDmaError([[maybe_unused]] DMA_HandleTypeDef* dma)
+{
+    FinishDma(false);
+}
+#endif
+}    // namespace
 
 uint32_t Crc(const uint32_t* data, size_t len, uint32_t initial)
 {
 #if defined(HAL_CRC_MODULE_ENABLED)
-    auto* crc = reinterpret_cast<CRC_TypeDef*>(CRC_BASE);
-    crc->DR   = initial;
-    for (size_t i = 0; i < len; i++)
-    {
-        crc->DR = data[i];
-    }
-    return crc->DR;
-#else
-    // TODO Implement crc
-    (void)data;
-    (void)len;
-    (void)initial;
-    return 0;
+#    if defined(NILAI_CRC_USE_DMA)
+    bool idle = !s_dmaBusy;
+#    else
+    bool idle = true;
+#    endif
+    if (idle && StartPeripheral(initial))
+    {
+        auto* crc = Peripheral();
+        for (size_t i = 0; i < len; i++)
+        {
+            crc->DR = data[i];
+        }
+        return crc->DR;
+    }
 #endif
+    return Crc32Mpeg2 {initial}.UpdateWords({data, len}).Value();
 }
+
+#if defined(NILAI_CRC_USE_DMA)
+bool CrcDma(DMA_HandleTypeDef* dma,
+            const uint32_t*    data,
+            size_t             len,
+            CrcCallback        cb,
+            void*              ctx,
+            uint32_t           initial)
+{
+#    if defined(HAL_CRC_MODULE_ENABLED)
+    if (len >= NILAI_CRC_DMA_MIN_WORDS)
+    {
+        {
+            System::CriticalSection lock;
+            if (s_dmaBusy)
+            {
+                return false;
+            }
+            s_dmaBusy = true;
+        }
+
+        if (StartPeripheral(initial))
+        {
+            s_dmaJob               = {dma, data, len, cb, ctx};
+            dma->XferCpltCallback  = &OnDmaComplete;
+            dma->XferErrorCallback = &OnDmaError;
+            if (StartDmaChunk())
+            {
+                return true;
+            }
+            s_dmaBusy = false;
+            return false;
+        }
+        // The peripheral can't start from that value, computed on the CPU instead.
+        s_dmaBusy = false;
+    }
+#    else
+    (void)dma;
+#    endif
+
+    uint32_t crc = Crc(data, len, initial);
+    if (cb != nullptr)
+    {
+        cb(true, crc, ctx);
+    }
+    return true;
+}
+
+bool CrcDmaBusy()
+{
+#    if defined(HAL_CRC_MODULE_ENABLED)
+    return s_dmaBusy;
+#    else
+    return false;
+#    endif
+}
+#endif
 }    // namespace Nilai::Services
@@ -33,12 +33,31 @@
  * @{
  */
 
+#include "software_crc.h"
+
+#if defined(NILAI_CRC_USE_DMA)
+#    include "../../defines/internal_config.h"
+#    include NILAI_HAL_HEADER
+#endif
+
 #include <array>
 #include <cstdint>
 #include <vector>
 
+#if !defined(NILAI_CRC_DMA_MIN_WORDS)
+#    define NILAI_CRC_DMA_MIN_WORDS 256
+#endif
+
 namespace Nilai::Services
 {
+/**
+ * @brief Computes the CRC-32/MPEG-2 of words, the most significant byte of each word first.
+ *
+ * Uses the CRC peripheral when it is available and idle, @ref Crc32Mpeg2 otherwise. Both give the
+ * same result.
+ *
+ * @param initial The value the CRC starts from.
+ */
 uint32_t Crc(const uint32_t* data, size_t len, uint32_t initial = 0xFFFFFFFF);
 
 template<size_t N>
@@ -52,6 +71,41 @@ static uint32_t Crc(const std::array<uint32_t, N>& array, uint32_t initial = 0xF
 {
     return Crc(array.data(), array.size(), initial);
 }
+
+#if defined(NILAI_CRC_USE_DMA)
+/**
+ * @brief Function called once a CRC computed with @ref CrcDma is done, from the interrupt context.
+ * @param ok False if the DMA transfer failed.
+ */
+using CrcCallback = void (*)(bool ok, uint32_t crc, void* ctx);
+
+/**
+ * @brief Computes the CRC-32/MPEG-2 of words, with the DMA feeding them to the CRC peripheral.
+ *
+ * The DMA stream must be configured as memory-to-memory, with a word width on both sides, the
+ * peripheral (source) address incremented and the memory (destination) address fixed. Buffers
+ * shorter than NILAI_CRC_DMA_MIN_WORDS are computed on the CPU right away, since starting the DMA
+ * costs more than it saves.
+ *
+ * @param dma The DMA stream.
+ * @param data The words, they must stay valid until @p cb is called.
+ * @param len The number of words.
+ * @param cb Called with the CRC once it is computed.
+ * @param initial The value the CRC starts from.
+ * @return False if the DMA is already computing a CRC or couldn't be started.
+ */
+bool CrcDma(DMA_HandleTypeDef* dma,
+            const uint32_t*    data,
+            size_t             len,
+            CrcCallback        cb,
+            void*              ctx     = nullptr,
+            uint32_t           initial = 0xFFFFFFFF);
+
+/**
+ * @brief Checks if a CRC is being computed with the DMA.
+ */
+bool CrcDmaBusy();
+#endif
 }    // namespace Nilai::Services
 //!@}
 //!@}
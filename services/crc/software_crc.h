@@ -0,0 +1,365 @@
+/**
+ * @file    software_crc.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Table-driven CRC-32 and CRC-16, computed on the CPU over any number of bytes.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+
+#ifndef GUARD_NILAI_SERVICES_SOFTWARE_CRC_H
+#define GUARD_NILAI_SERVICES_SOFTWARE_CRC_H
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+/**
+ * @addtogroup Services
+ * @{
+ */
+
+/**
+ * @addtogroup nilai_services_crc CRC
+ * @{
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Nilai::Services
+{
+namespace Internal
+{
+#if defined(NILAI_CRC_SMALL_TABLES)
+//! A single 1 KiB table, the CRC-32 is computed one byte at a time.
+constexpr std::size_t s_crc32Slices = 1;
+#else
+//! 8 KiB of tables, the CRC-32 is computed 8 bytes at a time (slice-by-8).
+constexpr std::size_t s_crc32Slices = 8;
+#endif
+
+template<typename T>
+constexpr T Reflect(T v) noexcept
+{
+    T r = 0;
+    for (std::size_t i = 0; i < sizeof(T) * 8; i++)
+    {
+        r = static_cast<T>((r << 1) | (v & 1));
+        v = static_cast<T>(v >> 1);
+    }
+    return r;
+}
+
+constexpr uint32_t ByteSwap(uint32_t v) noexcept
+{
+    return (v >> 24) | ((v >> 8) & 0x0000FF00) | ((v << 8) & 0x00FF0000) | (v << 24);
+}
+
+constexpr uint32_t Load32Le(const uint8_t* p) noexcept
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+constexpr uint32_t Load32Be(const uint8_t* p) noexcept
+{
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+/**
+ * @brief Builds the tables of a CRC-32.
+ *
+ * The first table advances the CRC by one byte. Table k advances it by one byte followed by k zero
+ * bytes, which lets 8 bytes be folded in with 8 independent lookups.
+ */
+template<uint32_t Poly, bool Reflected>
+constexpr auto MakeCrc32Tables() noexcept
+{
+    std::array<std::array<uint32_t, 256>, s_crc32Slices> tables = {};
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t c = Reflected ? i : i << 24;
+        for (int j = 0; j < 8; j++)
+        {
+            if constexpr (Reflected)
+            {
+                c = ((c & 1) != 0) ? (c >> 1) ^ Reflect(Poly) : (c >> 1);
+            }
+            else
+            {
+                c = ((c & 0x80000000) != 0) ? (c << 1) ^ Poly : (c << 1);
+            }
+        }
+        tables[0][i] = c;
+    }
+
+    for (std::size_t k = 1; k < s_crc32Slices; k++)
+    {
+        for (std::size_t i = 0; i < 256; i++)
+        {
+            uint32_t prev = tables[k - 1][i];
+            tables[k][i]  = Reflected ? (prev >> 8) ^ tables[0][prev & 0xFF]
+                                      : (prev << 8) ^ tables[0][prev >> 24];
+        }
+    }
+    return tables;
+}
+
+template<uint16_t Poly, bool Reflected>
+constexpr auto MakeCrc16Table() noexcept
+{
+    std::array<uint16_t, 256> table = {};
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        uint16_t c = Reflected ? i : static_cast<uint16_t>(i << 8);
+        for (int j = 0; j < 8; j++)
+        {
+            if constexpr (Reflected)
+            {
+                c = ((c & 1) != 0) ? static_cast<uint16_t>((c >> 1) ^ Reflect(Poly))
+                                   : static_cast<uint16_t>(c >> 1);
+            }
+            else
+            {
+                c = ((c & 0x8000) != 0) ? static_cast<uint16_t>((c << 1) ^ Poly)
+                                        : static_cast<uint16_t>(c << 1);
+            }
+        }
+        table[i] = c;
+    }
+    return table;
+}
+}    // namespace Internal
+
+/**
+ * @brief CRC-32 computed incrementally over bytes or words.
+ *
+ * Feeding a buffer in several calls to @ref Update gives the same result as feeding it at once:
+ * @code
+ * Crc32 crc;
+ * crc.Update(header);
+ * crc.Update(payload);
+ * uint32_t v = crc.Value();
+ * @endcode
+ *
+ * Unless NILAI_CRC_SMALL_TABLES is defined, 8 bytes are processed per iteration with 8 KiB of
+ * tables (slice-by-8) instead of 1 KiB for the byte-at-a-time loop.
+ *
+ * @tparam Poly The polynomial, in its normal (MSB first) form.
+ * @tparam Reflected True if the bits of the bytes are processed LSB first.
+ * @tparam Init The value the CRC starts from.
+ * @tparam XorOut XORed with the CRC to get its value.
+ */
+template<uint32_t Poly, bool Reflected, uint32_t Init, uint32_t XorOut>
+class Crc32Engine
+{
+public:
+    constexpr Crc32Engine() noexcept = default;
+
+    /**
+     * @brief Starts from @p initial instead of @p Init.
+     */
+    constexpr explicit Crc32Engine(uint32_t initial) noexcept : m_state(initial) {}
+
+    constexpr void Reset() noexcept { m_state = Init; }
+
+    /**
+     * @brief Adds bytes to the CRC.
+     */
+    constexpr Crc32Engine& Update(std::span<const uint8_t> data) noexcept
+    {
+        const uint8_t* p = data.data();
+        std::size_t    n = data.size();
+        uint32_t       c = m_state;
+        if constexpr (Internal::s_crc32Slices == 8)
+        {
+            for (; n >= 8; n -= 8, p += 8)
+            {
+                c = Reflected ? Slice8(c, Internal::Load32Le(p), Internal::Load32Le(p + 4))
+                              : Slice8(c, Internal::Load32Be(p), Internal::Load32Be(p + 4));
+            }
+        }
+        for (; n != 0; n--, p++)
+        {
+            c = UpdateByte(c, *p);
+        }
+        m_state = c;
+        return *this;
+    }
+
+    /**
+     * @brief Adds words to the CRC, in the order the CRC peripheral of the STM32 reads them: the
+     * most significant byte of each word first.
+     */
+    constexpr Crc32Engine& UpdateWords(std::span<const uint32_t> words) noexcept
+    {
+        const uint32_t* p = words.data();
+        std::size_t     n = words.size();
+        uint32_t        c = m_state;
+        if constexpr (Internal::s_crc32Slices == 8)
+        {
+            for (; n >= 2; n -= 2, p += 2)
+            {
+                c = Reflected ? Slice8(c, Internal::ByteSwap(p[0]), Internal::ByteSwap(p[1]))
+                              : Slice8(c, p[0], p[1]);
+            }
+        }
+        for (; n != 0; n--, p++)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+            {
+                c = UpdateByte(c, static_cast<uint8_t>(*p >> shift));
+            }
+        }
+        m_state = c;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr uint32_t Value() const noexcept { return m_state ^ XorOut; }
+
+    /**
+     * @brief Computes the CRC of a buffer at once.
+     */
+    [[nodiscard]] static constexpr uint32_t Compute(std::span<const uint8_t> data) noexcept
+    {
+        return Crc32Engine {}.Update(data).Value();
+    }
+
+private:
+    static constexpr uint32_t UpdateByte(uint32_t c, uint8_t b) noexcept
+    {
+        if constexpr (Reflected)
+        {
+            return (c >> 8) ^ s_tables[0][(c ^ b) & 0xFF];
+        }
+        else
+        {
+            return (c << 8) ^ s_tables[0][((c >> 24) ^ b) & 0xFF];
+        }
+    }
+
+    /**
+     * @brief Folds 8 bytes in the CRC.
+     * @param first The first 4 bytes, loaded in the bit order of the CRC.
+     * @param second The next 4 bytes, loaded the same way.
+     */
+    static constexpr uint32_t Slice8(uint32_t c, uint32_t first, uint32_t second) noexcept
+    {
+        const auto& t = s_tables;
+        if constexpr (Reflected)
+        {
+            uint32_t lo = c ^ first;
+            return t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^
+                   t[4][lo >> 24] ^ t[3][second & 0xFF] ^ t[2][(second >> 8) & 0xFF] ^
+                   t[1][(second >> 16) & 0xFF] ^ t[0][second >> 24];
+        }
+        else
+        {
+            uint32_t hi = c ^ first;
+            return t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xFF] ^ t[5][(hi >> 8) & 0xFF] ^
+                   t[4][hi & 0xFF] ^ t[3][second >> 24] ^ t[2][(second >> 16) & 0xFF] ^
+                   t[1][(second >> 8) & 0xFF] ^ t[0][second & 0xFF];
+        }
+    }
+
+    static constexpr auto s_tables = Internal::MakeCrc32Tables<Poly, Reflected>();
+
+    uint32_t m_state = Init;
+};
+
+/**
+ * @brief CRC-16 computed incrementally over bytes, one table lookup per byte.
+ *
+ * @tparam Poly The polynomial, in its normal (MSB first) form.
+ * @tparam Reflected True if the bits of the bytes are processed LSB first.
+ * @tparam Init The value the CRC starts from.
+ * @tparam XorOut XORed with the CRC to get its value.
+ */
+template<uint16_t Poly, bool Reflected, uint16_t Init, uint16_t XorOut>
+class Crc16Engine
+{
+public:
+    constexpr Crc16Engine() noexcept = default;
+
+    /**
+     * @brief Starts from @p initial instead of @p Init.
+     */
+    constexpr explicit Crc16Engine(uint16_t initial) noexcept : m_state(initial) {}
+
+    constexpr void Reset() noexcept { m_state = Init; }
+
+    /**
+     * @brief Adds bytes to the CRC.
+     */
+    constexpr Crc16Engine& Update(std::span<const uint8_t> data) noexcept
+    {
+        uint16_t c = m_state;
+        for (uint8_t b : data)
+        {
+            if constexpr (Reflected)
+            {
+                c = static_cast<uint16_t>((c >> 8) ^ s_table[(c ^ b) & 0xFF]);
+            }
+            else
+            {
+                c = static_cast<uint16_t>((c << 8) ^ s_table[((c >> 8) ^ b) & 0xFF]);
+            }
+        }
+        m_state = c;
+        return *this;
+    }
+
+    [[nodiscard]] constexpr uint16_t Value() const noexcept
+    {
+        return static_cast<uint16_t>(m_state ^ XorOut);
+    }
+
+    /**
+     * @brief Computes the CRC of a buffer at once.
+     */
+    [[nodiscard]] static constexpr uint16_t Compute(std::span<const uint8_t> data) noexcept
+    {
+        return Crc16Engine {}.Update(data).Value();
+    }
+
+private:
+    static constexpr auto s_table = Internal::MakeCrc16Table<Poly, Reflected>();
+
+    uint16_t m_state = Init;
+};
+
+//! CRC-32 of Ethernet, zlib and PNG (CRC-32/ISO-HDLC).
+using Crc32 = Crc32Engine<0x04C11DB7, true, 0xFFFFFFFF, 0xFFFFFFFF>;
+//! CRC-32 computed by the CRC peripheral of the STM32 with its default settings (CRC-32/MPEG-2).
+using Crc32Mpeg2 = Crc32Engine<0x04C11DB7, false, 0xFFFFFFFF, 0x00000000>;
+//! CRC-16/CCITT-FALSE, also known as CRC-16/IBM-3740.
+using Crc16Ccitt = Crc16Engine<0x1021, false, 0xFFFF, 0x0000>;
+
+namespace Internal
+{
+constexpr std::array<uint8_t, 9> s_crcCheckInput = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+}
+
+// Check values from https://reveng.sourceforge.io/crc-catalogue/
+static_assert(Crc32::Compute(Internal::s_crcCheckInput) == 0xCBF43926);
+static_assert(Crc32Mpeg2::Compute(Internal::s_crcCheckInput) == 0x0376E6E7);
+static_assert(Crc16Ccitt::Compute(Internal::s_crcCheckInput) == 0x29B1);
+}    // namespace Nilai::Services
+//!@}
+//!@}
+//!@}
+
+#endif    // GUARD_NILAI_SERVICES_SOFTWARE_CRC_H
@@ -0,0 +1,266 @@
+/**
+ * @file    deferred_log.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Binary logging, where the formatting is done by the host instead of the device.
+ *
+ * Logging a message only records the address of its format string, a timestamp and the raw
+ * arguments in a lock-free ring. This takes a few hundred cycles and can be done from an
+ * interrupt. The records are then sent as binary frames, and the host rebuilds the text with the
+ * format strings read from the firmware's ELF file, see deferred_log_decoder.h.
+ *
+ * A frame is laid out as follows, all fields are little-endian:
+ * <pre>
+ *  u8  Magic       0xA5
+ *  u8  Len         Size of the arguments, in bytes.
+ *  u8  Flags       See DeferredLogRecord::s_truncated.
+ *  u32 FormatId    Address of the format string.
+ *  u32 Timestamp   In milliseconds.
+ *  u8  Args[Len]   Each argument is a DeferredLogArg tag followed by its value. Strings are
+ *                  prefixed by their length on one byte.
+ * </pre>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DEFERRED_LOG_H
+#define NILAI_SERVICES_DEFERRED_LOG_H
+
+#include "../defines/mpsc_ring.h"
+#include "time.h"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#if !defined(NILAI_LOG_DEFERRED_RECORD_SIZE)
+#    define NILAI_LOG_DEFERRED_RECORD_SIZE 48
+#endif
+#if !defined(NILAI_LOG_DEFERRED_DEPTH)
+#    define NILAI_LOG_DEFERRED_DEPTH 64
+#endif
+
+/**
+ * Records a message in the deferred log. @p fmt must be a string literal, only its address is
+ * recorded.
+ */
+#define NILAI_LOG_DEFERRED(fmt, ...)                                                               \
+    ::Nilai::Services::DeferredLog::Write(fmt, ::Nilai::GetTime() __VA_OPT__(, ) __VA_ARGS__)
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Services
+{
+/**
+ * @brief Type tag preceding each argument of a record.
+ */
+enum class DeferredLogArg : uint8_t
+{
+    Int32 = 1,
+    UInt32,
+    Int64,
+    UInt64,
+    Double,
+    String,
+};
+
+/**
+ * @brief A message, as recorded in the ring.
+ */
+struct DeferredLogRecord
+{
+    //! Set when the arguments didn't all fit in the record.
+    static constexpr uint8_t s_truncated = 0x01;
+    static constexpr size_t  s_argsSize  = NILAI_LOG_DEFERRED_RECORD_SIZE - 10;
+    static_assert(s_argsSize > 0 && s_argsSize <= UINT8_MAX,
+                  "NILAI_LOG_DEFERRED_RECORD_SIZE must be between 11 and 265 bytes!");
+
+    uint32_t FormatId         = 0;
+    uint32_t Timestamp        = 0;
+    uint8_t  Len              = 0;
+    uint8_t  Flags            = 0;
+    uint8_t  Args[s_argsSize] = {};
+};
+
+class DeferredLog
+{
+public:
+    using Ring = MpscRing<DeferredLogRecord, NILAI_LOG_DEFERRED_DEPTH>;
+
+    static constexpr uint8_t s_frameMagic      = 0xA5;
+    static constexpr size_t  s_frameHeaderSize = 11;
+    static constexpr size_t  s_maxFrameSize = s_frameHeaderSize + DeferredLogRecord::s_argsSize;
+
+    static uint32_t FormatId(const char* fmt) noexcept
+    {
+        return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(fmt));
+    }
+
+    /**
+     * @brief Records a message. Can be called from any context.
+     *
+     * Integers, floating point numbers, pointers and C strings can be logged. Strings are copied,
+     * and truncated if they don't fit in the record.
+     *
+     * @param fmt The format string. Must have a static storage duration.
+     * @param timestamp The time of the message, in milliseconds.
+     * @param args The arguments of the message.
+     * @return True if the message was recorded, false if the ring was full.
+     */
+    template<typename... Args>
+    static bool Write(const char* fmt, uint32_t timestamp, const Args&... args) noexcept
+    {
+        return s_ring.Emplace(
+          [&](DeferredLogRecord& r)
+          {
+              r.FormatId  = FormatId(fmt);
+              r.Timestamp = timestamp;
+              r.Len       = 0;
+              r.Flags     = 0;
+              // Stops at the first argument that doesn't fit.
+              if (!(Encode(r, args) && ...))
+              {
+                  r.Flags |= DeferredLogRecord::s_truncated;
+              }
+          });
+    }
+
+    /**
+     * @brief Takes the oldest record out of the ring. Must only be called by a single consumer.
+     */
+    static std::optional<DeferredLogRecord> Read() noexcept { return s_ring.Pop(); }
+
+    /**
+     * @brief Gets the number of messages that were lost because the ring was full.
+     */
+    static size_t Dropped() noexcept { return s_ring.Overflows(); }
+
+    /**
+     * @brief Serializes a record into a frame.
+     * @return The size of the frame, or 0 if it doesn't fit in @p out.
+     */
+    static size_t ToFrame(const DeferredLogRecord& r, std::span<uint8_t> out) noexcept
+    {
+        size_t size = s_frameHeaderSize + r.Len;
+        if (out.size() < size)
+        {
+            return 0;
+        }
+
+        out[0] = s_frameMagic;
+        out[1] = r.Len;
+        out[2] = r.Flags;
+        PutLe(&out[3], r.FormatId);
+        PutLe(&out[7], r.Timestamp);
+        std::memcpy(&out[s_frameHeaderSize], r.Args, r.Len);
+        return size;
+    }
+
+private:
+    template<std::unsigned_integral T>
+    static void PutLe(uint8_t* dst, T v) noexcept
+    {
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            dst[i] = static_cast<uint8_t>(v >> (i * 8));
+        }
+    }
+
+    static bool Put(DeferredLogRecord& r, DeferredLogArg tag, uint64_t v, size_t size) noexcept
+    {
+        if (DeferredLogRecord::s_argsSize - r.Len < 1 + size)
+        {
+            return false;
+        }
+        r.Args[r.Len++] = static_cast<uint8_t>(tag);
+        for (size_t i = 0; i < size; i++)
+        {
+            r.Args[r.Len++] = static_cast<uint8_t>(v >> (i * 8));
+        }
+        return true;
+    }
+
+    template<typename T>
+    static bool Encode(DeferredLogRecord& r, const T& arg) noexcept
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, const char*> || std::is_same_v<U, char*>)
+        {
+            const char* str = arg;
+            if constexpr (!std::is_array_v<T>)
+            {
+                str = str != nullptr ? str : "(null)";
+            }
+            // As much of the string as fits is kept.
+            size_t room = DeferredLogRecord::s_argsSize - r.Len;
+            if (room < 2)
+            {
+                return false;
+            }
+            size_t len = strnlen(str, std::min<size_t>(room - 2, UINT8_MAX));
+            r.Args[r.Len++] = static_cast<uint8_t>(DeferredLogArg::String);
+            r.Args[r.Len++] = static_cast<uint8_t>(len);
+            std::memcpy(&r.Args[r.Len], str, len);
+            r.Len += static_cast<uint8_t>(len);
+            return str[len] == '\0';
+        }
+        else if constexpr (std::is_enum_v<U>)
+        {
+            return Encode(r, static_cast<std::underlying_type_t<U>>(arg));
+        }
+        else if constexpr (std::is_pointer_v<U>)
+        {
+            return Encode(r, reinterpret_cast<uintptr_t>(arg));
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            return Put(r,
+                       DeferredLogArg::Double,
+                       std::bit_cast<uint64_t>(static_cast<double>(arg)),
+                       sizeof(double));
+        }
+        else if constexpr (std::is_integral_v<U> && sizeof(U) <= sizeof(uint32_t))
+        {
+            return std::is_signed_v<U>
+                     ? Put(r,
+                           DeferredLogArg::Int32,
+                           static_cast<uint32_t>(static_cast<int32_t>(arg)),
+                           sizeof(uint32_t))
+                     : Put(r, DeferredLogArg::UInt32, static_cast<uint32_t>(arg), sizeof(uint32_t));
+        }
+        else if constexpr (std::is_integral_v<U>)
+        {
+            return Put(r,
+                       std::is_signed_v<U> ? DeferredLogArg::Int64 : DeferredLogArg::UInt64,
+                       static_cast<uint64_t>(arg),
+                       sizeof(uint64_t));
+        }
+        else
+        {
+            static_assert(std::is_integral_v<U>, "This type can't be logged!");
+            return false;
+        }
+    }
+
+private:
+    static inline Ring s_ring;
+};
+}    // namespace Nilai::Services
+//!@}
+#endif    // NILAI_SERVICES_DEFERRED_LOG_H
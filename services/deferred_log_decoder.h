@@ -0,0 +1,427 @@
+/**
+ * @file    deferred_log_decoder.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Host-side decoder for the frames of the deferred log.
+ *
+ * The format strings are looked up by address in the firmware's ELF file. The text is then
+ * formatted on the host, with the same conversion specifiers as printf.
+ *
+ * @code
+ * std::vector<uint8_t> elf = ReadFile("firmware.elf");
+ * Nilai::Services::ElfFormatTable   table(elf);
+ * Nilai::Services::DeferredLogDecoder decoder([&table](uint32_t id) { return table.Find(id); });
+ * decoder.Feed(bytesFromUart, [](const std::string& line) { std::cout << line; });
+ * @endcode
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DEFERRED_LOG_DECODER_H
+#define NILAI_SERVICES_DEFERRED_LOG_DECODER_H
+
+#include "deferred_log.h"
+
+#include <bit>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Services
+{
+/**
+ * @brief Finds the strings of a 32-bit little-endian ELF image by their address.
+ */
+class ElfFormatTable
+{
+    struct Section
+    {
+        uint32_t Address = 0;
+        uint32_t Offset  = 0;
+        uint32_t Size    = 0;
+    };
+
+public:
+    explicit ElfFormatTable(std::span<const uint8_t> elf) : m_elf(elf)
+    {
+        static constexpr uint8_t  s_magic[]     = {0x7F, 'E', 'L', 'F', 1, 1};
+        static constexpr uint32_t s_progBits    = 1;
+        static constexpr uint32_t s_shfAlloc    = 0x2;
+        static constexpr size_t   s_ehdrSize    = 52;
+        static constexpr size_t   s_shdrMinSize = 24;
+
+        if (elf.size() < s_ehdrSize || std::memcmp(elf.data(), s_magic, sizeof(s_magic)) != 0)
+        {
+            return;
+        }
+
+        uint32_t shoff     = Get<uint32_t>(0x20);
+        uint16_t shentsize = Get<uint16_t>(0x2E);
+        uint16_t shnum     = Get<uint16_t>(0x30);
+        if (shentsize < s_shdrMinSize || shoff + (size_t(shnum) * shentsize) > elf.size())
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < shnum; i++)
+        {
+            size_t   shdr  = shoff + (i * shentsize);
+            uint32_t type  = Get<uint32_t>(shdr + 4);
+            uint32_t flags = Get<uint32_t>(shdr + 8);
+            Section  s     = {
+              Get<uint32_t>(shdr + 12), Get<uint32_t>(shdr + 16), Get<uint32_t>(shdr + 20)};
+            if (type == s_progBits && (flags & s_shfAlloc) != 0 &&
+                size_t(s.Offset) + s.Size <= elf.size())
+            {
+                m_sections.push_back(s);
+            }
+        }
+    }
+
+    [[nodiscard]] bool Valid() const noexcept { return !m_sections.empty(); }
+
+    /**
+     * @brief Gets the string at an address, or nullptr if there's no string there.
+     */
+    [[nodiscard]] const char* Find(uint32_t address) const noexcept
+    {
+        for (const auto& s : m_sections)
+        {
+            if (address >= s.Address && address - s.Address < s.Size)
+            {
+                const char* str = reinterpret_cast<const char*>(&m_elf[s.Offset]);
+                size_t      pos = address - s.Address;
+                // The string must be terminated inside the section.
+                return std::memchr(str + pos, '\0', s.Size - pos) != nullptr ? str + pos : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    template<typename T>
+    [[nodiscard]] T Get(size_t pos) const noexcept
+    {
+        T v = 0;
+        for (size_t i = 0; i < sizeof(T); i++)
+        {
+            v |= static_cast<T>(static_cast<T>(m_elf[pos + i]) << (i * 8));
+        }
+        return v;
+    }
+
+private:
+    std::span<const uint8_t> m_elf;
+    std::vector<Section>     m_sections;
+};
+
+/**
+ * @brief Rebuilds the text of the messages of the deferred log.
+ */
+class DeferredLogDecoder
+{
+    struct Arg
+    {
+        DeferredLogArg Type = DeferredLogArg::Int32;
+        uint64_t       Raw  = 0;
+        std::string    Str;
+    };
+
+public:
+    //! Gets the format string with the given id, or nullptr if it is unknown.
+    using Lookup = std::function<const char*(uint32_t)>;
+
+    explicit DeferredLogDecoder(Lookup lookup) : m_lookup(std::move(lookup)) {}
+
+    /**
+     * @brief Parses a frame.
+     * @return The record, or nothing if the frame is incomplete or malformed.
+     */
+    static std::optional<DeferredLogRecord> FromFrame(std::span<const uint8_t> frame)
+    {
+        if (frame.size() < DeferredLog::s_frameHeaderSize ||
+            frame[0] != DeferredLog::s_frameMagic || frame[1] > DeferredLogRecord::s_argsSize ||
+            frame.size() < DeferredLog::s_frameHeaderSize + frame[1])
+        {
+            return std::nullopt;
+        }
+
+        DeferredLogRecord r;
+        r.Len       = frame[1];
+        r.Flags     = frame[2];
+        r.FormatId  = GetLe(&frame[3], sizeof(uint32_t));
+        r.Timestamp = GetLe(&frame[7], sizeof(uint32_t));
+        std::memcpy(r.Args, &frame[DeferredLog::s_frameHeaderSize], r.Len);
+        return r;
+    }
+
+    /**
+     * @brief Formats a record, prefixed by its timestamp like the text logger does.
+     */
+    [[nodiscard]] std::string Decode(const DeferredLogRecord& r) const
+    {
+        uint32_t ms  = r.Timestamp;
+        char     ts[32];
+        std::snprintf(ts,
+                      sizeof(ts),
+                      "[%02u:%02u:%02u.%03u]",
+                      ms / 3600000,
+                      (ms / 60000) % 60,
+                      (ms / 1000) % 60,
+                      ms % 1000);
+
+        const char* fmt = m_lookup(r.FormatId);
+        if (fmt == nullptr)
+        {
+            char unknown[32];
+            std::snprintf(unknown, sizeof(unknown), " <unknown format 0x%08X>", r.FormatId);
+            return std::string(ts) + unknown;
+        }
+
+        std::string text = Format(fmt, ParseArgs(r));
+        if ((r.Flags & DeferredLogRecord::s_truncated) != 0)
+        {
+            text += " <truncated>";
+        }
+        return std::string(ts) + text;
+    }
+
+    /**
+     * @brief Decodes a stream of frames, that can be cut anywhere.
+     *
+     * Bytes that are not part of a frame are skipped.
+     *
+     * @param bytes The next bytes of the stream.
+     * @param onMessage Called with the text of every complete message.
+     */
+    template<typename F>
+    void Feed(std::span<const uint8_t> bytes, F&& onMessage)
+    {
+        m_pending.insert(m_pending.end(), bytes.begin(), bytes.end());
+
+        size_t pos = 0;
+        while (pos < m_pending.size())
+        {
+            if (m_pending[pos] != DeferredLog::s_frameMagic)
+            {
+                pos++;
+                continue;
+            }
+            if (m_pending.size() - pos < DeferredLog::s_frameHeaderSize)
+            {
+                break;
+            }
+            if (m_pending[pos + 1] > DeferredLogRecord::s_argsSize)
+            {
+                // Not a frame, resynchronizes on the next magic byte.
+                pos++;
+                continue;
+            }
+            size_t size = DeferredLog::s_frameHeaderSize + m_pending[pos + 1];
+            if (m_pending.size() - pos < size)
+            {
+                break;
+            }
+
+            auto r = FromFrame({&m_pending[pos], size});
+            onMessage(Decode(*r));
+            pos += size;
+        }
+
+        m_pending.erase(m_pending.begin(), m_pending.begin() + static_cast<ptrdiff_t>(pos));
+    }
+
+private:
+    static uint64_t GetLe(const uint8_t* src, size_t size)
+    {
+        uint64_t v = 0;
+        for (size_t i = 0; i < size; i++)
+        {
+            v |= static_cast<uint64_t>(src[i]) << (i * 8);
+        }
+        return v;
+    }
+
+    static std::vector<Arg> ParseArgs(const DeferredLogRecord& r)
+    {
+        std::vector<Arg> args;
+        size_t           pos = 0;
+        while (pos < r.Len)
+        {
+            Arg arg;
+            arg.Type    = static_cast<DeferredLogArg>(r.Args[pos++]);
+            size_t size = 0;
+            switch (arg.Type)
+            {
+                case DeferredLogArg::Int32:
+                case DeferredLogArg::UInt32: size = sizeof(uint32_t); break;
+                case DeferredLogArg::Int64:
+                case DeferredLogArg::UInt64:
+                case DeferredLogArg::Double: size = sizeof(uint64_t); break;
+                case DeferredLogArg::String:
+                    size = pos < r.Len ? r.Args[pos++] : 0;
+                    size = std::min<size_t>(size, r.Len - pos);
+                    arg.Str.assign(reinterpret_cast<const char*>(&r.Args[pos]), size);
+                    break;
+                default: return args;
+            }
+            if (r.Len - pos < size)
+            {
+                break;
+            }
+            if (arg.Type != DeferredLogArg::String)
+            {
+                arg.Raw = GetLe(&r.Args[pos], size);
+            }
+            pos += size;
+            args.push_back(std::move(arg));
+        }
+        return args;
+    }
+
+    static long long AsSigned(const Arg& a)
+    {
+        switch (a.Type)
+        {
+            case DeferredLogArg::Int32: return static_cast<int32_t>(a.Raw);
+            case DeferredLogArg::Double:
+                return static_cast<long long>(std::bit_cast<double>(a.Raw));
+            default: return static_cast<long long>(a.Raw);
+        }
+    }
+
+    static unsigned long long AsUnsigned(const Arg& a)
+    {
+        // 32-bit values are stored as 32 bits, negative values are shown as they would be on the
+        // device.
+        return a.Type == DeferredLogArg::Double
+                 ? static_cast<unsigned long long>(std::bit_cast<double>(a.Raw))
+                 : a.Raw;
+    }
+
+    static double AsDouble(const Arg& a)
+    {
+        switch (a.Type)
+        {
+            case DeferredLogArg::Double: return std::bit_cast<double>(a.Raw);
+            case DeferredLogArg::Int32:
+            case DeferredLogArg::Int64: return static_cast<double>(AsSigned(a));
+            default: return static_cast<double>(a.Raw);
+        }
+    }
+
+    template<typename T>
+    static void Append(std::string& out, const std::string& spec, T v)
+    {
+        int size = std::snprintf(nullptr, 0, spec.c_str(), v);
+        if (size > 0)
+        {
+            std::string s(static_cast<size_t>(size) + 1, '\0');
+            std::snprintf(s.data(), s.size(), spec.c_str(), v);
+            s.resize(static_cast<size_t>(size));
+            out += s;
+        }
+    }
+
+    static std::string Format(const char* fmt, const std::vector<Arg>& args)
+    {
+        std::string out;
+        size_t      next = 0;
+        while (*fmt != '\0')
+        {
+            if (*fmt != '%')
+            {
+                out += *fmt++;
+                continue;
+            }
+            if (fmt[1] == '%')
+            {
+                out += '%';
+                fmt += 2;
+                continue;
+            }
+
+            // Flags, width and precision are kept, '*' takes its value from the arguments.
+            std::string spec = "%";
+            fmt++;
+            while (*fmt != '\0' && std::strchr("-+ #0123456789.*", *fmt) != nullptr)
+            {
+                if (*fmt == '*')
+                {
+                    spec += next < args.size() ? std::to_string(AsSigned(args[next++])) : "0";
+                }
+                else
+                {
+                    spec += *fmt;
+                }
+                fmt++;
+            }
+            // The length modifiers of the device don't apply, the arguments carry their size.
+            while (*fmt != '\0' && std::strchr("hljztL", *fmt) != nullptr)
+            {
+                fmt++;
+            }
+            if (*fmt == '\0')
+            {
+                break;
+            }
+
+            char conv = *fmt++;
+            if (next >= args.size())
+            {
+                out += "<?>";
+                continue;
+            }
+            const Arg& arg = args[next++];
+            switch (conv)
+            {
+                case 'd':
+                case 'i': Append(out, spec + "ll" + conv, AsSigned(arg)); break;
+                case 'u':
+                case 'o':
+                case 'x':
+                case 'X': Append(out, spec + "ll" + conv, AsUnsigned(arg)); break;
+                case 'c': Append(out, spec + conv, static_cast<int>(AsSigned(arg))); break;
+                case 'f':
+                case 'F':
+                case 'e':
+                case 'E':
+                case 'g':
+                case 'G':
+                case 'a':
+                case 'A': Append(out, spec + conv, AsDouble(arg)); break;
+                case 's':
+                    Append(out,
+                           spec + conv,
+                           arg.Type == DeferredLogArg::String ? arg.Str.c_str() : "<?>");
+                    break;
+                case 'p': Append(out, spec + "#llx", AsUnsigned(arg)); break;
+                default: out += "<?>"; break;
+            }
+        }
+        return out;
+    }
+
+private:
+    Lookup               m_lookup;
+    std::vector<uint8_t> m_pending;
+};
+}    // namespace Nilai::Services
+//!@}
+#endif    // NILAI_SERVICES_DEFERRED_LOG_DECODER_H
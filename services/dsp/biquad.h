@@ -0,0 +1,232 @@
+/**
+ * @file    biquad.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Cascade of fixed-point biquad filters.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_BIQUAD_H
+#define NILAI_SERVICES_DSP_BIQUAD_H
+
+#include "fixed_point.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Nilai::Services::Dsp
+{
+/**
+ * @brief Coefficients of a biquad, in the 3.23 format used by the TAS5707's on-chip filters.
+ *
+ * The feedback coefficients are added, like TI's tools generate them:
+ * y[n] = b0 x[n] + b1 x[n-1] + b2 x[n-2] + a1 y[n-1] + a2 y[n-2].
+ * They are the opposite of the ones of the usual textbook form.
+ */
+struct BiquadCoeffs
+{
+    static constexpr int32_t s_one = 1 << 23;
+
+    int32_t B0 = s_one;
+    int32_t B1 = 0;
+    int32_t B2 = 0;
+    int32_t A1 = 0;
+    int32_t A2 = 0;
+
+    /**
+     * @brief Converts coefficients of the textbook form, where a0 is 1 and the feedback is
+     * subtracted.
+     */
+    static constexpr BiquadCoeffs FromFloat(double b0, double b1, double b2, double a1, double a2)
+    {
+        return {To323(b0), To323(b1), To323(b2), To323(-a1), To323(-a2)};
+    }
+
+    /**
+     * @brief Converts a filter of @ref Nilai::Tas5707::BiquadFilter, or any other structure with
+     * the same members.
+     *
+     * The chip's registers are 26 bits wide, the bits above 25 are ignored.
+     */
+    template<typename Filter>
+    static constexpr BiquadCoeffs FromTas5707(const Filter& f)
+    {
+        return {SignExtend(f.b0), SignExtend(f.b1), SignExtend(f.b2), SignExtend(f.a1),
+                SignExtend(f.a2)};
+    }
+
+    //! A filter that doesn't do anything, like the ones the TAS5707 defaults to.
+    [[nodiscard]] constexpr bool IsIdentity() const noexcept
+    {
+        return B0 == s_one && B1 == 0 && B2 == 0 && A1 == 0 && A2 == 0;
+    }
+
+    constexpr bool operator==(const BiquadCoeffs&) const = default;
+
+private:
+    static constexpr int32_t To323(double v)
+    {
+        double scaled = v * s_one;
+        return static_cast<int32_t>(SaturateQ31(static_cast<int64_t>(scaled < 0 ? scaled - 0.5
+                                                                                 : scaled + 0.5)));
+    }
+
+    static constexpr int32_t SignExtend(uint32_t v)
+    {
+        return static_cast<int32_t>(v << 6) >> 6;
+    }
+};
+
+/**
+ * @brief Up to @p MaxSections biquads in series, filtering one channel.
+ *
+ * The filters use the direct form I, which has no internal overflow as long as the output fits.
+ * The samples are processed in Q31 and the accumulator has 64 bits, which is a single
+ * multiply-accumulate instruction per coefficient on a Cortex-M.
+ *
+ * @tparam MaxSections Maximum number of biquads.
+ */
+template<size_t MaxSections>
+class BiquadCascade
+{
+public:
+    /**
+     * @brief Replaces the filters and clears their state.
+     * @return False if there are more than @p MaxSections filters, in which case nothing changes.
+     */
+    bool SetSections(std::span<const BiquadCoeffs> sections) noexcept
+    {
+        if (sections.size() > MaxSections)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < sections.size(); i++)
+        {
+            m_coeffs[i] = sections[i];
+        }
+        m_count = sections.size();
+        Reset();
+        return true;
+    }
+
+    /**
+     * @brief Loads the filters of a bank of the TAS5707, such as @c BiquadBanks::Bank1.
+     *
+     * The filters left to their default are skipped, they would only cost time.
+     *
+     * @return False if there are more than @p MaxSections filters doing something, in which case
+     * nothing changes.
+     */
+    template<typename Bank>
+    bool Load(const Bank& bank) noexcept
+    {
+        std::array<BiquadCoeffs, MaxSections> sections = {};
+        size_t                                count    = 0;
+        for (const auto& f : bank)
+        {
+            BiquadCoeffs c = BiquadCoeffs::FromTas5707(f);
+            if (c.IsIdentity())
+            {
+                continue;
+            }
+            if (count == MaxSections)
+            {
+                return false;
+            }
+            sections[count++] = c;
+        }
+        return SetSections(std::span {sections}.first(count));
+    }
+
+    //! Clears the history of the filters, to be used after a discontinuity in the stream.
+    void Reset() noexcept { m_state = {}; }
+
+    [[nodiscard]] size_t SectionCount() const noexcept { return m_count; }
+
+    /**
+     * @brief Filters a block of Q31 samples in place.
+     * @param data The samples.
+     * @param n Number of samples to filter.
+     * @param stride Distance between two samples, the number of channels for interleaved data.
+     */
+    void Process(q31_t* data, size_t n, size_t stride = 1) noexcept
+    {
+        // One filter at a time over the whole block, for its coefficients and state to stay in
+        // registers.
+        for (size_t s = 0; s < m_count; s++)
+        {
+            const BiquadCoeffs& c  = m_coeffs[s];
+            State               st = m_state[s];
+            for (size_t i = 0; i < n; i++)
+            {
+                data[i * stride] = Step(c, st, data[i * stride]);
+            }
+            m_state[s] = st;
+        }
+    }
+
+    /**
+     * @brief Filters a block of Q15 samples in place. The filters run in Q31 all the same.
+     * @see Process(q31_t*, size_t, size_t)
+     */
+    void Process(q15_t* data, size_t n, size_t stride = 1) noexcept
+    {
+        if (m_count == 0)
+        {
+            return;
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            q15_t& sample = data[i * stride];
+            q31_t  x      = static_cast<q31_t>(static_cast<uint32_t>(sample) << 16);
+            for (size_t s = 0; s < m_count; s++)
+            {
+                x = Step(m_coeffs[s], m_state[s], x);
+            }
+            sample = SaturateQ15((static_cast<int64_t>(x) + 0x8000) >> 16);
+        }
+    }
+
+private:
+    struct State
+    {
+        q31_t X1 = 0;
+        q31_t X2 = 0;
+        q31_t Y1 = 0;
+        q31_t Y2 = 0;
+    };
+
+    static q31_t Step(const BiquadCoeffs& c, State& st, q31_t x) noexcept
+    {
+        int64_t acc = static_cast<int64_t>(c.B0) * x;
+        acc += static_cast<int64_t>(c.B1) * st.X1;
+        acc += static_cast<int64_t>(c.B2) * st.X2;
+        acc += static_cast<int64_t>(c.A1) * st.Y1;
+        acc += static_cast<int64_t>(c.A2) * st.Y2;
+        q31_t y = SaturateQ31((acc + (1 << 22)) >> 23);
+
+        st.X2 = st.X1;
+        st.X1 = x;
+        st.Y2 = st.Y1;
+        st.Y1 = y;
+        return y;
+    }
+
+private:
+    std::array<BiquadCoeffs, MaxSections> m_coeffs = {};
+    std::array<State, MaxSections>        m_state  = {};
+    size_t                                m_count  = 0;
+};
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_BIQUAD_H
@@ -0,0 +1,106 @@
+/**
+ * @file    fixed_point.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Q15 and Q31 fixed-point types and conversions used by the audio DSP blocks.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_FIXED_POINT_H
+#define NILAI_SERVICES_DSP_FIXED_POINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// The Cortex-M4 and M7 have dual 16-bit multiply-accumulates and saturating instructions, the
+// kernels use them through the ACLE intrinsics. Everything else, the host included, runs the
+// portable versions.
+#if defined(__ARM_FEATURE_DSP) && !defined(NILAI_DSP_PORTABLE)
+#    define NILAI_DSP_SIMD
+#    include <arm_acle.h>
+#endif
+
+namespace Nilai::Services::Dsp
+{
+//! Signed fraction in [-1, 1), with 15 fractional bits.
+using q15_t = int16_t;
+//! Signed fraction in [-1, 1), with 31 fractional bits.
+using q31_t = int32_t;
+
+//! The closest value to 1.0 in Q31.
+static constexpr q31_t s_q31One = INT32_MAX;
+
+constexpr q15_t SaturateQ15(int64_t v) noexcept
+{
+    return v > INT16_MAX ? INT16_MAX : (v < INT16_MIN ? INT16_MIN : static_cast<q15_t>(v));
+}
+
+constexpr q31_t SaturateQ31(int64_t v) noexcept
+{
+    return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : static_cast<q31_t>(v));
+}
+
+constexpr q31_t FloatToQ31(float f) noexcept
+{
+    return SaturateQ31(static_cast<int64_t>(static_cast<double>(f) * 2147483648.0));
+}
+
+constexpr q15_t FloatToQ15(float f) noexcept
+{
+    return SaturateQ15(static_cast<int64_t>(f * 32768.0f));
+}
+
+constexpr float ToFloat(q31_t v) noexcept
+{
+    return static_cast<float>(v) / 2147483648.0f;
+}
+
+constexpr float ToFloat(q15_t v) noexcept
+{
+    return static_cast<float>(v) / 32768.0f;
+}
+
+/**
+ * @brief Widens Q15 samples to Q31. @p in and @p out can't overlap.
+ */
+inline void Q15ToQ31(const q15_t* in, q31_t* out, size_t n) noexcept
+{
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = static_cast<q31_t>(static_cast<uint32_t>(in[i]) << 16);
+    }
+}
+
+/**
+ * @brief Rounds Q31 samples to Q15, saturating.
+ */
+inline void Q31ToQ15(const q31_t* in, q15_t* out, size_t n) noexcept
+{
+    size_t i = 0;
+#if defined(NILAI_DSP_SIMD)
+    // Two samples per store.
+    for (; i + 2 <= n; i += 2)
+    {
+        uint32_t lo   = static_cast<uint16_t>(__qadd(in[i], 0x8000) >> 16);
+        uint32_t hi   = static_cast<uint32_t>(__qadd(in[i + 1], 0x8000) >> 16);
+        uint32_t pair = lo | (hi << 16);
+        std::memcpy(&out[i], &pair, sizeof(pair));
+    }
+#endif
+    for (; i < n; i++)
+    {
+        out[i] = SaturateQ15((static_cast<int64_t>(in[i]) + 0x8000) >> 16);
+    }
+}
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_FIXED_POINT_H
@@ -0,0 +1,149 @@
+/**
+ * @file    gain_ramp.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Gain that slides to its new value instead of jumping to it.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_GAIN_RAMP_H
+#define NILAI_SERVICES_DSP_GAIN_RAMP_H
+
+#include "fixed_point.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Nilai::Services::Dsp
+{
+/**
+ * @brief Gain of a channel, between 0 and 1.
+ *
+ * Changing a gain from one block to the next makes a step in the signal that is heard as a click,
+ * or as zipper noise when the gain is moved continuously. @ref RampTo instead moves the gain a bit
+ * on every sample, until it reaches its target.
+ */
+class GainRamp
+{
+public:
+    constexpr GainRamp() noexcept = default;
+    constexpr explicit GainRamp(q31_t gain) noexcept { SetGain(gain); }
+
+    //! Jumps to @p gain, cancelling any ramp.
+    constexpr void SetGain(q31_t gain) noexcept
+    {
+        m_gain      = Clamp(gain);
+        m_target    = m_gain;
+        m_step      = 0;
+        m_remaining = 0;
+    }
+
+    /**
+     * @brief Moves linearly to @p target over the next @p samples samples.
+     *
+     * A ramp of 0 sample jumps to the target. A ramp started during another one starts from where
+     * the other one was.
+     */
+    constexpr void RampTo(q31_t target, size_t samples) noexcept
+    {
+        target = Clamp(target);
+        if (samples == 0 || target == m_gain)
+        {
+            SetGain(target);
+            return;
+        }
+        m_target    = target;
+        m_step      = static_cast<int32_t>((static_cast<int64_t>(target) - m_gain) /
+                                           static_cast<int64_t>(samples));
+        m_remaining = samples;
+    }
+
+    [[nodiscard]] constexpr q31_t  GetGain() const noexcept { return m_gain; }
+    [[nodiscard]] constexpr q31_t  GetTarget() const noexcept { return m_target; }
+    [[nodiscard]] constexpr bool   IsRamping() const noexcept { return m_remaining != 0; }
+    [[nodiscard]] constexpr size_t RemainingSamples() const noexcept { return m_remaining; }
+
+    /**
+     * @brief Applies the gain to a block of Q15 samples, in place.
+     * @param data The samples.
+     * @param n Number of samples.
+     * @param stride Distance between two samples, the number of channels for interleaved data.
+     */
+    void Process(q15_t* data, size_t n, size_t stride = 1) noexcept
+    {
+        size_t i = Ramp(data, n, stride);
+        if (m_gain == s_q31One)
+        {
+            return;
+        }
+        // The gain is constant for the rest of the block, it fits in 16 bits and so does the
+        // product.
+        int32_t g = SaturateQ15((static_cast<int64_t>(m_gain) + 0x8000) >> 16);
+        for (; i < n; i++)
+        {
+            q15_t& x = data[i * stride];
+            x        = static_cast<q15_t>((static_cast<int32_t>(x) * g) >> 15);
+        }
+    }
+
+    /**
+     * @brief Applies the gain to a block of Q31 samples, in place.
+     * @see Process(q15_t*, size_t, size_t)
+     */
+    void Process(q31_t* data, size_t n, size_t stride = 1) noexcept
+    {
+        size_t i = Ramp(data, n, stride);
+        if (m_gain == s_q31One)
+        {
+            return;
+        }
+        for (; i < n; i++)
+        {
+            q31_t& x = data[i * stride];
+            x        = Apply(x, m_gain);
+        }
+    }
+
+private:
+    static constexpr q31_t Clamp(q31_t gain) noexcept { return gain < 0 ? 0 : gain; }
+
+    template<typename T>
+    static constexpr T Apply(T x, q31_t gain) noexcept
+    {
+        return static_cast<T>((static_cast<int64_t>(x) * gain) >> 31);
+    }
+
+    //! Runs the ramp over the start of the block, returns the number of samples it took.
+    template<typename T>
+    size_t Ramp(T* data, size_t n, size_t stride) noexcept
+    {
+        size_t i = 0;
+        for (; i < n && m_remaining != 0; i++)
+        {
+            m_remaining--;
+            // The last step lands on the target, whatever the rounding of the step was.
+            m_gain = m_remaining == 0 ? m_target : m_gain + m_step;
+
+            T& x = data[i * stride];
+            x    = Apply(x, m_gain);
+        }
+        return i;
+    }
+
+private:
+    q31_t   m_gain      = s_q31One;
+    q31_t   m_target    = s_q31One;
+    int32_t m_step      = 0;
+    size_t  m_remaining = 0;
+};
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_GAIN_RAMP_H
@@ -0,0 +1,169 @@
+/**
+ * @file    mixer.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Weighted sum of several blocks of samples.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_MIXER_H
+#define NILAI_SERVICES_DSP_MIXER_H
+
+#include "fixed_point.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+namespace Nilai::Services::Dsp
+{
+/**
+ * @brief Mixes up to @p MaxInputs sources into one, each with its own gain.
+ *
+ * The sum is computed on 64 bits and saturated once, so sources can be loud without clipping each
+ * other as long as the mix itself fits.
+ *
+ * @tparam MaxInputs Maximum number of sources.
+ */
+template<size_t MaxInputs>
+class Mixer
+{
+public:
+    constexpr Mixer() noexcept { m_gains.fill(s_q31One); }
+
+    /**
+     * @brief Sets the gain of a source, between 0 and 1. Defaults to 1.
+     * @return False if @p input is out of range.
+     */
+    constexpr bool SetGain(size_t input, q31_t gain) noexcept
+    {
+        if (input >= MaxInputs)
+        {
+            return false;
+        }
+        m_gains[input] = gain < 0 ? 0 : gain;
+        return true;
+    }
+
+    [[nodiscard]] constexpr q31_t GetGain(size_t input) const noexcept
+    {
+        return input < MaxInputs ? m_gains[input] : 0;
+    }
+
+    /**
+     * @brief Mixes blocks of Q15 samples.
+     * @param inputs One buffer of @p n samples per source, source @c k using gain @c k.
+     * @param out Where the mix is written. Can be one of the inputs.
+     * @param n Number of samples per buffer, all channels included for interleaved data.
+     */
+    void Process(std::span<const q15_t* const> inputs, q15_t* out, size_t n) const noexcept
+    {
+        size_t count = inputs.size() < MaxInputs ? inputs.size() : MaxInputs;
+        if (count == 0)
+        {
+            std::memset(out, 0, n * sizeof(q15_t));
+            return;
+        }
+        if (count == 1 && m_gains[0] == s_q31One)
+        {
+            if (inputs[0] != out)
+            {
+                std::memmove(out, inputs[0], n * sizeof(q15_t));
+            }
+            return;
+        }
+
+#if defined(NILAI_DSP_SIMD)
+        // The gains of two sources are packed in a word, to be multiplied with a sample of each
+        // source with a single dual multiply-accumulate.
+        std::array<int32_t, (MaxInputs + 1) / 2> pairs = {};
+        for (size_t k = 0; k + 1 < count; k += 2)
+        {
+            pairs[k / 2] = static_cast<int32_t>(static_cast<uint16_t>(Gain15(k)) |
+                                                (static_cast<uint32_t>(Gain15(k + 1)) << 16));
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            int64_t acc = 0;
+            size_t  k   = 0;
+            for (; k + 1 < count; k += 2)
+            {
+                int32_t x = static_cast<int32_t>(static_cast<uint16_t>(inputs[k][i]) |
+                                                 (static_cast<uint32_t>(inputs[k + 1][i]) << 16));
+                acc       = __smlald(x, pairs[k / 2], acc);
+            }
+            if (k < count)
+            {
+                acc += static_cast<int32_t>(inputs[k][i]) * Gain15(k);
+            }
+            out[i] = SaturateQ15((acc + (1 << 14)) >> 15);
+        }
+#else
+        for (size_t i = 0; i < n; i++)
+        {
+            int64_t acc = 0;
+            for (size_t k = 0; k < count; k++)
+            {
+                acc += static_cast<int32_t>(inputs[k][i]) * Gain15(k);
+            }
+            out[i] = SaturateQ15((acc + (1 << 14)) >> 15);
+        }
+#endif
+    }
+
+    /**
+     * @brief Mixes blocks of Q31 samples.
+     * @see Process(std::span<const q15_t* const>, q15_t*, size_t)
+     */
+    void Process(std::span<const q31_t* const> inputs, q31_t* out, size_t n) const noexcept
+    {
+        size_t count = inputs.size() < MaxInputs ? inputs.size() : MaxInputs;
+        if (count == 0)
+        {
+            std::memset(out, 0, n * sizeof(q31_t));
+            return;
+        }
+        if (count == 1 && m_gains[0] == s_q31One)
+        {
+            if (inputs[0] != out)
+            {
+                std::memmove(out, inputs[0], n * sizeof(q31_t));
+            }
+            return;
+        }
+
+        for (size_t i = 0; i < n; i++)
+        {
+            // Each product is brought back to Q31 before the sum, for it not to overflow.
+            int64_t acc = 0;
+            for (size_t k = 0; k < count; k++)
+            {
+                acc += (static_cast<int64_t>(inputs[k][i]) * m_gains[k]) >> 31;
+            }
+            out[i] = SaturateQ31(acc);
+        }
+    }
+
+private:
+    [[nodiscard]] constexpr int32_t Gain15(size_t k) const noexcept
+    {
+        // Rounded, with a gain of 1 staying 0x7FFF.
+        return SaturateQ15((static_cast<int64_t>(m_gains[k]) + 0x8000) >> 16);
+    }
+
+private:
+    std::array<q31_t, MaxInputs> m_gains = {};
+};
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_MIXER_H
@@ -0,0 +1,344 @@
+/**
+ * @file    resampler.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Polyphase sample-rate converter for streamed audio.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_RESAMPLER_H
+#define NILAI_SERVICES_DSP_RESAMPLER_H
+
+#include "fixed_point.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#if !defined(NILAI_DSP_SRC_MAX_PHASES)
+#    define NILAI_DSP_SRC_MAX_PHASES 1024
+#endif
+
+namespace Nilai::Services::Dsp
+{
+/**
+ * @brief Settings of a @ref Resampler.
+ *
+ * The rates are in Hz. The values of Sai::SamplingRate and I2S::AudioFreqs are their rate in Hz,
+ * they can be cast to @c uint32_t.
+ */
+struct ResamplerConfig
+{
+    uint32_t InputRate  = 44100;
+    uint32_t OutputRate = 48000;
+    //! Length of the filter, in input samples. Longer filters have a sharper cut-off.
+    size_t TapsPerPhase = 32;
+    //! Bandwidth kept, as a fraction of the Nyquist frequency of the lowest rate.
+    float Passband = 0.9f;
+};
+
+/**
+ * @brief Result of @ref Resampler::Process.
+ */
+struct ResampleResult
+{
+    size_t Consumed = 0;    //!< Number of input frames used.
+    size_t Produced = 0;    //!< Number of output frames written.
+};
+
+/**
+ * @brief Converts interleaved audio from one sample rate to another by a rational ratio.
+ *
+ * The ratio of the rates is reduced to L/M: the input is conceptually upsampled by L, low-pass
+ * filtered and decimated by M. Only the outputs that are kept are computed, each with one of the
+ * L phases of the filter, so an output costs @ref ResamplerConfig::TapsPerPhase
+ * multiply-accumulates per channel whatever the ratio.
+ *
+ * This keeps the output clock fixed while the sources change: the audio device streams at one
+ * rate, and the refill callback of its pipeline converts the current source with
+ * @ref InputFramesFor and @ref Process. When the source changes, the resampler is configured again
+ * instead of the peripheral.
+ *
+ * The filter takes L * TapsPerPhase coefficients, L being at most NILAI_DSP_SRC_MAX_PHASES, and the
+ * history 2 * Channels * TapsPerPhase samples, both allocated by @ref Configure. Nothing else is
+ * allocated, not even temporarily. From 44.1 kHz to 48 kHz, L is 160: with 32 taps per phase, the
+ * coefficients take 10 KiB in Q15 and 20 KiB in Q31.
+ *
+ * @tparam T The type of the samples, @ref q15_t or @ref q31_t.
+ * @tparam Channels Number of interleaved channels.
+ */
+template<typename T, size_t Channels>
+class Resampler
+{
+    static_assert(std::is_same_v<T, q15_t> || std::is_same_v<T, q31_t>,
+                  "Samples must be in Q15 or in Q31");
+    static_assert(Channels > 0, "A resampler needs at least one channel");
+
+public:
+    /**
+     * @brief Computes the filter and clears the history. Must not be called while processing.
+     * @return False if the configuration is invalid, or if the ratio needs too many phases.
+     */
+    bool Configure(const ResamplerConfig& config)
+    {
+        if (config.InputRate == 0 || config.OutputRate == 0 || config.TapsPerPhase == 0 ||
+            !(config.Passband > 0.0f && config.Passband <= 1.0f))
+        {
+            return false;
+        }
+        uint32_t g  = std::gcd(config.InputRate, config.OutputRate);
+        uint32_t up = config.OutputRate / g;
+        if (up > NILAI_DSP_SRC_MAX_PHASES)
+        {
+            return false;
+        }
+
+        m_config = config;
+        m_up     = up;
+        m_down   = config.InputRate / g;
+        m_taps   = config.TapsPerPhase;
+        if (IsBypassed())
+        {
+            m_coeffs.clear();
+            m_history.clear();
+        }
+        else
+        {
+            DesignFilter();
+            m_history.assign(Channels * 2 * m_taps, 0);
+        }
+        Reset();
+        return true;
+    }
+
+    //! Clears the history, to be used after a discontinuity in the input.
+    void Reset() noexcept
+    {
+        std::fill(m_history.begin(), m_history.end(), T {0});
+        m_pos   = 0;
+        m_phase = 0;
+        m_need  = 1;
+    }
+
+    [[nodiscard]] bool IsConfigured() const noexcept { return m_up != 0; }
+    //! True when both rates are the same, the frames are then copied.
+    [[nodiscard]] bool     IsBypassed() const noexcept { return m_up == m_down; }
+    [[nodiscard]] uint32_t GetUpFactor() const noexcept { return m_up; }
+    [[nodiscard]] uint32_t GetDownFactor() const noexcept { return m_down; }
+    [[nodiscard]] const ResamplerConfig& Config() const noexcept { return m_config; }
+
+    /**
+     * @brief Number of input frames @ref Process needs to produce exactly @p outFrames frames.
+     */
+    [[nodiscard]] size_t InputFramesFor(size_t outFrames) const noexcept
+    {
+        if (outFrames == 0 || !IsConfigured())
+        {
+            return 0;
+        }
+        if (IsBypassed())
+        {
+            return outFrames;
+        }
+        uint64_t pos = m_phase + static_cast<uint64_t>(outFrames - 1) * m_down;
+        return m_need + static_cast<size_t>(pos / m_up);
+    }
+
+    /**
+     * @brief Converts frames until either the input is used up or the output is full.
+     *
+     * The input that can't be used yet is kept in the history, so blocks of any size can be fed.
+     *
+     * @param in Interleaved input frames.
+     * @param inFrames Number of input frames.
+     * @param out Where the interleaved output frames are written.
+     * @param outFrames Room in @p out, in frames.
+     *
+     * @note Unless the rates are the same, @p in and @p out must not overlap.
+     */
+    ResampleResult Process(const T* in, size_t inFrames, T* out, size_t outFrames) noexcept
+    {
+        ResampleResult r = {};
+        if (!IsConfigured())
+        {
+            return r;
+        }
+        if (IsBypassed())
+        {
+            r.Consumed = r.Produced = inFrames < outFrames ? inFrames : outFrames;
+            std::memmove(out, in, r.Produced * Channels * sizeof(T));
+            return r;
+        }
+
+        while (r.Produced < outFrames)
+        {
+            for (; m_need != 0; m_need--)
+            {
+                if (r.Consumed == inFrames)
+                {
+                    return r;
+                }
+                Push(&in[r.Consumed * Channels]);
+                r.Consumed++;
+            }
+
+            const T* h = &m_coeffs[m_phase * m_taps];
+            for (size_t c = 0; c < Channels; c++)
+            {
+                const T* x                     = &m_history[c * 2 * m_taps + m_pos + 1];
+                out[r.Produced * Channels + c] = Dot(h, x, m_taps);
+            }
+            r.Produced++;
+
+            uint32_t next = m_phase + m_down;
+            m_need        = next / m_up;
+            m_phase       = next % m_up;
+        }
+        return r;
+    }
+
+private:
+    void DesignFilter()
+    {
+        // Windowed sinc, cut at the Nyquist frequency of the lowest rate. The frequencies are
+        // relative to the upsampled rate.
+        size_t n      = static_cast<size_t>(m_up) * m_taps;
+        double fc     = 0.5 * m_config.Passband / static_cast<double>(std::max(m_up, m_down));
+        double center = static_cast<double>(n - 1) / 2.0;
+        double i0Beta = BesselI0(s_beta);
+
+        // Tap i of the prototype, computed when needed instead of being stored: the whole filter
+        // in double would take 8 times the room of the Q31 coefficients.
+        auto proto = [&](size_t i)
+        {
+            double t = static_cast<double>(i) - center;
+            double s = t == 0.0 ? 2.0 * fc : std::sin(2.0 * s_pi * fc * t) / (s_pi * t);
+            double r = n == 1 ? 0.0 : t / center;
+            return s * BesselI0(s_beta * std::sqrt(1.0 - r * r)) / i0Beta;
+        };
+
+        // Each phase is normalized to a gain of 1, for a constant input to stay constant whatever
+        // phase computes the output. The taps of a phase are stored oldest first, in the order of
+        // the history.
+        m_coeffs.assign(n, 0);
+        for (size_t p = 0; p < m_up; p++)
+        {
+            double sum = 0.0;
+            for (size_t j = 0; j < m_taps; j++)
+            {
+                sum += proto(p + j * m_up);
+            }
+            for (size_t j = 0; j < m_taps; j++)
+            {
+                double v                                = proto(p + j * m_up) / sum;
+                m_coeffs[p * m_taps + (m_taps - 1 - j)] = Quantize(v);
+            }
+        }
+    }
+
+    static T Quantize(double v) noexcept
+    {
+        constexpr double scale = std::is_same_v<T, q15_t> ? 32768.0 : 2147483648.0;
+        double           s     = v * scale;
+        int64_t          q     = static_cast<int64_t>(s < 0 ? s - 0.5 : s + 0.5);
+        if constexpr (std::is_same_v<T, q15_t>)
+        {
+            return SaturateQ15(q);
+        }
+        else
+        {
+            return SaturateQ31(q);
+        }
+    }
+
+    static double BesselI0(double x) noexcept
+    {
+        double sum  = 1.0;
+        double term = 1.0;
+        for (int k = 1; k < 32; k++)
+        {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    //! Adds a frame to the history, which is kept twice for the window to always be contiguous.
+    void Push(const T* frame) noexcept
+    {
+        m_pos = m_pos + 1 == m_taps ? 0 : m_pos + 1;
+        for (size_t c = 0; c < Channels; c++)
+        {
+            T* h              = &m_history[c * 2 * m_taps];
+            h[m_pos]          = frame[c];
+            h[m_pos + m_taps] = frame[c];
+        }
+    }
+
+    static q15_t Dot(const q15_t* h, const q15_t* x, size_t n) noexcept
+    {
+        int64_t acc = 0;
+        size_t  i   = 0;
+#if defined(NILAI_DSP_SIMD)
+        // Two taps per dual multiply-accumulate.
+        for (; i + 2 <= n; i += 2)
+        {
+            int32_t hh = 0;
+            int32_t xx = 0;
+            std::memcpy(&hh, &h[i], sizeof(hh));
+            std::memcpy(&xx, &x[i], sizeof(xx));
+            acc = __smlald(hh, xx, acc);
+        }
+#endif
+        for (; i < n; i++)
+        {
+            acc += static_cast<int32_t>(h[i]) * x[i];
+        }
+        return SaturateQ15((acc + (1 << 14)) >> 15);
+    }
+
+    static q31_t Dot(const q31_t* h, const q31_t* x, size_t n) noexcept
+    {
+        // Only the high word of each product is kept, which leaves guard bits for the sum.
+        int64_t acc = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            acc += (static_cast<int64_t>(h[i]) * x[i]) >> 32;
+        }
+        return SaturateQ31(acc * 2);
+    }
+
+private:
+    static constexpr double s_pi = 3.14159265358979323846;
+    //! Shape of the Kaiser window, for about 70 dB of stop-band attenuation.
+    static constexpr double s_beta = 7.0;
+
+    ResamplerConfig m_config = {};
+    uint32_t        m_up     = 0;
+    uint32_t        m_down   = 0;
+    size_t          m_taps   = 0;
+
+    std::vector<T> m_coeffs;
+    std::vector<T> m_history;
+
+    size_t   m_pos   = 0;
+    uint32_t m_phase = 0;
+    //! Number of input frames to push before the next output can be computed.
+    size_t m_need = 1;
+};
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_RESAMPLER_H
@@ -0,0 +1,108 @@
+/**
+ * @file    stage.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Software audio processing run on each block before it is streamed.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_DSP_STAGE_H
+#define NILAI_SERVICES_DSP_STAGE_H
+
+#include "biquad.h"
+#include "fixed_point.h"
+#include "gain_ramp.h"
+#include "mixer.h"
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace Nilai::Services::Dsp
+{
+/**
+ * @brief Mixes interleaved sources, then filters and scales each channel of the mix.
+ *
+ * This does in software what the TAS5707's on-chip DSP does, without having to push coefficients
+ * over I2C, and for any output. It is meant to be run from the refill callback of an audio
+ * pipeline, right before the block is handed to the DMA:
+ * @code
+ * size_t Refill(void* dst, size_t frames, void* ctx)
+ * {
+ *     auto* app = static_cast<App*>(ctx);
+ *     std::array<const q15_t*, 2> sources = {app->Music(frames), app->Beeps(frames)};
+ *     app->Stage.Process(std::span<const q15_t* const> {sources}, static_cast<q15_t*>(dst),
+ *                        frames);
+ *     return frames;
+ * }
+ * @endcode
+ *
+ * @tparam Channels Number of channels of the sources and of the output, 2 for stereo.
+ * @tparam MaxInputs Maximum number of sources.
+ * @tparam MaxSections Maximum number of biquads per channel.
+ */
+template<size_t Channels, size_t MaxInputs, size_t MaxSections>
+class Stage
+{
+    static_assert(Channels > 0, "A stage needs at least one channel");
+
+public:
+    Mixer<MaxInputs>& GetMixer() noexcept { return m_mixer; }
+
+    //! Filters of @p channel, which must be lower than @p Channels.
+    BiquadCascade<MaxSections>& GetFilters(size_t channel) noexcept { return m_filters[channel]; }
+
+    //! Output gain of @p channel, which must be lower than @p Channels.
+    GainRamp& GetGain(size_t channel) noexcept { return m_gains[channel]; }
+
+    //! Ramps the gain of every channel to @p target over @p frames frames.
+    void RampAllTo(q31_t target, size_t frames) noexcept
+    {
+        for (auto& g : m_gains)
+        {
+            g.RampTo(target, frames);
+        }
+    }
+
+    //! Clears the history of the filters.
+    void Reset() noexcept
+    {
+        for (auto& f : m_filters)
+        {
+            f.Reset();
+        }
+    }
+
+    /**
+     * @brief Processes a block.
+     * @param inputs The sources, each holding @p frames interleaved frames.
+     * @param out Where the result is written, interleaved. Can be one of the sources.
+     * @param frames Number of frames.
+     */
+    template<typename T>
+    void Process(std::span<const T* const> inputs, T* out, size_t frames) noexcept
+    {
+        m_mixer.Process(inputs, out, frames * Channels);
+        for (size_t c = 0; c < Channels; c++)
+        {
+            m_filters[c].Process(out + c, frames, Channels);
+            m_gains[c].Process(out + c, frames, Channels);
+        }
+    }
+
+private:
+    Mixer<MaxInputs>                                 m_mixer;
+    std::array<BiquadCascade<MaxSections>, Channels> m_filters = {};
+    std::array<GainRamp, Channels>                   m_gains   = {};
+};
+}    // namespace Nilai::Services::Dsp
+
+#endif    // NILAI_SERVICES_DSP_STAGE_H
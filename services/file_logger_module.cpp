@@ -6,10 +6,12 @@
  *******************************************************************************
  */
 #if defined(NILAI_USE_FILE_LOGGER)
-#    include "fileLoggerModule.h"
+#    include "file_logger_module.h"
 
-#    include "services/logger.hpp"
+#    include "logger.h"
+#    include "time.h"
 
+#    include <algorithm>
 #    include <cstring>
 
 FileLogger::FileLogger(const std::string& label, const std::string& path)
@@ -38,7 +40,7 @@ bool FileLogger::DoPost()
         {
             LOG_ERROR("[%s]: POST error, unable to open log file: %s",
                       m_label.c_str(),
-                      Nilai::Filesystem::ResultToStr(m_logFile.GetError()).c_str());
+                      Nilai::Filesystem::ResultToStr(m_logFile.GetError()));
             return false;
         }
     }
@@ -56,11 +58,16 @@ bool FileLogger::DoPost()
 
 void FileLogger::Run()
 {
-    static size_t lastSync = 0;
-
-    if (HAL_GetTick() >= lastSync + SYNC_TIME)
+    uint32_t now = Nilai::GetTime();
+#    if defined(NILAI_LOGGER_ASYNC)
+    // Writing a half-full cache leaves room for the logger to keep feeding it in the meantime.
+    bool flush = (m_cacheLoc >= CACHE_SIZE / 2) || (now - m_lastSync >= SYNC_TIME);
+#    else
+    bool flush = now - m_lastSync >= SYNC_TIME;
+#    endif
+    if (flush)
     {
-        lastSync = HAL_GetTick();
+        m_lastSync = now;
         Flush();
     }
 }
@@ -83,7 +90,7 @@ void FileLogger::Flush()
         r = m_logFile.Open(m_path, FileModes::WRITE_APPEND);
         if (r != Result::Ok)
         {
-            CEP_ASSERT(false, "Unable to open log file!");
+            NILAI_ASSERT(false, "Unable to open log file!");
             m_cacheLoc = 0;
             return;
         }
@@ -94,15 +101,20 @@ void FileLogger::Flush()
     r         = m_logFile.Write(m_cache, m_cacheLoc, &dw);
     if ((r != Result::Ok) || (m_cacheLoc != dw))
     {
-        CEP_ASSERT(false, "Unable to write to log file: %s", ResultToStr(r).c_str());
+        NILAI_ASSERT(false, "Unable to write to log file: %s", ResultToStr(r));
         m_cacheLoc = 0;
         return;
     }
 
+#    if defined(NILAI_LOGGER_ASYNC)
+    // Flushes happen often in this mode, re-opening the file each time would be too slow.
+    r = m_logFile.Sync();
+#    else
     r = m_logFile.Close();
+#    endif
     if (r != Result::Ok)
     {
-        CEP_ASSERT(false, "Unable to close file!");
+        NILAI_ASSERT(false, "Unable to close file!");
         m_cacheLoc = 0;
         return;
     }
@@ -110,6 +122,17 @@ void FileLogger::Flush()
     m_cacheLoc = 0;
 }
 
+#    if defined(NILAI_LOGGER_ASYNC)
+size_t FileLogger::Consume(std::span<const char> data)
+{
+    // Never touches the file here, what doesn't fit waits in the logger's ring.
+    size_t len = std::min(data.size(), CACHE_SIZE - m_cacheLoc);
+    std::memcpy(&m_cache[m_cacheLoc], data.data(), len);
+    m_cacheLoc += len;
+    return len;
+}
+#    endif
+
 void FileLogger::Log(const char* msg, size_t len)
 {
     // If buffer is full, flush it.
@@ -12,17 +12,39 @@
 /***********************************************/
 /* Includes */
 #if defined(NILAI_USE_FILE_LOGGER)
-#    include "defines/module.hpp"
+#    include "../defines/module.h"
 
-#    include "services/file.h"
-#    include "services/filesystem.h"
+#    include "file.h"
+#    include "filesystem.h"
+
+#    if defined(NILAI_LOGGER_ASYNC)
+#        include "log_ring.h"
+#    endif
 
 #    include <functional>
 
 
 /***********************************************/
 /* Defines */
+#    if !defined(NILAI_FILE_LOGGER_CACHE_SIZE)
+#        define NILAI_FILE_LOGGER_CACHE_SIZE 512
+#    endif
+#    if !defined(NILAI_FILE_LOGGER_SYNC_INTERVAL)
+#        define NILAI_FILE_LOGGER_SYNC_INTERVAL 1000
+#    endif
+
+/**
+ * @brief Module writing the log to a file.
+ *
+ * With NILAI_LOGGER_ASYNC, the module is a sink of the logger: add it with
+ * Nilai::Services::Logger::AddSink. The logger only hands it as much of the log as fits in its
+ * cache, the cache is written to the file by Run once it is half full or every SYNC_TIME
+ * milliseconds. The file is kept open between the writes.
+ */
 class FileLogger : public Nilai::Module
+#    if defined(NILAI_LOGGER_ASYNC)
+, public Nilai::Services::LogSink
+#    endif
 {
 public:
     FileLogger() = default;
@@ -41,6 +63,10 @@ public:
 
     void Flush();
 
+#    if defined(NILAI_LOGGER_ASYNC)
+    size_t Consume(std::span<const char> data) override;
+#    endif
+
 private:
     void Log(const char* msg, size_t len);
 
@@ -54,6 +80,7 @@ private:
     static constexpr size_t SYNC_TIME           = NILAI_FILE_LOGGER_SYNC_INTERVAL;
     char                    m_cache[CACHE_SIZE] = {0};
     size_t                  m_cacheLoc          = 0;
+    uint32_t                m_lastSync          = 0;
 };
 
 /***********************************************/
@@ -0,0 +1,264 @@
+/**
+ * @file    log_ring.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Ring buffer shared by the producers of log messages and the sinks that consume them.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_SERVICES_LOG_RING_H
+#define NILAI_SERVICES_LOG_RING_H
+
+#include "../defines/system.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Services
+{
+/**
+ * @brief Destination of the log messages, fed by the logger from the main loop.
+ */
+class LogSink
+{
+public:
+    virtual ~LogSink() = default;
+
+    /**
+     * @brief Hands the next bytes of the log to the sink.
+     *
+     * Must never block. The sink takes as many bytes as it can right now, the rest is handed to
+     * it again on the next call.
+     *
+     * @param data The bytes waiting to be consumed. Can end in the middle of a message.
+     * @return The number of bytes taken by the sink.
+     */
+    virtual size_t Consume(std::span<const char> data) = 0;
+};
+
+/**
+ * @brief Sink that passes the log to a function.
+ */
+class CallbackLogSink : public LogSink
+{
+public:
+    using Callback = std::function<void(const char*, size_t)>;
+
+    explicit CallbackLogSink(Callback cb) : m_cb(std::move(cb)) {}
+
+    size_t Consume(std::span<const char> data) override
+    {
+        if (m_cb)
+        {
+            m_cb(data.data(), data.size());
+        }
+        return data.size();
+    }
+
+    void SetCallback(Callback cb) { m_cb = std::move(cb); }
+
+private:
+    Callback m_cb;
+};
+
+/**
+ * @brief Byte ring written by any number of producers and read by up to @p MaxSinks sinks, each
+ * at its own pace.
+ *
+ * Messages are written whole or not at all. When the slowest sink lags too far behind, new
+ * messages are dropped and counted instead of waiting for room. @ref Write only masks the
+ * interrupts for the time of the copy, so it can be called from interrupts. The message must then
+ * not be in a buffer that an interrupt could modify during the call.
+ *
+ * @tparam Size Size of the ring, in bytes. Must be a power of two.
+ * @tparam MaxSinks Maximum number of sinks reading the ring.
+ */
+template<size_t Size, size_t MaxSinks>
+class LogRing
+{
+    static_assert(std::has_single_bit(Size), "The size of the ring must be a power of 2!");
+
+    static constexpr size_t s_mask = Size - 1;
+
+public:
+    static constexpr size_t s_invalidSink = MaxSinks;
+
+    /**
+     * @brief Adds a reader to the ring. It only sees the messages written from now on.
+     * @return The id of the sink, or @ref s_invalidSink if there are already @p MaxSinks sinks.
+     */
+    size_t AddSink() noexcept
+    {
+        System::CriticalSection lock;
+        for (size_t i = 0; i < MaxSinks; i++)
+        {
+            if (!m_used[i])
+            {
+                m_used[i] = true;
+                m_tails[i].store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                return i;
+            }
+        }
+        return s_invalidSink;
+    }
+
+    void RemoveSink(size_t sink) noexcept
+    {
+        System::CriticalSection lock;
+        if (sink < MaxSinks)
+        {
+            m_used[sink] = false;
+        }
+    }
+
+    /**
+     * @brief Appends a message to the ring. Can be called from any context.
+     * @return True if the message was written, false if it was dropped for lack of room.
+     */
+    bool Write(std::span<const char> msg) noexcept
+    {
+        System::CriticalSection lock;
+
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t used = head - SlowestTail(head);
+        if (msg.size() > Size - used)
+        {
+            m_droppedMessages++;
+            return false;
+        }
+
+        size_t pos   = head & s_mask;
+        size_t first = std::min(msg.size(), Size - pos);
+        std::memcpy(&m_buffer[pos], msg.data(), first);
+        std::memcpy(&m_buffer[0], msg.data() + first, msg.size() - first);
+
+        m_head.store(head + msg.size(), std::memory_order_release);
+        m_highWaterMark = std::max(m_highWaterMark, used + msg.size());
+        return true;
+    }
+
+    /**
+     * @brief Gets the contiguous bytes that a sink hasn't consumed yet.
+     *
+     * When the bytes wrap around the end of the ring, only the first part is returned.
+     */
+    [[nodiscard]] std::span<const char> Peek(size_t sink) const noexcept
+    {
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail = m_tails[sink].load(std::memory_order_relaxed);
+        size_t pos  = tail & s_mask;
+        return {&m_buffer[pos], std::min(head - tail, Size - pos)};
+    }
+
+    /**
+     * @brief Marks bytes as consumed by a sink.
+     */
+    void Consume(size_t sink, size_t count) noexcept
+    {
+        m_tails[sink].store(m_tails[sink].load(std::memory_order_relaxed) + count,
+                            std::memory_order_release);
+    }
+
+    /**
+     * @brief Hands the pending bytes to a sink until it stops taking them.
+     *
+     * @param sink The id of the sink.
+     * @param consume Called with the next contiguous bytes, returns how many it took.
+     * @return The number of bytes consumed.
+     */
+    template<typename F>
+    size_t Drain(size_t sink, F&& consume)
+    {
+        size_t total = 0;
+        while (true)
+        {
+            std::span<const char> data = Peek(sink);
+            if (data.empty())
+            {
+                break;
+            }
+            size_t taken = std::min(consume(data), data.size());
+            Consume(sink, taken);
+            total += taken;
+            if (taken < data.size())
+            {
+                break;
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Gets the number of bytes not yet consumed by the slowest sink.
+     */
+    [[nodiscard]] size_t Used() const noexcept
+    {
+        System::CriticalSection lock;
+        size_t                  head = m_head.load(std::memory_order_relaxed);
+        return head - SlowestTail(head);
+    }
+
+    [[nodiscard]] static constexpr size_t Capacity() noexcept { return Size; }
+
+    /**
+     * @brief Gets the number of messages dropped because the ring was full.
+     */
+    [[nodiscard]] size_t DroppedMessages() const noexcept { return m_droppedMessages; }
+
+    /**
+     * @brief Gets the highest number of bytes that were waiting in the ring at once.
+     */
+    [[nodiscard]] size_t HighWaterMark() const noexcept { return m_highWaterMark; }
+
+    void ResetStats() noexcept
+    {
+        System::CriticalSection lock;
+        m_droppedMessages = 0;
+        m_highWaterMark   = 0;
+    }
+
+private:
+    [[nodiscard]] size_t SlowestTail(size_t head) const noexcept
+    {
+        // Without any sink, the messages are discarded as they are written.
+        size_t used = 0;
+        for (size_t i = 0; i < MaxSinks; i++)
+        {
+            if (m_used[i])
+            {
+                used = std::max(used, head - m_tails[i].load(std::memory_order_acquire));
+            }
+        }
+        return head - used;
+    }
+
+private:
+    std::array<char, Size>                    m_buffer          = {};
+    std::atomic<size_t>                       m_head            = 0;
+    std::array<std::atomic<size_t>, MaxSinks> m_tails           = {};
+    std::array<bool, MaxSinks>                m_used            = {};
+    size_t                                    m_droppedMessages = 0;
+    size_t                                    m_highWaterMark   = 0;
+};
+}    // namespace Nilai::Services
+//!@}
+#endif    // NILAI_SERVICES_LOG_RING_H
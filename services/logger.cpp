@@ -9,32 +9,62 @@
 #if defined(NILAI_USE_LOGGER) && !defined(NILAI_TEST)
 #    include "logger.h"
 #    include "../defines/macros.h"
+#    include "../defines/system.h"
 #    if defined(NILAI_USE_UART)
 #        include "../drivers/uart_module.h"
 #    endif
 
+#    include <algorithm>
 #    include <cstdarg>
 #    include <cstdio>
 #    include <utility>
 
 namespace Nilai::Services
 {
+namespace
+{
+//! Longest message Log can send, with its terminating null character.
+constexpr size_t s_maxMessageSize = 1024;
+#    if defined(NILAI_USE_UART) && defined(NILAI_UART_TX_USE_QUEUE)
+static_assert(NILAI_UART_TX_QUEUE_BUFF_SIZE >= s_maxMessageSize,
+              "The UART TX queue can't hold the longest message of the logger");
+#    endif
+}    // namespace
+
 Logger* Logger::s_instance = nullptr;
 
 #    if defined(NILAI_USE_UART)
 Logger::Logger(Drivers::UartModule& uart, LogFunc logFunc)
-: m_uart(uart), m_logFunc(std::move(logFunc))
+: m_uart(uart),
+  m_logFunc(std::move(logFunc))
+#        if defined(NILAI_LOGGER_ASYNC)
+  ,
+  m_uartSink(uart),
+  m_funcSink(m_logFunc)
+#        endif
 {
     NILAI_ASSERT(s_instance == nullptr, "");
     NILAI_ASSERT(m_logFunc, "");
     s_instance = this;
+#        if defined(NILAI_LOGGER_ASYNC)
+    AddSink(m_uartSink);
+    AddSink(m_funcSink);
+#        endif
 }
 #    else
-Logger::Logger(const LogFunc& logFunc) : m_logFunc(std::move(logFunc))
+Logger::Logger(const LogFunc& logFunc)
+: m_logFunc(std::move(logFunc))
+#        if defined(NILAI_LOGGER_ASYNC)
+  ,
+  m_funcSink(m_logFunc)
+#        endif
 {
     CEP_ASSERT(s_instance == nullptr, "Can only have one instance of Logger!");
     NILAI_ASSERT(m_logFunc, "");
     s_instance = this;
+#        if defined(NILAI_LOGGER_ASYNC)
+    AddSink(m_funcSink);
+#        endif
 }
 #    endif
 
@@ -55,23 +85,123 @@ void Logger::Log(const char* fmt, ...)
 
 void Logger::VLog(const char* fmt, va_list args)
 {
-    static char buff[1024] = {};
-
+#    if defined(NILAI_LOGGER_ASYNC)
+    // Messages can be logged from interrupts, each context formats in its own buffer so that the
+    // interrupts stay enabled. Only the copy into the ring masks them. The sinks get the message
+    // from Run, it is dropped if the ring is full.
+    char   buff[s_maxMessageSize];
     size_t s = vsnprintf(buff, std::size(buff), fmt, args);
-
     NILAI_ASSERT(s < std::size(buff), "vsnprintf error!");
-#    if defined(NILAI_USE_UART)
+    m_ring.Write({buff, s});
+#    else
+    // Only called from the main loop, the message is sent before returning.
+    static char buff[s_maxMessageSize] = {};
+    size_t      s = vsnprintf(buff, std::size(buff), fmt, args);
+    NILAI_ASSERT(s < std::size(buff), "vsnprintf error!");
+#        if defined(NILAI_USE_UART)
     m_uart.Transmit(buff, s);
-#    endif
+#        endif
     m_logFunc(buff, s);
+#    endif
 }
 
+#    if defined(NILAI_LOGGER_DEFERRED)
+size_t Logger::FlushDeferred()
+{
+    // Frames are batched, to send as few transmissions as possible.
+    static uint8_t buff[4 * DeferredLog::s_maxFrameSize] = {};
+
+    size_t count = 0;
+    size_t size  = 0;
+    auto   send  = [this, &size]()
+    {
+        if (size != 0)
+        {
+#        if defined(NILAI_LOGGER_ASYNC)
+            m_ring.Write({reinterpret_cast<const char*>(buff), size});
+#        else
+#            if defined(NILAI_USE_UART)
+            m_uart.Transmit(buff, size);
+#            endif
+            m_logFunc(reinterpret_cast<const char*>(buff), size);
+#        endif
+            size = 0;
+        }
+    };
+
+    while (auto record = DeferredLog::Read())
+    {
+        if (std::size(buff) - size < DeferredLog::s_maxFrameSize)
+        {
+            send();
+        }
+        size += DeferredLog::ToFrame(*record, {&buff[size], std::size(buff) - size});
+        count++;
+    }
+    send();
+
+    return count;
+}
+#    endif
+
 void Logger::SetLogFunc(const LogFunc& logFunc)
 {
     if (logFunc)
     {
         m_logFunc = logFunc;
+#    if defined(NILAI_LOGGER_ASYNC)
+        m_funcSink.SetCallback(m_logFunc);
+#    endif
     }
 }
+
+#    if defined(NILAI_LOGGER_ASYNC)
+bool Logger::AddSink(LogSink& sink)
+{
+    size_t id = m_ring.AddSink();
+    if (id == Ring::s_invalidSink)
+    {
+        return false;
+    }
+    m_sinks[id] = &sink;
+    return true;
+}
+
+void Logger::RemoveSink(LogSink& sink)
+{
+    for (size_t id = 0; id < m_sinks.size(); id++)
+    {
+        if (m_sinks[id] == &sink)
+        {
+            m_ring.RemoveSink(id);
+            m_sinks[id] = nullptr;
+        }
+    }
+}
+
+void Logger::Run()
+{
+#        if defined(NILAI_LOGGER_DEFERRED)
+    FlushDeferred();
+#        endif
+
+    for (size_t id = 0; id < m_sinks.size(); id++)
+    {
+        if (m_sinks[id] != nullptr)
+        {
+            m_ring.Drain(id, [sink = m_sinks[id]](std::span<const char> data)
+                         { return sink->Consume(data); });
+        }
+    }
+}
+
+#        if defined(NILAI_USE_UART)
+size_t UartLogSink::Consume(std::span<const char> data)
+{
+    size_t len = std::min(data.size(), s_maxChunk);
+    return m_uart.Transmit(reinterpret_cast<const uint8_t*>(data.data()), len) ? len : 0;
+}
+#        endif
+#    endif
 }    // namespace Nilai::Services
 #endif
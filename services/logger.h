@@ -16,7 +16,30 @@
 #    include <cstdarg>    // For va_list
 #    include <functional>
 
-#    if !defined(NILAI_LOGGER_USE_RTC)
+#    if defined(NILAI_LOGGER_ASYNC)
+#        include "log_ring.h"
+
+#        include <array>
+
+#        if !defined(NILAI_LOGGER_RING_SIZE)
+#            define NILAI_LOGGER_RING_SIZE 2048
+#        endif
+#        if !defined(NILAI_LOGGER_MAX_SINKS)
+#            define NILAI_LOGGER_MAX_SINKS 4
+#        endif
+#    endif
+
+#    if defined(NILAI_LOGGER_DEFERRED)
+#        include "deferred_log.h"
+// Only the format string's address, the time and the arguments are recorded, the host does the
+// formatting and adds the timestamp.
+#        define LOG_HELPER(color, msg, ...)                                                        \
+            do                                                                                     \
+            {                                                                                      \
+                (void)NILAI_LOG_DEFERRED(color msg __VA_OPT__(, ) __VA_ARGS__);                    \
+            } while (0)
+#        define INT_NILAI_LOG_IMPL_OK
+#    elif !defined(NILAI_LOGGER_USE_RTC)
 #        include NILAI_HAL_HEADER
 #        define GET_CUR_MS()  (Nilai::GetTime())
 #        define GET_CUR_SEC() (GET_CUR_MS() / 1000)
@@ -99,6 +122,30 @@ namespace Nilai::Services
 {
 using LogFunc = std::function<void(const char*, size_t)>;
 
+#    if defined(NILAI_LOGGER_ASYNC) && defined(NILAI_USE_UART)
+#        if !defined(NILAI_UART_TX_USE_QUEUE)
+#            error The asynchronous logger needs the UART transmission queue
+#        endif
+/**
+ * @brief Sink that sends the log on a UART.
+ *
+ * Never blocks: when the transmission queue of the UART is full, the log waits in the ring.
+ */
+class UartLogSink : public LogSink
+{
+public:
+    //! Largest chunk handed to the UART at once, in bytes.
+    static constexpr size_t s_maxChunk = 128;
+
+    explicit UartLogSink(Drivers::UartModule& uart) : m_uart(uart) {}
+
+    size_t Consume(std::span<const char> data) override;
+
+private:
+    Drivers::UartModule& m_uart;
+};
+#    endif
+
 class Logger
 {
 public:
@@ -114,6 +161,46 @@ public:
     void VLog(const char* fmt, va_list args);
 
     void SetLogFunc(const LogFunc& logFunc);
+
+#    if defined(NILAI_LOGGER_DEFERRED)
+    /**
+     * @brief Sends the recorded messages as binary frames, to the UART and to the log function.
+     *
+     * Must be called periodically from the main loop.
+     *
+     * @return The number of messages sent.
+     */
+    size_t FlushDeferred();
+#    endif
+#    if defined(NILAI_LOGGER_ASYNC)
+    /**
+     * @brief Adds a destination for the log. The UART and the log function are added by default.
+     *
+     * The sink must outlive the logger, or be removed before being destroyed.
+     *
+     * @return True if the sink was added, false if there are already NILAI_LOGGER_MAX_SINKS sinks.
+     */
+    bool AddSink(LogSink& sink);
+    void RemoveSink(LogSink& sink);
+
+    /**
+     * @brief Hands the pending messages to the sinks, as much as each of them can take.
+     *
+     * Called by the application on every pass of the main loop.
+     */
+    void Run();
+
+    /**
+     * @brief Gets the number of messages that were dropped because the slowest sink lagged too far
+     * behind.
+     */
+    [[nodiscard]] size_t GetDroppedMessages() const { return m_ring.DroppedMessages(); }
+    /**
+     * @brief Gets the highest number of bytes that were waiting in the ring at once.
+     */
+    [[nodiscard]] size_t GetRingHighWaterMark() const { return m_ring.HighWaterMark(); }
+    void                 ResetStats() { m_ring.ResetStats(); }
+#    endif
 #    if defined(NILAI_USE_UART)
     Drivers::UartModule& GetUart() { return m_uart; }
 #    endif
@@ -127,6 +214,16 @@ private:
     Drivers::UartModule& m_uart;
 #    endif
     LogFunc m_logFunc = [](const char*, size_t) {};
+
+#    if defined(NILAI_LOGGER_ASYNC)
+    using Ring = LogRing<NILAI_LOGGER_RING_SIZE, NILAI_LOGGER_MAX_SINKS>;
+    Ring                                         m_ring;
+    std::array<LogSink*, NILAI_LOGGER_MAX_SINKS> m_sinks = {};
+#        if defined(NILAI_USE_UART)
+    UartLogSink m_uartSink;
+#        endif
+    CallbackLogSink m_funcSink;
+#    endif
 };
 }    // namespace Nilai::Services
 #else
@@ -30,6 +30,7 @@
 
 #if defined(NILAI_ENABLE_PROFILING)
 
+#    include "../../defines/system.h"
 #    include "../time.h"
 
 #    include <cstdarg>
@@ -37,11 +38,22 @@
 #    include <cstring>
 #    include <string>
 
+#    if defined(NILAI_TEST)
+#        include <chrono>
+#    endif
+
 namespace Nilai
 {
 
 Profiler* Profiler::s_instance = nullptr;
 
+Profiling::CycleHistogram Profiler::s_loop          = {};
+uint32_t                  Profiler::s_lastLoopStart = 0;
+bool                      Profiler::s_loopStarted   = false;
+
+std::array<Profiler::StatsSlot, NILAI_PROFILE_MAX_MODULES> Profiler::s_modules = {};
+std::array<Profiler::StatsSlot, NILAI_PROFILE_MAX_ISRS>    Profiler::s_isrs    = {};
+
 Profiler::Profiler(const std::function<void(const char*, size_t)>& printStr, size_t reportFreq)
 : m_reportFreq(reportFreq)
 {
@@ -87,10 +99,7 @@ void Profiler::StartImpl(const std::string_view& name)
     m_profName = name;
     m_events.clear();
 
-#    if !defined(NILAI_TEST)
-    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
-    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;    // Enable counter.
-#    endif
+    StartCycleCounter();
 }
 
 size_t Profiler::CreateImpl(const std::string_view& name)
@@ -155,6 +164,129 @@ void Profiler::Print(const char* fmt, ...)
     va_end(args);
 }
 
+void Profiler::StartCycleCounter() noexcept
+{
+#    if !defined(NILAI_TEST)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;    // Enable counter.
+#    endif
+}
+
+uint32_t Profiler::GetCycles() noexcept
+{
+#    if defined(NILAI_TEST)
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+#    else
+    return DWT->CYCCNT;
+#    endif
+}
+
+uint32_t Profiler::GetCycleFrequency() noexcept
+{
+#    if defined(NILAI_TEST)
+    return 1'000'000'000;
+#    else
+    return SystemCoreClock;
+#    endif
+}
+
+template<size_t N>
+Profiler::StatsSlot* Profiler::FindSlot(std::array<StatsSlot, N>& slots, uint16_t id) noexcept
+{
+    StatsSlot* free = nullptr;
+    for (auto& slot : slots)
+    {
+        if (slot.Used && slot.Id == id)
+        {
+            return &slot;
+        }
+        if (!slot.Used && free == nullptr)
+        {
+            free = &slot;
+        }
+    }
+
+    if (free != nullptr)
+    {
+        free->Id   = id;
+        free->Used = true;
+    }
+    return free;
+}
+
+void Profiler::RecordLoop() noexcept
+{
+    uint32_t now = GetCycles();
+    if (s_loopStarted)
+    {
+        s_loop.Add(now - s_lastLoopStart);
+    }
+    s_lastLoopStart = now;
+    s_loopStarted   = true;
+}
+
+void Profiler::RecordModule(size_t id, uint32_t cycles) noexcept
+{
+    // When all the slots are taken, the module is not profiled.
+    StatsSlot* slot = FindSlot(s_modules, static_cast<uint16_t>(id));
+    if (slot != nullptr)
+    {
+        slot->Hist.Add(cycles);
+    }
+}
+
+void Profiler::RecordIsr(uint16_t exception, uint32_t cycles) noexcept
+{
+    // Each interrupt only updates its own slot, but two interrupts could claim the same one.
+    StatsSlot* slot;
+    {
+        System::CriticalSection lock;
+        slot = FindSlot(s_isrs, exception);
+    }
+    if (slot != nullptr)
+    {
+        slot->Hist.Add(cycles);
+    }
+}
+
+size_t Profiler::Snapshot(std::span<uint8_t> out) noexcept
+{
+    Profiling::SnapshotWriter writer(out, GetCycleFrequency(), GetTime());
+    writer.Add(Profiling::RecordKind::Loop, 0, s_loop);
+    for (const auto& slot : s_modules)
+    {
+        if (slot.Used)
+        {
+            writer.Add(Profiling::RecordKind::Module, slot.Id, slot.Hist);
+        }
+    }
+    for (const auto& slot : s_isrs)
+    {
+        if (slot.Used)
+        {
+            // Copied with the interrupts masked, so that the histogram isn't torn.
+            Profiling::CycleHistogram hist;
+            {
+                System::CriticalSection lock;
+                hist = slot.Hist;
+            }
+            writer.Add(Profiling::RecordKind::Isr, slot.Id, hist);
+        }
+    }
+    return writer.Size();
+}
+
+void Profiler::ResetStats() noexcept
+{
+    System::CriticalSection lock;
+    s_loop.Reset();
+    s_loopStarted = false;
+    s_modules.fill({});
+    s_isrs.fill({});
+}
+
 #    if defined(NILAI_TEST)
 ProfilingTimer::ProfilingTimer(size_t id) : m_id(id), m_startTime(GetTime())
 {
@@ -174,5 +306,17 @@ ProfilingTimer::~ProfilingTimer()
     Profiler::UpdateEvent(m_id, end - m_startTime);
 }
 #    endif
+
+IsrProfilingTimer::IsrProfilingTimer() noexcept : m_startTime(Profiler::GetCycles())
+{
+#    if !defined(NILAI_TEST)
+    m_exception = static_cast<uint16_t>(__get_IPSR());
+#    endif
+}
+
+IsrProfilingTimer::~IsrProfilingTimer()
+{
+    Profiler::RecordIsr(m_exception, Profiler::GetCycles() - m_startTime);
+}
 }    // namespace Nilai
 #endif
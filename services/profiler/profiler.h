@@ -22,11 +22,26 @@
 #    include "../../defines/internal_config.h"
 #    include NILAI_HAL_HEADER
 
+#    include "profiling_snapshot.h"
+
+#    include <array>
 #    include <functional>
 #    include <limits>
+#    include <span>
 #    include <string_view>
 #    include <vector>
 
+#    if !defined(NILAI_PROFILE_MAX_MODULES)
+#        if defined(NILAI_MAX_MODULE_AMOUNT)
+#            define NILAI_PROFILE_MAX_MODULES NILAI_MAX_MODULE_AMOUNT
+#        else
+#            define NILAI_PROFILE_MAX_MODULES 16
+#        endif
+#    endif
+#    if !defined(NILAI_PROFILE_MAX_ISRS)
+#        define NILAI_PROFILE_MAX_ISRS 8
+#    endif
+
 #    define NILAI_PROFILING_INIT(func, freq)    ::Nilai::Profiler::Init(func, freq)
 #    define NILAI_PROFILING_DEINIT()            ::Nilai::Profiler::Deinit();
 #    define NILAI_PROFILING_START_SESSION(name) ::Nilai::Profiler::Start(name)
@@ -36,11 +51,20 @@
  * without degrading ease of use.
  */
 #    define NILAI_PROFILE_SCOPE(name)                                                              \
-        static size_t nilaiProfilingTimerId##__LINE__ = ::Nilai::Profiler::CreateEvent(name);      \
-        ::Nilai::ProfilingTimer nilaiProfilingTimer##__LINE__(nilaiProfilingTimerId##__LINE__)
+        static size_t NILAI_CONCAT(nilaiProfilingTimerId, __LINE__) =                              \
+          ::Nilai::Profiler::CreateEvent(name);                                                    \
+        ::Nilai::ProfilingTimer NILAI_CONCAT(nilaiProfilingTimer, __LINE__)(                       \
+          NILAI_CONCAT(nilaiProfilingTimerId, __LINE__))
 
 #    define NILAI_PROFILE_FUNCTION() NILAI_PROFILE_SCOPE(FUNCSIG)
 
+/**
+ * Times the interrupt it is placed in, until the end of the scope. The interrupt is identified by
+ * the exception number read from the IPSR register.
+ */
+#    define NILAI_PROFILE_ISR()                                                                    \
+        ::Nilai::IsrProfilingTimer NILAI_CONCAT(nilaiIsrProfilingTimer, __LINE__)
+
 namespace Nilai
 {
 /**
@@ -75,19 +99,100 @@ public:
      *
      * @param name Profiler name
      */
-    inline static void Start(const std::string_view& name) { s_instance->m_startFunc(name); }
+    inline static void Start(const std::string_view& name)
+    {
+        if (s_instance != nullptr)
+        {
+            s_instance->m_startFunc(name);
+        }
+    }
 
     inline static size_t CreateEvent(const std::string_view& name)
     {
-        return s_instance->m_createFunc(name);
+        return s_instance != nullptr ? s_instance->m_createFunc(name) : INVALID_EVENT_ID;
     }
 
     inline static void UpdateEvent(size_t id, uint32_t wallTime)
     {
-        s_instance->m_updateFunc(id, wallTime);
+        if (s_instance != nullptr)
+        {
+            s_instance->m_updateFunc(id, wallTime);
+        }
     }
 
-    inline static void Report() { s_instance->m_reportFunc(); }
+    inline static void Report()
+    {
+        if (s_instance != nullptr)
+        {
+            s_instance->m_reportFunc();
+        }
+    }
+
+    /**
+     * @brief Size of a buffer large enough to hold any snapshot.
+     */
+    static constexpr size_t s_maxSnapshotSize =
+      Profiling::SnapshotSize(1 + NILAI_PROFILE_MAX_MODULES + NILAI_PROFILE_MAX_ISRS);
+
+    /**
+     * @brief Enables the DWT cycle counter, used to time the modules and the interrupts.
+     */
+    static void StartCycleCounter() noexcept;
+
+    /**
+     * @brief Reads the cycle counter.
+     *
+     * On the host, this is a nanosecond clock.
+     */
+    static uint32_t GetCycles() noexcept;
+
+    /**
+     * @brief Gets the number of cycles per second of the cycle counter.
+     */
+    static uint32_t GetCycleFrequency() noexcept;
+
+    /**
+     * @brief Marks the start of a pass of the main loop, the time since the previous pass is
+     * recorded.
+     *
+     * Called by the application, the spread of the histogram is the jitter of the main loop.
+     */
+    static void RecordLoop() noexcept;
+
+    /**
+     * @brief Records the time spent in a module's Run.
+     *
+     * Called by the application around each Module::Run. This includes the time spent in the
+     * interrupts that preempted the module.
+     *
+     * @param id The id of the module.
+     * @param cycles The time spent, in cycles.
+     */
+    static void RecordModule(size_t id, uint32_t cycles) noexcept;
+
+    /**
+     * @brief Records the time spent in an interrupt. Usually called through NILAI_PROFILE_ISR.
+     *
+     * @param exception The exception number of the interrupt.
+     * @param cycles The time spent, in cycles.
+     */
+    static void RecordIsr(uint16_t exception, uint32_t cycles) noexcept;
+
+    /**
+     * @brief Serializes the recorded histograms, see profiling_snapshot.h for the format.
+     *
+     * Nothing is formatted on the device, the snapshot is meant to be sent as-is to a host tool
+     * that decodes it with Profiling::ReadSnapshot.
+     *
+     * @param out The buffer in which to write the snapshot. Records that don't fit are left out.
+     * @return The size of the snapshot, in bytes.
+     */
+    static size_t Snapshot(std::span<uint8_t> out) noexcept;
+
+    /**
+     * @brief Clears the recorded histograms.
+     */
+    static void ResetStats() noexcept;
 
 private:
     struct ProfilingEvent
@@ -101,6 +206,16 @@ private:
         ProfilingEvent(const std::string_view& name) : Name(name) {}
     };
 
+    struct StatsSlot
+    {
+        uint16_t                  Id   = 0;
+        bool                      Used = false;
+        Profiling::CycleHistogram Hist = {};
+    };
+
+    template<size_t N>
+    static StatsSlot* FindSlot(std::array<StatsSlot, N>& slots, uint16_t id) noexcept;
+
 private:
     Profiler(const std::function<void(const char*, size_t)>& printStr, size_t reportFreq);
 
@@ -127,6 +242,13 @@ private:
     std::string_view m_profName;
 
     std::vector<ProfilingEvent> m_events = {};
+
+    // The statistics don't need Init, they are always recorded.
+    static Profiling::CycleHistogram                       s_loop;
+    static uint32_t                                        s_lastLoopStart;
+    static bool                                            s_loopStarted;
+    static std::array<StatsSlot, NILAI_PROFILE_MAX_MODULES> s_modules;
+    static std::array<StatsSlot, NILAI_PROFILE_MAX_ISRS>    s_isrs;
 };
 
 class ProfilingTimer
@@ -140,6 +262,17 @@ private:
     uint32_t m_startTime = 0;
 };
 
+class IsrProfilingTimer
+{
+public:
+    IsrProfilingTimer() noexcept;
+    ~IsrProfilingTimer();
+
+private:
+    uint16_t m_exception = 0;
+    uint32_t m_startTime = 0;
+};
+
 }    // namespace Nilai
 
 #else
@@ -148,6 +281,7 @@ private:
 #    define NILAI_PROFILING_START_SESSION(name)
 #    define NILAI_PROFILE_SCOPE(name)
 #    define NILAI_PROFILE_FUNCTION()
+#    define NILAI_PROFILE_ISR()
 #endif
 
 #endif    // NILAI_PROFILER_H
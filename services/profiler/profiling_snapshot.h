@@ -0,0 +1,286 @@
+/**
+ * @file    profiling_snapshot.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Cycle histograms and the binary format used to export them.
+ *
+ * This file doesn't depend on the HAL, so that a host tool can include it to decode the snapshots
+ * made by the device.
+ *
+ * A snapshot is a header followed by a list of records, all fields are little-endian:
+ * <pre>
+ * Header (16 bytes):
+ *  u32 Magic           "NPRF"
+ *  u16 Version
+ *  u16 RecordCount
+ *  u32 CycleFrequency  Number of cycles per second.
+ *  u32 Timestamp       Time at which the snapshot was taken, in milliseconds.
+ * Record (26 bytes + 4 bytes per bucket):
+ *  u8  Kind            See RecordKind.
+ *  u8  Reserved
+ *  u16 Id              Id of the module, or exception number of the interrupt.
+ *  u32 Count
+ *  u32 Min
+ *  u32 Max
+ *  u64 Total
+ *  u8  FirstBucket     Index of the first bucket that follows.
+ *  u8  BucketCount     Number of buckets that follow, empty buckets on either end are left out.
+ *  u32 Buckets[BucketCount]
+ * </pre>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_PROFILING_SNAPSHOT_H
+#define NILAI_PROFILING_SNAPSHOT_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+/**
+ * @addtogroup Nilai
+ * @{
+ */
+
+namespace Nilai::Profiling
+{
+/**
+ * @brief Distribution of durations, in cycles.
+ *
+ * Bucket N counts the durations in [2^N, 2^(N+1)[, durations of 0 are counted in the first bucket.
+ * Adding a duration is a handful of instructions, so this can be updated from an interrupt.
+ */
+struct CycleHistogram
+{
+    static constexpr size_t s_bucketCount = 32;
+
+    uint32_t                            Count   = 0;
+    uint32_t                            Min     = std::numeric_limits<uint32_t>::max();
+    uint32_t                            Max     = 0;
+    uint64_t                            Total   = 0;
+    std::array<uint32_t, s_bucketCount> Buckets = {};
+
+    static constexpr size_t BucketOf(uint32_t cycles) noexcept
+    {
+        return cycles == 0 ? 0 : static_cast<size_t>(std::bit_width(cycles)) - 1;
+    }
+
+    constexpr void Add(uint32_t cycles) noexcept
+    {
+        Count++;
+        Min = std::min(Min, cycles);
+        Max = std::max(Max, cycles);
+        Total += cycles;
+        Buckets[BucketOf(cycles)]++;
+    }
+
+    constexpr void Reset() noexcept { *this = {}; }
+
+    constexpr bool operator==(const CycleHistogram&) const noexcept = default;
+};
+
+/**
+ * @brief What a record of a snapshot measures.
+ */
+enum class RecordKind : uint8_t
+{
+    //! Time between two passes of the main loop. The id is unused.
+    Loop = 0,
+    //! Time spent in Module::Run. The id is the id of the module.
+    Module,
+    //! Time spent in an interrupt. The id is the exception number.
+    Isr,
+};
+
+struct SnapshotHeader
+{
+    uint16_t Version        = 0;
+    uint16_t RecordCount    = 0;
+    uint32_t CycleFrequency = 0;
+    uint32_t Timestamp      = 0;
+};
+
+static constexpr uint32_t s_snapshotMagic      = 0x4652504E;    // "NPRF"
+static constexpr uint16_t s_snapshotVersion    = 1;
+static constexpr size_t   s_snapshotHeaderSize = 16;
+static constexpr size_t   s_recordHeaderSize   = 26;
+
+/**
+ * @brief Gets the size of the largest snapshot holding @p records records.
+ */
+constexpr size_t SnapshotSize(size_t records) noexcept
+{
+    return s_snapshotHeaderSize +
+           (records * (s_recordHeaderSize + (CycleHistogram::s_bucketCount * sizeof(uint32_t))));
+}
+
+namespace Internal
+{
+template<typename T>
+constexpr void PutLe(uint8_t* dst, T v) noexcept
+{
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        dst[i] = static_cast<uint8_t>(v >> (i * 8));
+    }
+}
+
+template<typename T>
+constexpr T GetLe(const uint8_t* src) noexcept
+{
+    T v = 0;
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        v |= static_cast<T>(static_cast<T>(src[i]) << (i * 8));
+    }
+    return v;
+}
+}    // namespace Internal
+
+/**
+ * @brief Serializes histograms into a caller-provided buffer.
+ *
+ * Records that don't fit in the buffer are left out, the snapshot stays valid.
+ */
+class SnapshotWriter
+{
+public:
+    SnapshotWriter(std::span<uint8_t> out, uint32_t cycleFrequency, uint32_t timestamp) noexcept
+    : m_out(out)
+    {
+        if (m_out.size() >= s_snapshotHeaderSize)
+        {
+            Internal::PutLe(&m_out[0], s_snapshotMagic);
+            Internal::PutLe(&m_out[4], s_snapshotVersion);
+            Internal::PutLe(&m_out[6], uint16_t {0});
+            Internal::PutLe(&m_out[8], cycleFrequency);
+            Internal::PutLe(&m_out[12], timestamp);
+            m_size = s_snapshotHeaderSize;
+        }
+    }
+
+    /**
+     * @brief Appends a record to the snapshot.
+     * @return True if the record was added, false if it didn't fit.
+     */
+    bool Add(RecordKind kind, uint16_t id, const CycleHistogram& hist) noexcept
+    {
+        const auto& b     = hist.Buckets;
+        auto        first = std::find_if(b.begin(), b.end(), [](uint32_t c) { return c != 0; });
+        auto last = std::find_if(b.rbegin(), b.rend(), [](uint32_t c) { return c != 0; }).base();
+        size_t firstIdx = first == b.end() ? 0 : static_cast<size_t>(first - b.begin());
+        size_t count    = first == b.end() ? 0 : static_cast<size_t>(last - first);
+
+        size_t size = s_recordHeaderSize + (count * sizeof(uint32_t));
+        if (m_size == 0 || m_out.size() - m_size < size)
+        {
+            return false;
+        }
+
+        uint8_t* dst = &m_out[m_size];
+        dst[0]       = static_cast<uint8_t>(kind);
+        dst[1]       = 0;
+        Internal::PutLe(&dst[2], id);
+        Internal::PutLe(&dst[4], hist.Count);
+        Internal::PutLe(&dst[8], hist.Min);
+        Internal::PutLe(&dst[12], hist.Max);
+        Internal::PutLe(&dst[16], hist.Total);
+        dst[24] = static_cast<uint8_t>(firstIdx);
+        dst[25] = static_cast<uint8_t>(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            Internal::PutLe(&dst[s_recordHeaderSize + (i * sizeof(uint32_t))], b[firstIdx + i]);
+        }
+
+        m_size += size;
+        m_records++;
+        Internal::PutLe(&m_out[6], m_records);
+        return true;
+    }
+
+    /**
+     * @brief Gets the size of the snapshot, in bytes. 0 if the buffer can't even hold the header.
+     */
+    [[nodiscard]] size_t Size() const noexcept { return m_size; }
+
+private:
+    std::span<uint8_t> m_out;
+    size_t             m_size    = 0;
+    uint16_t           m_records = 0;
+};
+
+/**
+ * @brief Decodes a snapshot.
+ *
+ * @param in The snapshot.
+ * @param header Receives the header of the snapshot.
+ * @param onRecord Called with the kind, the id and the histogram of each record.
+ * @return True if the whole snapshot was decoded, false if it is malformed or truncated.
+ */
+template<typename F>
+bool ReadSnapshot(std::span<const uint8_t> in, SnapshotHeader& header, F&& onRecord)
+{
+    if (in.size() < s_snapshotHeaderSize ||
+        Internal::GetLe<uint32_t>(&in[0]) != s_snapshotMagic)
+    {
+        return false;
+    }
+
+    header.Version        = Internal::GetLe<uint16_t>(&in[4]);
+    header.RecordCount    = Internal::GetLe<uint16_t>(&in[6]);
+    header.CycleFrequency = Internal::GetLe<uint32_t>(&in[8]);
+    header.Timestamp      = Internal::GetLe<uint32_t>(&in[12]);
+    if (header.Version != s_snapshotVersion)
+    {
+        return false;
+    }
+
+    size_t pos = s_snapshotHeaderSize;
+    for (size_t r = 0; r < header.RecordCount; r++)
+    {
+        if (in.size() - pos < s_recordHeaderSize)
+        {
+            return false;
+        }
+
+        const uint8_t* src   = &in[pos];
+        size_t         first = src[24];
+        size_t         count = src[25];
+        if (first + count > CycleHistogram::s_bucketCount ||
+            in.size() - pos - s_recordHeaderSize < count * sizeof(uint32_t))
+        {
+            return false;
+        }
+
+        CycleHistogram hist;
+        hist.Count = Internal::GetLe<uint32_t>(&src[4]);
+        hist.Min   = Internal::GetLe<uint32_t>(&src[8]);
+        hist.Max   = Internal::GetLe<uint32_t>(&src[12]);
+        hist.Total = Internal::GetLe<uint64_t>(&src[16]);
+        for (size_t i = 0; i < count; i++)
+        {
+            hist.Buckets[first + i] =
+              Internal::GetLe<uint32_t>(&src[s_recordHeaderSize + (i * sizeof(uint32_t))]);
+        }
+
+        onRecord(static_cast<RecordKind>(src[0]), Internal::GetLe<uint16_t>(&src[2]), hist);
+        pos += s_recordHeaderSize + (count * sizeof(uint32_t));
+    }
+
+    return true;
+}
+}    // namespace Nilai::Profiling
+//!@}
+#endif    // NILAI_PROFILING_SNAPSHOT_H
@@ -11,6 +11,7 @@
 #include "umo_module.h"
 #if defined(NILAI_USE_UMO) && (defined(NILAI_USE_UART) || defined(NILAI_USE_CAN))
 #    include "defines/macros.hpp"
+#    include "services/crc/software_crc.h"
 
 #    if defined(NILAI_UMO_USE_CAN)
 #        error Not implemented
@@ -75,15 +76,17 @@ void UmoModule::Run()
         // If the Universe is old enough to die:
         if (m_universes[i].age++ > OLDEST_AGE)
         {
-            // #TODO Compute CRC
-            uint16_t crc = 0;
+            uint8_t                     id = static_cast<uint8_t>(i);
+            Nilai::Services::Crc16Ccitt crc;
+            crc.Update({&id, 1}).Update(m_universes[i].universe);
             // It's time to answer to the PC.
             m_universes[i].age = -1;
             LOG_INFO("[UMO] Sending Universe %i", i);
 #    if defined(NILAI_UMO_USE_UART)
             m_handle->Transmit(std::vector<uint8_t> {(uint8_t)i});
             m_handle->Transmit(m_universes[i].universe);
-            m_handle->Transmit(std::vector<uint8_t> {(uint8_t)(crc >> 8), (uint8_t)(crc & 0x00FF)});
+            m_handle->Transmit(std::vector<uint8_t> {(uint8_t)(crc.Value() >> 8),
+                                                     (uint8_t)(crc.Value() & 0x00FF)});
 #    elif defined(NILAI_UMO_USE_CAN)
 
 #    endif
@@ -96,10 +99,11 @@ void UmoModule::Run()
     {
         CEP_UART::Frame frame = m_handle->Receive();
         // Make sure the Universe is valid. (Valid ID + CRC)
-        if (frame.data[0] < m_universes.size( ) /*&&
-            frame.data.size( ) == (1 + Universe::CHANNEL_COUNT + 2)*/)
+        constexpr size_t crcPos = 1 + Universe::CHANNEL_COUNT;
+        if (frame.data.size() == crcPos + 2 && frame.data[0] < m_universes.size() &&
+            Nilai::Services::Crc16Ccitt::Compute({frame.data.data(), crcPos}) ==
+              ((frame.data[crcPos] << 8) | frame.data[crcPos + 1]))
         {
-            // #TODO Check CRC.
             // Copy Universe into module if it is valid.
             for (size_t i = 0; i < Universe::CHANNEL_COUNT; i++)
             {
@@ -0,0 +1,121 @@
+/**
+ * @file    stats_benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "interfaces/ADS131/ads131_block_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Nilai::Interfaces::Ads131;
+
+namespace
+{
+constexpr size_t s_frames     = 128;
+constexpr size_t s_iterations = 20'000;
+
+volatile float g_sink = 0.0f;
+
+float CalculateTension(const uint8_t* data)
+{
+    int32_t up  = ((int32_t)data[0] << 24);
+    int32_t mid = ((int32_t)data[1] << 16);
+    int32_t bot = ((int32_t)data[2] << 8);
+    return ((float)(((int32_t)(up | mid | bot)) >> 8) * s_lsb) + s_offset;
+}
+
+//! What AdsModule does without the block kernels: convert every sample, then go over each channel.
+void ScalarPath(const std::vector<uint8_t>& frames)
+{
+    static std::array<std::array<float, s_frames>, s_channelCount> channels;
+    for (size_t f = 0; f < s_frames; f++)
+    {
+        for (size_t ch = 0; ch < s_channelCount; ch++)
+        {
+            channels[ch][f] = CalculateTension(
+              &frames[(f * s_frameSize) + s_firstChannelOffset + (ch * s_sampleSize)]);
+        }
+    }
+
+    for (const auto& channel : channels)
+    {
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        float tot = 0.0f;
+        for (float v : channel)
+        {
+            min = std::min(min, v);
+            max = std::max(max, v);
+            tot += v;
+        }
+        g_sink = g_sink + min + max + (tot / s_frames);
+    }
+}
+
+template<typename Fn>
+void Run(const char* name, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < s_iterations; i++)
+    {
+        fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf(
+      "%-36s %8.2f ns/frame\n", name, ns / static_cast<double>(s_iterations * s_frames));
+}
+}    // namespace
+
+int main()
+{
+    std::mt19937                       rng(42);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<uint8_t>               frames(s_frames * s_frameSize);
+    std::generate(frames.begin(), frames.end(), [&] { return static_cast<uint8_t>(byte(rng)); });
+
+    Run("Scalar float", [&] { ScalarPath(frames); });
+    Run("AccumulateFrames",
+        [&]
+        {
+            BlockStats stats;
+            AccumulateFrames(frames, stats);
+            g_sink = g_sink + stats[0].MeanVolts() + stats[3].RmsVolts();
+        });
+    Run("AccumulateFramesPortable",
+        [&]
+        {
+            BlockStats stats;
+            AccumulateFramesPortable(frames, stats);
+            g_sink = g_sink + stats[0].MeanVolts() + stats[3].RmsVolts();
+        });
+    Run("ConvertChannel (x4)",
+        [&]
+        {
+            static std::array<float, s_frames> out;
+            for (size_t ch = 0; ch < s_channelCount; ch++)
+            {
+                ConvertChannel(frames, ch, out);
+                g_sink = g_sink + out[0];
+            }
+        });
+
+    return 0;
+}
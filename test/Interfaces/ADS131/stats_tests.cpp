@@ -0,0 +1,245 @@
+/**
+ * @file    stats_tests.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "interfaces/ADS131/ads131_block_stats.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Nilai::Interfaces::Ads131;
+
+namespace
+{
+// The conversion done by AdsModule before the block kernels, kept as the reference.
+float ScalarConvertToVolt(int32_t val)
+{
+    constexpr float LSB = (2.0f * (2.442f / 1.0f)) / 16777216.0f;
+    return (((float)val * LSB) + 0.02656f);
+}
+
+float ScalarCalculateTension(const uint8_t* data)
+{
+    int32_t up  = ((int32_t)data[0] << 24);
+    int32_t mid = ((int32_t)data[1] << 16);
+    int32_t bot = ((int32_t)data[2] << 8);
+    return ScalarConvertToVolt(((int32_t)(up | mid | bot)) >> 8);
+}
+
+void PutSample(uint8_t* frame, size_t channel, int32_t value)
+{
+    uint8_t* p = &frame[s_firstChannelOffset + (channel * s_sampleSize)];
+    p[0]       = static_cast<uint8_t>(value >> 16);
+    p[1]       = static_cast<uint8_t>(value >> 8);
+    p[2]       = static_cast<uint8_t>(value);
+}
+
+// Random frames, with the extremes of the 24-bit range in the first ones.
+std::vector<uint8_t> MakeFrames(size_t count, uint32_t seed)
+{
+    static constexpr int32_t s_extremes[] = {-0x800000, 0x7FFFFF, 0, -1};
+
+    std::mt19937                           rng(seed);
+    std::uniform_int_distribution<int32_t> dist(-0x800000, 0x7FFFFF);
+    std::uniform_int_distribution<int>     byte(0, 255);
+
+    std::vector<uint8_t> frames(count * s_frameSize);
+    for (size_t f = 0; f < count; f++)
+    {
+        uint8_t* frame = &frames[f * s_frameSize];
+        // Status word and padding, which must not leak into the samples.
+        frame[0]  = static_cast<uint8_t>(byte(rng));
+        frame[1]  = static_cast<uint8_t>(byte(rng));
+        frame[2]  = static_cast<uint8_t>(byte(rng));
+        frame[15] = static_cast<uint8_t>(byte(rng));
+        for (size_t ch = 0; ch < s_channelCount; ch++)
+        {
+            int32_t v = f < std::size(s_extremes) ? s_extremes[(f + ch) % std::size(s_extremes)]
+                                                  : dist(rng);
+            PutSample(frame, ch, v);
+        }
+    }
+    return frames;
+}
+
+// What AdsModule::UpdateLatestFrame computes from the converted samples.
+struct ScalarStats
+{
+    float Min = std::numeric_limits<float>::max();
+    float Max = std::numeric_limits<float>::lowest();
+    float Avg = 0.0f;
+};
+
+std::array<ScalarStats, s_channelCount> ScalarPath(const std::vector<uint8_t>& frames)
+{
+    std::array<std::vector<float>, s_channelCount> channels;
+    for (size_t f = 0; f < frames.size() / s_frameSize; f++)
+    {
+        for (size_t ch = 0; ch < s_channelCount; ch++)
+        {
+            channels[ch].push_back(ScalarCalculateTension(
+              &frames[(f * s_frameSize) + s_firstChannelOffset + (ch * s_sampleSize)]));
+        }
+    }
+
+    std::array<ScalarStats, s_channelCount> stats;
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        float tot = 0.0f;
+        for (float v : channels[ch])
+        {
+            stats[ch].Min = std::min(stats[ch].Min, v);
+            stats[ch].Max = std::max(stats[ch].Max, v);
+            tot += v;
+        }
+        stats[ch].Avg = tot / static_cast<float>(channels[ch].size());
+    }
+    return stats;
+}
+}    // namespace
+
+TEST(NilaiAds131Stats, SignExtension)
+{
+    std::vector<uint8_t> frames(s_frameSize, 0xA5);
+    PutSample(frames.data(), 0, -0x800000);
+    PutSample(frames.data(), 1, 0x7FFFFF);
+    PutSample(frames.data(), 2, 0);
+    PutSample(frames.data(), 3, -1);
+
+    EXPECT_EQ(GetSample(frames.data(), 0), -0x800000);
+    EXPECT_EQ(GetSample(frames.data(), 1), 0x7FFFFF);
+    EXPECT_EQ(GetSample(frames.data(), 2), 0);
+    EXPECT_EQ(GetSample(frames.data(), 3), -1);
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        const uint8_t* p = &frames[s_firstChannelOffset + (ch * s_sampleSize)];
+        EXPECT_EQ(Internal::LoadSampleWord(p), Internal::LoadSampleBytes(p));
+    }
+}
+
+TEST(NilaiAds131Stats, MatchesIntegerReference)
+{
+    static constexpr size_t s_count  = 1000;
+    std::vector<uint8_t>    frames   = MakeFrames(s_count, 1);
+    BlockStats              stats    = {};
+    BlockStats              portable = {};
+    AccumulateFrames(frames, stats);
+    AccumulateFramesPortable(frames, portable);
+    EXPECT_EQ(stats, portable);
+
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        int32_t min   = std::numeric_limits<int32_t>::max();
+        int32_t max   = std::numeric_limits<int32_t>::min();
+        int64_t sum   = 0;
+        int64_t sumSq = 0;
+        for (size_t f = 0; f < s_count; f++)
+        {
+            int32_t v = GetSample(&frames[f * s_frameSize], ch);
+            min       = std::min(min, v);
+            max       = std::max(max, v);
+            sum += v;
+            sumSq += static_cast<int64_t>(v) * v;
+        }
+        EXPECT_EQ(stats[ch].Min, min);
+        EXPECT_EQ(stats[ch].Max, max);
+        EXPECT_EQ(stats[ch].Sum, sum);
+        EXPECT_EQ(stats[ch].SumSq, sumSq);
+        EXPECT_EQ(stats[ch].Count, s_count);
+    }
+}
+
+TEST(NilaiAds131Stats, MatchesScalarPath)
+{
+    std::vector<uint8_t> frames = MakeFrames(512, 2);
+    auto                 ref    = ScalarPath(frames);
+    BlockStats           stats  = {};
+    AccumulateFrames(frames, stats);
+
+    std::vector<double> values;
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        // The conversion is monotonic, so the extremes are the same floats.
+        EXPECT_EQ(stats[ch].MinVolts(), ref[ch].Min);
+        EXPECT_EQ(stats[ch].MaxVolts(), ref[ch].Max);
+        // The scalar path loses precision in its float sum, the integer sum doesn't.
+        EXPECT_NEAR(stats[ch].MeanVolts(), ref[ch].Avg, 1e-4);
+
+        double ms = 0.0;
+        for (size_t f = 0; f < 512; f++)
+        {
+            double v = ScalarCalculateTension(
+              &frames[(f * s_frameSize) + s_firstChannelOffset + (ch * s_sampleSize)]);
+            ms += v * v;
+        }
+        EXPECT_NEAR(stats[ch].RmsVolts(), std::sqrt(ms / 512.0), 1e-5);
+    }
+}
+
+TEST(NilaiAds131Stats, ConvertChannelMatchesScalarPath)
+{
+    std::vector<uint8_t> frames = MakeFrames(64, 3);
+    std::vector<float>   out(64);
+    for (size_t ch = 0; ch < s_channelCount; ch++)
+    {
+        ASSERT_EQ(ConvertChannel(frames, ch, out), 64);
+        for (size_t f = 0; f < 64; f++)
+        {
+            ASSERT_EQ(out[f],
+                      ScalarCalculateTension(
+                        &frames[(f * s_frameSize) + s_firstChannelOffset + (ch * s_sampleSize)]));
+        }
+    }
+
+    // Only what fits in the output is converted.
+    std::vector<float> small(10);
+    EXPECT_EQ(ConvertChannel(frames, 0, small), 10);
+    EXPECT_EQ(ConvertChannel({}, 0, small), 0);
+}
+
+TEST(NilaiAds131Stats, Accumulates)
+{
+    std::vector<uint8_t> frames = MakeFrames(100, 4);
+    BlockStats           whole  = {};
+    BlockStats           split  = {};
+    AccumulateFrames(frames, whole);
+    AccumulateFrames(std::span(frames).first(40 * s_frameSize), split);
+    AccumulateFrames(std::span(frames).subspan(40 * s_frameSize), split);
+    EXPECT_EQ(whole, split);
+
+    // A partial frame at the end is left out.
+    BlockStats partial = {};
+    AccumulateFrames(std::span(frames).first((10 * s_frameSize) + 7), partial);
+    EXPECT_EQ(partial[0].Count, 10);
+
+}
+
+TEST(NilaiAds131Stats, EmptyBlockIsZero)
+{
+    BlockStats empty = {};
+    AccumulateFrames({}, empty);
+    EXPECT_EQ(empty, BlockStats {});
+    for (const ChannelStats& ch : empty)
+    {
+        EXPECT_EQ(ch.MinVolts(), 0.0f);
+        EXPECT_EQ(ch.MaxVolts(), 0.0f);
+        EXPECT_EQ(ch.MeanVolts(), 0.0f);
+        EXPECT_EQ(ch.RmsVolts(), 0.0f);
+    }
+}
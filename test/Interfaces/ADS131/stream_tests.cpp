@@ -0,0 +1,119 @@
+/**
+ * @file    stream_tests.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "interfaces/ADS131/ads131_stream.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace Nilai::Interfaces::Ads131;
+
+namespace
+{
+using Stream = SampleStream<4>;
+
+// Reads a frame whose bytes are all equal to @p value, like the DMA would.
+bool ReadFrame(Stream& s, uint8_t value, uint32_t timestamp = 0)
+{
+    uint8_t* dest = s.BeginFrame(timestamp);
+    EXPECT_NE(dest, nullptr);
+    std::memset(dest, value, s_frameSize);
+    return s.EndFrame(true);
+}
+}    // namespace
+
+TEST(NilaiAds131Stream, HandsFullBlocks)
+{
+    Stream s;
+    EXPECT_EQ(s.Acquire(), nullptr);
+
+    EXPECT_FALSE(ReadFrame(s, 1, 100));
+    EXPECT_FALSE(ReadFrame(s, 2, 101));
+    EXPECT_FALSE(ReadFrame(s, 3, 102));
+    EXPECT_EQ(s.Acquire(), nullptr);
+    EXPECT_TRUE(ReadFrame(s, 4, 103));
+
+    const Stream::block_t* block = s.Acquire();
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->Timestamp, 100);
+    EXPECT_EQ(block->Sequence, 0);
+    for (size_t i = 0; i < Stream::block_t::s_frames; i++)
+    {
+        for (uint8_t b : block->Frame(i))
+        {
+            ASSERT_EQ(b, i + 1);
+        }
+    }
+
+    // The next block is filled in the other buffer while this one is held.
+    ReadFrame(s, 5, 104);
+    EXPECT_EQ(block->Frame(0)[0], 1);
+    s.Release();
+    EXPECT_EQ(s.Acquire(), nullptr);
+    EXPECT_EQ(s.Stats().Blocks, 1);
+    EXPECT_EQ(s.Stats().Frames, 5);
+}
+
+TEST(NilaiAds131Stream, DropsBlocksWhenHeld)
+{
+    Stream s;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        ReadFrame(s, 1);
+    }
+    const Stream::block_t* held = s.Acquire();
+    ASSERT_NE(held, nullptr);
+
+    // The second block completes while the first one is still held, it is dropped.
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        EXPECT_FALSE(ReadFrame(s, 2));
+    }
+    EXPECT_EQ(s.Stats().Overruns, 1);
+    EXPECT_EQ(held->Frame(0)[0], 1);
+
+    s.Release();
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        ReadFrame(s, 3);
+    }
+    EXPECT_TRUE(ReadFrame(s, 3));
+    const Stream::block_t* next = s.Acquire();
+    ASSERT_NE(next, nullptr);
+    EXPECT_EQ(next->Frame(3)[0], 3);
+    // The gap in the sequence shows that a block was lost.
+    EXPECT_EQ(next->Sequence, 2);
+}
+
+TEST(NilaiAds131Stream, MissedAndFailedFrames)
+{
+    Stream   s;
+    uint8_t* dest = s.BeginFrame(0);
+    ASSERT_NE(dest, nullptr);
+    // Data ready while the frame is still being read.
+    EXPECT_EQ(s.BeginFrame(0), nullptr);
+    EXPECT_EQ(s.Stats().MissedFrames, 1);
+
+    // A failed frame is read again at the same place.
+    EXPECT_FALSE(s.EndFrame(false));
+    EXPECT_EQ(s.BeginFrame(0), dest);
+    s.EndFrame(true);
+    EXPECT_EQ(s.Stats().FailedFrames, 1);
+    EXPECT_EQ(s.Stats().Frames, 1);
+
+    s.Reset();
+    EXPECT_EQ(s.BeginFrame(0), dest);
+}
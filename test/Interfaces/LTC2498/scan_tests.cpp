@@ -0,0 +1,230 @@
+/**
+ * @file    scan_tests.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "interfaces/LTC2498/ltc2498_scan.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Nilai::Interfaces::Ltc2498;
+
+namespace
+{
+using Engine = ScanEngine<16>;
+
+SlotConfig Config(uint8_t channel)
+{
+    return {static_cast<uint8_t>(0xB0 | channel), 0x80, 0x00, 0x00};
+}
+
+std::array<uint8_t, s_frameSize> Encode(int32_t raw)
+{
+    uint32_t word = (static_cast<uint32_t>(raw + 0x01000000) & 0x01FFFFFF) << 5;
+    return {static_cast<uint8_t>(word >> 24),
+            static_cast<uint8_t>(word >> 16),
+            static_cast<uint8_t>(word >> 8),
+            static_cast<uint8_t>(word)};
+}
+
+//! Value converted by the fake chip for a channel.
+int32_t ValueOf(uint8_t channel)
+{
+    return 1000 * channel - 3000;
+}
+
+/**
+ * @brief Answers the frames like the LTC2498: the result of the conversion that just ended is
+ * shifted out while the next configuration is shifted in.
+ */
+struct FakeChip
+{
+    uint8_t              Converting = 0x0F;
+    std::vector<uint8_t> Programmed;
+
+    void Transfer(const Engine::Frame& frame)
+    {
+        auto out = Encode(ValueOf(Converting));
+        std::copy(out.begin(), out.end(), frame.Rx.begin());
+        // Without the EN bit, the chip keeps its last configuration.
+        if ((frame.Tx[0] & 0x20) != 0)
+        {
+            Converting = frame.Tx[0] & 0x0F;
+            Programmed.push_back(Converting);
+        }
+    }
+
+    //! Signals the end of conversion and runs the frame, if the engine asks for one.
+    bool Eoc(Engine& engine, uint32_t timestamp = 0, bool ok = true)
+    {
+        Engine::Frame frame;
+        if (!engine.BeginFrame(frame, timestamp))
+        {
+            return false;
+        }
+        Transfer(frame);
+        engine.EndFrame(ok);
+        return true;
+    }
+};
+}    // namespace
+
+TEST(NilaiLtc2498Scan, DecodesResults)
+{
+    int32_t raw = 0;
+    EXPECT_EQ(DecodeResult(Encode(0), raw), ResultStatus::Ok);
+    EXPECT_EQ(raw, 0);
+    EXPECT_EQ(DecodeResult(Encode(-1), raw), ResultStatus::Ok);
+    EXPECT_EQ(raw, -1);
+    EXPECT_EQ(DecodeResult(Encode(123456), raw), ResultStatus::Ok);
+    EXPECT_EQ(raw, 123456);
+    EXPECT_EQ(DecodeResult(Encode(-0x00800000), raw), ResultStatus::Ok);
+    EXPECT_EQ(raw, -0x00800000);
+
+    // At or above +FS, and below -FS.
+    EXPECT_EQ(DecodeResult(std::array<uint8_t, 4> {0x30, 0, 0, 0}, raw), ResultStatus::OverRange);
+    EXPECT_EQ(raw, 0x00800000);
+    EXPECT_EQ(DecodeResult(std::array<uint8_t, 4> {0x0F, 0xFF, 0xFF, 0xE0}, raw),
+              ResultStatus::UnderRange);
+    EXPECT_EQ(raw, -0x00800001);
+
+    // A conversion in progress reads as all ones, the raw value is left untouched.
+    raw = 42;
+    EXPECT_EQ(DecodeResult(std::array<uint8_t, 4> {0xFF, 0xFF, 0xFF, 0xFF}, raw),
+              ResultStatus::Invalid);
+    EXPECT_EQ(DecodeResult(std::array<uint8_t, 4> {0x60, 0, 0, 0}, raw), ResultStatus::Invalid);
+    EXPECT_EQ(raw, 42);
+}
+
+TEST(NilaiLtc2498Scan, ConvertsToVolts)
+{
+    EXPECT_FLOAT_EQ(ToVolts(0x00800000, 5.0f), 2.5f);
+    EXPECT_FLOAT_EQ(ToVolts(-0x00400000, 5.0f), -1.25f);
+    EXPECT_FLOAT_EQ(ToVolts(0, 4.096f), 0.0f);
+}
+
+TEST(NilaiLtc2498Scan, ProgramsTheNextSlotWhileReadingTheLast)
+{
+    std::vector<SlotConfig> slots = {Config(3), Config(7), Config(12)};
+    Engine                  engine;
+    ASSERT_TRUE(engine.Configure(slots, true));
+    engine.Start();
+
+    FakeChip chip;
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        ASSERT_TRUE(chip.Eoc(engine, i));
+    }
+
+    // The first frame only programs slot 0, every frame after that reads one slot.
+    std::vector<uint8_t> exp = {3, 7, 12, 3, 7, 12, 3, 7, 12, 3};
+    EXPECT_EQ(chip.Programmed, exp);
+    for (size_t s = 0; s < slots.size(); s++)
+    {
+        const Result& r = engine.GetResult(s);
+        EXPECT_EQ(r.Status, ResultStatus::Ok);
+        EXPECT_EQ(r.Raw, ValueOf(slots[s][0] & 0x0F)) << "slot " << s;
+        EXPECT_EQ(r.Count, 3);
+    }
+    EXPECT_EQ(engine.GetResult(2).Timestamp, 9);
+    EXPECT_EQ(engine.Stats().Conversions, 9);
+    EXPECT_EQ(engine.Stats().Sweeps, 3);
+    EXPECT_TRUE(engine.IsRunning());
+}
+
+TEST(NilaiLtc2498Scan, SingleScanStopsAfterTheLastSlot)
+{
+    std::vector<SlotConfig> slots = {Config(1), Config(2)};
+    Engine                  engine;
+    ASSERT_TRUE(engine.Configure(slots, false));
+    engine.Start();
+
+    FakeChip chip;
+    EXPECT_TRUE(chip.Eoc(engine));
+    EXPECT_TRUE(chip.Eoc(engine));
+    // Reads slot 1 without programming anything.
+    EXPECT_TRUE(chip.Eoc(engine));
+    EXPECT_FALSE(engine.IsRunning());
+    EXPECT_FALSE(chip.Eoc(engine));
+
+    EXPECT_EQ(chip.Programmed, (std::vector<uint8_t> {1, 2}));
+    EXPECT_EQ(engine.GetResult(0).Raw, ValueOf(1));
+    EXPECT_EQ(engine.GetResult(1).Raw, ValueOf(2));
+    EXPECT_EQ(engine.Stats().Sweeps, 1);
+}
+
+TEST(NilaiLtc2498Scan, IgnoresEndOfConversionDuringAFrame)
+{
+    std::vector<SlotConfig> slots = {Config(0), Config(1)};
+    Engine                  engine;
+    ASSERT_TRUE(engine.Configure(slots, true));
+    engine.Start();
+
+    Engine::Frame frame;
+    ASSERT_TRUE(engine.BeginFrame(frame));
+    EXPECT_TRUE(engine.IsBusy());
+
+    // MISO toggles while the result is shifted out.
+    Engine::Frame other;
+    EXPECT_FALSE(engine.BeginFrame(other));
+    EXPECT_EQ(engine.Stats().SpuriousEocs, 1);
+
+    FakeChip chip;
+    chip.Transfer(frame);
+    EXPECT_FALSE(engine.EndFrame(true));
+    EXPECT_TRUE(chip.Eoc(engine));
+    EXPECT_EQ(engine.GetResult(0).Raw, ValueOf(0));
+}
+
+TEST(NilaiLtc2498Scan, ReprogramsTheSlotAfterAFailedFrame)
+{
+    std::vector<SlotConfig> slots = {Config(4), Config(5), Config(6)};
+    Engine                  engine;
+    ASSERT_TRUE(engine.Configure(slots, true));
+    engine.Start();
+
+    FakeChip chip;
+    ASSERT_TRUE(chip.Eoc(engine));    // Programs 4.
+    ASSERT_TRUE(chip.Eoc(engine));    // Reads 4, programs 5.
+
+    // The frame reading 5 and programming 6 fails, the chip's state is unknown.
+    Engine::Frame frame;
+    ASSERT_TRUE(engine.BeginFrame(frame));
+    engine.EndFrame(false);
+    EXPECT_EQ(engine.Stats().FailedFrames, 1);
+
+    // Slot 6 is programmed again, what is read then is dropped.
+    ASSERT_TRUE(chip.Eoc(engine));
+    ASSERT_TRUE(chip.Eoc(engine));
+    EXPECT_EQ(chip.Programmed, (std::vector<uint8_t> {4, 5, 6, 4}));
+    EXPECT_EQ(engine.GetResult(0).Count, 1);
+    EXPECT_EQ(engine.GetResult(1).Count, 0);
+    EXPECT_EQ(engine.GetResult(2).Count, 1);
+    EXPECT_EQ(engine.GetResult(2).Raw, ValueOf(6));
+}
+
+TEST(NilaiLtc2498Scan, RejectsInvalidConfigurations)
+{
+    Engine                  engine;
+    std::vector<SlotConfig> slots(17, Config(0));
+    EXPECT_FALSE(engine.Configure({}, true));
+    EXPECT_FALSE(engine.Configure(slots, true));
+    EXPECT_TRUE(engine.Configure(std::span {slots}.first(16), true));
+
+    // Not started.
+    Engine::Frame frame;
+    EXPECT_FALSE(engine.BeginFrame(frame));
+}
@@ -0,0 +1,234 @@
+/**
+ * @file    register_cache_tests.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/register_cache.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Nilai;
+
+namespace
+{
+enum class Registers : uint8_t
+{
+    Status = 0x00,
+    Power,
+    Config,
+    VolumeL,
+    VolumeR,
+    Filter  = 0x08,
+    Clip2   = 0x10,
+    Clip1,
+};
+
+using Cache = RegisterCache<Registers, 0x12>;
+
+// Stands in for the device: holds its registers and records the bursts.
+struct Device
+{
+    struct Burst
+    {
+        uint8_t              Reg;
+        std::vector<uint8_t> Data;
+    };
+
+    bool Write(uint8_t reg, std::span<const uint8_t> data)
+    {
+        if (Fail)
+        {
+            return false;
+        }
+        Writes.push_back({reg, {data.begin(), data.end()}});
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            Regs[reg + i] = data[i];
+        }
+        return true;
+    }
+
+    bool Read(uint8_t reg, std::span<uint8_t> data)
+    {
+        Reads++;
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            data[i] = Regs[reg + i];
+        }
+        return true;
+    }
+
+    auto Writer()
+    {
+        return [this](uint8_t reg, std::span<const uint8_t> data) { return Write(reg, data); };
+    }
+    auto Reader()
+    {
+        return [this](uint8_t reg, std::span<uint8_t> data) { return Read(reg, data); };
+    }
+
+    std::array<uint8_t, 0x12> Regs   = {};
+    std::vector<Burst>        Writes = {};
+    size_t                    Reads  = 0;
+    bool                      Fail   = false;
+};
+}    // namespace
+
+TEST(NilaiRegisterCache, CoalescesDirtyRegisters)
+{
+    Cache  cache;
+    Device dev;
+    EXPECT_FALSE(cache.Get(Registers::Power).has_value());
+
+    cache.Set(Registers::Power, 0x01);
+    cache.Set(Registers::Config, 0x02);
+    cache.Set(Registers::VolumeR, 0x05);
+    cache.Set(Registers::VolumeL, 0x04);
+    cache.Set(Registers::Filter, 0x08);
+    uint8_t clip[2] = {0xFF, 0xFC};
+    cache.Set(Registers::Clip2, clip);
+    EXPECT_EQ(cache.DirtyCount(), 7);
+
+    ASSERT_TRUE(cache.Flush(dev.Writer()));
+    ASSERT_EQ(dev.Writes.size(), 3);
+    EXPECT_EQ(dev.Writes[0].Reg, 0x01);
+    EXPECT_EQ(dev.Writes[0].Data, std::vector<uint8_t>({1, 2, 4, 5}));
+    EXPECT_EQ(dev.Writes[1].Reg, 0x08);
+    EXPECT_EQ(dev.Writes[2].Reg, 0x10);
+    EXPECT_EQ(dev.Writes[2].Data, std::vector<uint8_t>({0xFF, 0xFC}));
+    EXPECT_EQ(cache.DirtyCount(), 0);
+    EXPECT_EQ(cache.Stats().Bursts, 3);
+    EXPECT_EQ(cache.Stats().Bytes, 7);
+    EXPECT_EQ(cache.Get(Registers::VolumeL), 0x04);
+
+    // Nothing to do.
+    ASSERT_TRUE(cache.Flush(dev.Writer()));
+    EXPECT_EQ(dev.Writes.size(), 3);
+}
+
+TEST(NilaiRegisterCache, SkipsUnchangedValues)
+{
+    Cache  cache;
+    Device dev;
+    cache.Preset(Registers::VolumeL, 0xCF);
+    EXPECT_FALSE(cache.Set(Registers::VolumeL, 0xCF));
+    EXPECT_TRUE(cache.Set(Registers::VolumeR, 0xCF));
+    cache.Flush(dev.Writer());
+
+    // A volume ramp where only one channel moves.
+    for (uint8_t v = 0xC0; v < 0xD0; v++)
+    {
+        cache.Set(Registers::VolumeL, v);
+        cache.Set(Registers::VolumeR, 0xCF);
+        cache.Flush(dev.Writer());
+    }
+    EXPECT_EQ(dev.Writes.size(), 17);
+    EXPECT_EQ(cache.Stats().Skipped, 17);
+
+    // Changed and changed back before the flush: still written, the value on the device is unknown
+    // to the cache until then.
+    cache.Set(Registers::VolumeL, 0x00);
+    EXPECT_TRUE(cache.Set(Registers::VolumeL, 0xCF));
+    cache.Flush(dev.Writer());
+    EXPECT_EQ(dev.Writes.size(), 18);
+}
+
+TEST(NilaiRegisterCache, VolatileRegisters)
+{
+    Cache  cache;
+    Device dev;
+    cache.SetVolatile(Registers::Status);
+    cache.SetVerifyInterval(1);
+    cache.Set(Registers::Status, 0xFF);
+    cache.Flush(dev.Writer());
+    EXPECT_TRUE(cache.Set(Registers::Status, 0xFF));
+
+    // The device clears it, that's not a mismatch.
+    cache.Set(Registers::Status, 0xFF);
+    cache.Set(Registers::Power, 0x01);
+    auto cleared = [&](uint8_t reg, std::span<uint8_t> data)
+    {
+        dev.Regs[0] = 0;
+        return dev.Read(reg, data);
+    };
+    EXPECT_TRUE(cache.Flush(dev.Writer(), cleared));
+    EXPECT_EQ(dev.Writes.size(), 2);
+    EXPECT_EQ(dev.Writes[1].Data, std::vector<uint8_t>({0xFF, 0x01}));
+    EXPECT_EQ(cache.Stats().Mismatches, 0);
+}
+
+TEST(NilaiRegisterCache, SampledVerification)
+{
+    Cache  cache;
+    Device dev;
+    cache.SetVerifyInterval(4);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        cache.Set(Registers::Config, i);
+        EXPECT_TRUE(cache.Flush(dev.Writer(), dev.Reader()));
+    }
+    EXPECT_EQ(dev.Reads, 2);
+    EXPECT_EQ(cache.Stats().Verified, 2);
+
+    // The register doesn't take the value: written again on the next flush.
+    cache.SetVerifyInterval(1);
+    cache.Set(Registers::Config, 0x55);
+    auto stuck = [&](uint8_t reg, std::span<uint8_t> data)
+    {
+        dev.Regs[reg] = 0;
+        return dev.Read(reg, data);
+    };
+    EXPECT_FALSE(cache.Flush(dev.Writer(), stuck));
+    EXPECT_EQ(cache.Stats().Mismatches, 1);
+    EXPECT_TRUE(cache.IsDirty(Registers::Config));
+    EXPECT_TRUE(cache.Flush(dev.Writer(), dev.Reader()));
+    EXPECT_EQ(dev.Regs[2], 0x55);
+
+    // Without a read function, nothing is verified.
+    cache.Set(Registers::Config, 0x56);
+    EXPECT_TRUE(cache.Flush(dev.Writer()));
+    EXPECT_EQ(cache.Stats().Verified, 4);
+}
+
+TEST(NilaiRegisterCache, FailuresStayDirty)
+{
+    Cache  cache;
+    Device dev;
+    cache.Set(Registers::Power, 0x01);
+    dev.Fail = true;
+    EXPECT_FALSE(cache.Flush(dev.Writer()));
+    EXPECT_TRUE(cache.IsDirty(Registers::Power));
+    dev.Fail = false;
+    EXPECT_TRUE(cache.Flush(dev.Writer()));
+    EXPECT_EQ(dev.Regs[1], 0x01);
+}
+
+TEST(NilaiRegisterCache, RefreshAndInvalidate)
+{
+    Cache  cache;
+    Device dev;
+    dev.Regs = {0, 1, 2, 3, 4, 5};
+    cache.Set(Registers::Config, 0x22);
+    ASSERT_TRUE(cache.Refresh(Registers::Status, 6, dev.Reader()));
+    EXPECT_EQ(cache.Get(Registers::VolumeR), 4);
+    // Dirty registers keep the value to write.
+    EXPECT_EQ(cache.Get(Registers::Config), 0x22);
+    EXPECT_FALSE(cache.Refresh(Registers::Clip1, 2, dev.Reader()));
+
+    cache.Invalidate();
+    EXPECT_FALSE(cache.Get(Registers::VolumeR).has_value());
+    EXPECT_TRUE(cache.Get(Registers::Config).has_value());
+    EXPECT_TRUE(cache.Set(Registers::VolumeR, 4));
+}
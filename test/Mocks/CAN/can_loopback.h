@@ -0,0 +1,139 @@
+/**
+ * @file    can_loopback.h
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   CAN bus on which the frames sent by a node are received by the others.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#ifndef NILAI_TEST_MOCK_CAN_LOOPBACK_H
+#define NILAI_TEST_MOCK_CAN_LOOPBACK_H
+
+#include "drivers/CAN/structs.h"
+#include "drivers/CAN/tx_queue.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace Nilai::Mocks
+{
+/**
+ * @brief Stands in for the CAN modules of several nodes sharing a bus.
+ *
+ * Each node sends through its own @ref Port, which has a transmit queue of limited depth like
+ * CanModule. The frames are put on the bus with @ref Transfer, in order of priority, and every
+ * other node receives them.
+ */
+class CanLoopback
+{
+public:
+    using Receiver = std::function<void(const Can::Frame& frame)>;
+
+    struct Port
+    {
+        Can::TxQueue<256> Queue;
+        //! Number of frames the transmit queue accepts.
+        size_t   Capacity = 16;
+        Receiver Rx;
+        //! Every frame this node put on the bus.
+        std::vector<Can::TxFrame> Sent;
+    };
+
+    /**
+     * @brief Adds a node to the bus.
+     * @param rx Called with every frame sent by the other nodes.
+     */
+    Port& AddNode(Receiver rx, size_t capacity = 16)
+    {
+        Port& port    = m_ports.emplace_back();
+        port.Capacity = capacity;
+        port.Rx       = std::move(rx);
+        return port;
+    }
+
+    /**
+     * @brief Queues a frame on a port, in the format of Can::IsoTp::SendFunc.
+     * @param port The @ref Port.
+     */
+    static bool Send(void* port, const Can::TxFrame& frame)
+    {
+        auto* p = static_cast<Port*>(port);
+        if (p->Queue.Size() >= p->Capacity)
+        {
+            return false;
+        }
+        return p->Queue.Push(frame);
+    }
+
+    /**
+     * @brief Puts the queued frames on the bus, the one with the highest priority first.
+     * @param max Maximum number of frames to put on the bus.
+     * @return The number of frames put on the bus.
+     */
+    size_t Transfer(size_t max = SIZE_MAX)
+    {
+        size_t count = 0;
+        while (count < max)
+        {
+            Port* winner = nullptr;
+            for (Port& p : m_ports)
+            {
+                const Can::TxFrame* top = p.Queue.Top();
+                if (top != nullptr &&
+                    (winner == nullptr || top->Priority() < winner->Queue.Top()->Priority()))
+                {
+                    winner = &p;
+                }
+            }
+            if (winner == nullptr)
+            {
+                break;
+            }
+
+            Can::TxFrame tx = *winner->Queue.Pop();
+            winner->Sent.push_back(tx);
+            count++;
+            if (DropNext)
+            {
+                DropNext = false;
+                continue;
+            }
+
+            Can::Frame rx {};
+            rx.frame.IDE = static_cast<uint32_t>(tx.Extended ? Can::IdentifierType::Extended
+                                                             : Can::IdentifierType::Standard);
+            rx.frame.StdId = tx.Extended ? 0 : tx.Id;
+            rx.frame.ExtId = tx.Extended ? tx.Id : 0;
+            rx.frame.DLC   = tx.Len;
+            rx.data        = tx.Data;
+            for (Port& p : m_ports)
+            {
+                if (&p != winner && p.Rx)
+                {
+                    p.Rx(rx);
+                }
+            }
+        }
+        return count;
+    }
+
+    //! Loses the next frame put on the bus.
+    bool DropNext = false;
+
+private:
+    std::deque<Port> m_ports;
+};
+}    // namespace Nilai::Mocks
+
+#endif    // NILAI_TEST_MOCK_CAN_LOOPBACK_H
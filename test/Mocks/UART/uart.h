@@ -29,6 +29,7 @@ struct UART_HandleTypeDef
 {
     size_t                id         = 0;
     HAL_UART_StateTypeDef gState     = {};
+    HAL_UART_StateTypeDef RxState    = {};
     DMA_HandleTypeDef*    hdmarx     = nullptr;
     DMA_HandleTypeDef*    hdmatx     = nullptr;
     uint16_t              RxXferSize = 0;
@@ -0,0 +1,26 @@
+/**
+ * @file    assertion.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Host replacement for defines/assertion.cpp, which needs the target's debugger.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/assertion.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" [[noreturn]] void AssertFailed(const uint8_t* file, uint32_t line, uint8_t)
+{
+    std::fprintf(stderr, "An assertion failed: line %u, %s\n", line, file);
+    std::abort();
+}
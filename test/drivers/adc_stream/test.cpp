@@ -0,0 +1,251 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/ADC/decimator.h"
+#include "drivers/ADC/stream.h"
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace Nilai::Drivers::Adc;
+
+namespace
+{
+std::vector<uint32_t> MakeSamples(size_t count, uint32_t max)
+{
+    std::vector<uint32_t> samples(count);
+    uint32_t              x = 12345;
+    for (uint32_t& s : samples)
+    {
+        x = x * 1664525 + 1013904223;
+        s = (x >> 8) % (max + 1);
+    }
+    return samples;
+}
+
+/**
+ * @brief Impulse response of a CIC filter: a boxcar of @p ratio ones, convolved @p order times.
+ */
+std::vector<double> CicResponse(size_t order, size_t ratio)
+{
+    std::vector<double> h = {1.0};
+    for (size_t s = 0; s < order; s++)
+    {
+        std::vector<double> next(h.size() + ratio - 1, 0.0);
+        for (size_t i = 0; i < h.size(); i++)
+        {
+            for (size_t j = 0; j < ratio; j++)
+            {
+                next[i + j] += h[i];
+            }
+        }
+        h = next;
+    }
+    return h;
+}
+
+struct Received
+{
+    std::vector<std::vector<float>> Channels;
+    std::vector<uint32_t>           Sequences;
+};
+
+void OnBlock(const StreamBlock& block, void* ctx)
+{
+    auto* r = static_cast<Received*>(ctx);
+    r->Channels.resize(block.Channels);
+    for (size_t ch = 0; ch < block.Channels; ch++)
+    {
+        auto samples = block.Channel(ch);
+        r->Channels[ch].insert(r->Channels[ch].end(), samples.begin(), samples.end());
+    }
+    r->Sequences.push_back(block.Sequence);
+}
+}    // namespace
+
+TEST(NilaiAdcDecimator, MovingAverage)
+{
+    Decimator d;
+    ASSERT_TRUE(d.Configure(1, 4));
+
+    std::vector<uint32_t> in = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    std::vector<float>    out(3);
+    EXPECT_EQ(d.Process(in.data(), in.size(), 1, out.data()), 2);
+    EXPECT_FLOAT_EQ(out[0], 2.5f);
+    EXPECT_FLOAT_EQ(out[1], 6.5f);
+
+    // The 9th sample is kept for the next output.
+    std::vector<uint32_t> more = {10, 11, 12};
+    EXPECT_EQ(d.Process(more.data(), more.size(), 1, out.data()), 1);
+    EXPECT_FLOAT_EQ(out[0], 10.5f);
+}
+
+TEST(NilaiAdcDecimator, MatchesTheImpulseResponse)
+{
+    constexpr size_t order = 3;
+    constexpr size_t ratio = 8;
+
+    Decimator d;
+    ASSERT_TRUE(d.Configure(order, ratio));
+
+    std::vector<uint32_t> in = MakeSamples(ratio * 40, 4095);
+    std::vector<float>    out(40);
+    ASSERT_EQ(d.Process(in.data(), in.size(), 1, out.data()), 40);
+
+    std::vector<double> h    = CicResponse(order, ratio);
+    double              gain = static_cast<double>(ratio * ratio * ratio);
+    for (size_t m = 0; m < out.size(); m++)
+    {
+        size_t n   = m * ratio + ratio - 1;
+        double exp = 0.0;
+        for (size_t k = 0; k < h.size() && k <= n; k++)
+        {
+            exp += h[k] * in[n - k];
+        }
+        EXPECT_NEAR(out[m], exp / gain, 1e-3) << "output " << m;
+    }
+}
+
+TEST(NilaiAdcDecimator, SurvivesIntegratorWrapAround)
+{
+    // 12 + 3 * 4 = 24 bits, the integrators wrap after a few thousand samples of full scale.
+    Decimator d;
+    ASSERT_TRUE(d.Configure(3, 16));
+
+    std::vector<uint32_t> in(16 * 1000, 4095);
+    std::vector<float>    out(1000);
+    ASSERT_EQ(d.Process(in.data(), in.size(), 1, out.data()), 1000);
+    for (size_t i = 2; i < out.size(); i++)
+    {
+        ASSERT_FLOAT_EQ(out[i], 4095.0f) << "output " << i;
+    }
+}
+
+TEST(NilaiAdcDecimator, RejectsConfigurationsThatOverflow)
+{
+    Decimator d;
+    EXPECT_FALSE(d.Configure(0, 4));
+    EXPECT_FALSE(d.Configure(Decimator::MaxOrder + 1, 4));
+    EXPECT_FALSE(d.Configure(1, 0));
+    EXPECT_FALSE(d.Configure(4, 256));       // 12 + 4 * 8 bits.
+    EXPECT_TRUE(d.Configure(4, 32));         // 12 + 4 * 5 bits.
+    EXPECT_FALSE(d.Configure(4, 33));        // 12 + 4 * 6 bits.
+    EXPECT_TRUE(d.Configure(2, 256, 16));    // 16 + 2 * 8 bits.
+}
+
+TEST(NilaiAdcStream, DeinterleavesAndDecimatesEachHalf)
+{
+    Stream       stream;
+    Received     r;
+    StreamConfig cfg = {.ScansPerHalf = 8, .Order = 1, .Ratio = 4, .Scale = 0.5f};
+    ASSERT_TRUE(stream.Configure(3, cfg, &OnBlock, &r));
+    ASSERT_EQ(stream.DmaBuffer().size(), 2 * 3 * 8);
+    EXPECT_EQ(stream.OutputsPerHalf(), 2);
+
+    // Channel c of scan s reads 100 * c + s.
+    auto buff = stream.DmaBuffer();
+    for (size_t s = 0; s < 16; s++)
+    {
+        for (size_t c = 0; c < 3; c++)
+        {
+            buff[s * 3 + c] = static_cast<uint32_t>(100 * c + s);
+        }
+    }
+
+    stream.OnHalfComplete();
+    stream.OnComplete();
+
+    ASSERT_EQ(r.Channels.size(), 3);
+    for (size_t c = 0; c < 3; c++)
+    {
+        ASSERT_EQ(r.Channels[c].size(), 4);
+        for (size_t i = 0; i < 4; i++)
+        {
+            // Average of 4 consecutive scans, times the scale.
+            float exp = (100.0f * c + 4.0f * i + 1.5f) * 0.5f;
+            EXPECT_FLOAT_EQ(r.Channels[c][i], exp) << "channel " << c << ", output " << i;
+        }
+    }
+    EXPECT_EQ(r.Sequences, (std::vector<uint32_t> {0, 1}));
+    EXPECT_EQ(stream.LastRaw(2), 215);
+    EXPECT_EQ(stream.Stats().Blocks, 2);
+    EXPECT_EQ(stream.Stats().Overruns, 0);
+}
+
+TEST(NilaiAdcStream, CountsOverruns)
+{
+    Stream   stream;
+    Received r;
+    ASSERT_TRUE(stream.Configure(1, {.ScansPerHalf = 4}, &OnBlock, &r));
+
+    stream.OnHalfComplete();
+    stream.OnComplete();
+    // The first half was missed.
+    stream.OnComplete();
+    stream.OnHalfComplete();
+
+    EXPECT_EQ(stream.Stats().Overruns, 1);
+    EXPECT_EQ(r.Sequences, (std::vector<uint32_t> {0, 1, 3, 4}));
+}
+
+TEST(NilaiAdcStream, FindsHalvesTheDmaCameBackTo)
+{
+    // Conversions the DMA has yet to write, out of the 8 of the buffer.
+    struct Dma
+    {
+        size_t Remaining = 8;
+
+        static size_t Query(void* ctx) { return static_cast<Dma*>(ctx)->Remaining; }
+    };
+
+    Stream   stream;
+    Received r;
+    Dma      dma;
+    ASSERT_TRUE(stream.Configure(1, {.ScansPerHalf = 4}, &OnBlock, &r));
+    stream.SetPositionQuery(&Dma::Query, &dma);
+
+    // Read while the DMA fills the other half.
+    dma.Remaining = 3;
+    stream.OnHalfComplete();
+    dma.Remaining = 8;
+    stream.OnComplete();
+    EXPECT_EQ(stream.Stats().Overruns, 0);
+
+    // The interrupts still alternate, but the DMA had already wrapped around.
+    dma.Remaining = 7;
+    stream.OnHalfComplete();
+    dma.Remaining = 2;
+    stream.OnComplete();
+    EXPECT_EQ(stream.Stats().Overruns, 2);
+    // The blocks are still handed out.
+    EXPECT_EQ(r.Sequences, (std::vector<uint32_t> {0, 1, 2, 3}));
+
+    // Only the missed interrupts are seen without the position.
+    stream.SetPositionQuery(nullptr, nullptr);
+    dma.Remaining = 7;
+    stream.OnHalfComplete();
+    EXPECT_EQ(stream.Stats().Overruns, 2);
+}
+
+TEST(NilaiAdcStream, RejectsInvalidConfigurations)
+{
+    Stream stream;
+    EXPECT_FALSE(stream.Configure(0, {}, &OnBlock, nullptr));
+    EXPECT_FALSE(stream.Configure(2, {.ScansPerHalf = 10, .Ratio = 4}, &OnBlock, nullptr));
+    EXPECT_FALSE(stream.Configure(2, {.ScansPerHalf = 8, .Order = 0}, &OnBlock, nullptr));
+    EXPECT_TRUE(stream.Configure(2, {.ScansPerHalf = 8, .Ratio = 4}, &OnBlock, nullptr));
+}
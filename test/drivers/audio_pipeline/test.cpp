@@ -0,0 +1,200 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/AUDIO/pipeline.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace Nilai::Drivers::Audio;
+
+namespace
+{
+/**
+ * @brief Produces a ramp of stereo 16-bit frames, the left channel counting up and the right one
+ * counting down. Stops after @ref Available frames.
+ */
+struct Ramp
+{
+    int16_t Next      = 1;
+    size_t  Available = SIZE_MAX;
+    size_t  Calls     = 0;
+
+    static size_t Fill(void* dst, size_t frames, void* ctx)
+    {
+        auto* self = static_cast<Ramp*>(ctx);
+        self->Calls++;
+        size_t n = std::min(frames, self->Available);
+        auto*  s = static_cast<int16_t*>(dst);
+        for (size_t i = 0; i < n; i++)
+        {
+            s[2 * i]     = self->Next;
+            s[2 * i + 1] = static_cast<int16_t>(-self->Next);
+            self->Next++;
+        }
+        self->Available -= n;
+        return n;
+    }
+};
+
+//! Reads the left channel of the buffer, the way the DMA would play it.
+std::vector<int16_t> Left(Pipeline& p)
+{
+    auto                 buff = p.DmaBuffer();
+    std::vector<int16_t> out(buff.size() / 4);
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        std::memcpy(&out[i], &buff[i * 4], 2);
+    }
+    return out;
+}
+}    // namespace
+
+TEST(NilaiAudioPipeline, PrimesBothHalves)
+{
+    Pipeline p;
+    Ramp     r;
+    ASSERT_TRUE(p.Configure({.LatencyFrames = 4}, &Ramp::Fill, &r));
+    EXPECT_EQ(p.DmaBuffer().size(), 2 * 4 * 2 * 2);
+    EXPECT_EQ(p.DmaSamples(), 16);
+    EXPECT_EQ(p.LatencyFrames(), 4);
+
+    p.Prime();
+    EXPECT_EQ(Left(p), (std::vector<int16_t> {1, 2, 3, 4, 5, 6, 7, 8}));
+    EXPECT_EQ(p.Stats().Refills, 2);
+}
+
+TEST(NilaiAudioPipeline, RefillsTheHalfThatWasPlayed)
+{
+    Pipeline p;
+    Ramp     r;
+    ASSERT_TRUE(p.Configure({.LatencyFrames = 4}, &Ramp::Fill, &r));
+    p.Prime();
+
+    p.OnHalfComplete();
+    EXPECT_EQ(Left(p), (std::vector<int16_t> {9, 10, 11, 12, 5, 6, 7, 8}));
+    p.OnComplete();
+    EXPECT_EQ(Left(p), (std::vector<int16_t> {9, 10, 11, 12, 13, 14, 15, 16}));
+
+    // The right channel is interleaved with the left one.
+    int16_t right = 0;
+    std::memcpy(&right, &p.DmaBuffer()[2], 2);
+    EXPECT_EQ(right, -9);
+    EXPECT_EQ(p.Stats().Underruns, 0);
+    EXPECT_EQ(p.Stats().LateRefills, 0);
+}
+
+TEST(NilaiAudioPipeline, PlaysSilenceOnUnderrun)
+{
+    Pipeline p;
+    Ramp     r;
+    r.Available = 10;
+    ASSERT_TRUE(p.Configure({.LatencyFrames = 4}, &Ramp::Fill, &r));
+    p.Prime();
+
+    p.OnHalfComplete();
+    EXPECT_EQ(Left(p), (std::vector<int16_t> {9, 10, 0, 0, 5, 6, 7, 8}));
+    p.OnComplete();
+    EXPECT_EQ(Left(p), (std::vector<int16_t> {9, 10, 0, 0, 0, 0, 0, 0}));
+    for (uint8_t b : p.DmaBuffer().subspan(4 * 4))
+    {
+        ASSERT_EQ(b, 0);
+    }
+
+    EXPECT_EQ(p.Stats().Underruns, 2);
+    EXPECT_EQ(p.Stats().SilentFrames, 6);
+    EXPECT_EQ(r.Calls, 4);
+}
+
+TEST(NilaiAudioPipeline, CountsLateRefills)
+{
+    Pipeline p;
+    Ramp     r;
+    ASSERT_TRUE(p.Configure({.LatencyFrames = 2, .Channels = 1, .BytesPerSample = 4},
+                            &Ramp::Fill,
+                            &r));
+    p.Prime();
+
+    p.OnHalfComplete();
+    // The interrupt of the second half was missed.
+    p.OnHalfComplete();
+    p.OnComplete();
+
+    EXPECT_EQ(p.Stats().LateRefills, 1);
+    EXPECT_EQ(p.Stats().Refills, 5);
+}
+
+TEST(NilaiAudioPipeline, FindsRefillsTheDmaCaughtUpWith)
+{
+    // Bytes the DMA has yet to read, out of the 16 of the buffer.
+    struct Dma
+    {
+        size_t Remaining = 16;
+
+        static size_t Query(void* ctx) { return static_cast<Dma*>(ctx)->Remaining; }
+    };
+
+    Pipeline p;
+    Ramp     r;
+    Dma      dma;
+    ASSERT_TRUE(p.Configure({.LatencyFrames = 2, .Channels = 1, .BytesPerSample = 4},
+                            &Ramp::Fill,
+                            &r));
+    p.SetPositionQuery(&Dma::Query, &dma);
+    p.Prime();
+
+    // Done while the DMA plays the other half.
+    dma.Remaining = 6;
+    p.OnHalfComplete();
+    dma.Remaining = 16;
+    p.OnComplete();
+    EXPECT_EQ(p.Stats().LateRefills, 0);
+
+    // The interrupts still alternate, but the DMA had already wrapped around when the refill was
+    // done.
+    dma.Remaining = 14;
+    p.OnHalfComplete();
+    dma.Remaining = 8;
+    p.OnComplete();
+    EXPECT_EQ(p.Stats().LateRefills, 2);
+
+    // Only the missed interrupts are seen without the position.
+    p.SetPositionQuery(nullptr, nullptr);
+    dma.Remaining = 14;
+    p.OnHalfComplete();
+    EXPECT_EQ(p.Stats().LateRefills, 2);
+}
+
+TEST(NilaiAudioPipeline, RejectsInvalidConfigurations)
+{
+    Pipeline p;
+    Ramp     r;
+    EXPECT_FALSE(p.Configure({.LatencyFrames = 0}, &Ramp::Fill, &r));
+    EXPECT_FALSE(p.Configure({.Channels = 0}, &Ramp::Fill, &r));
+    EXPECT_FALSE(p.Configure({.BytesPerSample = 3}, &Ramp::Fill, &r));
+    EXPECT_FALSE(p.Configure({}, nullptr, &r));
+    EXPECT_FALSE(p.IsConfigured());
+
+    // Not configured, the interrupts are ignored.
+    p.OnHalfComplete();
+    EXPECT_EQ(p.Stats().Refills, 0);
+
+    EXPECT_TRUE(p.Configure({}, &Ramp::Fill, &r));
+    EXPECT_TRUE(p.IsConfigured());
+}
@@ -0,0 +1,167 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/CAN/filter_table.h"
+#include <gtest/gtest.h>
+
+using namespace Nilai::Can;
+
+namespace
+{
+using Table = FilterTable<14>;
+
+FilterConfiguration MakeConfig(uint8_t               bank,
+                               FilterMode            mode,
+                               FilterScale           scale,
+                               FilterFifoAssignation fifo = FilterFifoAssignation::Fifo0)
+{
+    FilterConfiguration config = {};
+    config.bank                = bank;
+    config.mode                = mode;
+    config.scale               = scale;
+    config.fifo                = fifo;
+    return config;
+}
+
+int g_lastHandler = -1;
+
+FrameHandler MakeHandler(int n)
+{
+    return [n](const Frame&) { g_lastHandler = n; };
+}
+}    // namespace
+
+TEST(NilaiCanFilterTable, FreeBanksFromTheEnd)
+{
+    Table t;
+    EXPECT_EQ(t.FindFreeBank(), 13);
+    t.Attach(13, FilterFifoAssignation::Fifo0, MakeHandler(0));
+    EXPECT_EQ(t.FindFreeBank(), 12);
+    t.Configure(MakeConfig(12, FilterMode::IdMask, FilterScale::Scale32bit));
+    EXPECT_EQ(t.FindFreeBank(), 11);
+    t.Detach(13);
+    EXPECT_EQ(t.FindFreeBank(), 13);
+
+    for (size_t i = 0; i < 14; i++)
+    {
+        t.Attach(i, FilterFifoAssignation::Fifo0, MakeHandler(0));
+    }
+    EXPECT_EQ(t.FindFreeBank(), Table::s_invalidBank);
+}
+
+TEST(NilaiCanFilterTable, IndexFollowsBankModes)
+{
+    Table t;
+    // Banks 0 to 12 are left as after a reset: 16-bit mask, 2 filters each, on FIFO 0.
+    t.Attach(13, FilterFifoAssignation::Fifo0, MakeHandler(13));
+    g_lastHandler = -1;
+    ASSERT_NE(t.Find(RxFifo::Fifo0, 26), nullptr);
+    (*t.Find(RxFifo::Fifo0, 26))(Frame {});
+    EXPECT_EQ(g_lastHandler, 13);
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 27), nullptr);
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 25), nullptr);
+
+    // Bank 0 now holds 4 filters, which shifts the index of bank 13 by 2.
+    t.Configure(MakeConfig(0, FilterMode::IdList, FilterScale::Scale16bit));
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 26), nullptr);
+    ASSERT_NE(t.Find(RxFifo::Fifo0, 28), nullptr);
+
+    // Bank 1 moves to FIFO 1, where it's the only bank.
+    t.Configure(
+      MakeConfig(1, FilterMode::IdMask, FilterScale::Scale32bit, FilterFifoAssignation::Fifo1));
+    ASSERT_NE(t.Find(RxFifo::Fifo0, 26), nullptr);
+    EXPECT_EQ(t.Find(RxFifo::Fifo1, 0), nullptr);
+    t.Attach(1, FilterFifoAssignation::Fifo1, MakeHandler(1));
+    ASSERT_NE(t.Find(RxFifo::Fifo1, 0), nullptr);
+    (*t.Find(RxFifo::Fifo1, 0))(Frame {});
+    EXPECT_EQ(g_lastHandler, 1);
+}
+
+TEST(NilaiCanFilterTable, DispatchesToEachHandler)
+{
+    Table t;
+    for (size_t i = 0; i < 14; i++)
+    {
+        t.Attach(i, FilterFifoAssignation::Fifo0, MakeHandler(static_cast<int>(i)));
+    }
+
+    // Every bank holds a single 32-bit filter, the index is the bank.
+    for (uint32_t fmi = 0; fmi < 14; fmi++)
+    {
+        const FrameHandler* h = t.Find(RxFifo::Fifo0, fmi);
+        ASSERT_NE(h, nullptr);
+        (*h)(Frame {});
+        EXPECT_EQ(g_lastHandler, static_cast<int>(fmi));
+    }
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 14), nullptr);
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 255), nullptr);
+    EXPECT_EQ(t.Find(RxFifo::Fifo1, 0), nullptr);
+
+    // Detaching keeps the numbering of the other banks.
+    t.Detach(3);
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 3), nullptr);
+    (*t.Find(RxFifo::Fifo0, 4))(Frame {});
+    EXPECT_EQ(g_lastHandler, 4);
+}
+
+TEST(NilaiCanFilterTable, ConfigureRemovesHandler)
+{
+    Table t;
+    t.Attach(5, FilterFifoAssignation::Fifo0, MakeHandler(5));
+    t.Configure(MakeConfig(5, FilterMode::IdMask, FilterScale::Scale32bit));
+    for (uint32_t fmi = 0; fmi < Table::s_maxFilters; fmi++)
+    {
+        EXPECT_EQ(t.Find(RxFifo::Fifo0, fmi), nullptr);
+    }
+    // Out of range banks are ignored.
+    t.Configure(MakeConfig(20, FilterMode::IdMask, FilterScale::Scale32bit));
+    t.Attach(20, FilterFifoAssignation::Fifo0, MakeHandler(20));
+    EXPECT_EQ(t.FindFreeBank(), 13);
+}
+
+TEST(NilaiCanFilterTable, DetachedBankKeepsItsFifo)
+{
+    Table t;
+    for (size_t i = 0; i < 14; i++)
+    {
+        t.Attach(i, FilterFifoAssignation::Fifo0, MakeHandler(static_cast<int>(i)));
+    }
+    // Banks 10 to 13 on FIFO 1, FMI 0 to 3 there.
+    for (size_t i = 10; i < 14; i++)
+    {
+        t.Attach(i, FilterFifoAssignation::Fifo1, MakeHandler(static_cast<int>(i)));
+    }
+
+    // Unsubscribing disables the bank with the FIFO recorded for it.
+    t.Detach(11);
+    EXPECT_EQ(t.GetFifo(11), FilterFifoAssignation::Fifo1);
+    t.Configure(MakeConfig(11, FilterMode::IdMask, FilterScale::Scale32bit, t.GetFifo(11)));
+
+    EXPECT_EQ(t.Find(RxFifo::Fifo1, 1), nullptr);
+    for (uint32_t fmi : {0u, 2u, 3u})
+    {
+        ASSERT_NE(t.Find(RxFifo::Fifo1, fmi), nullptr);
+        (*t.Find(RxFifo::Fifo1, fmi))(Frame {});
+        EXPECT_EQ(g_lastHandler, static_cast<int>(10 + fmi));
+    }
+    for (uint32_t fmi = 0; fmi < 10; fmi++)
+    {
+        ASSERT_NE(t.Find(RxFifo::Fifo0, fmi), nullptr);
+        (*t.Find(RxFifo::Fifo0, fmi))(Frame {});
+        EXPECT_EQ(g_lastHandler, static_cast<int>(fmi));
+    }
+    EXPECT_EQ(t.Find(RxFifo::Fifo0, 10), nullptr);
+}
@@ -0,0 +1,374 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/CAN/isotp.h"
+#include "Mocks/CAN/can_loopback.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace Nilai;
+using namespace Nilai::Can;
+using Nilai::Mocks::CanLoopback;
+
+namespace
+{
+struct Result
+{
+    int                  Calls  = 0;
+    IsoTpStatus          Status = IsoTpStatus::Ok;
+    std::vector<uint8_t> Data;
+};
+
+void OnSent(IsoTpStatus status, void* ctx)
+{
+    auto* r = static_cast<Result*>(ctx);
+    r->Calls++;
+    r->Status = status;
+}
+
+void OnReceived(IsoTpStatus status, std::span<const uint8_t> data, void* ctx)
+{
+    auto* r = static_cast<Result*>(ctx);
+    r->Calls++;
+    r->Status = status;
+    r->Data.assign(data.begin(), data.end());
+}
+
+std::vector<uint8_t> MakeMessage(size_t len)
+{
+    std::vector<uint8_t> msg(len);
+    std::iota(msg.begin(), msg.end(), static_cast<uint8_t>(1));
+    return msg;
+}
+
+// Two nodes talking to each other over the loopback.
+struct Link
+{
+    explicit Link(IsoTpConfig a = {.TxId = 0x700, .RxId = 0x708},
+                  size_t      capacity = 16)
+    : A(&bus.AddNode([this](const Frame& f) { NodeA->OnFrame(f); }, capacity)),
+      B(&bus.AddNode([this](const Frame& f) { NodeB->OnFrame(f); }, capacity)),
+      NodeA(std::make_unique<IsoTp>(a, &CanLoopback::Send, A)),
+      NodeB(std::make_unique<IsoTp>(Swap(a), &CanLoopback::Send, B))
+    {
+        NodeA->Receive(BufferA, &OnReceived, &ReceivedA);
+        NodeB->Receive(BufferB, &OnReceived, &ReceivedB);
+    }
+
+    static IsoTpConfig Swap(IsoTpConfig c)
+    {
+        std::swap(c.TxId, c.RxId);
+        return c;
+    }
+
+    // Runs both nodes and the bus until nothing moves anymore. Fewer frames are put on the bus at
+    // once than the nodes can store between two runs.
+    void Step(uint32_t now)
+    {
+        do
+        {
+            NodeA->Run(now);
+            NodeB->Run(now);
+        } while (bus.Transfer(4) != 0);
+    }
+
+    CanLoopback              bus;
+    CanLoopback::Port*       A;
+    CanLoopback::Port*       B;
+    std::unique_ptr<IsoTp>   NodeA;
+    std::unique_ptr<IsoTp>   NodeB;
+    std::array<uint8_t, 512> BufferA   = {};
+    std::array<uint8_t, 512> BufferB   = {};
+    Result                   ReceivedA = {};
+    Result                   ReceivedB = {};
+    Result                   Sent      = {};
+};
+}    // namespace
+
+TEST(NilaiCanIsoTp, SingleFrame)
+{
+    Link                 link;
+    std::vector<uint8_t> msg = MakeMessage(7);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+
+    EXPECT_EQ(link.Sent.Calls, 1);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+    ASSERT_EQ(link.ReceivedB.Calls, 1);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+
+    ASSERT_EQ(link.A->Sent.size(), 1);
+    const TxFrame& f = link.A->Sent[0];
+    EXPECT_EQ(f.Id, 0x700);
+    EXPECT_EQ(f.Len, 8);
+    EXPECT_EQ(f.Data[0], 0x07);
+    EXPECT_EQ(f.Data[7], 7);
+}
+
+TEST(NilaiCanIsoTp, MultiFrame)
+{
+    Link                 link;
+    std::vector<uint8_t> msg = MakeMessage(100);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    EXPECT_FALSE(link.NodeA->Send(msg));
+    link.Step(0);
+
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+    ASSERT_EQ(link.ReceivedB.Calls, 1);
+    EXPECT_EQ(link.ReceivedB.Status, IsoTpStatus::Ok);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+    EXPECT_FALSE(link.NodeA->IsSending());
+    EXPECT_FALSE(link.NodeB->IsReceiving());
+
+    // First frame + 14 consecutive frames, a single flow control in return.
+    ASSERT_EQ(link.A->Sent.size(), 15);
+    EXPECT_EQ(link.A->Sent[0].Data[0], 0x10);
+    EXPECT_EQ(link.A->Sent[0].Data[1], 100);
+    for (size_t i = 1; i < 15; i++)
+    {
+        EXPECT_EQ(link.A->Sent[i].Data[0], 0x20 | (i & 0x0F));
+    }
+    ASSERT_EQ(link.B->Sent.size(), 1);
+    EXPECT_EQ(link.B->Sent[0].Data[0], 0x30);
+}
+
+TEST(NilaiCanIsoTp, BlockSize)
+{
+    Link                 link({.TxId = 0x700, .RxId = 0x708, .BlockSize = 4});
+    std::vector<uint8_t> msg = MakeMessage(300);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    ASSERT_TRUE(link.NodeB->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+
+    // Both ways at once.
+    EXPECT_EQ(link.Sent.Calls, 2);
+    EXPECT_EQ(link.ReceivedA.Data, msg);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+
+    // 300 bytes: 6 in the first frame, then 42 consecutive frames, in blocks of 4.
+    size_t flowControls = 0;
+    for (const TxFrame& f : link.B->Sent)
+    {
+        if ((f.Data[0] & 0xF0) == 0x30)
+        {
+            flowControls++;
+            EXPECT_EQ(f.Data[1], 4);
+        }
+    }
+    EXPECT_EQ(flowControls, 11);
+    EXPECT_EQ(link.NodeA->DroppedFrames(), 0);
+    EXPECT_EQ(link.NodeB->DroppedFrames(), 0);
+}
+
+TEST(NilaiCanIsoTp, SeparationTime)
+{
+    Link                 link({.TxId = 0x700, .RxId = 0x708, .StMin = 5});
+    std::vector<uint8_t> msg = MakeMessage(30);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+
+    // First frame, flow control and the first consecutive frame.
+    link.Step(100);
+    EXPECT_EQ(link.A->Sent.size(), 2);
+    // The tick being 1 ms, waiting only 5 ticks could be less than 5 ms.
+    link.Step(105);
+    EXPECT_EQ(link.A->Sent.size(), 2);
+    link.Step(106);
+    EXPECT_EQ(link.A->Sent.size(), 3);
+    link.Step(112);
+    link.Step(118);
+    EXPECT_EQ(link.A->Sent.size(), 5);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+}
+
+TEST(NilaiCanIsoTp, SeparationTimeIsNeverShorterThanStMin)
+{
+    for (uint8_t stMin : {1, 2, 5})
+    {
+        Link                 link({.TxId = 0x700, .RxId = 0x708, .StMin = stMin});
+        std::vector<uint8_t> msg = MakeMessage(60);
+        ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+
+        // Runs every 100 us with a millisecond tick, noting when each consecutive frame leaves.
+        // The transfer starts late in a tick.
+        std::vector<uint32_t> sentAt;
+        for (uint32_t us = 700; us < 100000 && link.Sent.Calls == 0; us += 100)
+        {
+            size_t before = link.A->Sent.size();
+            link.Step(us / 1000);
+            for (size_t i = before; i < link.A->Sent.size(); i++)
+            {
+                if ((link.A->Sent[i].Data[0] & 0xF0) == 0x20)
+                {
+                    sentAt.push_back(us);
+                }
+            }
+        }
+        ASSERT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+        ASSERT_EQ(sentAt.size(), 8);
+
+        uint32_t minGap = UINT32_MAX;
+        for (size_t i = 1; i < sentAt.size(); i++)
+        {
+            minGap = std::min(minGap, sentAt[i] - sentAt[i - 1]);
+        }
+        EXPECT_GE(minGap, stMin * 1000u) << "STmin " << static_cast<int>(stMin);
+    }
+}
+
+TEST(NilaiCanIsoTp, PacedByTxQueue)
+{
+    // Only 2 frames fit in the transmit queue at once.
+    Link                 link({.TxId = 0x700, .RxId = 0x708}, 2);
+    std::vector<uint8_t> msg = MakeMessage(200);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    for (int i = 0; i < 40 && link.NodeA->IsSending(); i++)
+    {
+        link.NodeA->Run(0);
+        link.NodeB->Run(0);
+        link.bus.Transfer(1);
+    }
+    link.Step(0);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+}
+
+TEST(NilaiCanIsoTp, LargestMessage)
+{
+    Link                 link;
+    std::vector<uint8_t> big(IsoTp::s_maxLen + 1);
+    EXPECT_FALSE(link.NodeA->Send(big));
+    EXPECT_FALSE(link.NodeA->Send({}));
+
+    std::vector<uint8_t> buffer(IsoTp::s_maxLen);
+    link.NodeB->Receive(buffer, &OnReceived, &link.ReceivedB);
+    std::vector<uint8_t> msg = MakeMessage(IsoTp::s_maxLen);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+}
+
+TEST(NilaiCanIsoTp, ReceiverOverflow)
+{
+    Link                 link;
+    std::array<uint8_t, 16> small = {};
+    link.NodeB->Receive(small, &OnReceived, &link.ReceivedB);
+
+    std::vector<uint8_t> msg = MakeMessage(17);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Overflow);
+    EXPECT_EQ(link.ReceivedB.Status, IsoTpStatus::Overflow);
+    EXPECT_TRUE(link.ReceivedB.Data.empty());
+    EXPECT_EQ(link.B->Sent[0].Data[0], 0x32);
+
+    // The buffer fits the next one.
+    msg = MakeMessage(16);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+}
+
+TEST(NilaiCanIsoTp, Timeouts)
+{
+    Link link;
+    link.NodeB->StopReceiving();
+
+    // Nobody answers the first frame.
+    std::vector<uint8_t> msg = MakeMessage(20);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+    EXPECT_TRUE(link.NodeA->IsSending());
+    link.Step(999);
+    EXPECT_EQ(link.Sent.Calls, 0);
+    link.Step(1000);
+    EXPECT_EQ(link.Sent.Calls, 1);
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Timeout);
+
+    // The receiver gives up when the consecutive frames stop.
+    Link       rx;
+    IsoTpConfig cfg = Link::Swap({.TxId = 0x700, .RxId = 0x708});
+    Frame       ff {};
+    ff.frame.StdId = cfg.RxId;
+    ff.frame.DLC   = 8;
+    ff.data        = {0x10, 20, 1, 2, 3, 4, 5, 6};
+    rx.NodeB->OnFrame(ff);
+    rx.NodeB->Run(50);
+    EXPECT_TRUE(rx.NodeB->IsReceiving());
+    rx.NodeB->Run(1050);
+    EXPECT_FALSE(rx.NodeB->IsReceiving());
+    EXPECT_EQ(rx.ReceivedB.Status, IsoTpStatus::Timeout);
+}
+
+TEST(NilaiCanIsoTp, LostFrame)
+{
+    Link                 link;
+    std::vector<uint8_t> msg = MakeMessage(40);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+
+    // First frame and flow control.
+    link.NodeA->Run(0);
+    link.bus.Transfer(1);
+    link.NodeB->Run(0);
+    link.bus.Transfer(1);
+    link.NodeA->Run(0);
+    // The first consecutive frame is lost.
+    link.bus.DropNext = true;
+    link.Step(0);
+
+    EXPECT_EQ(link.ReceivedB.Calls, 1);
+    EXPECT_EQ(link.ReceivedB.Status, IsoTpStatus::WrongSequence);
+    // The sender doesn't know about it.
+    EXPECT_EQ(link.Sent.Status, IsoTpStatus::Ok);
+}
+
+TEST(NilaiCanIsoTp, IgnoresOtherIds)
+{
+    Link  link;
+    Frame f {};
+    f.frame.StdId = 0x123;
+    f.frame.DLC   = 8;
+    f.data        = {0x03, 1, 2, 3};
+    link.NodeB->OnFrame(f);
+    link.NodeB->Run(0);
+    EXPECT_EQ(link.ReceivedB.Calls, 0);
+
+    // Same identifier, but extended.
+    f.frame.StdId = 0;
+    f.frame.ExtId = 0x700;
+    f.frame.IDE   = static_cast<uint32_t>(IdentifierType::Extended);
+    link.NodeB->OnFrame(f);
+    link.NodeB->Run(0);
+    EXPECT_EQ(link.ReceivedB.Calls, 0);
+}
+
+TEST(NilaiCanIsoTp, ExtendedWithoutPadding)
+{
+    Link link({.TxId = 0x18DA00F1, .RxId = 0x18DAF100, .Extended = true, .Padding = false});
+    std::vector<uint8_t> msg = MakeMessage(10);
+    ASSERT_TRUE(link.NodeA->Send(msg, &OnSent, &link.Sent));
+    link.Step(0);
+    EXPECT_EQ(link.ReceivedB.Data, msg);
+    ASSERT_EQ(link.A->Sent.size(), 2);
+    EXPECT_TRUE(link.A->Sent[0].Extended);
+    EXPECT_EQ(link.A->Sent[1].Len, 5);
+    EXPECT_EQ(link.B->Sent[0].Len, 3);
+}
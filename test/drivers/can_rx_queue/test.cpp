@@ -0,0 +1,142 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/CAN/rx_queue.h"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+using namespace Nilai::Can;
+
+namespace
+{
+using Queue = RxQueue<4>;
+
+Frame MakeFrame(uint32_t id, uint32_t timestamp = 0)
+{
+    Frame f {};
+    f.frame.StdId = id;
+    f.frame.DLC   = 1;
+    f.data[0]     = static_cast<uint8_t>(id);
+    f.timestamp   = timestamp;
+    return f;
+}
+}    // namespace
+
+TEST(NilaiCanRxQueue, InOrder)
+{
+    Queue q;
+    EXPECT_FALSE(q.Pop().has_value());
+
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        ASSERT_TRUE(q.Push(RxFifo::Fifo0, MakeFrame(i, i * 10)));
+    }
+    EXPECT_EQ(q.Size(), 3);
+
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        auto f = q.Pop();
+        ASSERT_TRUE(f.has_value());
+        EXPECT_EQ(f->frame.StdId, i);
+        EXPECT_EQ(f->timestamp, i * 10);
+    }
+    EXPECT_EQ(q.Stats(RxFifo::Fifo0).Received, 3);
+}
+
+TEST(NilaiCanRxQueue, SeparateFifos)
+{
+    Queue q;
+    q.Push(RxFifo::Fifo1, MakeFrame(10));
+    q.Push(RxFifo::Fifo0, MakeFrame(1));
+    q.Push(RxFifo::Fifo1, MakeFrame(11));
+    q.Push(RxFifo::Fifo0, MakeFrame(2));
+    EXPECT_EQ(q.Size(RxFifo::Fifo0), 2);
+    EXPECT_EQ(q.Size(RxFifo::Fifo1), 2);
+
+    std::array<Frame, 8> out = {};
+    ASSERT_EQ(q.PopMany(std::span(out).first(1), RxFifo::Fifo1), 1);
+    EXPECT_EQ(out[0].frame.StdId, 10);
+
+    // FIFO 0 is drained first.
+    ASSERT_EQ(q.PopMany(out), 3);
+    EXPECT_EQ(out[0].frame.StdId, 1);
+    EXPECT_EQ(out[1].frame.StdId, 2);
+    EXPECT_EQ(out[2].frame.StdId, 11);
+    EXPECT_EQ(q.Size(), 0);
+}
+
+TEST(NilaiCanRxQueue, CountsDrops)
+{
+    Queue q;
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        q.Push(RxFifo::Fifo0, MakeFrame(i));
+    }
+    q.OnOverrun(RxFifo::Fifo0);
+    q.OnOverrun(RxFifo::Fifo1);
+
+    RxStats stats = q.Stats(RxFifo::Fifo0);
+    EXPECT_EQ(stats.Received, 4);
+    EXPECT_EQ(stats.RingFull, 2);
+    EXPECT_EQ(stats.Overruns, 1);
+    EXPECT_EQ(q.Stats(RxFifo::Fifo1).Overruns, 1);
+
+    // The oldest frames are kept.
+    std::array<Frame, 8> out = {};
+    ASSERT_EQ(q.PopMany(out, RxFifo::Fifo0), 4);
+    EXPECT_EQ(out[0].frame.StdId, 0);
+    EXPECT_EQ(out[3].frame.StdId, 3);
+}
+
+TEST(NilaiCanRxQueue, ConcurrentProducer)
+{
+    static constexpr uint32_t s_count = 100000;
+
+    RxQueue<64>           q;
+    std::atomic<uint32_t> pushed = 0;
+    std::thread           producer(
+      [&]
+      {
+          for (uint32_t i = 0; i < s_count; i++)
+          {
+              while (!q.Push(RxFifo::Fifo0, MakeFrame(i)))
+              {
+                  std::this_thread::yield();
+              }
+          }
+          pushed = s_count;
+      });
+
+    std::array<Frame, 16> out      = {};
+    uint32_t              expected = 0;
+    while (expected < s_count)
+    {
+        size_t n = q.PopMany(out);
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < n; i++)
+        {
+            ASSERT_EQ(out[i].frame.StdId, expected++);
+        }
+    }
+    producer.join();
+    EXPECT_EQ(pushed, s_count);
+}
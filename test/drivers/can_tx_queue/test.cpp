@@ -0,0 +1,157 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/CAN/tx_queue.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace Nilai::Can;
+
+namespace
+{
+TxFrame MakeFrame(uint32_t id, uint8_t tag = 0, bool extended = false)
+{
+    return TxFrame(id, &tag, 1, extended);
+}
+}    // namespace
+
+TEST(NilaiCanTxQueue, Frame)
+{
+    uint8_t data[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    TxFrame f(0x123, data, sizeof(data), false);
+    EXPECT_FALSE(f.Extended);
+    EXPECT_EQ(f.Len, 8);
+    EXPECT_EQ(f.Data[7], 8);
+
+    EXPECT_TRUE(TxFrame(0x800, nullptr, 0, false).Extended);
+    EXPECT_TRUE(TxFrame(0x12, nullptr, 0, true).Extended);
+    EXPECT_EQ(TxFrame(0x12, nullptr, 0, false).Len, 0);
+}
+
+TEST(NilaiCanTxQueue, ArbitrationPriority)
+{
+    // Lower identifiers win.
+    EXPECT_LT(MakeFrame(0x100).Priority(), MakeFrame(0x101).Priority());
+    // A standard frame wins against an extended frame with the same base identifier.
+    TxFrame ext = MakeFrame(0x100 << 18, 0, true);
+    EXPECT_LT(MakeFrame(0x100).Priority(), ext.Priority());
+    EXPECT_LT(ext.Priority(), MakeFrame(0x101).Priority());
+    // The base identifier is decided before the extension bits.
+    EXPECT_LT(MakeFrame((0x100 << 18) | 0x3FFFF, 0, true).Priority(), MakeFrame(0x101).Priority());
+}
+
+TEST(NilaiCanTxQueue, HighestPriorityFirst)
+{
+    TxQueue<8> q;
+    EXPECT_EQ(q.Top(), nullptr);
+    EXPECT_FALSE(q.Pop().has_value());
+
+    q.Push(MakeFrame(0x500));
+    q.Push(MakeFrame(0x010));
+    q.Push(MakeFrame(0x7FF));
+    q.Push(MakeFrame(0x100));
+    ASSERT_NE(q.Top(), nullptr);
+    EXPECT_EQ(q.Top()->Id, 0x010);
+
+    std::vector<uint32_t> ids;
+    while (auto f = q.Pop())
+    {
+        ids.push_back(f->Id);
+    }
+    EXPECT_EQ(ids, (std::vector<uint32_t> {0x010, 0x100, 0x500, 0x7FF}));
+}
+
+TEST(NilaiCanTxQueue, SamePriorityInOrder)
+{
+    TxQueue<16> q;
+    for (uint8_t i = 0; i < 6; i++)
+    {
+        q.Push(MakeFrame(0x700, i));
+        q.Push(MakeFrame(0x200, i));
+    }
+
+    for (uint32_t id : {0x200, 0x700})
+    {
+        for (uint8_t i = 0; i < 6; i++)
+        {
+            auto f = q.Pop();
+            ASSERT_TRUE(f.has_value());
+            EXPECT_EQ(f->Id, id);
+            EXPECT_EQ(f->Data[0], i);
+        }
+    }
+}
+
+TEST(NilaiCanTxQueue, RejectsWhenFull)
+{
+    TxQueue<2> q;
+    EXPECT_TRUE(q.Push(MakeFrame(1)));
+    EXPECT_TRUE(q.Push(MakeFrame(2)));
+    EXPECT_FALSE(q.Push(MakeFrame(0)));
+
+    q.OnSent();
+    q.OnAborted();
+    TxStats stats = q.Stats();
+    EXPECT_EQ(stats.Depth, 2);
+    EXPECT_EQ(stats.HighWaterMark, 2);
+    EXPECT_EQ(stats.Rejected, 1);
+    EXPECT_EQ(stats.Sent, 1);
+    EXPECT_EQ(stats.Aborted, 1);
+
+    q.Clear();
+    EXPECT_TRUE(q.Empty());
+}
+
+TEST(NilaiCanTxQueue, MatchesStableSort)
+{
+    struct Ref
+    {
+        uint32_t Priority;
+        uint32_t Id;
+        uint8_t  Tag;
+    };
+
+    std::mt19937                            rng(7);
+    std::uniform_int_distribution<uint32_t> id(0, 15);
+    std::uniform_int_distribution<int>      count(0, 5);
+
+    TxQueue<64>      q;
+    std::vector<Ref> ref;
+    uint8_t          tag = 0;
+    for (int round = 0; round < 200; round++)
+    {
+        // Interleaves pushes and pops, like the main loop and the mailbox interrupts.
+        for (int i = count(rng); i > 0 && q.Size() < 64; i--)
+        {
+            TxFrame f = MakeFrame(id(rng), tag++);
+            q.Push(f);
+            ref.push_back({f.Priority(), f.Id, f.Data[0]});
+        }
+        std::stable_sort(ref.begin(), ref.end(), [](const Ref& a, const Ref& b)
+                         { return a.Priority < b.Priority; });
+        for (int i = count(rng); i > 0 && !ref.empty(); i--)
+        {
+            auto f = q.Pop();
+            ASSERT_TRUE(f.has_value());
+            EXPECT_EQ(f->Id, ref.front().Id);
+            EXPECT_EQ(f->Data[0], ref.front().Tag);
+            ref.erase(ref.begin());
+        }
+    }
+}
@@ -0,0 +1,325 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/I2C/job_queue.h"
+#include "drivers/I2C/write_batch.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Nilai;
+using namespace Nilai::Drivers::I2c;
+
+namespace
+{
+using Queue = JobQueue<3>;
+
+// Stands in for the DMA: records what is put on the bus.
+struct Bus
+{
+    struct Transfer
+    {
+        uint8_t              Address;
+        int                  Register;
+        JobStep              Step;
+        std::vector<uint8_t> Data;
+    };
+
+    static bool Start(void* ctx, const Job& job, JobStep step)
+    {
+        auto* bus = static_cast<Bus*>(ctx);
+        if (bus->Fail)
+        {
+            return false;
+        }
+        Transfer t {job.Address, job.UseRegister ? job.Register : -1, step, {}};
+        if (step == JobStep::Write)
+        {
+            t.Data.assign(job.Tx.begin(), job.Tx.end());
+        }
+        bus->Transfers.push_back(t);
+        return true;
+    }
+
+    std::vector<Transfer> Transfers;
+    bool                  Fail = false;
+};
+
+void Record(const Job& job, bool ok, void* ctx)
+{
+    static_cast<std::vector<std::pair<uint8_t, bool>>*>(ctx)->push_back({job.Address, ok});
+}
+}    // namespace
+
+TEST(NilaiI2cJobQueue, RegisterJobs)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[2] = {1, 2};
+    uint8_t rx[4] = {};
+
+    std::vector<std::pair<uint8_t, bool>> done;
+    ASSERT_TRUE(q.Submit(Job::WriteRegister(0x40, 0x10, tx, &Record, &done)));
+    ASSERT_TRUE(q.Submit(Job::ReadRegister(0x42, 0x20, rx, &Record, &done)));
+    ASSERT_EQ(bus.Transfers.size(), 1);
+    EXPECT_EQ(bus.Transfers[0].Register, 0x10);
+    EXPECT_EQ(bus.Transfers[0].Step, JobStep::Write);
+    EXPECT_EQ(bus.Transfers[0].Data, std::vector<uint8_t>({1, 2}));
+
+    q.OnComplete(true);
+    ASSERT_EQ(bus.Transfers.size(), 2);
+    EXPECT_EQ(bus.Transfers[1].Address, 0x42);
+    EXPECT_EQ(bus.Transfers[1].Register, 0x20);
+    EXPECT_EQ(bus.Transfers[1].Step, JobStep::Read);
+    q.OnComplete(false);
+
+    ASSERT_EQ(done.size(), 2);
+    EXPECT_TRUE(done[0].second);
+    EXPECT_FALSE(done[1].second);
+    EXPECT_FALSE(q.Busy());
+    EXPECT_EQ(q.Stats().Completed, 1);
+    EXPECT_EQ(q.Stats().Failed, 1);
+
+    // Spurious completions are ignored.
+    q.OnComplete(true);
+    EXPECT_EQ(done.size(), 2);
+}
+
+TEST(NilaiI2cJobQueue, WriteThenRead)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t cmd[1] = {0xE3};
+    uint8_t rx[2]  = {};
+
+    std::vector<std::pair<uint8_t, bool>> done;
+    ASSERT_TRUE(q.Submit(Job::WriteRead(0x80, cmd, rx, &Record, &done)));
+    ASSERT_EQ(bus.Transfers.size(), 1);
+    EXPECT_EQ(bus.Transfers[0].Step, JobStep::Write);
+    EXPECT_EQ(bus.Transfers[0].Register, -1);
+
+    // The read follows the write, as part of the same job.
+    q.OnComplete(true);
+    ASSERT_EQ(bus.Transfers.size(), 2);
+    EXPECT_EQ(bus.Transfers[1].Step, JobStep::Read);
+    EXPECT_TRUE(done.empty());
+    q.OnComplete(true);
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_TRUE(done[0].second);
+
+    // A failed write skips the read.
+    ASSERT_TRUE(q.Submit(Job::WriteRead(0x80, cmd, rx, &Record, &done)));
+    q.OnComplete(false);
+    EXPECT_EQ(bus.Transfers.size(), 3);
+    ASSERT_EQ(done.size(), 2);
+    EXPECT_FALSE(done[1].second);
+
+    // Read only.
+    ASSERT_TRUE(q.Submit(Job::WriteRead(0x80, {}, rx)));
+    EXPECT_EQ(bus.Transfers.back().Step, JobStep::Read);
+}
+
+TEST(NilaiI2cJobQueue, RejectsInvalid)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[2] = {};
+    uint8_t rx[3] = {};
+
+    EXPECT_FALSE(q.Submit(Job {}));
+    EXPECT_FALSE(q.Submit(Job::WriteRegister(0x40, 0, {})));
+    EXPECT_FALSE(q.Submit(Job {.Address = 0x40, .UseRegister = true, .Tx = tx, .Rx = rx}));
+
+    // A group is queued whole or not at all.
+    Job jobs[4] = {Job::WriteRead(0x40, tx, {}),
+                   Job::WriteRead(0x40, tx, {}),
+                   Job::WriteRead(0x40, tx, {}),
+                   Job::WriteRead(0x40, tx, {})};
+    EXPECT_FALSE(q.Submit(jobs));
+    jobs[1] = {};
+    EXPECT_FALSE(q.Submit(std::span<const Job> {jobs, 3}));
+    EXPECT_TRUE(bus.Transfers.empty());
+    EXPECT_EQ(q.Stats().Rejected, 5);
+}
+
+TEST(NilaiI2cJobQueue, FailsWhatCantStart)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[2] = {};
+
+    std::vector<std::pair<uint8_t, bool>> done;
+    bus.Fail = true;
+    EXPECT_TRUE(q.Submit(Job::WriteRegister(0x40, 0, tx, &Record, &done)));
+    EXPECT_FALSE(q.Busy());
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_FALSE(done[0].second);
+    EXPECT_EQ(q.Stats().Failed, 1);
+}
+
+TEST(NilaiI2cJobQueue, CallbackOfAFailedJobCanSubmit)
+{
+    struct Retry
+    {
+        Queue*  Q;
+        Bus*    B;
+        uint8_t Buff[2] = {};
+        int     Calls   = 0;
+
+        static void Again(const Job&, bool ok, void* ctx)
+        {
+            auto* self = static_cast<Retry*>(ctx);
+            self->Calls++;
+            if (!ok)
+            {
+                // The bus is back, the job is queued again.
+                self->B->Fail = false;
+                EXPECT_TRUE(self->Q->Submit(Job::ReadRegister(0x40, 0, self->Buff, &Again, self)));
+            }
+        }
+    };
+
+    Bus   bus;
+    Queue q(&Bus::Start, &bus);
+    Retry retry {&q, &bus};
+    bus.Fail = true;
+    ASSERT_TRUE(q.Submit(Job::ReadRegister(0x40, 0, retry.Buff, &Retry::Again, &retry)));
+    // The second attempt is on the bus.
+    EXPECT_TRUE(q.Busy());
+    EXPECT_EQ(bus.Transfers.size(), 1);
+    q.OnComplete(true);
+    EXPECT_FALSE(q.Busy());
+    EXPECT_EQ(retry.Calls, 2);
+    EXPECT_EQ(q.Stats().Failed, 1);
+    EXPECT_EQ(q.Stats().Completed, 1);
+}
+
+TEST(NilaiI2cJobQueue, CallbackCanSubmit)
+{
+    struct Poller
+    {
+        Queue*  Q;
+        uint8_t Buff[2] = {};
+        int     Left    = 3;
+
+        static void Again(const Job&, bool, void* ctx)
+        {
+            auto* self = static_cast<Poller*>(ctx);
+            if (--self->Left > 0)
+            {
+                self->Q->Submit(Job::ReadRegister(0x40, 0, self->Buff, &Again, self));
+            }
+        }
+    };
+
+    Bus    bus;
+    Queue  q(&Bus::Start, &bus);
+    Poller poller {&q};
+    ASSERT_TRUE(q.Submit(Job::ReadRegister(0x40, 0, poller.Buff, &Poller::Again, &poller)));
+    while (q.Busy())
+    {
+        q.OnComplete(true);
+    }
+    EXPECT_EQ(bus.Transfers.size(), 3);
+    EXPECT_EQ(poller.Left, 0);
+}
+
+TEST(NilaiI2cWriteBatch, MergesAdjacentRegisters)
+{
+    WriteBatch<16, 3> batch;
+    uint8_t           coefs[3] = {7, 8, 9};
+    EXPECT_TRUE(batch.Add(0x54, 0x00, 1));
+    EXPECT_TRUE(batch.Add(0x54, 0x01, 2));
+    EXPECT_TRUE(batch.Add(0x54, 0x02, coefs));
+    // Another device.
+    EXPECT_TRUE(batch.Add(0x56, 0x05, 3));
+    // A gap in the registers.
+    EXPECT_TRUE(batch.Add(0x56, 0x07, 4));
+    EXPECT_TRUE(batch.Add(0x56, 0x08, 5));
+    // No burst left, but this one is merged.
+    EXPECT_TRUE(batch.Add(0x56, 0x09, 6));
+    EXPECT_FALSE(batch.Add(0x54, 0x00, 1));
+    EXPECT_EQ(batch.Size(), 9);
+
+    ASSERT_EQ(batch.Jobs().size(), 3);
+    Bus   bus;
+    Queue q(&Bus::Start, &bus);
+    ASSERT_TRUE(batch.Submit(q));
+    while (q.Busy())
+    {
+        q.OnComplete(true);
+    }
+    ASSERT_EQ(bus.Transfers.size(), 3);
+    EXPECT_EQ(bus.Transfers[0].Address, 0x54);
+    EXPECT_EQ(bus.Transfers[0].Register, 0x00);
+    EXPECT_EQ(bus.Transfers[0].Data, std::vector<uint8_t>({1, 2, 7, 8, 9}));
+    EXPECT_EQ(bus.Transfers[1].Data, std::vector<uint8_t>({3}));
+    EXPECT_EQ(bus.Transfers[2].Register, 0x07);
+    EXPECT_EQ(bus.Transfers[2].Data, std::vector<uint8_t>({4, 5, 6}));
+}
+
+TEST(NilaiI2cWriteBatch, CompletesOnce)
+{
+    struct Result
+    {
+        int  Calls = 0;
+        bool Ok    = false;
+
+        static void Done(bool ok, void* ctx)
+        {
+            auto* r = static_cast<Result*>(ctx);
+            r->Calls++;
+            r->Ok = ok;
+        }
+    };
+
+    WriteBatch<8, 2> batch;
+    Bus              bus;
+    Queue            q(&Bus::Start, &bus);
+    Result           result;
+    EXPECT_FALSE(batch.Submit(q, &Result::Done, &result));
+    batch.Add(0x54, 0x10, 1);
+    batch.Add(0x54, 0x20, 2);
+
+    ASSERT_TRUE(batch.Submit(q, &Result::Done, &result));
+    EXPECT_TRUE(batch.IsPending());
+    EXPECT_FALSE(batch.Add(0x54, 0x21, 3));
+    EXPECT_FALSE(batch.Submit(q));
+    q.OnComplete(true);
+    EXPECT_EQ(result.Calls, 0);
+    q.OnComplete(false);
+    EXPECT_EQ(result.Calls, 1);
+    EXPECT_FALSE(result.Ok);
+    EXPECT_FALSE(batch.IsPending());
+
+    // Sent again as is.
+    ASSERT_TRUE(batch.Submit(q, &Result::Done, &result));
+    q.OnComplete(true);
+    q.OnComplete(true);
+    EXPECT_EQ(result.Calls, 2);
+    EXPECT_TRUE(result.Ok);
+    EXPECT_EQ(bus.Transfers.size(), 4);
+
+    // Doesn't fit in the queue with another job in it.
+    uint8_t rx[1] = {};
+    q.Submit(Job::ReadRegister(0x54, 0, rx));
+    q.Submit(Job::ReadRegister(0x54, 0, rx));
+    EXPECT_FALSE(batch.Submit(q, &Result::Done, &result));
+    EXPECT_FALSE(batch.IsPending());
+
+    batch.Clear();
+    EXPECT_TRUE(batch.Jobs().empty());
+}
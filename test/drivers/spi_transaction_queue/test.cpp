@@ -0,0 +1,246 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/SPI/transaction_queue.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Nilai;
+using namespace Nilai::Drivers::Spi;
+
+namespace
+{
+using Queue = TransactionQueue<3>;
+
+bool CsLow(const Pin& cs)
+{
+    return cs.port->NILAI_GPIO_BSRR_REG == (static_cast<uint32_t>(cs.pin) << 16);
+}
+
+// Stands in for the DMA: records what is put on the bus.
+struct Bus
+{
+    struct Transfer
+    {
+        size_t Size;
+        bool   CsLow;
+    };
+
+    static bool Start(void* ctx, const Transaction& t)
+    {
+        auto* bus = static_cast<Bus*>(ctx);
+        if (bus->Fail)
+        {
+            return false;
+        }
+        bus->Transfers.push_back({t.Size(), t.Cs.IsDefault() || CsLow(t.Cs)});
+        return true;
+    }
+
+    std::vector<Transfer> Transfers;
+    bool                  Fail = false;
+};
+
+struct Completion
+{
+    size_t Size;
+    bool   Ok;
+};
+
+void Record(const Transaction& t, bool ok, void* ctx)
+{
+    static_cast<std::vector<Completion>*>(ctx)->push_back({t.Size(), ok});
+}
+}    // namespace
+
+TEST(NilaiSpiTransactionQueue, StartsRightAway)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[4] = {1, 2, 3, 4};
+    uint8_t rx[4] = {};
+    Pin     cs(&GPIOA, 0x0010);
+
+    std::vector<Completion> done;
+    ASSERT_TRUE(q.Submit({tx, rx, cs, false, &Record, &done}));
+    ASSERT_EQ(bus.Transfers.size(), 1);
+    EXPECT_EQ(bus.Transfers[0].Size, 4);
+    EXPECT_TRUE(bus.Transfers[0].CsLow);
+    EXPECT_TRUE(q.Busy());
+    EXPECT_TRUE(done.empty());
+
+    q.OnComplete(true);
+    EXPECT_FALSE(q.Busy());
+    EXPECT_FALSE(CsLow(cs));
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_TRUE(done[0].Ok);
+    EXPECT_EQ(q.Stats().Completed, 1);
+}
+
+TEST(NilaiSpiTransactionQueue, ChainsInOrder)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t a[1] = {};
+    uint8_t b[2] = {};
+    uint8_t c[3] = {};
+
+    std::vector<Completion> done;
+    ASSERT_TRUE(q.Submit({.Tx = a, .Cb = &Record, .Ctx = &done}));
+    ASSERT_TRUE(q.Submit({.Rx = b, .Cb = &Record, .Ctx = &done}));
+    ASSERT_TRUE(q.Submit({.Tx = c, .Cb = &Record, .Ctx = &done}));
+    // Only the first one is on the bus.
+    EXPECT_EQ(bus.Transfers.size(), 1);
+    EXPECT_FALSE(q.Submit({.Tx = a}));
+    EXPECT_EQ(q.Stats().Rejected, 1);
+    EXPECT_EQ(q.Stats().HighWaterMark, 3);
+
+    q.OnComplete(true);
+    EXPECT_EQ(bus.Transfers.size(), 2);
+    q.OnComplete(true);
+    q.OnComplete(true);
+    ASSERT_EQ(bus.Transfers.size(), 3);
+    EXPECT_EQ(bus.Transfers[1].Size, 2);
+    EXPECT_EQ(bus.Transfers[2].Size, 3);
+    ASSERT_EQ(done.size(), 3);
+    EXPECT_EQ(done[2].Size, 3);
+    EXPECT_FALSE(q.Busy());
+
+    // Spurious completions are ignored.
+    q.OnComplete(true);
+    EXPECT_EQ(done.size(), 3);
+}
+
+TEST(NilaiSpiTransactionQueue, RejectsInvalid)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[2] = {};
+    uint8_t rx[3] = {};
+
+    EXPECT_FALSE(q.Submit({}));
+    EXPECT_FALSE(q.Submit({.Tx = tx, .Rx = rx}));
+    EXPECT_TRUE(bus.Transfers.empty());
+    EXPECT_EQ(q.Stats().Rejected, 2);
+}
+
+TEST(NilaiSpiTransactionQueue, KeepsCsAcrossAFrame)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t cmd[1]  = {};
+    uint8_t data[4] = {};
+    Pin     cs(&GPIOB, 0x0001);
+
+    ASSERT_TRUE(q.Submit({.Tx = cmd, .Cs = cs, .KeepCs = true}));
+    ASSERT_TRUE(q.Submit({.Rx = data, .Cs = cs}));
+    q.OnComplete(true);
+    EXPECT_TRUE(CsLow(cs));
+    q.OnComplete(true);
+    EXPECT_FALSE(CsLow(cs));
+    EXPECT_TRUE(bus.Transfers[1].CsLow);
+}
+
+TEST(NilaiSpiTransactionQueue, FailuresReleaseCs)
+{
+    Bus     bus;
+    Queue   q(&Bus::Start, &bus);
+    uint8_t tx[2] = {};
+    Pin     cs(&GPIOC, 0x0100);
+
+    std::vector<Completion> done;
+    ASSERT_TRUE(q.Submit({.Tx = tx, .Cs = cs, .KeepCs = true, .Cb = &Record, .Ctx = &done}));
+    q.OnComplete(false);
+    EXPECT_FALSE(CsLow(cs));
+    ASSERT_EQ(done.size(), 1);
+    EXPECT_FALSE(done[0].Ok);
+
+    // A transfer that can't be started fails right away.
+    bus.Fail = true;
+    EXPECT_TRUE(q.Submit({.Tx = tx, .Cs = cs, .Cb = &Record, .Ctx = &done}));
+    EXPECT_FALSE(q.Busy());
+    EXPECT_FALSE(CsLow(cs));
+    EXPECT_EQ(done.size(), 2);
+    EXPECT_EQ(q.Stats().Failed, 2);
+}
+
+TEST(NilaiSpiTransactionQueue, CallbackOfAFailedTransactionCanSubmit)
+{
+    struct Retry
+    {
+        Queue*  Q;
+        Bus*    B;
+        uint8_t Buff[2] = {};
+        int     Calls   = 0;
+
+        static void Again(const Transaction&, bool ok, void* ctx)
+        {
+            auto* self = static_cast<Retry*>(ctx);
+            self->Calls++;
+            if (!ok)
+            {
+                // The bus is back, the transaction is queued again.
+                self->B->Fail = false;
+                EXPECT_TRUE(self->Q->Submit({.Rx = self->Buff, .Cb = &Again, .Ctx = self}));
+            }
+        }
+    };
+
+    Bus   bus;
+    Queue q(&Bus::Start, &bus);
+    Retry retry {&q, &bus};
+    bus.Fail = true;
+    ASSERT_TRUE(q.Submit({.Rx = retry.Buff, .Cb = &Retry::Again, .Ctx = &retry}));
+    // The second attempt is on the bus.
+    EXPECT_TRUE(q.Busy());
+    EXPECT_EQ(bus.Transfers.size(), 1);
+    q.OnComplete(true);
+    EXPECT_FALSE(q.Busy());
+    EXPECT_EQ(retry.Calls, 2);
+    EXPECT_EQ(q.Stats().Failed, 1);
+    EXPECT_EQ(q.Stats().Completed, 1);
+}
+
+TEST(NilaiSpiTransactionQueue, CallbackCanSubmit)
+{
+    struct Reader
+    {
+        Queue*  Q;
+        uint8_t Buff[2] = {};
+        int     Left    = 3;
+
+        static void Again(const Transaction&, bool, void* ctx)
+        {
+            auto* self = static_cast<Reader*>(ctx);
+            if (--self->Left > 0)
+            {
+                self->Q->Submit({.Rx = self->Buff, .Cb = &Again, .Ctx = self});
+            }
+        }
+    };
+
+    Bus    bus;
+    Queue  q(&Bus::Start, &bus);
+    Reader reader {&q};
+    ASSERT_TRUE(q.Submit({.Rx = reader.Buff, .Cb = &Reader::Again, .Ctx = &reader}));
+    while (q.Busy())
+    {
+        q.OnComplete(true);
+    }
+    EXPECT_EQ(bus.Transfers.size(), 3);
+    EXPECT_EQ(reader.Left, 0);
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/UART/frame_pool.h"
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace Nilai::Drivers::Uart;
+
+namespace
+{
+// Simulates the DMA writing a frame in the slot it was given.
+uint8_t* Receive(FramePool<16, 4>& pool, uint8_t* slot, const char* msg, uint32_t timestamp)
+{
+    size_t len = std::strlen(msg);
+    std::memcpy(slot, msg, len);
+    return pool.Commit(len, timestamp);
+}
+}    // namespace
+
+TEST(NilaiUartFramePool, Empty)
+{
+    FramePool<16, 4> pool;
+    EXPECT_EQ(pool.Available(), 0);
+    EXPECT_EQ(pool.Receiving(), nullptr);
+
+    FrameView view = pool.Pop();
+    EXPECT_FALSE(view);
+}
+
+TEST(NilaiUartFramePool, InOrder)
+{
+    FramePool<16, 4> pool;
+    uint8_t*         slot = pool.Acquire();
+    ASSERT_NE(slot, nullptr);
+
+    slot = Receive(pool, slot, "first", 1);
+    slot = Receive(pool, slot, "second", 2);
+    EXPECT_EQ(pool.Available(), 2);
+
+    FrameView a = pool.Pop();
+    ASSERT_TRUE(a);
+    EXPECT_EQ(a, "first");
+    EXPECT_EQ(a.Timestamp, 1);
+
+    FrameView b = pool.Pop();
+    ASSERT_TRUE(b);
+    EXPECT_EQ(b, "second");
+    EXPECT_EQ(b.Timestamp, 2);
+
+    pool.Release(a);
+    pool.Release(b);
+    EXPECT_FALSE(a);
+    EXPECT_EQ(pool.Available(), 0);
+    EXPECT_EQ(pool.DroppedFrames(), 0);
+}
+
+TEST(NilaiUartFramePool, EmptyCommitKeepsSlot)
+{
+    FramePool<16, 4> pool;
+    uint8_t*         slot = pool.Acquire();
+
+    EXPECT_EQ(pool.Commit(0, 0), slot);
+    EXPECT_EQ(pool.Available(), 0);
+}
+
+TEST(NilaiUartFramePool, DropsWhenFull)
+{
+    FramePool<16, 4> pool;
+    uint8_t*         slot = pool.Acquire();
+
+    // One slot is always kept for the DMA.
+    slot = Receive(pool, slot, "a", 0);
+    slot = Receive(pool, slot, "b", 0);
+    slot = Receive(pool, slot, "c", 0);
+    EXPECT_EQ(pool.Available(), 3);
+
+    uint8_t* same = Receive(pool, slot, "d", 0);
+    EXPECT_EQ(same, slot);
+    EXPECT_EQ(pool.Available(), 3);
+    EXPECT_EQ(pool.DroppedFrames(), 1);
+
+    // Releasing a frame makes room for the next one.
+    FrameView view = pool.Pop();
+    EXPECT_EQ(view, "a");
+    pool.Release(view);
+
+    slot = Receive(pool, slot, "e", 0);
+    EXPECT_NE(slot, same);
+    EXPECT_EQ(pool.Available(), 3);
+
+    for (const char* expected : {"b", "c", "e"})
+    {
+        FrameView v = pool.Pop();
+        EXPECT_EQ(v, expected);
+        pool.Release(v);
+    }
+}
+
+TEST(NilaiUartFramePool, ClampsLength)
+{
+    FramePool<16, 4> pool;
+    pool.Acquire();
+    pool.Commit(64, 0);
+
+    FrameView view = pool.Pop();
+    EXPECT_EQ(view.Len, 16);
+}
@@ -0,0 +1,204 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/UART/rx_ring.h"
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+using namespace Nilai::Drivers::Uart;
+
+namespace
+{
+using Ring = RxRing<16, 4>;
+
+/**
+ * Simulates the DMA writing in the ring, then raising the events the HAL would raise.
+ */
+class FakeDma
+{
+public:
+    explicit FakeDma(Ring& ring) : m_ring(ring) {}
+
+    void Write(std::string_view data)
+    {
+        for (char c : data)
+        {
+            m_ring.Data()[m_pos] = static_cast<uint8_t>(c);
+            m_pos                = (m_pos + 1) % Ring::s_size;
+            if (m_pos == Ring::s_size / 2)
+            {
+                m_ring.OnRxEvent(m_pos, false, 0);
+            }
+            else if (m_pos == 0)
+            {
+                m_ring.OnRxEvent(Ring::s_size, false, 0);
+            }
+        }
+    }
+
+    void Idle(uint32_t timestamp) { m_ring.OnRxEvent(m_pos, true, timestamp); }
+
+    //! Restarts the reception from the start of the ring, like after an error.
+    void Restart()
+    {
+        m_pos = 0;
+        m_ring.Resync();
+    }
+
+private:
+    Ring&  m_ring;
+    size_t m_pos = 0;
+};
+}    // namespace
+
+TEST(NilaiUartRxRing, Empty)
+{
+    Ring ring;
+    EXPECT_EQ(ring.Available(), 0);
+    EXPECT_FALSE(ring.Pop());
+}
+
+TEST(NilaiUartRxRing, IdleDelimitsFrames)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    dma.Write("hello");
+    dma.Idle(1);
+    dma.Write("world");
+    dma.Idle(2);
+    EXPECT_EQ(ring.Available(), 2);
+
+    RingFrameView a = ring.Pop();
+    EXPECT_EQ(a, "hello");
+    EXPECT_EQ(a.Timestamp, 1);
+    ring.Release(a);
+
+    RingFrameView b = ring.Pop();
+    EXPECT_EQ(b, "world");
+    EXPECT_EQ(b.Timestamp, 2);
+    ring.Release(b);
+    EXPECT_FALSE(b);
+}
+
+TEST(NilaiUartRxRing, HalfAndCompleteDontCloseFrames)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    // Goes past the half-transfer event without being cut.
+    dma.Write("0123456789");
+    EXPECT_EQ(ring.Available(), 0);
+    // Only the bytes up to the last event are known to the ring.
+    EXPECT_EQ(ring.Pending(), 8);
+
+    dma.Idle(0);
+    RingFrameView view = ring.Pop();
+    EXPECT_EQ(view, "0123456789");
+    ring.Release(view);
+}
+
+TEST(NilaiUartRxRing, FrameWrapsAround)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    dma.Write("0123456789");
+    dma.Idle(0);
+    RingFrameView first = ring.Pop();
+    ring.Release(first);
+
+    dma.Write("abcdefghij");
+    dma.Idle(0);
+    RingFrameView view = ring.Pop();
+    EXPECT_EQ(view.First.size(), 6);
+    EXPECT_EQ(view.Second.size(), 4);
+    EXPECT_EQ(view, "abcdefghij");
+
+    std::array<uint8_t, 16> buff = {};
+    ASSERT_EQ(view.CopyTo(buff.data(), buff.size()), 10);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(buff.data()), 10), "abcdefghij");
+    ring.Release(view);
+    EXPECT_EQ(ring.Overruns(), 0);
+}
+
+TEST(NilaiUartRxRing, DropsWhenNoDescriptorsLeft)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    for (std::string_view f : {"a", "b", "c", "d", "e"})
+    {
+        dma.Write(f);
+        dma.Idle(0);
+    }
+    EXPECT_EQ(ring.Available(), 4);
+    EXPECT_EQ(ring.DroppedFrames(), 1);
+}
+
+TEST(NilaiUartRxRing, DetectsOverrun)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    dma.Write("01234567");
+    dma.Idle(0);
+    // Not released, the DMA goes over it.
+    dma.Write("abcdefghij");
+    dma.Idle(0);
+
+    EXPECT_EQ(ring.Overruns(), 1);
+}
+
+TEST(NilaiUartRxRing, DroppedFramesArentOverruns)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    for (std::string_view f : {"a", "b", "c", "d", "e"})
+    {
+        dma.Write(f);
+        dma.Idle(0);
+    }
+    ASSERT_EQ(ring.DroppedFrames(), 1);
+    while (RingFrameView view = ring.Pop())
+    {
+        ring.Release(view);
+    }
+
+    // Everything was released, the whole ring can be written.
+    dma.Write("0123456789abcdef");
+    dma.Idle(0);
+    EXPECT_EQ(ring.Overruns(), 0);
+}
+
+TEST(NilaiUartRxRing, ResyncIsntAnOverrun)
+{
+    Ring    ring;
+    FakeDma dma {ring};
+
+    // Reception restarts in the middle of a frame, which is lost.
+    dma.Write("0123456789");
+    dma.Restart();
+    dma.Write("abcdefghij");
+    dma.Idle(0);
+
+    RingFrameView view = ring.Pop();
+    EXPECT_EQ(view, "abcdefghij");
+    ring.Release(view);
+    EXPECT_EQ(ring.Overruns(), 0);
+}
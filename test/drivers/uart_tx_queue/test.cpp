@@ -0,0 +1,163 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "drivers/UART/tx_queue.h"
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+using namespace Nilai::Drivers::Uart;
+
+namespace
+{
+using Queue = TxQueue<4, 16>;
+
+bool Push(Queue& q, std::string_view s)
+{
+    return q.Push(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+}
+
+std::string_view FrontStr(const Queue& q)
+{
+    const TxSegment* seg = q.Front();
+    return seg == nullptr ? std::string_view {}
+                          : std::string_view {reinterpret_cast<const char*>(seg->Data), seg->Len};
+}
+}    // namespace
+
+TEST(NilaiUartTxQueue, Empty)
+{
+    Queue q;
+    EXPECT_TRUE(q.Empty());
+    EXPECT_EQ(q.Front(), nullptr);
+    // Popping an empty queue does nothing.
+    q.Pop();
+    EXPECT_EQ(q.Size(), 0);
+}
+
+TEST(NilaiUartTxQueue, CopiesInOrder)
+{
+    Queue q;
+    std::string msg = "abc";
+    ASSERT_TRUE(Push(q, msg));
+    ASSERT_TRUE(Push(q, "defg"));
+    // The queue holds a copy.
+    msg = "xyz";
+
+    EXPECT_EQ(FrontStr(q), "abc");
+    q.Pop();
+    EXPECT_EQ(FrontStr(q), "defg");
+    q.Pop();
+    EXPECT_TRUE(q.Empty());
+}
+
+TEST(NilaiUartTxQueue, RejectsWhenFull)
+{
+    Queue q;
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(Push(q, "a"));
+    }
+    EXPECT_FALSE(Push(q, "b"));
+
+    // Copy buffer full.
+    Queue q2;
+    ASSERT_TRUE(Push(q2, "0123456789"));
+    EXPECT_FALSE(Push(q2, "0123456789"));
+    EXPECT_FALSE(Push(q2, "this is way too long"));
+
+    EXPECT_EQ(q.Stats().Rejected, 1);
+    EXPECT_EQ(q2.Stats().Rejected, 2);
+}
+
+TEST(NilaiUartTxQueue, SegmentsStayContiguous)
+{
+    Queue q;
+    ASSERT_TRUE(Push(q, "0123456789"));
+    q.Pop();
+
+    // Doesn't fit in the 6 bytes left before the end, goes back to the start of the buffer.
+    ASSERT_TRUE(Push(q, "abcdefgh"));
+    EXPECT_EQ(FrontStr(q), "abcdefgh");
+    q.Pop();
+    EXPECT_TRUE(Push(q, "0123456789"));
+}
+
+TEST(NilaiUartTxQueue, BorrowedCallsCallback)
+{
+    static constexpr uint8_t data[] = {1, 2, 3};
+    Queue                    q;
+    int                      calls = 0;
+
+    ASSERT_TRUE(q.PushBorrowed(
+      data,
+      sizeof(data),
+      [](const uint8_t* d, size_t len, void* ctx)
+      {
+          EXPECT_EQ(d, data);
+          EXPECT_EQ(len, sizeof(data));
+          (*static_cast<int*>(ctx))++;
+      },
+      &calls));
+    // Not copied.
+    EXPECT_EQ(q.Front()->Data, data);
+    EXPECT_EQ(calls, 0);
+    q.Pop();
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(q.Stats().PoolHighWaterMark, 0);
+}
+
+TEST(NilaiUartTxQueue, ScatterGatherIsAllOrNothing)
+{
+    const uint8_t header[]  = {'h', 'd'};
+    const uint8_t payload[] = {'p', 'a', 'y'};
+
+    Queue                          q;
+    std::span<const uint8_t>       parts[] = {header, payload};
+    ASSERT_TRUE(q.Push(std::span<const std::span<const uint8_t>> {parts}));
+    EXPECT_EQ(q.Size(), 2);
+    EXPECT_EQ(FrontStr(q), "hd");
+    q.Pop();
+    EXPECT_EQ(FrontStr(q), "pay");
+    q.Pop();
+
+    // Enough segments, but not enough bytes for the last one.
+    const uint8_t            big[12] = {};
+    std::span<const uint8_t> tooBig[] = {header, big, payload};
+    EXPECT_FALSE(q.Push(std::span<const std::span<const uint8_t>> {tooBig}));
+    EXPECT_TRUE(q.Empty());
+    // Nothing was allocated by the failed push.
+    EXPECT_TRUE(Push(q, "0123456789abcdef"));
+}
+
+TEST(NilaiUartTxQueue, Stats)
+{
+    Queue q;
+    Push(q, "abc");
+    Push(q, "de");
+    q.Pop();
+    Push(q, "f");
+
+    TxQueueStats stats = q.Stats();
+    EXPECT_EQ(stats.Depth, 2);
+    EXPECT_EQ(stats.HighWaterMark, 2);
+    EXPECT_EQ(stats.PoolHighWaterMark, 5);
+    EXPECT_EQ(stats.Rejected, 0);
+
+    q.ResetStats();
+    EXPECT_EQ(q.Stats().HighWaterMark, 0);
+    EXPECT_EQ(q.Stats().Depth, 2);
+}
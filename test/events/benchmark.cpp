@@ -0,0 +1,162 @@
+/**
+ * @file    benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Measures the latency of the event dispatch on the host.
+ *
+ * The previous implementation, built on std::function and a heap-allocated DataEvent payload, is
+ * reproduced here to compare against.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "processes/application.h"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+using namespace Nilai;
+
+namespace
+{
+constexpr size_t s_iterations = 1'000'000;
+
+volatile uint32_t g_sink = 0;
+
+struct Payload
+{
+    uint32_t A;
+    uint32_t B;
+    uint32_t C;
+};
+
+//! DataEvent as it was before: the payload is copied on the heap.
+struct LegacyDataEvent : public Events::Event
+{
+    void*  Data = nullptr;
+    size_t Len  = 0;
+
+    template<typename T>
+    LegacyDataEvent(const T& data) : Event(Events::EventTypes::DataEvent, Events::EventCategories::Data)
+    {
+        Len  = sizeof(T);
+        Data = malloc(Len);
+        memcpy(Data, &data, Len);
+    }
+    ~LegacyDataEvent() override { free(Data); }
+};
+
+//! Dispatch as it was before: a list of std::function per event type.
+class LegacyDispatcher
+{
+    struct CallbackSlot
+    {
+        std::function<bool(Events::Event*)> F    = [](Events::Event*) { return false; };
+        bool                                Used = false;
+    };
+
+public:
+    void Register(Events::EventTypes t, const std::function<bool(Events::Event*)>& cb)
+    {
+        for (auto& slot : m_callbacks[static_cast<size_t>(t)])
+        {
+            if (!slot.Used)
+            {
+                slot = {cb, true};
+                return;
+            }
+        }
+    }
+
+    void Dispatch(Events::Event* e)
+    {
+        for (const auto& [cb, used] : m_callbacks[static_cast<size_t>(e->Type)])
+        {
+            if (cb(e))
+            {
+                return;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t s_numOfEvents = static_cast<size_t>(Events::EventTypes::Count);
+    std::array<std::array<CallbackSlot, NILAI_EVENTS_MAX_CALLBACKS>, s_numOfEvents> m_callbacks;
+};
+
+template<typename Fn>
+void Run(const char* name, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < s_iterations; i++)
+    {
+        fn(static_cast<uint32_t>(i));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-36s %8.2f ns/event\n", name, ns / static_cast<double>(s_iterations));
+}
+}    // namespace
+
+int main()
+{
+    // Every callback captures a pointer, like modules capturing `this`.
+    uint32_t         acc = 0;
+    auto             cb  = [&acc](Events::Event* e) { acc += e->Timestamp + 1; return false; };
+    auto             dataCb = [&acc](Events::Event* e)
+    {
+        acc += static_cast<Events::DataEvent*>(e)->As<Payload>().A;
+        return false;
+    };
+    auto legacyDataCb = [&acc](Events::Event* e)
+    {
+        acc += static_cast<const Payload*>(static_cast<LegacyDataEvent*>(e)->Data)->A;
+        return false;
+    };
+
+    LegacyDispatcher legacy;
+    Application      app;
+    for (size_t i = 0; i < NILAI_EVENTS_MAX_CALLBACKS; i++)
+    {
+        legacy.Register(Events::EventTypes::Exti0, cb);
+        legacy.Register(Events::EventTypes::DataEvent, legacyDataCb);
+        app.RegisterEventCallback(Events::EventTypes::Exti0, cb);
+        app.RegisterEventCallback(Events::EventTypes::DataEvent, dataCb);
+    }
+
+    Run("Before: Event (EXTI)",
+        [&](uint32_t)
+        {
+            Events::Event e {Events::EventTypes::Exti0, Events::EventCategories::External};
+            legacy.Dispatch(&e);
+        });
+    Run("After:  Event (EXTI)",
+        [&](uint32_t)
+        {
+            Events::Event e {Events::EventTypes::Exti0, Events::EventCategories::External};
+            app.DispatchEvent(&e);
+        });
+    Run("Before: DataEvent",
+        [&](uint32_t i)
+        {
+            LegacyDataEvent e {Payload {i, i, i}};
+            legacy.Dispatch(&e);
+        });
+    Run("After:  DataEvent",
+        [&](uint32_t i) { app.TriggerDataEvent(Payload {i, i, i}); });
+
+    g_sink = acc;
+    return 0;
+}
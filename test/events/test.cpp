@@ -0,0 +1,291 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/inplace_function.h"
+#include "processes/application.h"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Nilai;
+
+namespace
+{
+struct Payload
+{
+    uint32_t A;
+    float    B;
+    uint8_t  C[8];
+};
+}    // namespace
+
+TEST(NilaiInplaceFunction, EmptyByDefault)
+{
+    InplaceFunction<int(int), 16> f;
+    EXPECT_FALSE(f);
+    f = [](int i) { return i * 2; };
+    ASSERT_TRUE(f);
+    EXPECT_EQ(f(21), 42);
+    f = nullptr;
+    EXPECT_FALSE(f);
+}
+
+TEST(NilaiInplaceFunction, CopiesCaptures)
+{
+    int                          calls = 0;
+    InplaceFunction<void(), 16>  a     = [&calls] { calls++; };
+    InplaceFunction<void(), 16>  b     = a;
+    InplaceFunction<void(), 16>  c;
+    c = b;
+    a();
+    b();
+    c();
+    EXPECT_EQ(calls, 3);
+}
+
+TEST(NilaiInplaceFunction, DestroysCallable)
+{
+    auto counter = std::make_shared<int>(0);
+    {
+        InplaceFunction<int(), 32> f = [counter] { return *counter; };
+        InplaceFunction<int(), 32> g = f;
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(NilaiDataEvent, CarriesACopy)
+{
+    Payload p = {42, 1.5F, {1, 2, 3, 4, 5, 6, 7, 8}};
+
+    Events::DataEvent e(p);
+    p.A = 0;
+
+    EXPECT_EQ(e.Len, sizeof(Payload));
+    EXPECT_EQ(e.As<Payload>().A, 42);
+    EXPECT_EQ(e.As<Payload>().B, 1.5F);
+    EXPECT_EQ(e.As<Payload>().C[7], 8);
+}
+
+TEST(NilaiEventDispatch, CallsRegisteredCallbacksInOrder)
+{
+    Application        app;
+    std::array<int, 3> order = {};
+    int                count = 0;
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(app.RegisterEventCallback(Events::EventTypes::DataEvent,
+                                            [&order, &count, i](Events::Event*)
+                                            {
+                                                order[count++] = i;
+                                                return false;
+                                            }),
+                  i);
+    }
+
+    app.TriggerDataEvent(uint32_t {7});
+    EXPECT_EQ(count, 3);
+    EXPECT_EQ(order, (std::array {0, 1, 2}));
+}
+
+TEST(NilaiEventDispatch, StopsPropagation)
+{
+    Application app;
+    int         calls = 0;
+
+    size_t first = app.RegisterEventCallback(Events::EventTypes::DataEvent,
+                                             [&calls](Events::Event*)
+                                             {
+                                                 calls++;
+                                                 return true;
+                                             });
+    app.RegisterEventCallback(Events::EventTypes::DataEvent,
+                              [&calls](Events::Event*)
+                              {
+                                  calls++;
+                                  return false;
+                              });
+
+    app.TriggerDataEvent(uint32_t {7});
+    EXPECT_EQ(calls, 1);
+
+    // Unregistered slots are skipped.
+    app.UnregisterEventCallback(Events::EventTypes::DataEvent, first);
+    app.TriggerDataEvent(uint32_t {7});
+    EXPECT_EQ(calls, 2);
+}
+
+TEST(NilaiEventDispatch, DataEventPayload)
+{
+    Application app;
+    uint32_t    received = 0;
+
+    app.RegisterEventCallback(Events::EventTypes::DataEvent,
+                              [&received](Events::Event* e)
+                              {
+                                  received = static_cast<Events::DataEvent*>(e)->As<Payload>().A;
+                                  return false;
+                              });
+
+    app.TriggerDataEvent(Payload {1234, 0.0F, {}});
+    EXPECT_EQ(received, 1234);
+}
+
+TEST(NilaiEventQueue, PushPop)
+{
+    Events::EventQueue<64, 4> queue;
+    EXPECT_TRUE(queue.Empty());
+
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(queue.Push(Events::DataEvent {i}));
+    }
+    EXPECT_FALSE(queue.Push(Events::DataEvent {4}));
+    EXPECT_EQ(queue.Dropped(), 1);
+
+    for (int i = 0; i < 4; i++)
+    {
+        int got = -1;
+        EXPECT_TRUE(queue.Pop([&got](Events::Event* e)
+                              { got = static_cast<Events::DataEvent*>(e)->As<int>(); }));
+        EXPECT_EQ(got, i);
+    }
+    EXPECT_FALSE(queue.Pop([](Events::Event*) {}));
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(NilaiEventQueue, ManyProducers)
+{
+    static constexpr int      s_perProducer = 20000;
+    Events::EventQueue<64, 8> queue;
+
+    auto produce = [&queue](int base)
+    {
+        for (int i = 0; i < s_perProducer;)
+        {
+            if (queue.Push(Events::DataEvent {base + i}))
+            {
+                i++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::thread a(produce, 0);
+    std::thread b(produce, s_perProducer);
+
+    // Each producer's events must come out in the order they were pushed.
+    int nextA = 0;
+    int nextB = s_perProducer;
+    while (nextA < s_perProducer || nextB < 2 * s_perProducer)
+    {
+        if (!queue.Pop(
+              [&](Events::Event* e)
+              {
+                  int v = static_cast<Events::DataEvent*>(e)->As<int>();
+                  EXPECT_EQ(v, v < s_perProducer ? nextA++ : nextB++);
+              }))
+        {
+            std::this_thread::yield();
+        }
+    }
+    a.join();
+    b.join();
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(NilaiEventDispatch, PostedEventsAreDeferred)
+{
+    Application app;
+    app.SetEventBudget(0);
+    int calls = 0;
+
+    app.RegisterEventCallback(Events::EventTypes::Exti0,
+                              [&calls](Events::Event*)
+                              {
+                                  calls++;
+                                  return false;
+                              });
+
+    EXPECT_TRUE(app.PostEvent(Events::Event {Events::EventTypes::Exti0,
+                                             Events::EventCategories::External}));
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(app.ProcessEvents(), 1);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(app.ProcessEvents(), 0);
+
+    // Nothing is queued when no callback would receive it.
+    EXPECT_TRUE(app.PostEvent(Events::Event {Events::EventTypes::Exti1,
+                                             Events::EventCategories::External}));
+    EXPECT_EQ(app.ProcessEvents(), 0);
+}
+
+TEST(NilaiEventDispatch, ImmediateCallbacksRunWhenPosted)
+{
+    Application app;
+    int         immediate = 0;
+    int         deferred  = 0;
+
+    app.RegisterEventCallback(
+      Events::EventTypes::Exti0,
+      [&immediate](Events::Event*)
+      {
+          immediate++;
+          return false;
+      },
+      Events::DispatchMode::Immediate);
+    app.RegisterEventCallback(Events::EventTypes::Exti0,
+                              [&deferred](Events::Event*)
+                              {
+                                  deferred++;
+                                  return false;
+                              });
+
+    app.PostEvent(Events::Event {Events::EventTypes::Exti0, Events::EventCategories::External});
+    EXPECT_EQ(immediate, 1);
+    EXPECT_EQ(deferred, 0);
+
+    app.ProcessEvents();
+    EXPECT_EQ(immediate, 1);
+    EXPECT_EQ(deferred, 1);
+}
+
+TEST(NilaiEventDispatch, HighPriorityFirst)
+{
+    Application      app;
+    std::vector<int> order;
+
+    app.RegisterEventCallback(Events::EventTypes::DataEvent,
+                              [&order](Events::Event* e)
+                              {
+                                  order.push_back(static_cast<Events::DataEvent*>(e)->As<int>());
+                                  return false;
+                              });
+
+    app.PostEvent(Events::DataEvent {1}, Events::EventPriority::Low);
+    app.PostEvent(Events::DataEvent {2}, Events::EventPriority::Normal);
+    app.PostEvent(Events::DataEvent {3}, Events::EventPriority::High);
+    app.PostEvent(Events::DataEvent {4}, Events::EventPriority::Normal);
+
+    EXPECT_EQ(app.ProcessEvents(), 4);
+    EXPECT_EQ(order, (std::vector {3, 2, 4, 1}));
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "processes/application.h"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace Nilai;
+
+namespace
+{
+std::vector<int> g_runs;
+
+class TestModule : public Module
+{
+public:
+    explicit TestModule(int tag, RunPolicy policy, uint8_t priority = 0, uint32_t period = 0)
+    : m_tag(tag)
+    {
+        switch (policy)
+        {
+            case RunPolicy::Always: SetRunAlways(); break;
+            case RunPolicy::Periodic: SetRunPeriod(period); break;
+            case RunPolicy::OnSignal: SetRunOnSignal(); break;
+        }
+        SetPriority(priority);
+    }
+
+    void Run() override { g_runs.push_back(m_tag); }
+
+private:
+    int m_tag;
+};
+
+class TestApp : public Application
+{
+public:
+    size_t        Idles            = 0;
+    Nilai::time_t LastTimeUntilRun = 0;
+
+protected:
+    void OnIdle(Nilai::time_t timeUntilNextRun) override
+    {
+        Idles++;
+        LastTimeUntilRun = timeUntilNextRun;
+    }
+};
+}    // namespace
+
+TEST(NilaiScheduler, AlwaysRunsEveryPass)
+{
+    g_runs.clear();
+    TestApp app;
+    app.AddModule<TestModule>(1, RunPolicy::Always);
+
+    app.OnRun();
+    app.OnRun();
+    EXPECT_EQ(g_runs, (std::vector {1, 1}));
+    // Never sleeps, the module always has something to do.
+    EXPECT_EQ(app.Idles, 0);
+}
+
+TEST(NilaiScheduler, OnSignalRunsOncePerSignal)
+{
+    g_runs.clear();
+    TestApp     app;
+    TestModule& m = app.AddModule<TestModule>(2, RunPolicy::OnSignal);
+
+    app.OnRun();
+    EXPECT_TRUE(g_runs.empty());
+    EXPECT_EQ(app.Idles, 1);
+    EXPECT_EQ(app.LastTimeUntilRun, Application::s_noDeadline);
+    EXPECT_EQ(app.GetNextWakeUp(), Application::s_noDeadline);
+
+    m.Signal();
+    app.OnRun();
+    app.OnRun();
+    EXPECT_EQ(g_runs, (std::vector {2}));
+}
+
+TEST(NilaiScheduler, PeriodicRunsWhenDue)
+{
+    g_runs.clear();
+    TestApp app;
+    // An hour, long enough not to elapse during the test.
+    static constexpr uint32_t s_period = 3600 * 1000;
+    TestModule& m = app.AddModule<TestModule>(3, RunPolicy::Periodic, 0, s_period);
+
+    // Due right away, then not again until the period has elapsed.
+    app.OnRun();
+    app.OnRun();
+    EXPECT_EQ(g_runs, (std::vector {3}));
+    EXPECT_EQ(app.Idles, 2);
+    EXPECT_GT(app.LastTimeUntilRun, 0);
+    EXPECT_LE(app.LastTimeUntilRun, s_period);
+    EXPECT_NE(app.GetNextWakeUp(), Application::s_noDeadline);
+
+    // Signalling a periodic module runs it without waiting.
+    m.Signal();
+    app.OnRun();
+    EXPECT_EQ(g_runs, (std::vector {3, 3}));
+}
+
+TEST(NilaiScheduler, HigherPriorityRunsFirst)
+{
+    g_runs.clear();
+    TestApp app;
+    app.AddModule<TestModule>(1, RunPolicy::Always, 1);
+    app.AddModule<TestModule>(2, RunPolicy::Always, 5);
+    app.AddModule<TestModule>(3, RunPolicy::Always, 1);
+
+    app.OnRun();
+    EXPECT_EQ(g_runs, (std::vector {2, 1, 3}));
+}
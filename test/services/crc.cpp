@@ -0,0 +1,152 @@
+/**
+ * @file    crc.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include <gtest/gtest.h>
+
+#include "services/crc/constexpr_crc.h"
+#include "services/crc/crc.h"
+#include "services/crc/software_crc.h"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace Nilai::Services;
+
+namespace
+{
+std::vector<uint8_t> MakeData(size_t len)
+{
+    std::vector<uint8_t> data(len);
+    uint32_t             x = 0x12345678;
+    for (uint8_t& b : data)
+    {
+        x = x * 1664525 + 1013904223;
+        b = static_cast<uint8_t>(x >> 24);
+    }
+    return data;
+}
+
+//! Bit-at-a-time CRC-32/ISO-HDLC, the reference the tables are checked against.
+uint32_t BitwiseCrc32(std::span<const uint8_t> data)
+{
+    uint32_t c = 0xFFFFFFFF;
+    for (uint8_t b : data)
+    {
+        c ^= b;
+        for (int i = 0; i < 8; i++)
+        {
+            c = ((c & 1) != 0) ? (c >> 1) ^ 0xEDB88320 : (c >> 1);
+        }
+    }
+    return ~c;
+}
+
+//! Bit-at-a-time CRC-16/CCITT-FALSE.
+uint16_t BitwiseCrc16(std::span<const uint8_t> data)
+{
+    uint16_t c = 0xFFFF;
+    for (uint8_t b : data)
+    {
+        c = static_cast<uint16_t>(c ^ (b << 8));
+        for (int i = 0; i < 8; i++)
+        {
+            c = ((c & 0x8000) != 0) ? static_cast<uint16_t>((c << 1) ^ 0x1021)
+                                    : static_cast<uint16_t>(c << 1);
+        }
+    }
+    return c;
+}
+}    // namespace
+
+TEST(NilaiCrc, MatchesReferenceForAnyLengthAndAlignment)
+{
+    std::vector<uint8_t> data = MakeData(300);
+    for (size_t offset = 0; offset < 8; offset++)
+    {
+        for (size_t len = 0; len + offset <= data.size(); len += 7)
+        {
+            std::span<const uint8_t> s {data.data() + offset, len};
+            ASSERT_EQ(Crc32::Compute(s), BitwiseCrc32(s)) << "offset " << offset << ", len " << len;
+            ASSERT_EQ(Crc16Ccitt::Compute(s), BitwiseCrc16(s))
+              << "offset " << offset << ", len " << len;
+        }
+    }
+}
+
+TEST(NilaiCrc, StreamingMatchesSingleUpdate)
+{
+    std::vector<uint8_t> data = MakeData(100);
+    uint32_t             exp32 = Crc32::Compute(data);
+    uint16_t             exp16 = Crc16Ccitt::Compute(data);
+    for (size_t split = 0; split <= data.size(); split++)
+    {
+        std::span<const uint8_t> all {data};
+
+        Crc32 crc32;
+        crc32.Update(all.first(split)).Update(all.subspan(split));
+        EXPECT_EQ(crc32.Value(), exp32) << "split " << split;
+
+        Crc16Ccitt crc16;
+        crc16.Update(all.first(split)).Update(all.subspan(split));
+        EXPECT_EQ(crc16.Value(), exp16) << "split " << split;
+    }
+}
+
+TEST(NilaiCrc, ResetStartsOver)
+{
+    std::vector<uint8_t> data = MakeData(20);
+
+    Crc32 crc;
+    crc.Update(data);
+    crc.Reset();
+    crc.Update(data);
+    EXPECT_EQ(crc.Value(), Crc32::Compute(data));
+}
+
+TEST(NilaiCrc, WordsAreReadMostSignificantByteFirst)
+{
+    std::array<uint32_t, 5> words = {0x12345678, 0x9ABCDEF0, 0x0F1E2D3C, 0x4B5A6978, 0xDEADBEEF};
+    std::array<uint8_t, 20> bytes = {};
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        for (size_t j = 0; j < 4; j++)
+        {
+            bytes[i * 4 + j] = static_cast<uint8_t>(words[i] >> (24 - 8 * j));
+        }
+    }
+
+    for (size_t n = 0; n <= words.size(); n++)
+    {
+        std::span<const uint32_t> w {words.data(), n};
+        std::span<const uint8_t>  b {bytes.data(), n * 4};
+        EXPECT_EQ(Crc32Mpeg2 {}.UpdateWords(w).Value(), Crc32Mpeg2::Compute(b));
+        EXPECT_EQ(Crc32 {}.UpdateWords(w).Value(), Crc32::Compute(b));
+    }
+}
+
+TEST(NilaiCrc, MatchesThePeripheral)
+{
+    // Without the CRC peripheral, Crc falls back to the software implementation.
+    std::array<uint32_t, 9> words = {1, 2, 3, 4, 5, 6, 7, 8, 0x12345678};
+    EXPECT_EQ(Crc(words), ConstexprCrc(words.data(), words.size()));
+    EXPECT_EQ(Crc(words.data(), words.size(), 0x0BADF00D),
+              ConstexprCrc(words.data(), words.size(), 0x0BADF00D));
+
+    uint32_t x = 0x12345678;
+    EXPECT_EQ(Crc(&x, 1), 0xDF8A8A2B);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    crc_benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Compares the throughput of the CRC implementations on the host, for several buffer
+ *          sizes.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "services/crc/constexpr_crc.h"
+#include "services/crc/software_crc.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+using namespace Nilai::Services;
+
+namespace
+{
+//! Bytes processed per measurement, whatever the size of the buffer.
+constexpr size_t s_totalBytes = 64 * 1024 * 1024;
+
+constexpr std::array<size_t, 6> s_sizes = {16, 64, 256, 1024, 4096, 65536};
+
+// Keeps the compiler from optimizing the loops away.
+volatile uint32_t g_sink = 0;
+
+template<typename Fn>
+void Run(const char* name, size_t size, Fn&& fn)
+{
+    size_t   iterations = s_totalBytes / size;
+    uint32_t sum        = 0;
+    auto     start      = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        sum += fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_sink   = sum;
+
+    double s = std::chrono::duration<double>(end - start).count();
+    std::printf("%-32s %6zu B %10.1f MB/s\n",
+                name,
+                size,
+                static_cast<double>(iterations * size) / s / 1e6);
+}
+}    // namespace
+
+int main()
+{
+    std::vector<uint8_t> bytes(s_sizes.back());
+    for (size_t i = 0; i < bytes.size(); i++)
+    {
+        bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    std::vector<uint32_t> words(s_sizes.back() / 4);
+    for (size_t i = 0; i < words.size(); i++)
+    {
+        words[i] = static_cast<uint32_t>(i * 2654435761u);
+    }
+
+    for (size_t size : s_sizes)
+    {
+        std::span<const uint8_t>  b {bytes.data(), size};
+        std::span<const uint32_t> w {words.data(), size / 4};
+
+        Run("ConstexprCrc (byte table)", size, [&] { return ConstexprCrc(w.data(), w.size()); });
+        Run("Crc32Mpeg2::UpdateWords", size, [&] { return Crc32Mpeg2 {}.UpdateWords(w).Value(); });
+        Run("Crc32Mpeg2::Update", size, [&] { return Crc32Mpeg2::Compute(b); });
+        Run("Crc32::Update", size, [&] { return Crc32::Compute(b); });
+        Run("Crc16Ccitt::Update", size, [&] { return uint32_t {Crc16Ccitt::Compute(b)}; });
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file    benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Compares the cost of a deferred log message with formatting it with vsnprintf.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "services/deferred_log.h"
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+
+using namespace Nilai::Services;
+
+namespace
+{
+constexpr size_t s_iterations = 1'000'000;
+
+volatile size_t g_sink = 0;
+
+//! What Logger::VLog does, without the transmission.
+void Format(const char* fmt, ...)
+{
+    static char buff[1024] = {};
+    va_list     args;
+    va_start(args, fmt);
+    g_sink = g_sink + static_cast<size_t>(vsnprintf(buff, sizeof(buff), fmt, args));
+    va_end(args);
+}
+
+template<typename Fn>
+void Run(const char* name, Fn&& fn)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < s_iterations; i++)
+    {
+        fn(static_cast<uint32_t>(i));
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-36s %8.2f ns/message\n", name, ns / static_cast<double>(s_iterations));
+}
+}    // namespace
+
+int main()
+{
+    static constexpr const char* s_fmt =
+      "\033[32;40mI [%02i:%02i:%02i.%03i] ADC %s: %d mV, %f C\n\r";
+
+    Run("vsnprintf",
+        [](uint32_t i)
+        {
+            Format(
+              s_fmt, i / 3600000, (i / 60000) % 60, (i / 1000) % 60, i % 1000, "CH1", i, 21.5);
+        });
+    Run("Deferred",
+        [](uint32_t i)
+        {
+            DeferredLog::Write(s_fmt, i, "CH1", i, 21.5);
+            // Drained right away, so that the ring never fills up.
+            g_sink = g_sink + DeferredLog::Read()->Len;
+        });
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/mpsc_ring.h"
+#include "services/deferred_log.h"
+#include "services/deferred_log_decoder.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Nilai;
+using namespace Nilai::Services;
+
+namespace
+{
+// Format strings are looked up by the id the device would send.
+class Formats
+{
+public:
+    const char* Add(const char* fmt)
+    {
+        m_formats[DeferredLog::FormatId(fmt)] = fmt;
+        return fmt;
+    }
+
+    DeferredLogDecoder Decoder() const
+    {
+        return DeferredLogDecoder(
+          [this](uint32_t id)
+          {
+              auto it = m_formats.find(id);
+              return it != m_formats.end() ? it->second : nullptr;
+          });
+    }
+
+private:
+    std::map<uint32_t, const char*> m_formats;
+};
+
+std::vector<std::string> Drain(const DeferredLogDecoder& decoder)
+{
+    std::vector<std::string> lines;
+    while (auto r = DeferredLog::Read())
+    {
+        lines.push_back(decoder.Decode(*r));
+    }
+    return lines;
+}
+
+template<typename T>
+void Put(std::vector<uint8_t>& v, size_t pos, T t)
+{
+    for (size_t i = 0; i < sizeof(T); i++)
+    {
+        v[pos + i] = static_cast<uint8_t>(t >> (i * 8));
+    }
+}
+}    // namespace
+
+TEST(NilaiMpscRing, PushPop)
+{
+    MpscRing<int, 4> ring;
+    EXPECT_TRUE(ring.Empty());
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(ring.Push(i));
+    }
+    EXPECT_FALSE(ring.Push(4));
+    EXPECT_EQ(ring.Overflows(), 1);
+    EXPECT_EQ(ring.Size(), 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(ring.Pop(), i);
+    }
+    EXPECT_FALSE(ring.Pop().has_value());
+    EXPECT_TRUE(ring.Empty());
+}
+
+TEST(NilaiMpscRing, ManyProducers)
+{
+    static constexpr int s_perProducer = 20000;
+    MpscRing<int, 16>    ring;
+
+    auto produce = [&ring](int base)
+    {
+        for (int i = 0; i < s_perProducer;)
+        {
+            if (ring.Emplace([&](int& item) { item = base + i; }))
+            {
+                i++;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    };
+    std::thread a(produce, 0);
+    std::thread b(produce, s_perProducer);
+
+    // Each producer's items must come out in the order they were pushed.
+    int nextA = 0;
+    int nextB = s_perProducer;
+    while (nextA < s_perProducer || nextB < 2 * s_perProducer)
+    {
+        if (auto v = ring.Pop())
+        {
+            EXPECT_EQ(*v, *v < s_perProducer ? nextA++ : nextB++);
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    a.join();
+    b.join();
+    EXPECT_TRUE(ring.Empty());
+}
+
+TEST(NilaiDeferredLog, FormatsOnTheHost)
+{
+    Formats formats;
+    auto    decoder = formats.Decoder();
+
+    const char* fmt = formats.Add("I %d %u 0x%08lX %5.2f %s %c");
+    EXPECT_TRUE(DeferredLog::Write(fmt, 3723004, -12, 42U, 0xBEEFUL, 3.14159F, "abc", 'z'));
+    EXPECT_TRUE(DeferredLog::Write(formats.Add("%lld %% %-4s|"), 0, int64_t {-5000000000}, "xy"));
+
+    auto lines = Drain(decoder);
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_EQ(lines[0], "[01:02:03.004]I -12 42 0x0000BEEF  3.14 abc z");
+    EXPECT_EQ(lines[1], "[00:00:00.000]-5000000000 % xy  |");
+}
+
+TEST(NilaiDeferredLog, NegativeHexLooksLikeOnTheDevice)
+{
+    Formats formats;
+    auto    decoder = formats.Decoder();
+
+    DeferredLog::Write(formats.Add("%x %d"), 0, int32_t {-1}, uint8_t {200});
+    auto lines = Drain(decoder);
+    ASSERT_EQ(lines.size(), 1);
+    EXPECT_EQ(lines[0], "[00:00:00.000]ffffffff 200");
+}
+
+TEST(NilaiDeferredLog, TruncatesWhatDoesNotFit)
+{
+    Formats formats;
+    auto    decoder = formats.Decoder();
+
+    std::string longStr(200, 'a');
+    DeferredLog::Write(formats.Add("%s %d"), 0, longStr.c_str(), 1);
+
+    auto r = DeferredLog::Read();
+    ASSERT_TRUE(r.has_value());
+    EXPECT_NE(r->Flags & DeferredLogRecord::s_truncated, 0);
+    EXPECT_EQ(r->Len, DeferredLogRecord::s_argsSize);
+    std::string expected =
+      "[00:00:00.000]" + std::string(DeferredLogRecord::s_argsSize - 2, 'a') + " <?> <truncated>";
+    EXPECT_EQ(decoder.Decode(*r), expected);
+}
+
+TEST(NilaiDeferredLog, CountsDroppedMessages)
+{
+    Formats     formats;
+    const char* fmt     = formats.Add("%d");
+    size_t      dropped = DeferredLog::Dropped();
+
+    for (size_t i = 0; i < DeferredLog::Ring::Capacity() + 3; i++)
+    {
+        DeferredLog::Write(fmt, 0, static_cast<int>(i));
+    }
+    EXPECT_EQ(DeferredLog::Dropped() - dropped, 3);
+
+    auto lines = Drain(formats.Decoder());
+    ASSERT_EQ(lines.size(), DeferredLog::Ring::Capacity());
+    EXPECT_EQ(lines.back(), "[00:00:00.000]" + std::to_string(lines.size() - 1));
+}
+
+TEST(NilaiDeferredLog, DecodesAStreamOfFrames)
+{
+    Formats formats;
+    auto    decoder = formats.Decoder();
+
+    std::vector<uint8_t> stream = {0x00, 0x13};    // Garbage before the first frame.
+    for (int i = 0; i < 3; i++)
+    {
+        DeferredLog::Write(formats.Add("n=%d s=%s"), 1000, i, "hi");
+        auto                                             r = DeferredLog::Read();
+        std::array<uint8_t, DeferredLog::s_maxFrameSize> frame;
+        size_t                                           size = DeferredLog::ToFrame(*r, frame);
+        ASSERT_NE(size, 0);
+        stream.insert(stream.end(), frame.begin(), frame.begin() + size);
+    }
+
+    // Fed one byte at a time, like it would come from a serial port.
+    std::vector<std::string> lines;
+    for (uint8_t b : stream)
+    {
+        decoder.Feed({&b, 1}, [&lines](const std::string& l) { lines.push_back(l); });
+    }
+    EXPECT_EQ(lines,
+              (std::vector<std::string> {"[00:00:01.000]n=0 s=hi",
+                                         "[00:00:01.000]n=1 s=hi",
+                                         "[00:00:01.000]n=2 s=hi"}));
+}
+
+TEST(NilaiDeferredLog, FindsFormatsInElf)
+{
+    // A minimal 32-bit ELF: the header, a .rodata section at 0x08001000 and its section header.
+    static constexpr uint32_t s_rodataAddr = 0x08001000;
+    const char                rodata[]     = "boot\0value=%d\n";
+    static constexpr size_t   s_dataOff    = 52;
+    static constexpr size_t   s_shOff      = s_dataOff + sizeof(rodata);
+
+    std::vector<uint8_t> elf(s_shOff + (2 * 40), 0);
+    std::copy_n("\x7F" "ELF\x01\x01", 6, elf.begin());
+    Put(elf, 0x20, uint32_t {s_shOff});
+    Put(elf, 0x2E, uint16_t {40});
+    Put(elf, 0x30, uint16_t {2});
+    std::copy_n(rodata, sizeof(rodata), elf.begin() + s_dataOff);
+    // The first section header is the null one.
+    size_t sh = s_shOff + 40;
+    Put(elf, sh + 4, uint32_t {1});      // SHT_PROGBITS
+    Put(elf, sh + 8, uint32_t {0x2});    // SHF_ALLOC
+    Put(elf, sh + 12, s_rodataAddr);
+    Put(elf, sh + 16, uint32_t {s_dataOff});
+    Put(elf, sh + 20, uint32_t {sizeof(rodata)});
+
+    ElfFormatTable table(elf);
+    ASSERT_TRUE(table.Valid());
+    EXPECT_STREQ(table.Find(s_rodataAddr), "boot");
+    EXPECT_STREQ(table.Find(s_rodataAddr + 5), "value=%d\n");
+    EXPECT_EQ(table.Find(s_rodataAddr + sizeof(rodata)), nullptr);
+    EXPECT_EQ(table.Find(0x20000000), nullptr);
+
+    DeferredLogRecord r;
+    r.FormatId = s_rodataAddr + 5;
+    r.Args[0]  = static_cast<uint8_t>(DeferredLogArg::Int32);
+    r.Args[1]  = 7;
+    r.Len      = 5;
+    DeferredLogDecoder decoder([&table](uint32_t id) { return table.Find(id); });
+    EXPECT_EQ(decoder.Decode(r), "[00:00:00.000]value=7\n");
+
+    r.FormatId = 0x1234;
+    EXPECT_EQ(decoder.Decode(r), "[00:00:00.000] <unknown format 0x00001234>");
+}
@@ -0,0 +1,270 @@
+/**
+ * @file    dsp.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include <gtest/gtest.h>
+
+#include "services/dsp/biquad.h"
+#include "services/dsp/fixed_point.h"
+#include "services/dsp/gain_ramp.h"
+#include "services/dsp/mixer.h"
+#include "services/dsp/stage.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace Nilai::Services::Dsp;
+
+namespace
+{
+//! Low-pass at 1 kHz for 48 kHz, Q of 0.707, in the textbook form.
+constexpr std::array<double, 5> s_lowPass = {
+  0.003916126660547, 0.007832253321095, 0.003916126660547, -1.815341082704568, 0.831005589346757};
+
+std::vector<q31_t> MakeSine(size_t n, double freq, double amplitude)
+{
+    std::vector<q31_t> out(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        double v = amplitude * std::sin(freq * static_cast<double>(i));
+        out[i]   = FloatToQ31(static_cast<float>(v));
+    }
+    return out;
+}
+
+//! The same filter in double precision, as a reference.
+std::vector<double> Reference(const std::vector<q31_t>& in, const std::array<double, 5>& c)
+{
+    std::vector<double> out(in.size());
+    double              x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        double x = ToFloat(in[i]);
+        double y = c[0] * x + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2;
+        x2       = x1;
+        x1       = x;
+        y2       = y1;
+        y1       = y;
+        out[i]   = y;
+    }
+    return out;
+}
+
+struct TasFilter
+{
+    uint32_t b0 = 0x00800000;
+    uint32_t b1 = 0x00000000;
+    uint32_t b2 = 0x00000000;
+    uint32_t a1 = 0x00000000;
+    uint32_t a2 = 0x00000000;
+};
+}    // namespace
+
+TEST(NilaiDsp, ConvertsAndSaturates)
+{
+    EXPECT_EQ(FloatToQ15(0.5f), 0x4000);
+    EXPECT_EQ(FloatToQ15(1.0f), INT16_MAX);
+    EXPECT_EQ(FloatToQ15(-1.5f), INT16_MIN);
+    EXPECT_EQ(FloatToQ31(-0.25f), -0x20000000);
+    EXPECT_EQ(FloatToQ31(2.0f), INT32_MAX);
+
+    std::array<q15_t, 4> q15 = {0x1234, -1, INT16_MAX, INT16_MIN};
+    std::array<q31_t, 4> q31 = {};
+    Q15ToQ31(q15.data(), q31.data(), q15.size());
+    EXPECT_EQ(q31[0], 0x12340000);
+    EXPECT_EQ(q31[1], -0x10000);
+
+    // Rounded to the nearest, without wrapping at the top.
+    q31 = {0x12348000, 0x12347FFF, INT32_MAX, INT32_MIN};
+    Q31ToQ15(q31.data(), q15.data(), q31.size());
+    EXPECT_EQ(q15, (std::array<q15_t, 4> {0x1235, 0x1234, INT16_MAX, INT16_MIN}));
+}
+
+TEST(NilaiDsp, MixerSumsWeightedInputs)
+{
+    Mixer<3>                    mixer;
+    std::array<q15_t, 3>        a   = {1000, -2000, 30000};
+    std::array<q15_t, 3>        b   = {500, 500, 30000};
+    std::array<q15_t, 3>        c   = {-100, 0, 30000};
+    std::array<q15_t, 3>        out = {};
+    std::array<const q15_t*, 3> in  = {a.data(), b.data(), c.data()};
+
+    ASSERT_TRUE(mixer.SetGain(1, FloatToQ31(0.5f)));
+    EXPECT_FALSE(mixer.SetGain(3, 0));
+    mixer.Process(std::span<const q15_t* const> {in}, out.data(), out.size());
+    // A gain of 1 is 0x7FFF in Q15, which loses a fraction of a LSB.
+    EXPECT_NEAR(out[0], 1000 + 250 - 100, 1);
+    EXPECT_NEAR(out[1], -2000 + 250, 1);
+    EXPECT_EQ(out[2], INT16_MAX);
+
+    std::array<q31_t, 2>        x    = {0x50000000, -0x50000000};
+    std::array<q31_t, 2>        y    = {0x40000000, -0x40000000};
+    std::array<q31_t, 2>        o31  = {};
+    std::array<const q31_t*, 2> in31 = {x.data(), y.data()};
+    Mixer<2>                    m31;
+    m31.Process(std::span<const q31_t* const> {in31}, o31.data(), o31.size());
+    EXPECT_EQ(o31[0], INT32_MAX);
+    EXPECT_EQ(o31[1], INT32_MIN);
+}
+
+TEST(NilaiDsp, MixerCopiesASingleInputAtUnity)
+{
+    Mixer<2>                    mixer;
+    std::array<q15_t, 4>        a   = {1, -2, INT16_MAX, INT16_MIN};
+    std::array<q15_t, 4>        out = {};
+    std::array<const q15_t*, 1> in  = {a.data()};
+    mixer.Process(std::span<const q15_t* const> {in}, out.data(), out.size());
+    EXPECT_EQ(out, a);
+
+    mixer.Process(std::span<const q15_t* const> {}, out.data(), out.size());
+    EXPECT_EQ(out, (std::array<q15_t, 4> {}));
+}
+
+TEST(NilaiDsp, GainRampsWithoutSteps)
+{
+    GainRamp ramp;
+    ramp.RampTo(FloatToQ31(0.25f), 100);
+    EXPECT_TRUE(ramp.IsRamping());
+
+    // Ramps over two blocks, the signal being a constant.
+    std::vector<q31_t> data(160, 0x40000000);
+    ramp.Process(data.data(), 60);
+    ramp.Process(data.data() + 60, 100);
+    EXPECT_FALSE(ramp.IsRamping());
+    EXPECT_EQ(ramp.GetGain(), FloatToQ31(0.25f));
+
+    int64_t biggestStep = 0;
+    for (size_t i = 1; i < 100; i++)
+    {
+        ASSERT_LE(data[i], data[i - 1]) << i;
+        biggestStep = std::max<int64_t>(biggestStep, static_cast<int64_t>(data[i - 1]) - data[i]);
+    }
+    // Each sample moves by about 1/100 of the change.
+    EXPECT_LE(biggestStep, 0x40000000 / 4 * 3 / 100 + 64);
+    for (size_t i = 99; i < data.size(); i++)
+    {
+        ASSERT_EQ(data[i], 0x10000000) << i;
+    }
+}
+
+TEST(NilaiDsp, GainAppliesToQ15WithAStride)
+{
+    GainRamp             gain(FloatToQ31(0.5f));
+    std::array<q15_t, 4> data = {1000, 1000, -1000, -1000};
+    gain.Process(data.data(), 2, 2);
+    EXPECT_EQ(data, (std::array<q15_t, 4> {500, 1000, -500, -1000}));
+
+    // A ramp of no sample is a jump.
+    gain.RampTo(0, 0);
+    EXPECT_EQ(gain.GetGain(), 0);
+    gain.Process(data.data(), 4);
+    EXPECT_EQ(data, (std::array<q15_t, 4> {}));
+}
+
+TEST(NilaiDsp, BiquadMatchesTheReference)
+{
+    auto c = BiquadCoeffs::FromFloat(s_lowPass[0], s_lowPass[1], s_lowPass[2], s_lowPass[3],
+                                     s_lowPass[4]);
+    BiquadCascade<2> cascade;
+    ASSERT_TRUE(cascade.SetSections(std::span {&c, 1}));
+
+    // One tone in the pass band, one far above.
+    std::vector<q31_t> in = MakeSine(2000, 0.05, 0.4);
+    std::vector<q31_t> hi = MakeSine(2000, 2.5, 0.4);
+    for (size_t i = 0; i < in.size(); i++)
+    {
+        in[i] += hi[i];
+    }
+    std::vector<double> exp = Reference(in, s_lowPass);
+
+    // In blocks of uneven sizes, the state carries over.
+    std::vector<q31_t> out = in;
+    cascade.Process(out.data(), 37);
+    cascade.Process(out.data() + 37, out.size() - 37);
+
+    // The coefficients are only 23 bits.
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        ASSERT_NEAR(ToFloat(out[i]), exp[i], 1e-4) << i;
+    }
+}
+
+TEST(NilaiDsp, BiquadFiltersQ15LikeQ31)
+{
+    auto c = BiquadCoeffs::FromFloat(s_lowPass[0], s_lowPass[1], s_lowPass[2], s_lowPass[3],
+                                     s_lowPass[4]);
+    BiquadCascade<1> a;
+    BiquadCascade<1> b;
+    a.SetSections(std::span {&c, 1});
+    b.SetSections(std::span {&c, 1});
+
+    std::vector<q31_t> in31 = MakeSine(500, 0.1, 0.8);
+    std::vector<q15_t> in15(in31.size());
+    Q31ToQ15(in31.data(), in15.data(), in31.size());
+    Q15ToQ31(in15.data(), in31.data(), in31.size());
+
+    a.Process(in31.data(), in31.size());
+    b.Process(in15.data(), in15.size());
+    std::vector<q15_t> exp(in31.size());
+    Q31ToQ15(in31.data(), exp.data(), in31.size());
+    EXPECT_EQ(in15, exp);
+}
+
+TEST(NilaiDsp, LoadsTas5707Banks)
+{
+    std::array<TasFilter, 7> bank = {};
+    // TI's tools add the feedback, and fill the 6 bits above the 26 of the register.
+    bank[2] = {0x00400000, 0x00200000, 0x00000000, 0xFFC00000, 0x00000000};
+    bank[5] = {0x00800000, 0x00000000, 0x00000000, 0x00000000, 0x03F00000};
+
+    BiquadCascade<2> cascade;
+    ASSERT_TRUE(cascade.Load(bank));
+    EXPECT_EQ(cascade.SectionCount(), 2);
+
+    // y = 0.5 x + 0.25 x1 - 0.5 y1.
+    std::array<q31_t, 3> data = {0x20000000, 0, 0};
+    cascade.Process(data.data(), data.size());
+    // Then the second one subtracts an eighth of y2.
+    EXPECT_EQ(data[0], 0x10000000);
+    EXPECT_EQ(data[1], 0);
+    EXPECT_EQ(data[2], -0x02000000);
+
+    bank[0].b1 = 1;
+    BiquadCascade<2> small;
+    EXPECT_FALSE(small.Load(bank));
+    EXPECT_EQ(small.SectionCount(), 0);
+}
+
+TEST(NilaiDsp, StageMixesFiltersAndScalesEachChannel)
+{
+    Stage<2, 2, 1> stage;
+    // Left is halved by its filter, right by its gain.
+    BiquadCoeffs half = {.B0 = BiquadCoeffs::s_one / 2};
+    ASSERT_TRUE(stage.GetFilters(0).SetSections(std::span {&half, 1}));
+    stage.GetGain(1).SetGain(FloatToQ31(0.5f));
+
+    std::array<q15_t, 4>        music = {4000, 4000, -4000, -4000};
+    std::array<q15_t, 4>        beeps = {2000, -2000, 2000, -2000};
+    std::array<const q15_t*, 2> in    = {music.data(), beeps.data()};
+    stage.Process(std::span<const q15_t* const> {in}, music.data(), 2);
+    for (size_t i = 0; i < music.size(); i++)
+    {
+        EXPECT_NEAR(music[i], (std::array<int, 4> {3000, 1000, -1000, -3000})[i], 1) << i;
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * @file    dsp_benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Measures the throughput of the audio DSP blocks on the host, for several block sizes.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "services/dsp/biquad.h"
+#include "services/dsp/fixed_point.h"
+#include "services/dsp/gain_ramp.h"
+#include "services/dsp/mixer.h"
+#include "services/dsp/stage.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+using namespace Nilai::Services::Dsp;
+
+namespace
+{
+//! Samples processed per measurement, whatever the size of the block.
+constexpr size_t s_totalSamples = 16 * 1024 * 1024;
+
+constexpr std::array<size_t, 4> s_sizes = {32, 128, 512, 2048};
+
+// Keeps the compiler from optimizing the loops away.
+volatile int32_t g_sink = 0;
+
+template<typename Fn>
+void Run(const char* name, size_t size, Fn&& fn)
+{
+    size_t  iterations = s_totalSamples / size;
+    int32_t sum        = 0;
+    auto    start      = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++)
+    {
+        sum += fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    g_sink   = sum;
+
+    double s = std::chrono::duration<double>(end - start).count();
+    std::printf("%-32s %6zu samples %10.1f MS/s\n",
+                name,
+                size,
+                static_cast<double>(iterations * size) / s / 1e6);
+}
+
+//! Five sections, like a typical equalizer.
+std::array<BiquadCoeffs, 5> MakeSections()
+{
+    std::array<BiquadCoeffs, 5> out = {};
+    for (size_t i = 0; i < out.size(); i++)
+    {
+        double k = 0.01 * static_cast<double>(i + 1);
+        out[i]   = BiquadCoeffs::FromFloat(k, 2 * k, k, -1.6, 0.7);
+    }
+    return out;
+}
+}    // namespace
+
+int main()
+{
+#if defined(NILAI_DSP_SIMD)
+    std::printf("SIMD kernels\n\n");
+#else
+    std::printf("Portable kernels\n\n");
+#endif
+
+    std::vector<q15_t> a15(s_sizes.back());
+    std::vector<q15_t> b15(s_sizes.back());
+    std::vector<q31_t> a31(s_sizes.back());
+    for (size_t i = 0; i < a15.size(); i++)
+    {
+        a15[i] = static_cast<q15_t>(i * 97);
+        b15[i] = static_cast<q15_t>(i * 31 + 5);
+        a31[i] = static_cast<q31_t>(i * 2654435761u) >> 2;
+    }
+    std::vector<q15_t> out15(s_sizes.back());
+    std::vector<q31_t> out31(s_sizes.back());
+    auto               sections = MakeSections();
+
+    for (size_t size : s_sizes)
+    {
+        std::array<const q15_t*, 2> in15 = {a15.data(), b15.data()};
+        std::array<const q31_t*, 2> in31 = {a31.data(), a31.data()};
+
+        Mixer<2> mixer;
+        mixer.SetGain(1, FloatToQ31(0.5f));
+        Run("Mixer<2> Q15", size, [&] {
+            mixer.Process(std::span<const q15_t* const> {in15}, out15.data(), size);
+            return out15[size - 1];
+        });
+        Run("Mixer<2> Q31", size, [&] {
+            mixer.Process(std::span<const q31_t* const> {in31}, out31.data(), size);
+            return out31[size - 1];
+        });
+
+        GainRamp gain(FloatToQ31(0.8f));
+        Run("GainRamp Q15", size, [&] {
+            gain.Process(out15.data(), size);
+            return out15[0];
+        });
+        Run("GainRamp Q15 (ramping)", size, [&] {
+            gain.RampTo(gain.GetGain() ^ 0x10000000, size);
+            gain.Process(out15.data(), size);
+            return out15[0];
+        });
+
+        BiquadCascade<5> cascade;
+        cascade.SetSections(sections);
+        Run("BiquadCascade<5> Q31", size, [&] {
+            cascade.Process(out31.data(), size);
+            return out31[0];
+        });
+        Run("BiquadCascade<5> Q15", size, [&] {
+            cascade.Process(out15.data(), size);
+            return out15[0];
+        });
+
+        Stage<2, 2, 5> stage;
+        stage.GetFilters(0).SetSections(sections);
+        stage.GetFilters(1).SetSections(sections);
+        stage.GetGain(1).SetGain(FloatToQ31(0.5f));
+        Run("Stage<2, 2, 5> Q15", size, [&] {
+            stage.Process(std::span<const q15_t* const> {in15}, out15.data(), size / 2);
+            return out15[0];
+        });
+        std::printf("\n");
+    }
+    return 0;
+}
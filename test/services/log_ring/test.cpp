@@ -0,0 +1,191 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "services/log_ring.h"
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+using namespace Nilai::Services;
+
+namespace
+{
+using Ring = LogRing<16, 2>;
+
+std::span<const char> Msg(std::string_view s)
+{
+    return {s.data(), s.size()};
+}
+
+// Takes at most a few bytes per call, like a sink whose DMA is busy.
+class SlowSink : public LogSink
+{
+public:
+    explicit SlowSink(size_t chunk) : m_chunk(chunk) {}
+
+    size_t Consume(std::span<const char> data) override
+    {
+        size_t len = std::min(data.size(), m_chunk);
+        Received.append(data.data(), len);
+        return len;
+    }
+
+    std::string Received;
+
+private:
+    size_t m_chunk;
+};
+
+size_t Feed(Ring& ring, size_t id, LogSink& sink)
+{
+    return ring.Drain(id, [&sink](std::span<const char> d) { return sink.Consume(d); });
+}
+}    // namespace
+
+TEST(LogRing, WithoutSinksDiscards)
+{
+    Ring ring;
+    EXPECT_TRUE(ring.Write(Msg("0123456789")));
+    EXPECT_TRUE(ring.Write(Msg("0123456789")));
+    EXPECT_EQ(ring.Used(), 0);
+    EXPECT_EQ(ring.DroppedMessages(), 0);
+}
+
+TEST(LogRing, DropsWholeMessages)
+{
+    Ring   ring;
+    size_t id = ring.AddSink();
+    ASSERT_NE(id, Ring::s_invalidSink);
+
+    EXPECT_TRUE(ring.Write(Msg("0123456789")));
+    // Only 6 bytes are left, the message isn't cut.
+    EXPECT_FALSE(ring.Write(Msg("abcdefg")));
+    EXPECT_TRUE(ring.Write(Msg("abcdef")));
+    EXPECT_FALSE(ring.Write(Msg("x")));
+    EXPECT_EQ(ring.DroppedMessages(), 2);
+    EXPECT_EQ(ring.Used(), 16);
+
+    SlowSink sink(100);
+    EXPECT_EQ(Feed(ring, id, sink), 16);
+    EXPECT_EQ(sink.Received, "0123456789abcdef");
+    EXPECT_EQ(ring.Used(), 0);
+}
+
+TEST(LogRing, HighWaterMark)
+{
+    Ring     ring;
+    size_t   id = ring.AddSink();
+    SlowSink sink(100);
+
+    ring.Write(Msg("0123"));
+    ring.Write(Msg("4567890"));
+    EXPECT_EQ(ring.HighWaterMark(), 11);
+    Feed(ring, id, sink);
+    ring.Write(Msg("abc"));
+    EXPECT_EQ(ring.HighWaterMark(), 11);
+
+    ring.ResetStats();
+    EXPECT_EQ(ring.HighWaterMark(), 0);
+    ring.Write(Msg("d"));
+    EXPECT_EQ(ring.HighWaterMark(), 4);
+}
+
+TEST(LogRing, WrapsAround)
+{
+    Ring     ring;
+    size_t   id = ring.AddSink();
+    SlowSink sink(100);
+
+    std::string expected;
+    for (int i = 0; i < 20; i++)
+    {
+        std::string msg = "msg" + std::to_string(i) + ";";
+        ASSERT_TRUE(ring.Write(Msg(msg)));
+        expected += msg;
+        Feed(ring, id, sink);
+    }
+    EXPECT_EQ(sink.Received, expected);
+}
+
+TEST(LogRing, SlowestSinkLimits)
+{
+    Ring     ring;
+    size_t   fastId = ring.AddSink();
+    size_t   slowId = ring.AddSink();
+    SlowSink fast(100);
+    SlowSink slow(3);
+    EXPECT_EQ(ring.AddSink(), Ring::s_invalidSink);
+
+    ring.Write(Msg("0123456789"));
+    EXPECT_EQ(Feed(ring, fastId, fast), 10);
+    EXPECT_EQ(Feed(ring, slowId, slow), 3);
+    EXPECT_EQ(ring.Used(), 7);
+
+    // The fast sink is done, but the slow one still holds 7 bytes.
+    EXPECT_FALSE(ring.Write(Msg("abcdefghij")));
+    EXPECT_TRUE(ring.Write(Msg("abcdefghi")));
+    EXPECT_EQ(ring.DroppedMessages(), 1);
+
+    Feed(ring, fastId, fast);
+    while (Feed(ring, slowId, slow) != 0)
+    {
+    }
+    EXPECT_EQ(fast.Received, "0123456789abcdefghi");
+    EXPECT_EQ(slow.Received, fast.Received);
+
+    // Once removed, a sink no longer holds the ring back.
+    ring.Write(Msg("0123456789"));
+    ring.RemoveSink(slowId);
+    Feed(ring, fastId, fast);
+    EXPECT_EQ(ring.Used(), 0);
+}
+
+TEST(LogRing, NewSinkStartsAtHead)
+{
+    Ring ring;
+    ring.AddSink();
+    ring.Write(Msg("old"));
+
+    size_t   id = ring.AddSink();
+    SlowSink sink(100);
+    ring.Write(Msg("new"));
+    Feed(ring, id, sink);
+    EXPECT_EQ(sink.Received, "new");
+}
+
+TEST(LogRing, CallbackSink)
+{
+    Ring            ring;
+    size_t          id = ring.AddSink();
+    std::string     received;
+    CallbackLogSink sink([&received](const char* msg, size_t len) { received.append(msg, len); });
+
+    for (int i = 0; i < 5; i++)
+    {
+        ring.Write(Msg("0123456789"));
+        Feed(ring, id, sink);
+    }
+    EXPECT_EQ(received.size(), 50);
+    EXPECT_EQ(ring.Used(), 0);
+
+    // Without a callback, the sink still empties the ring.
+    sink.SetCallback({});
+    ring.Write(Msg("lost"));
+    Feed(ring, id, sink);
+    EXPECT_EQ(received.size(), 50);
+    EXPECT_EQ(ring.Used(), 0);
+}
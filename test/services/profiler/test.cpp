@@ -0,0 +1,186 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "processes/application.h"
+#include "services/profiler/profiler.h"
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+using namespace Nilai;
+using namespace Nilai::Profiling;
+
+namespace
+{
+class TestModule : public Module
+{
+public:
+    void Run() override {}
+};
+
+struct Decoded
+{
+    SnapshotHeader                     Header;
+    std::map<uint16_t, CycleHistogram> Modules;
+    std::map<uint16_t, CycleHistogram> Isrs;
+    std::vector<CycleHistogram>        Loops;
+};
+
+Decoded Decode(std::span<const uint8_t> snapshot)
+{
+    Decoded d;
+    EXPECT_TRUE(ReadSnapshot(snapshot,
+                             d.Header,
+                             [&d](RecordKind kind, uint16_t id, const CycleHistogram& h)
+                             {
+                                 switch (kind)
+                                 {
+                                     case RecordKind::Loop: d.Loops.push_back(h); break;
+                                     case RecordKind::Module: d.Modules[id] = h; break;
+                                     case RecordKind::Isr: d.Isrs[id] = h; break;
+                                 }
+                             }));
+    return d;
+}
+}    // namespace
+
+TEST(NilaiCycleHistogram, Buckets)
+{
+    EXPECT_EQ(CycleHistogram::BucketOf(0), 0);
+    EXPECT_EQ(CycleHistogram::BucketOf(1), 0);
+    EXPECT_EQ(CycleHistogram::BucketOf(2), 1);
+    EXPECT_EQ(CycleHistogram::BucketOf(3), 1);
+    EXPECT_EQ(CycleHistogram::BucketOf(1024), 10);
+    EXPECT_EQ(CycleHistogram::BucketOf(0xFFFFFFFF), 31);
+
+    CycleHistogram h;
+    h.Add(5);
+    h.Add(7);
+    h.Add(100);
+    EXPECT_EQ(h.Count, 3);
+    EXPECT_EQ(h.Min, 5);
+    EXPECT_EQ(h.Max, 100);
+    EXPECT_EQ(h.Total, 112);
+    EXPECT_EQ(h.Buckets[2], 2);
+    EXPECT_EQ(h.Buckets[6], 1);
+}
+
+TEST(NilaiProfilingSnapshot, RoundTrip)
+{
+    CycleHistogram a;
+    a.Add(0);
+    a.Add(0xFFFFFFFF);
+    CycleHistogram b;
+    b.Add(300);
+    CycleHistogram empty;
+
+    std::array<uint8_t, SnapshotSize(3)> buff = {};
+    SnapshotWriter                       writer(buff, 168'000'000, 1234);
+    EXPECT_TRUE(writer.Add(RecordKind::Loop, 0, empty));
+    EXPECT_TRUE(writer.Add(RecordKind::Module, 7, a));
+    EXPECT_TRUE(writer.Add(RecordKind::Isr, 54, b));
+    // Only the non-empty buckets are written.
+    EXPECT_EQ(writer.Size(), s_snapshotHeaderSize + (3 * s_recordHeaderSize) + (33 * 4));
+
+    Decoded d = Decode({buff.data(), writer.Size()});
+    EXPECT_EQ(d.Header.Version, s_snapshotVersion);
+    EXPECT_EQ(d.Header.RecordCount, 3);
+    EXPECT_EQ(d.Header.CycleFrequency, 168'000'000);
+    EXPECT_EQ(d.Header.Timestamp, 1234);
+    ASSERT_EQ(d.Loops.size(), 1);
+    EXPECT_EQ(d.Loops[0], empty);
+    EXPECT_EQ(d.Modules[7], a);
+    EXPECT_EQ(d.Isrs[54], b);
+}
+
+TEST(NilaiProfilingSnapshot, LeavesOutWhatDoesNotFit)
+{
+    CycleHistogram h;
+    h.Add(1);
+
+    std::array<uint8_t, s_snapshotHeaderSize + s_recordHeaderSize + 4> buff = {};
+    SnapshotWriter writer(buff, 1, 0);
+    EXPECT_TRUE(writer.Add(RecordKind::Module, 1, h));
+    EXPECT_FALSE(writer.Add(RecordKind::Module, 2, h));
+
+    Decoded d = Decode({buff.data(), writer.Size()});
+    EXPECT_EQ(d.Header.RecordCount, 1);
+    EXPECT_EQ(d.Modules.size(), 1);
+
+    // Truncated or foreign data is rejected.
+    SnapshotHeader header;
+    auto           ignore = [](RecordKind, uint16_t, const CycleHistogram&) {};
+    EXPECT_FALSE(ReadSnapshot({buff.data(), writer.Size() - 1}, header, ignore));
+    buff[0] = 0;
+    EXPECT_FALSE(ReadSnapshot(buff, header, ignore));
+}
+
+TEST(NilaiProfiler, TimesEachModuleAndTheLoop)
+{
+    Profiler::ResetStats();
+    Application app;
+    app.AddModule<TestModule>();
+    app.AddModule<TestModule>();
+
+    for (int i = 0; i < 5; i++)
+    {
+        app.OnRun();
+    }
+
+    std::array<uint8_t, Profiler::s_maxSnapshotSize> buff = {};
+    Decoded d = Decode({buff.data(), Profiler::Snapshot(buff)});
+    EXPECT_EQ(d.Header.CycleFrequency, Profiler::GetCycleFrequency());
+    ASSERT_EQ(d.Loops.size(), 1);
+    // The first pass only marks the start of the loop.
+    EXPECT_EQ(d.Loops[0].Count, 4);
+    ASSERT_EQ(d.Modules.size(), 2);
+    EXPECT_EQ(d.Modules[0].Count, 5);
+    EXPECT_EQ(d.Modules[1].Count, 5);
+    EXPECT_TRUE(d.Isrs.empty());
+}
+
+TEST(NilaiProfiler, TimesInterrupts)
+{
+    Profiler::ResetStats();
+    {
+        NILAI_PROFILE_ISR();
+    }
+    Profiler::RecordIsr(54, 100);
+    Profiler::RecordIsr(54, 200);
+
+    std::array<uint8_t, Profiler::s_maxSnapshotSize> buff = {};
+    Decoded d = Decode({buff.data(), Profiler::Snapshot(buff)});
+    ASSERT_EQ(d.Isrs.size(), 2);
+    EXPECT_EQ(d.Isrs[0].Count, 1);
+    EXPECT_EQ(d.Isrs[54].Count, 2);
+    EXPECT_EQ(d.Isrs[54].Total, 300);
+    EXPECT_EQ(d.Loops[0].Count, 0);
+}
+
+TEST(NilaiProfiler, MacrosCanShareAScope)
+{
+    Profiler::ResetStats();
+    {
+        NILAI_PROFILE_ISR();
+        NILAI_PROFILE_ISR();
+    }
+
+    std::array<uint8_t, Profiler::s_maxSnapshotSize> buff = {};
+    Decoded d = Decode({buff.data(), Profiler::Snapshot(buff)});
+    ASSERT_EQ(d.Isrs.size(), 1);
+    EXPECT_EQ(d.Isrs[0].Count, 2);
+}
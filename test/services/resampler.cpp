@@ -0,0 +1,217 @@
+/**
+ * @file    resampler.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include <gtest/gtest.h>
+
+#include "services/dsp/resampler.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace Nilai::Services::Dsp;
+
+namespace
+{
+constexpr double s_pi = 3.14159265358979323846;
+
+//! Stereo sine, the right channel being the opposite of the left one.
+template<typename T>
+std::vector<T> MakeSine(size_t frames, double freq, double rate, double amplitude)
+{
+    std::vector<T> out(2 * frames);
+    for (size_t i = 0; i < frames; i++)
+    {
+        double v = amplitude * std::sin(2.0 * s_pi * freq * static_cast<double>(i) / rate);
+        if constexpr (std::is_same_v<T, q15_t>)
+        {
+            out[2 * i]     = FloatToQ15(static_cast<float>(v));
+            out[2 * i + 1] = FloatToQ15(static_cast<float>(-v));
+        }
+        else
+        {
+            out[2 * i]     = FloatToQ31(static_cast<float>(v));
+            out[2 * i + 1] = FloatToQ31(static_cast<float>(-v));
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Checks that the output is the input sine at the output rate, delayed by the filter.
+ * @return The biggest error, relative to full scale.
+ */
+template<typename T>
+double SineError(const Resampler<T, 2>& src, const std::vector<T>& out, double freq, double amp)
+{
+    double l     = src.GetUpFactor();
+    double m     = src.GetDownFactor();
+    double delay = (l * static_cast<double>(src.Config().TapsPerPhase) - 1.0) / 2.0;
+    double rate  = src.Config().InputRate;
+    double error = 0.0;
+    // Skips the start, where the history was still filling.
+    for (size_t k = out.size() / 4; k < out.size() / 2; k++)
+    {
+        double t   = (static_cast<double>(k) * m - delay) / l;
+        double exp = amp * std::sin(2.0 * s_pi * freq * t / rate);
+        error      = std::max(error, std::abs(ToFloat(out[2 * k]) - exp));
+        error      = std::max(error, std::abs(ToFloat(out[2 * k + 1]) + exp));
+    }
+    return error;
+}
+}    // namespace
+
+TEST(NilaiResampler, ReducesTheRatio)
+{
+    Resampler<q15_t, 2> src;
+    ASSERT_TRUE(src.Configure({.InputRate = 44100, .OutputRate = 48000}));
+    EXPECT_EQ(src.GetUpFactor(), 160);
+    EXPECT_EQ(src.GetDownFactor(), 147);
+    ASSERT_TRUE(src.Configure({.InputRate = 48000, .OutputRate = 16000}));
+    EXPECT_EQ(src.GetUpFactor(), 1);
+    EXPECT_EQ(src.GetDownFactor(), 3);
+}
+
+TEST(NilaiResampler, ConvertsASine)
+{
+    for (auto [in, out] : {std::pair {44100u, 48000u}, {48000u, 44100u}, {16000u, 48000u}})
+    {
+        Resampler<q31_t, 2> src;
+        ASSERT_TRUE(src.Configure({.InputRate = in, .OutputRate = out}));
+        auto               input = MakeSine<q31_t>(4000, 1000.0, in, 0.5);
+        std::vector<q31_t> output(2 * (src.GetUpFactor() * 4000 / src.GetDownFactor() + 1));
+        auto               r = src.Process(input.data(), 4000, output.data(), output.size() / 2);
+        EXPECT_EQ(r.Consumed, 4000);
+        output.resize(2 * r.Produced);
+        EXPECT_LT(SineError(src, output, 1000.0, 0.5), 5e-4) << in << " -> " << out;
+    }
+
+    Resampler<q15_t, 2> src;
+    ASSERT_TRUE(src.Configure({.InputRate = 44100, .OutputRate = 48000}));
+    auto               input = MakeSine<q15_t>(4000, 1000.0, 44100, 0.5);
+    std::vector<q15_t> output(2 * 4000);
+    auto               r = src.Process(input.data(), 4000, output.data(), 4000);
+    output.resize(2 * r.Produced);
+    EXPECT_LT(SineError(src, output, 1000.0, 0.5), 5e-4);
+}
+
+TEST(NilaiResampler, RemovesWhatTheOutputCantCarry)
+{
+    // 20 kHz doesn't fit in 16 kHz.
+    Resampler<q31_t, 2> src;
+    ASSERT_TRUE(src.Configure({.InputRate = 48000, .OutputRate = 16000}));
+    auto               input = MakeSine<q31_t>(3000, 20000.0, 48000, 0.9);
+    std::vector<q31_t> output(2 * 1000);
+    src.Process(input.data(), 3000, output.data(), 1000);
+
+    double peak = 0.0;
+    for (size_t i = output.size() / 2; i < output.size(); i++)
+    {
+        peak = std::max(peak, static_cast<double>(std::abs(ToFloat(output[i]))));
+    }
+    // At least 70 dB down.
+    EXPECT_LT(peak, 0.9 * 3e-4);
+}
+
+TEST(NilaiResampler, BlockSizesDontChangeTheOutput)
+{
+    Resampler<q15_t, 2> whole;
+    Resampler<q15_t, 2> blocks;
+    ASSERT_TRUE(whole.Configure({.InputRate = 44100, .OutputRate = 48000, .TapsPerPhase = 8}));
+    ASSERT_TRUE(blocks.Configure(whole.Config()));
+
+    auto               input = MakeSine<q15_t>(1000, 3000.0, 44100, 0.7);
+    std::vector<q15_t> exp(2 * 1200);
+    auto               r = whole.Process(input.data(), 1000, exp.data(), 1200);
+    exp.resize(2 * r.Produced);
+
+    // Uneven input blocks, and output blocks too small for what the input could produce.
+    std::vector<q15_t> out;
+    size_t             consumed = 0;
+    for (size_t i = 0; consumed < 1000; i++)
+    {
+        size_t                   n    = std::min<size_t>(1 + (i * 7) % 23, 1000 - consumed);
+        std::array<q15_t, 2 * 5> buff = {};
+        size_t                   used = 0;
+        do
+        {
+            auto br = blocks.Process(&input[2 * (consumed + used)], n - used, buff.data(), 5);
+            used += br.Consumed;
+            out.insert(out.end(), buff.begin(), buff.begin() + 2 * br.Produced);
+        } while (used < n);
+        consumed += n;
+    }
+    EXPECT_EQ(out, exp);
+}
+
+TEST(NilaiResampler, TellsHowMuchInputIsNeeded)
+{
+    Resampler<q15_t, 1> src;
+    ASSERT_TRUE(src.Configure({.InputRate = 44100, .OutputRate = 48000}));
+    std::vector<q15_t> input(1024, 100);
+    std::vector<q15_t> output(256);
+
+    size_t total = 0;
+    for (size_t block : {256, 1, 17, 256, 255})
+    {
+        size_t need = src.InputFramesFor(block);
+        auto   r    = src.Process(input.data(), need, output.data(), block);
+        EXPECT_EQ(r.Consumed, need);
+        EXPECT_EQ(r.Produced, block);
+        total += need;
+    }
+    // 785 frames at 48 kHz last as long as about 721 at 44.1 kHz.
+    EXPECT_NEAR(static_cast<double>(total), 785.0 * 147.0 / 160.0, 1.0);
+
+    // Each phase has a gain of 1, a constant stays the same.
+    for (q15_t s : output)
+    {
+        EXPECT_NEAR(s, 100, 1);
+    }
+}
+
+TEST(NilaiResampler, CopiesWhenTheRatesAreTheSame)
+{
+    Resampler<q15_t, 2> src;
+    ASSERT_TRUE(src.Configure({.InputRate = 48000, .OutputRate = 48000}));
+    EXPECT_TRUE(src.IsBypassed());
+
+    std::vector<q15_t> input = {1, 2, 3, 4, 5, 6};
+    std::vector<q15_t> out(4);
+    EXPECT_EQ(src.InputFramesFor(2), 2);
+    auto r = src.Process(input.data(), 3, out.data(), 2);
+    EXPECT_EQ(r.Consumed, 2);
+    EXPECT_EQ(r.Produced, 2);
+    EXPECT_EQ(out, (std::vector<q15_t> {1, 2, 3, 4}));
+}
+
+TEST(NilaiResampler, RejectsInvalidConfigurations)
+{
+    Resampler<q15_t, 2> src;
+    EXPECT_FALSE(src.Configure({.InputRate = 0}));
+    EXPECT_FALSE(src.Configure({.TapsPerPhase = 0}));
+    EXPECT_FALSE(src.Configure({.Passband = 1.5f}));
+    // Would need 44101 phases.
+    EXPECT_FALSE(src.Configure({.InputRate = 44100, .OutputRate = 44101}));
+    EXPECT_FALSE(src.IsConfigured());
+
+    // Not configured, nothing is converted.
+    std::array<q15_t, 2> frame = {};
+    EXPECT_EQ(src.Process(frame.data(), 1, frame.data(), 1).Produced, 0);
+    EXPECT_EQ(src.InputFramesFor(10), 0);
+}
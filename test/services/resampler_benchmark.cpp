@@ -0,0 +1,133 @@
+/**
+ * @file    resampler_benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Measures the cost of each output sample of the resampler on the host, for the usual
+ *          ratios.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "services/dsp/resampler.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <x86intrin.h>
+#    define NILAI_BENCH_HAS_TSC
+#endif
+
+using namespace Nilai::Services::Dsp;
+
+namespace
+{
+//! Output frames produced per measurement.
+constexpr size_t s_totalFrames = 2 * 1024 * 1024;
+//! Output frames per call, like the refill of an audio pipeline.
+constexpr size_t s_blockFrames = 256;
+
+constexpr std::array<std::pair<uint32_t, uint32_t>, 6> s_ratios = {{
+  {44100, 48000},
+  {48000, 44100},
+  {32000, 48000},
+  {22050, 48000},
+  {16000, 48000},
+  {48000, 16000},
+}};
+
+// Keeps the compiler from optimizing the loops away.
+volatile int32_t g_sink = 0;
+
+uint64_t Ticks()
+{
+#if defined(NILAI_BENCH_HAS_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+template<typename T>
+void Run(const char* type, uint32_t in, uint32_t out, size_t taps)
+{
+    Resampler<T, 2> src;
+    if (!src.Configure({.InputRate = in, .OutputRate = out, .TapsPerPhase = taps}))
+    {
+        std::printf("%s %u -> %u: invalid\n", type, in, out);
+        return;
+    }
+
+    std::vector<T> input(2 * src.InputFramesFor(s_blockFrames) + 16);
+    for (size_t i = 0; i < input.size(); i++)
+    {
+        input[i] = static_cast<T>(static_cast<uint32_t>(i) * 2654435761u);
+    }
+    std::vector<T> output(2 * s_blockFrames);
+
+    int32_t  sum   = 0;
+    auto     start = std::chrono::steady_clock::now();
+    uint64_t t0    = Ticks();
+    for (size_t done = 0; done < s_totalFrames; done += s_blockFrames)
+    {
+        size_t need = src.InputFramesFor(s_blockFrames);
+        src.Process(input.data(), need, output.data(), s_blockFrames);
+        sum += output[0];
+    }
+    uint64_t t1  = Ticks();
+    auto     end = std::chrono::steady_clock::now();
+    g_sink       = sum;
+
+    // Per sample of a channel.
+    double samples = 2.0 * static_cast<double>(s_totalFrames);
+    double ns      = std::chrono::duration<double, std::nano>(end - start).count() / samples;
+    std::printf("%-4s %2zu taps %5u -> %5u (L=%3u, M=%3u) %7.2f ns/sample",
+                type,
+                taps,
+                in,
+                out,
+                src.GetUpFactor(),
+                src.GetDownFactor(),
+                ns);
+#if defined(NILAI_BENCH_HAS_TSC)
+    std::printf(" %7.1f ticks/sample", static_cast<double>(t1 - t0) / samples);
+#else
+    (void)t0;
+    (void)t1;
+#endif
+    std::printf("\n");
+}
+}    // namespace
+
+int main()
+{
+#if defined(NILAI_DSP_SIMD)
+    std::printf("SIMD kernels, stereo, %zu frames per block\n\n", s_blockFrames);
+#else
+    std::printf("Portable kernels, stereo, %zu frames per block\n\n", s_blockFrames);
+#endif
+
+    for (size_t taps : {16, 32})
+    {
+        for (auto [in, out] : s_ratios)
+        {
+            Run<q15_t>("Q15", in, out, taps);
+        }
+        for (auto [in, out] : s_ratios)
+        {
+            Run<q31_t>("Q31", in, out, taps);
+        }
+        std::printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file    benchmark.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief   Compares the throughput of SpscRing against CircularBuffer on the host.
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/circular_buffer.h"
+#include "defines/spsc_ring.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+using namespace Nilai;
+
+namespace
+{
+constexpr size_t s_capacity   = 256;
+constexpr size_t s_iterations = 2'000'000;
+constexpr size_t s_burst      = 32;
+
+// Keeps the compiler from optimizing the loops away.
+volatile uint32_t g_sink = 0;
+
+template<typename Fn>
+void Run(const char* name, Fn&& fn)
+{
+    auto     start = std::chrono::steady_clock::now();
+    uint32_t sum   = fn();
+    auto     end   = std::chrono::steady_clock::now();
+    g_sink         = sum;
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    std::printf("%-40s %8.2f ns/item\n", name, ns / static_cast<double>(s_iterations));
+}
+}    // namespace
+
+int main()
+{
+    Run("CircularBuffer Push/Pop",
+        []
+        {
+            static CircularBuffer<uint32_t, s_capacity> cb;
+            uint32_t                                    sum = 0;
+            for (uint32_t i = 0; i < s_iterations; i++)
+            {
+                cb.Push(i);
+                sum += *cb.Pop();
+            }
+            return sum;
+        });
+
+    Run("SpscRing Push/Pop",
+        []
+        {
+            static SpscRing<uint32_t, s_capacity> ring;
+            uint32_t                              sum = 0;
+            for (uint32_t i = 0; i < s_iterations; i++)
+            {
+                ring.Push(i);
+                sum += *ring.Pop();
+            }
+            return sum;
+        });
+
+    Run("CircularBuffer PushMany/PopMany (vector)",
+        []
+        {
+            static CircularBuffer<uint32_t, s_capacity> cb;
+            std::array<uint32_t, s_burst>               in  = {};
+            uint32_t                                    sum = 0;
+            for (uint32_t i = 0; i < s_iterations; i += s_burst)
+            {
+                in[0] = i;
+                cb.PushMany(in);
+                for (uint32_t v : cb.PopMany(s_burst))
+                {
+                    sum += v;
+                }
+            }
+            return sum;
+        });
+
+    Run("SpscRing PushMany/PopMany (span)",
+        []
+        {
+            static SpscRing<uint32_t, s_capacity> ring;
+            std::array<uint32_t, s_burst>         in  = {};
+            std::array<uint32_t, s_burst>         out = {};
+            uint32_t                              sum = 0;
+            for (uint32_t i = 0; i < s_iterations; i += s_burst)
+            {
+                in[0] = i;
+                ring.PushMany(std::span<const uint32_t> {in});
+                size_t got = ring.PopMany(out);
+                for (size_t j = 0; j < got; j++)
+                {
+                    sum += out[j];
+                }
+            }
+            return sum;
+        });
+
+    return 0;
+}
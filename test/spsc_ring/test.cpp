@@ -0,0 +1,140 @@
+/**
+ * @file    test.cpp
+ * @author  Samuel Martel
+ * @date    2026-10-16
+ * @brief
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ * You should have received a copy of the GNU General Public License along with this program. If
+ * not, see <a href=https://www.gnu.org/licenses/>https://www.gnu.org/licenses/</a>.
+ */
+#include "defines/spsc_ring.h"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <thread>
+
+using namespace Nilai;
+
+TEST(NilaiSpscRing, DefaultInit)
+{
+    SpscRing<int, 8> ring;
+    EXPECT_EQ(ring.Size(), 0);
+    EXPECT_EQ(ring.Capacity(), 8);
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_FALSE(ring.Full());
+    EXPECT_FALSE(ring.Pop());
+    EXPECT_EQ(ring.Front(), nullptr);
+}
+
+TEST(NilaiSpscRing, PushPop)
+{
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_TRUE(ring.Push(i));
+    }
+    EXPECT_TRUE(ring.Full());
+
+    EXPECT_EQ(*ring.Front(), 0);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(ring.Pop(), i);
+    }
+    EXPECT_TRUE(ring.Empty());
+}
+
+TEST(NilaiSpscRing, RejectsWhenFull)
+{
+    SpscRing<int, 4> ring;
+    for (int i = 0; i < 4; i++)
+    {
+        ring.Push(i);
+    }
+    EXPECT_FALSE(ring.Push(4));
+    EXPECT_EQ(ring.Overflows(), 1);
+
+    // The oldest item is not overwritten.
+    EXPECT_EQ(ring.Pop(), 0);
+}
+
+TEST(NilaiSpscRing, PushManyWrapsAround)
+{
+    SpscRing<int, 8> ring;
+    std::array       first = {0, 1, 2, 3, 4, 5};
+    EXPECT_EQ(ring.PushMany(std::span<const int> {first}), 6);
+
+    std::array<int, 4> out = {};
+    EXPECT_EQ(ring.PopMany(out), 4);
+    EXPECT_EQ(out, (std::array {0, 1, 2, 3}));
+
+    // 2 left, room for 6. The last 2 are rejected.
+    std::array second = {6, 7, 8, 9, 10, 11, 12, 13};
+    EXPECT_EQ(ring.PushMany(std::span<const int> {second}), 6);
+    EXPECT_EQ(ring.Overflows(), 2);
+
+    std::array<int, 16> all = {};
+    ASSERT_EQ(ring.PopMany(all), 8);
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_EQ(all[i], i + 4);
+    }
+    EXPECT_EQ(ring.PopMany(all), 0);
+}
+
+TEST(NilaiSpscRing, Clear)
+{
+    SpscRing<int, 4> ring;
+    ring.Push(1);
+    ring.Push(2);
+    ring.Clear();
+    EXPECT_TRUE(ring.Empty());
+    EXPECT_TRUE(ring.Push(3));
+    EXPECT_EQ(ring.Pop(), 3);
+}
+
+TEST(NilaiSpscRing, ConcurrentProducerConsumer)
+{
+    static constexpr uint32_t s_count = 200000;
+    SpscRing<uint32_t, 64>    ring;
+
+    std::thread producer(
+      [&ring]
+      {
+          for (uint32_t i = 0; i < s_count;)
+          {
+              if (ring.Push(i))
+              {
+                  i++;
+              }
+              else
+              {
+                  // Lets the consumer run when both threads share a core.
+                  std::this_thread::yield();
+              }
+          }
+      });
+
+    uint32_t expected = 0;
+    while (expected < s_count)
+    {
+        std::array<uint32_t, 16> out = {};
+        size_t                   got = ring.PopMany(out);
+        if (got == 0)
+        {
+            std::this_thread::yield();
+        }
+        for (size_t i = 0; i < got; i++)
+        {
+            ASSERT_EQ(out[i], expected++);
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring.Empty());
+}